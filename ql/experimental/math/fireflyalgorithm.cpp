@@ -21,6 +21,7 @@ FOR A PARTICULAR PURPOSE.  See the license for more details.
 #include <ql/math/randomnumbers/sobolrsg.hpp>
 #include <algorithm>
 #include <cmath>
+#include <string>
 #include <utility>
 
 namespace QuantLib {
@@ -30,11 +31,12 @@ namespace QuantLib {
                                        Size Mde,
                                        Real mutation,
                                        Real crossover,
-                                       unsigned long seed)
+                                       unsigned long seed,
+                                       bool parallelEvaluation)
     : mutation_(mutation), crossover_(crossover), M_(M), Mde_(Mde), Mfa_(M_ - Mde_),
       intensity_(std::move(intensity)), randomWalk_(std::move(randomWalk)),
       generator_(seed), distribution_(Mfa_, Mde > 0 ? M_ - 1 : M_),
-      rng_(seed) {
+      rng_(seed), parallelEvaluation_(parallelEvaluation) {
         QL_REQUIRE(M_ >= Mde_,
             "Differential Evolution subpopulation cannot be larger than total population");
     }
@@ -63,10 +65,13 @@ namespace QuantLib {
                 //Assign X=lb+(ub-lb)*random
                 x[j] = lX_[j] + bounds[j] * sample[j];
             }
-            //Evaluate point
-            values_.emplace_back(P.value(x), i);
         }
 
+        //Evaluate points
+        const Array values = evaluate(P, x_);
+        for (Size i = 0; i < M_; i++)
+            values_.emplace_back(values[i], i);
+
         //init intensity & randomWalk
         intensity_->init(this);
         randomWalk_->init(this);
@@ -84,8 +89,9 @@ namespace QuantLib {
         startState(P, endCriteria);
 
         bool isFA = Mfa_ > 0;
-        //Variables for DE
-        Array z(N_, 0.0);
+        //Trial points
+        std::vector<Array> zDE(M_ - Mfa_, Array(N_, 0.0));
+        std::vector<Array> zFA(Mfa_, Array(N_, 0.0));
         Size indexR1, indexR2;
         decltype(distribution_)::param_type nParam(0, N_ - 1);
 
@@ -115,12 +121,10 @@ namespace QuantLib {
             //Differential evolution
             if(Mfa_ < M_){
                 Size indexBest = values_[0].second;
-                Array& xBest = x_[indexBest];
                 for (Size i = Mfa_; i < M_; i++) { 
                     if (!isFA) {
                         //Pure DE requires random index
                         indexBest = distribution_(generator_);
-                        xBest = x_[indexBest];
                     }
                     do { 
                         indexR1 = distribution_(generator_);
@@ -129,11 +133,12 @@ namespace QuantLib {
                         indexR2 = distribution_(generator_);
                     } while(indexR2 == indexBest || indexR2 == indexR1);
                     
-                    Size index = values_[i].second;
-                    Array& x   = x_[index];
-                    Array& xR1 = x_[indexR1];
-                    Array& xR2 = x_[indexR2];
-					Size rIndex = distribution_(generator_, nParam);
+                    const Array& x     = x_[values_[i].second];
+                    const Array& xBest = x_[indexBest];
+                    const Array& xR1   = x_[indexR1];
+                    const Array& xR2   = x_[indexR2];
+                    Array& z = zDE[i - Mfa_];
+                    Size rIndex = distribution_(generator_, nParam);
                     for (Size j = 0; j < N_; j++) {
                         if (j == rIndex || rng_.nextReal() <= crossover_) {
                             //Change x[j] according to crossover
@@ -149,15 +154,18 @@ namespace QuantLib {
                             z[j] = uX_[j];
                         }
                     }
-                    Real val = P.value(z);
-                    if (val < values_[index].first) {
+                }
+
+                const Array val = evaluate(P, zDE);
+                for (Size i = Mfa_; i < M_; i++) {
+                    if (val[i - Mfa_] < values_[i].first) {
                         //Accept new point
-                        x = z;
-                        values_[index].first = val;
+                        x_[values_[i].second] = zDE[i - Mfa_];
+                        values_[i].first = val[i - Mfa_];
                         //mark best
-                        if (val < bestValue) {
-                            bestValue = val;
-                            bestX = x;
+                        if (values_[i].first < bestValue) {
+                            bestValue = values_[i].first;
+                            bestX = zDE[i - Mfa_];
                             iterationStat = 0;
                         }
                     }
@@ -175,9 +183,10 @@ namespace QuantLib {
                 //Loop over particles
                 for (Size i = 0; i < Mfa_; i++) {
                     Size index = values_[i].second;
-                    Array& x   = x_[index];
-                    Array& xI  = xI_[index];
-                    Array& xRW = xRW_[index];
+                    const Array& x   = x_[index];
+                    const Array& xI  = xI_[index];
+                    const Array& xRW = xRW_[index];
+                    Array& z = zFA[i];
 
                     //Loop over dimensions
                     for (Size j = 0; j < N_; j++) {
@@ -191,19 +200,22 @@ namespace QuantLib {
                             z[j] = uX_[j];
                         }
                     }
-                    Real val = P.value(z);
-                    if(!std::isnan(val))
-					{
-						//Accept new point
-                        x = z;
-                        values_[index].first = val;
+                }
+
+                const Array val = evaluate(P, zFA);
+                for (Size i = 0; i < Mfa_; i++) {
+                    if(!std::isnan(val[i]))
+                    {
+                        //Accept new point
+                        x_[values_[i].second] = zFA[i];
+                        values_[i].first = val[i];
                         //mark best
-                        if (val < bestValue) {
-                            bestValue = val;
-                            bestX = x;
+                        if (val[i] < bestValue) {
+                            bestValue = val[i];
+                            bestX = zFA[i];
                             iterationStat = 0;
                         }
-					}
+                    }
                 }
             }
         } while (true);
@@ -218,6 +230,27 @@ namespace QuantLib {
         return ecType;
     }
 
+    Array FireflyAlgorithm::evaluate(Problem& P,
+                                     const std::vector<Array>& x) const {
+        const CostFunction& costFunction = P.costFunction();
+        Array f(x.size());
+        std::vector<std::string> errors(x.size());
+
+        #pragma omp parallel for schedule(dynamic) if(parallelEvaluation_)
+        for (long i = 0; i < (long)x.size(); i++) {
+            try {
+                f[i] = costFunction.value(x[i]);
+            } catch (std::exception& e) {
+                errors[i] = e.what();
+            }
+        }
+        P.incrementFunctionEvaluation(x.size());
+
+        for (const auto& error : errors)
+            QL_REQUIRE(error.empty(), error);
+        return f;
+    }
+
     void FireflyAlgorithm::Intensity::findBrightest() {
         //Brightest ignores all others
         Array& xI = (*xI_)[(*values_)[0].second];
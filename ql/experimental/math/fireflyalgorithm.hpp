@@ -75,7 +75,16 @@ namespace QuantLib {
     X_{i,j}^{k+1} = X_{i,j}^{k+1}\ \text{otherwise}
     \f]
     where C is the crossover constant, and R is a random uniformly distributed
-    number.
+    number. The DE trial points of an iteration are all built from the
+    population of the previous iteration.
+
+    If parallelEvaluation is true, the trial points of each subpopulation are
+    evaluated concurrently (if OpenMP is enabled). Random numbers are drawn
+    before the evaluation, hence the results do not depend on the number of
+    threads.
+
+    \warning Concurrent evaluation requires the value() method of the cost
+             function to be thread-safe.
     */
     class FireflyAlgorithm : public OptimizationMethod {
       public:
@@ -87,11 +96,15 @@ namespace QuantLib {
                          Size Mde = 0,
                          Real mutationFactor = 1.0,
                          Real crossoverFactor = 0.5,
-                         unsigned long seed = SeedGenerator::instance().get());
+                         unsigned long seed = SeedGenerator::instance().get(),
+                         bool parallelEvaluation = false);
         void startState(Problem &P, const EndCriteria &endCriteria);
         EndCriteria::Type minimize(Problem& P, const EndCriteria& endCriteria) override;
 
       protected:
+        //! cost function values at the given points
+        Array evaluate(Problem& P, const std::vector<Array>& x) const;
+
         std::vector<Array> x_, xI_, xRW_; 
         std::vector<std::pair<Real, Size> > values_;
         Array lX_, uX_;
@@ -102,6 +115,7 @@ namespace QuantLib {
         std::mt19937 generator_;
         std::uniform_int_distribution<QuantLib::Size> distribution_;
         MersenneTwisterUniformRng rng_;
+        bool parallelEvaluation_;
     };
 
     //! Base intensity class
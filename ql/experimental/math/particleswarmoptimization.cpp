@@ -20,6 +20,7 @@ FOR A PARTICULAR PURPOSE.  See the license for more details.
 #include <ql/experimental/math/particleswarmoptimization.hpp>
 #include <ql/math/randomnumbers/sobolrsg.hpp>
 #include <cmath>
+#include <string>
 #include <utility>
 
 using std::sqrt;
@@ -30,8 +31,10 @@ namespace QuantLib {
                                                          ext::shared_ptr<Inertia> inertia,
                                                          Real c1,
                                                          Real c2,
-                                                         unsigned long seed)
-    : M_(M), rng_(seed), topology_(std::move(topology)), inertia_(std::move(inertia)) {
+                                                         unsigned long seed,
+                                                         bool parallelEvaluation)
+    : M_(M), rng_(seed), topology_(std::move(topology)), inertia_(std::move(inertia)),
+      parallelEvaluation_(parallelEvaluation) {
         Real phi = c1 + c2;
         QL_ENSURE(phi*phi - 4 * phi != 0.0, "Invalid phi");
         c0_ = 2.0 / std::abs(2.0 - phi - sqrt(phi*phi - 4 * phi));
@@ -45,9 +48,10 @@ namespace QuantLib {
                                                          Real omega,
                                                          Real c1,
                                                          Real c2,
-                                                         unsigned long seed)
+                                                         unsigned long seed,
+                                                         bool parallelEvaluation)
     : M_(M), c0_(omega), c1_(c1), c2_(c2), rng_(seed), topology_(std::move(topology)),
-      inertia_(std::move(inertia)) {}
+      inertia_(std::move(inertia)), parallelEvaluation_(parallelEvaluation) {}
 
     void ParticleSwarmOptimization::startState(Problem &P, const EndCriteria &endCriteria) {
         QL_REQUIRE(topology_, "Invalid topology");
@@ -82,10 +86,11 @@ namespace QuantLib {
                 //Assign V=(ub-lb)*2*random-(ub-lb) -> between (lb-ub) and (ub-lb)
                 v[j] = bounds[j] * (2.0*sample[2 * j + 1] - 1.0);
             }
-            //Evaluate X and assign as personal best
+            //Assign X as personal best
             pBX_.push_back(X_.back());
-            pBF_[i] = P.value(X_.back());
         }
+        //Evaluate X
+        pBF_ = evaluate(P);
 
         //init topology & inertia
         topology_->init(this);
@@ -130,7 +135,7 @@ namespace QuantLib {
             //Loop over particles
             for (Size i = 0; i < M_; i++) {
                 Array& x = X_[i];
-                Array& pB = pBX_[i];
+                const Array& pB = pBX_[i];
                 const Array& gB = gBX_[i];
                 Array& v = V_[i];
 
@@ -150,15 +155,18 @@ namespace QuantLib {
                         v[j] = 0.0;
                     }
                 }
-                //Evaluate x
-                Real f = P.value(x);
-                if (f < pBF_[i]) {
+            }
+
+            //Evaluate particles
+            const Array f = evaluate(P);
+            for (Size i = 0; i < M_; i++) {
+                if (f[i] < pBF_[i]) {
                     //Update personal best
-                    pBF_[i] = f;
-                    pB = x;
+                    pBF_[i] = f[i];
+                    pBX_[i] = X_[i];
                     //Check stationary condition
-                    if (f < bestValue) {
-                        bestValue = f;
+                    if (f[i] < bestValue) {
+                        bestValue = f[i];
                         bestPosition = i;
                         iterationStat = 0;
                     }
@@ -176,6 +184,26 @@ namespace QuantLib {
         return ecType;
     }
 
+    Array ParticleSwarmOptimization::evaluate(Problem& P) const {
+        const CostFunction& costFunction = P.costFunction();
+        Array f(M_);
+        std::vector<std::string> errors(M_);
+
+        #pragma omp parallel for schedule(dynamic) if(parallelEvaluation_)
+        for (long i = 0; i < (long)M_; i++) {
+            try {
+                f[i] = costFunction.value(X_[i]);
+            } catch (std::exception& e) {
+                errors[i] = e.what();
+            }
+        }
+        P.incrementFunctionEvaluation(M_);
+
+        for (const auto& error : errors)
+            QL_REQUIRE(error.empty(), error);
+        return f;
+    }
+
     void AdaptiveInertia::setValues() {
         Real currBest = (*pBF_)[0];
         for (Size i = 1; i < M_; i++) {
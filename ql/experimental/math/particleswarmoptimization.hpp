@@ -88,6 +88,13 @@ namespace QuantLib {
 
     The optimization stops either because the number of iterations has been reached
     or because the stationary function value limit has been reached.
+
+    If parallelEvaluation is true, the particles of an iteration are evaluated
+    concurrently (if OpenMP is enabled). Random numbers are drawn before the
+    evaluation, hence the results do not depend on the number of threads.
+
+    \warning Concurrent evaluation requires the value() method of the cost
+             function to be thread-safe.
     */
     class ParticleSwarmOptimization : public OptimizationMethod {
       public:
@@ -98,18 +105,23 @@ namespace QuantLib {
                                   ext::shared_ptr<Inertia> inertia,
                                   Real c1 = 2.05,
                                   Real c2 = 2.05,
-                                  unsigned long seed = SeedGenerator::instance().get());
+                                  unsigned long seed = SeedGenerator::instance().get(),
+                                  bool parallelEvaluation = false);
         explicit ParticleSwarmOptimization(Size M,
                                            ext::shared_ptr<Topology> topology,
                                            ext::shared_ptr<Inertia> inertia,
                                            Real omega,
                                            Real c1,
                                            Real c2,
-                                           unsigned long seed = SeedGenerator::instance().get());
+                                           unsigned long seed = SeedGenerator::instance().get(),
+                                           bool parallelEvaluation = false);
         void startState(Problem &P, const EndCriteria &endCriteria);
         EndCriteria::Type minimize(Problem& P, const EndCriteria& endCriteria) override;
 
       protected:
+        //! cost function values at the current positions of the particles
+        Array evaluate(Problem& P) const;
+
         std::vector<Array> X_, V_, pBX_, gBX_;
         Array pBF_, gBF_;
         Array lX_, uX_;
@@ -118,6 +130,7 @@ namespace QuantLib {
         MersenneTwisterUniformRng rng_;
         ext::shared_ptr<Topology> topology_;
         ext::shared_ptr<Inertia> inertia_;
+        bool parallelEvaluation_;
     };
 
     //! Base inertia class used to alter the PSO state
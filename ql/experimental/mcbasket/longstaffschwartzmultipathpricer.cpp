@@ -211,8 +211,19 @@ namespace QuantLib {
                 }
             }
 
-            if (v_.size() <=  x.size()) {
-                coeff_[i] = GeneralLinearLeastSquares(x, y, v_).coefficients();
+            // evaluate the basis functions only once per path taking
+            // part in the regression; the values are reused below
+            const Size m = v_.size();
+            Matrix basisValues(x.size(), m);
+            #pragma omp parallel for
+            for (long k=0; k<(long)x.size(); ++k) {
+                for (Size l=0; l<m; ++l)
+                    basisValues[k][l] = v_[l](x[k]);
+            }
+
+            if (m <= x.size()) {
+                coeff_[i] =
+                    GeneralLinearLeastSquares(basisValues, y).coefficients();
             }
             else {
             // if number of itm paths is smaller then the number of
@@ -239,8 +250,8 @@ namespace QuantLib {
                     sumAlwaysExercise += exercise[j];
                     if (!coeff_[i].empty() && exercise[j] > lowerBounds_[i + 1]) {
                         Real continuationValue = 0.0;
-                        for (Size l = 0; l < v_.size(); ++l) {
-                            continuationValue += coeff_[i][l] * v_[l](x[k]);
+                        for (Size l = 0; l < m; ++l) {
+                            continuationValue += coeff_[i][l] * basisValues[k][l];
                         }
                         
                         if (continuationValue < exercise[j]) {
@@ -37,6 +37,10 @@ namespace QuantLib {
         by Simulation: A Simple Least-Squares Approach, The Review of
         Financial Studies, Volume 14, No. 1, 113-147
 
+        \warning When OpenMP is enabled, the basis functions are
+                 evaluated concurrently on the in-the-money paths;
+                 they must therefore be thread-safe.
+
         \ingroup mcarlo
 
         \test the correctness of the returned value is tested by
@@ -19,10 +19,17 @@
 
 #include <ql/experimental/volatility/noarbsabr.hpp>
 
+#include <ql/math/interpolations/cubicinterpolation.hpp>
 #include <ql/math/solvers1d/brent.hpp>
 #include <ql/math/modifiedbessel.hpp>
 #include <boost/math/special_functions/gamma.hpp>
 #include <boost/functional/hash.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <algorithm>
+#include <fstream>
+#include <numeric>
+#include <utility>
 
 namespace QuantLib {
 
@@ -122,6 +129,50 @@ Real NoArbSabrModel::optionPrice(const Real strike) const {
             numericalIntegralOverP_);
 }
 
+std::vector<Real>
+NoArbSabrModel::optionPrices(const std::vector<Real>& strikes) const {
+    const Size n = strikes.size();
+    std::vector<Real> result(n, 0.0);
+    if (n == 0)
+        return result;
+
+    // the strikes and the upper integration bounds used by optionPrice
+    // split the integration range into segments; p(f) and (f-L) p(f),
+    // L being the lower end of the segment, are integrated once on each
+    std::vector<Real> nodes;
+    nodes.reserve(2 * n);
+    for (Real strike : strikes) {
+        nodes.push_back(strike);
+        nodes.push_back(std::max(fmax_, 2.0 * strike));
+    }
+    std::sort(nodes.begin(), nodes.end());
+    nodes.erase(std::unique(nodes.begin(), nodes.end()), nodes.end());
+
+    std::vector<Real> i0(nodes.size() - 1), i1(nodes.size() - 1);
+    for (Size j = 0; j < nodes.size() - 1; ++j) {
+        i0[j] = (*integrator_)(p_integrand(this), nodes[j], nodes[j + 1]);
+        i1[j] = (*integrator_)(integrand(this, nodes[j]), nodes[j],
+                               nodes[j + 1]);
+    }
+
+    // (f-K) p(f) = (f-L) p(f) + (L-K) p(f) with L >= K, so that all
+    // the contributions are positive
+    for (Size k = 0; k < n; ++k) {
+        const Real strike = strikes[k];
+        if (p(std::max(forward_, strike)) <
+            detail::NoArbSabrModel::density_threshold)
+            continue;
+        const Real upper = std::max(fmax_, 2.0 * strike);
+        Real price = 0.0;
+        for (Size j = std::lower_bound(nodes.begin(), nodes.end(), strike) -
+                      nodes.begin();
+             nodes[j] < upper; ++j)
+            price += i1[j] + (nodes[j] - strike) * i0[j];
+        result[k] = (1.0 - absProb_) * price / numericalIntegralOverP_;
+    }
+    return result;
+}
+
 Real NoArbSabrModel::digitalOptionPrice(const Real strike) const {
     if (strike < QL_MIN_POSITIVE_REAL)
         return 1.0;
@@ -181,6 +232,170 @@ Real NoArbSabrModel::p(const Real f) const {
     return res;
 }
 
+NoArbSabrPriceGrid::NoArbSabrPriceGrid(ext::shared_ptr<NoArbSabrModel> model,
+                                       const Size gridPoints,
+                                       const Real numberOfStdDevs)
+    : model_(std::move(model)) {
+    QL_REQUIRE(model_ != nullptr, "no model given");
+    QL_REQUIRE(gridPoints == 0 || gridPoints >= 2,
+               "at least two grid points (" << gridPoints << ") required");
+    QL_REQUIRE(numberOfStdDevs > 0.0, "number of standard deviations ("
+                                          << numberOfStdDevs
+                                          << ") must be positive");
+    if (gridPoints == 0)
+        return;
+
+    Real stdDev = model_->alpha() *
+                  std::pow(model_->forward(), model_->beta() - 1.0) *
+                  std::sqrt(model_->expiryTime());
+    Real lower = std::log(model_->forward()) - numberOfStdDevs * stdDev;
+    Real step = 2.0 * numberOfStdDevs * stdDev / (gridPoints - 1);
+    strikes_.resize(gridPoints);
+    for (Size i = 0; i < gridPoints; ++i)
+        strikes_[i] = std::exp(lower + i * step);
+    prices_ = model_->optionPrices(strikes_);
+    interpolation_ = CubicNaturalSpline(strikes_.begin(), strikes_.end(),
+                                        prices_.begin());
+}
+
+Real NoArbSabrPriceGrid::optionPrice(const Real strike) const {
+    if (strikes_.empty() || strike < strikes_.front() ||
+        strike > strikes_.back())
+        return model_->optionPrice(strike);
+    return std::max(interpolation_(strike), 0.0);
+}
+
+void NoArbSabrPriceGridCache::setCapacity(const Size capacity) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    capacity_ = capacity;
+    while (entries_.size() > capacity_) {
+        index_.erase(entries_.back().first);
+        entries_.pop_back();
+    }
+}
+
+void NoArbSabrPriceGridCache::setStrikeGrid(const Size gridPoints,
+                                            const Real numberOfStdDevs) {
+    QL_REQUIRE(gridPoints == 0 || gridPoints >= 2,
+               "at least two grid points (" << gridPoints << ") required");
+    QL_REQUIRE(numberOfStdDevs > 0.0, "number of standard deviations ("
+                                          << numberOfStdDevs
+                                          << ") must be positive");
+    std::lock_guard<std::mutex> lock(mutex_);
+    gridPoints_ = gridPoints;
+    numberOfStdDevs_ = numberOfStdDevs;
+    entries_.clear();
+    index_.clear();
+}
+
+void NoArbSabrPriceGridCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.clear();
+    index_.clear();
+}
+
+Size NoArbSabrPriceGridCache::capacity() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return capacity_;
+}
+
+Size NoArbSabrPriceGridCache::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entries_.size();
+}
+
+ext::shared_ptr<NoArbSabrPriceGrid>
+NoArbSabrPriceGridCache::priceGrid(const Real expiryTime, const Real forward,
+                                   const Real alpha, const Real beta,
+                                   const Real nu, const Real rho) {
+    const Key key = {expiryTime, forward, alpha, beta, nu, rho};
+    Size gridPoints;
+    Real numberOfStdDevs;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (capacity_ > 0) {
+            auto i = index_.find(key);
+            if (i != index_.end()) {
+                entries_.splice(entries_.begin(), entries_, i->second);
+                return i->second->second;
+            }
+        }
+        gridPoints = gridPoints_;
+        numberOfStdDevs = numberOfStdDevs_;
+    }
+
+    // the grid is built without holding the lock, so that different
+    // parameter sets can be processed concurrently
+    auto grid = ext::make_shared<NoArbSabrPriceGrid>(
+        ext::make_shared<NoArbSabrModel>(expiryTime, forward, alpha, beta, nu,
+                                         rho),
+        gridPoints, numberOfStdDevs);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (capacity_ == 0 || gridPoints != gridPoints_ ||
+        numberOfStdDevs != numberOfStdDevs_ || index_.count(key) != 0U)
+        return grid;
+    entries_.emplace_front(key, grid);
+    index_[key] = entries_.begin();
+    if (entries_.size() > capacity_) {
+        index_.erase(entries_.back().first);
+        entries_.pop_back();
+    }
+    return grid;
+}
+
+class NoArbSabrAbsorptionTable::Mapping {
+  public:
+    explicit Mapping(const std::string& fileName)
+    : file(fileName.c_str(), boost::interprocess::read_only),
+      region(file, boost::interprocess::read_only) {}
+    boost::interprocess::file_mapping file;
+    boost::interprocess::mapped_region region;
+};
+
+unsigned long NoArbSabrAbsorptionTable::builtIn(const Size i) {
+    return detail::sabrabsprob[i];
+}
+
+void NoArbSabrAbsorptionTable::load(const std::string& fileName) {
+    if (fileName.empty()) {
+        reset();
+        return;
+    }
+    ext::shared_ptr<Mapping> mapping;
+    try {
+        mapping = ext::make_shared<Mapping>(fileName);
+    } catch (std::exception& e) {
+        QL_FAIL("could not map absorption table " << fileName << ": "
+                                                  << e.what());
+    }
+    QL_REQUIRE(mapping->region.get_size() == entries * sizeof(std::uint32_t),
+               "absorption table " << fileName << " has "
+                                   << mapping->region.get_size()
+                                   << " bytes, expected "
+                                   << entries * sizeof(std::uint32_t));
+    mapping_ = mapping;
+    mapped_ =
+        static_cast<const std::uint32_t*>(mapping_->region.get_address());
+}
+
+void NoArbSabrAbsorptionTable::reset() {
+    mapped_ = nullptr;
+    mapping_.reset();
+}
+
+void NoArbSabrAbsorptionTable::save(const std::string& fileName) const {
+    std::vector<std::uint32_t> table(entries);
+    for (Size i = 0; i < entries; ++i)
+        table[i] = static_cast<std::uint32_t>((*this)[i]);
+    std::ofstream out(fileName.c_str(), std::ios::binary);
+    QL_REQUIRE(out.good(), "could not open " << fileName);
+    out.write(reinterpret_cast<const char*>(table.data()),
+              table.size() * sizeof(std::uint32_t));
+    QL_REQUIRE(out.good(), "could not write absorption table to "
+                               << fileName);
+}
+
 namespace detail {
 
 D0Interpolator::D0Interpolator(const Real forward, const Real expiryTime,
@@ -222,6 +437,9 @@ Real D0Interpolator::operator()() const {
     // we do not need to check the indices here, because this is already
     // done in the NoArbSabr constructor
 
+    const NoArbSabrAbsorptionTable& table =
+        NoArbSabrAbsorptionTable::instance();
+
     Size tauInd = std::upper_bound(tauG_.begin(), tauG_.end(), expiryTime_) -
                                    tauG_.begin();
     if (tauInd == tauG_.size())
@@ -301,7 +519,7 @@ Real D0Interpolator::operator()() const {
                                 QL_REQUIRE(ind >= 0 && ind < 1209600,
                                            "absorption matrix index ("
                                                << ind << ") invalid");
-                                phiTmp = phi((Real)sabrabsprob[ind] /
+                                phiTmp = phi((Real)table[ind] /
                                              detail::NoArbSabrModel::nsim);
                             }
                         }
@@ -45,6 +45,12 @@
     model implied forward different from the desired one.
     This situation can be identified by comparing forward()
     and numericalForward().
+
+    The absorption probabilities are taken from a table compiled
+    into the library by default; NoArbSabrAbsorptionTable allows to
+    use a binary file mapped into memory instead. Option prices can
+    be precomputed on a strike grid for each parameter set, see
+    NoArbSabrPriceGrid, and cached in NoArbSabrPriceGridCache.
 */
 
 #ifndef quantlib_noarb_sabr
@@ -53,7 +59,15 @@
 #include <ql/qldefines.hpp>
 #include <ql/types.hpp>
 #include <ql/math/integrals/gausslobattointegral.hpp>
+#include <ql/math/interpolation.hpp>
+#include <ql/patterns/singleton.hpp>
 
+#include <array>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <mutex>
+#include <string>
 #include <vector>
 
 namespace QuantLib {
@@ -103,6 +117,11 @@ class NoArbSabrModel {
     NoArbSabrModel(Real expiryTime, Real forward, Real alpha, Real beta, Real nu, Real rho);
 
     Real optionPrice(Real strike) const;
+    /*! call prices for a set of strikes with the same integration
+        bounds as optionPrice; the density is integrated once between
+        consecutive bounds, which is much faster than calling
+        optionPrice for each of them */
+    std::vector<Real> optionPrices(const std::vector<Real>& strikes) const;
     Real digitalOptionPrice(Real strike) const;
     Real density(const Real strike) const {
         return p(strike) * (1 - absProb_) / numericalIntegralOverP_;
@@ -131,6 +150,113 @@ class NoArbSabrModel {
       class p_integrand;
 };
 
+//! option prices of a NoArbSabrModel precomputed on a strike grid
+/*! The strikes are equidistant in log-strike and span the given
+    number of standard deviations \f$ \sigma_I \sqrt{T} \f$ around
+    the forward, where \f$ \sigma_I = \alpha F^{\beta-1} \f$.
+    Prices between the grid points are interpolated by a natural cubic
+    spline, outside of the grid they are calculated by the model.
+    Without grid points all prices are calculated by the model.
+*/
+class NoArbSabrPriceGrid {
+  public:
+    explicit NoArbSabrPriceGrid(ext::shared_ptr<NoArbSabrModel> model,
+                                Size gridPoints = 101,
+                                Real numberOfStdDevs = 6.0);
+    NoArbSabrPriceGrid(const NoArbSabrPriceGrid&) = delete;
+    NoArbSabrPriceGrid& operator=(const NoArbSabrPriceGrid&) = delete;
+
+    Real optionPrice(Real strike) const;
+    const ext::shared_ptr<NoArbSabrModel>& model() const { return model_; }
+    const std::vector<Real>& strikes() const { return strikes_; }
+    const std::vector<Real>& prices() const { return prices_; }
+
+  private:
+    ext::shared_ptr<NoArbSabrModel> model_;
+    std::vector<Real> strikes_, prices_;
+    Interpolation interpolation_;
+};
+
+//! cache of NoArbSabr price grids keyed by expiry, forward and parameters
+/*! NoArbSabrSmileSection (and hence the NoArbSabr interpolation and
+    swaption cube) gets its prices from this cache. With the default
+    settings, nothing is cached and no grid is used, i.e. each smile
+    section builds its own model and integrates the density for each
+    price. The least recently used grid is dropped when the capacity
+    is exceeded. Access to the cache is synchronized.
+*/
+class NoArbSabrPriceGridCache : public Singleton<NoArbSabrPriceGridCache> {
+    friend class Singleton<NoArbSabrPriceGridCache>;
+
+  private:
+    NoArbSabrPriceGridCache() = default;
+
+  public:
+    //! number of cached grids, zero disables the cache
+    void setCapacity(Size capacity);
+    //! grid used for new entries, zero grid points disables the grid
+    void setStrikeGrid(Size gridPoints, Real numberOfStdDevs = 6.0);
+    void clear();
+
+    Size capacity() const;
+    Size size() const;
+
+    ext::shared_ptr<NoArbSabrPriceGrid> priceGrid(Real expiryTime, Real forward,
+                                                  Real alpha, Real beta,
+                                                  Real nu, Real rho);
+
+  private:
+    typedef std::array<Real, 6> Key;
+    typedef std::list<std::pair<Key, ext::shared_ptr<NoArbSabrPriceGrid> > > Entries;
+    mutable std::mutex mutex_;
+    Size capacity_ = 0, gridPoints_ = 0;
+    Real numberOfStdDevs_ = 6.0;
+    // most recently used entry first
+    Entries entries_;
+    std::map<Key, Entries::iterator> index_;
+};
+
+//! absorption probabilities used by NoArbSabrModel
+/*! The table holds the number of absorptions out of
+    detail::NoArbSabrModel::nsim simulated paths for each point of the
+    parameter grid. By default the table compiled into the library is
+    used; load() maps a binary file of native 32-bit unsigned integers,
+    e.g. as written by save(), into memory and uses it instead.
+
+    \warning Switching the table is not synchronized with models
+             being built in other threads.
+*/
+class NoArbSabrAbsorptionTable : public Singleton<NoArbSabrAbsorptionTable> {
+    friend class Singleton<NoArbSabrAbsorptionTable>;
+
+  private:
+    NoArbSabrAbsorptionTable() = default;
+
+  public:
+    static constexpr Size entries = 1209600;
+
+    //! number of absorptions for the i-th grid point
+    unsigned long operator[](Size i) const {
+        return mapped_ != nullptr ? (unsigned long)mapped_[i] : builtIn(i);
+    }
+    //! whether a file is used instead of the compiled-in table
+    bool mapped() const { return mapped_ != nullptr; }
+
+    //! uses the table stored in the given file
+    /*! An empty file name selects the compiled-in table. */
+    void load(const std::string& fileName);
+    //! uses the table compiled into the library
+    void reset();
+    //! writes the table currently in use to the given file
+    void save(const std::string& fileName) const;
+
+  private:
+    static unsigned long builtIn(Size i);
+    class Mapping;
+    ext::shared_ptr<Mapping> mapping_;
+    const std::uint32_t* mapped_ = nullptr;
+};
+
 namespace detail {
 
 extern "C" const unsigned long sabrabsprob[1209600];
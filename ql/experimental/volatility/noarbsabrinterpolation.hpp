@@ -230,6 +230,12 @@ class NoArbSabrInterpolation : public Interpolation {
         return coeffs().weights_;
     }
     EndCriteria::Type endCriteria() { return coeffs().XABREndCriteria_; }
+    //! number of cost-function evaluations of the last fit
+    Size functionEvaluations() const { return coeffs().XABRFunctionEvaluations_; }
+    //! number of cost-function jacobian evaluations of the last fit
+    Size jacobianEvaluations() const { return coeffs().XABRJacobianEvaluations_; }
+    //! number of starting points tried in the last fit
+    Size guesses() const { return coeffs().XABRGuesses_; }
 
   private:
     const detail::XABRCoeffHolder<detail::NoArbSabrSpecs>& coeffs() const {
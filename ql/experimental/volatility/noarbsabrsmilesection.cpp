@@ -51,14 +51,15 @@ void NoArbSabrSmileSection::init() {
         shift_ == 0.0,
         "shift (" << shift_
                   << ") must be zero, other shifts are not implemented yet");
-    model_ =
-        ext::make_shared<NoArbSabrModel>(exerciseTime(), forward_, params_[0],
-                                           params_[1], params_[2], params_[3]);
+    priceGrid_ = NoArbSabrPriceGridCache::instance().priceGrid(
+        exerciseTime(), forward_, params_[0], params_[1], params_[2],
+        params_[3]);
+    model_ = priceGrid_->model();
 }
 
 Real NoArbSabrSmileSection::optionPrice(Rate strike, Option::Type type,
                                         Real discount) const {
-    Real call = model_->optionPrice(strike);
+    Real call = priceGrid_->optionPrice(strike);
     return discount *
            (type == Option::Call ? call : call - (forward_ - strike));
 }
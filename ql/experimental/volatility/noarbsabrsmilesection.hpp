@@ -64,6 +64,7 @@ class NoArbSabrSmileSection : public SmileSection {
   private:
     void init();
     ext::shared_ptr<NoArbSabrModel> model_;
+    ext::shared_ptr<NoArbSabrPriceGrid> priceGrid_;
     Rate forward_;
     std::vector<Real> params_;
     Real shift_;
@@ -53,6 +53,14 @@ namespace QuantLib {
                                   yIterator yBegin, yIterator yEnd,
                                   vIterator vBegin, vIterator vEnd);
 
+        /*! regression on a precomputed design matrix, i.e.,
+            \f$ A_{ij} = v_j(x_i) \f$; this allows the caller to
+            reuse the basis-function values once the coefficients
+            are known.
+        */
+        template <class yContainer>
+        GeneralLinearLeastSquares(const Matrix& A, const yContainer& y);
+
         const Array& coefficients()   const { return a_; }
         const Array& residuals()      const { return residuals_; }
 
@@ -73,6 +81,9 @@ namespace QuantLib {
             xIterator xBegin, xIterator xEnd,
             yIterator yBegin, yIterator yEnd,
             vIterator vBegin);
+
+        template <class yIterator>
+        void calculate(const Matrix& A, yIterator yBegin, yIterator yEnd);
     };
 
     template <class xContainer, class yContainer, class vContainer> inline
@@ -99,6 +110,17 @@ namespace QuantLib {
     }
 
 
+    template <class yContainer> inline
+    GeneralLinearLeastSquares::GeneralLinearLeastSquares(const Matrix& A,
+                                                         const yContainer& y)
+    : a_(A.columns(), 0.0),
+      err_(A.columns(), 0.0),
+      residuals_(y.size()),
+      standardErrors_(A.columns()) {
+        calculate(A, y.begin(), y.end());
+    }
+
+
     template <class xIterator, class yIterator, class vIterator>
     void GeneralLinearLeastSquares::calculate(xIterator xBegin, xIterator xEnd,
                                               yIterator yBegin, yIterator yEnd,
@@ -111,12 +133,31 @@ namespace QuantLib {
             "sample set need to be of the same size");
         QL_REQUIRE(n >= m, "sample set is too small");
 
-        Size i;
-
         Matrix A(n, m);
-        for (i=0; i<m; ++i)
+        for (Size i=0; i<m; ++i)
             std::transform(xBegin, xEnd, A.column_begin(i), *vBegin++);
 
+        calculate(A, yBegin, yEnd);
+    }
+
+    template <class yIterator>
+    void GeneralLinearLeastSquares::calculate(const Matrix& A,
+                                              yIterator yBegin,
+                                              yIterator yEnd) {
+
+        const Size n = residuals_.size();
+        const Size m = err_.size();
+
+        QL_REQUIRE(A.rows() == n && A.columns() == m,
+                   "design matrix (" << A.rows() << "x" << A.columns()
+                   << ") does not match the sample set (" << n
+                   << ") and the number of basis functions (" << m << ")");
+        QL_REQUIRE( n == Size(std::distance(yBegin, yEnd)),
+            "sample set need to be of the same size");
+        QL_REQUIRE(n >= m, "sample set is too small");
+
+        Size i;
+
         const SVD svd(A);
         const Matrix& V = svd.V();
         const Matrix& U = svd.U();
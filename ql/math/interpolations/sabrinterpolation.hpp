@@ -54,6 +54,16 @@ class SABRWrapper {
         return shiftedSabrVolatility(x, forward_, t_, params_[0], params_[1],
                                      params_[2], params_[3], shift_, volatilityType);
     }
+    std::vector<Real> volatilities(const std::vector<Real>& x,
+                                   const VolatilityType volatilityType,
+                                   Matrix& gradient) {
+        for (Real xi : x)
+            QL_REQUIRE(xi + shift_ > 0.0, "strike+shift must be positive: "
+                                              << xi << "+" << shift_ << " not allowed");
+        return unsafeShiftedSabrVolatilities(x, forward_, t_, params_[0], params_[1],
+                                             params_[2], params_[3], shift_,
+                                             volatilityType, gradient);
+    }
 
   private:
     const Real t_, &forward_;
@@ -128,6 +138,19 @@ struct SABRSpecs {
                    : Real(eps2() * (x[3] > 0.0 ? 1.0 : (-1.0)));
         return y;
     }
+    Array directDerivative(const Array &x, const std::vector<bool> &,
+                           const std::vector<Real> &, const Real) {
+        Array dy(4);
+        dy[0] = std::fabs(x[0]) < 5.0 ? Real(2.0 * x[0])
+                                      : Real(x[0] > 0.0 ? 10.0 : -10.0);
+        dy[1] = std::fabs(x[1]) < std::sqrt(-std::log(eps1()))
+                    ? Real(-2.0 * x[1] * std::exp(-(x[1] * x[1])))
+                    : 0.0;
+        dy[2] = std::fabs(x[2]) < 5.0 ? Real(2.0 * x[2])
+                                      : Real(x[2] > 0.0 ? 10.0 : -10.0);
+        dy[3] = std::fabs(x[3]) < 2.5 * M_PI ? Real(eps2() * std::cos(x[3])) : 0.0;
+        return dy;
+    }
     Real weight(const Real strike, const Real forward, const Real stdDev,
                 const std::vector<Real> &addParams) {
         return blackFormulaStdDevDerivative(strike, forward, stdDev, 1.0,
@@ -186,6 +209,12 @@ class SABRInterpolation : public Interpolation {
         return coeffs().weights_;
     }
     EndCriteria::Type endCriteria() { return coeffs().XABREndCriteria_; }
+    //! number of cost-function evaluations of the last fit
+    Size functionEvaluations() const { return coeffs().XABRFunctionEvaluations_; }
+    //! number of cost-function jacobian evaluations of the last fit
+    Size jacobianEvaluations() const { return coeffs().XABRJacobianEvaluations_; }
+    //! number of starting points tried in the last fit
+    Size guesses() const { return coeffs().XABRGuesses_; }
 
   private:
     const detail::XABRCoeffHolder<detail::SABRSpecs>& coeffs() const {
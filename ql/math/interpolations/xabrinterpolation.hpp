@@ -43,6 +43,7 @@
 #include <ql/termstructures/volatility/volatilitytype.hpp>
 #include <ql/utilities/dataformatters.hpp>
 #include <ql/utilities/null.hpp>
+#include <type_traits>
 #include <utility>
 
 namespace QuantLib::detail {
@@ -90,12 +91,35 @@ template <typename Model> class XABRCoeffHolder {
     /*! Interpolation results */
     Real error_, maxError_;
     EndCriteria::Type XABREndCriteria_ = EndCriteria::None;
+    /*! Calibration statistics, summed over all starting points */
+    Size XABRFunctionEvaluations_ = 0, XABRJacobianEvaluations_ = 0, XABRGuesses_ = 0;
     /*! Model instance (if required) */
     ext::shared_ptr<typename Model::type> modelInstance_;
     /*! additional parameters */
     std::vector<Real> addParams_;
 };
 
+/*! Models providing the derivative of their parameter transformation
+    (directDerivative, acting on each parameter separately) and the
+    gradient of the volatility with respect to the parameters (a
+    volatilities method of the model instance) give an analytic
+    jacobian to the optimizers using the one of the cost function,
+    e.g. LevenbergMarquardt with useCostFunctionsJacobian = true.
+
+    The default optimizer does not use it. When the smile is best
+    fitted in the limit beta -> 1 with alpha and nu growing without
+    bound, the error keeps decreasing slowly along that direction.
+    The less accurate finite-difference jacobian makes the optimizer
+    stop early there, while the exact one follows the direction up
+    to the iteration limit, which is much slower overall.
+*/
+template <typename Model, typename = void>
+struct XABRAnalyticGradient : std::false_type {};
+
+template <typename Model>
+struct XABRAnalyticGradient<Model, std::void_t<decltype(&Model::directDerivative)> >
+    : std::true_type {};
+
 template <class I1, class I2, typename Model>
 class XABRInterpolationImpl final : public Interpolation::templateImpl<I1, I2>,
                                     public XABRCoeffHolder<Model> {
@@ -166,6 +190,8 @@ class XABRInterpolationImpl final : public Interpolation::templateImpl<I1, I2>,
             this->error_ = interpolationError();
             this->maxError_ = interpolationMaxError();
             this->XABREndCriteria_ = EndCriteria::None;
+            this->XABRFunctionEvaluations_ = this->XABRJacobianEvaluations_ =
+                this->XABRGuesses_ = 0;
             return;
         } else {
             XABRError costFunction(this);
@@ -184,6 +210,7 @@ class XABRInterpolationImpl final : public Interpolation::templateImpl<I1, I2>,
             HaltonRsg halton(freeParameters, 42);
             EndCriteria::Type tmpEndCriteria;
             Real tmpInterpolationError;
+            this->XABRFunctionEvaluations_ = this->XABRJacobianEvaluations_ = 0;
 
             do {
 
@@ -210,6 +237,7 @@ class XABRInterpolationImpl final : public Interpolation::templateImpl<I1, I2>,
                 Problem problem(constrainedXABRError, constraint,
                                 projectedGuess);
                 tmpEndCriteria = optMethod_->minimize(problem, *endCriteria_);
+                this->XABRFunctionEvaluations_ += problem.functionEvaluation();
                 Array projectedResult(problem.currentValue());
                 Array transfResult(
                     constrainedXABRError.include(projectedResult));
@@ -227,6 +255,7 @@ class XABRInterpolationImpl final : public Interpolation::templateImpl<I1, I2>,
 
             } while (++iterations < maxGuesses_ &&
                      tmpInterpolationError > errorAccept_);
+            this->XABRGuesses_ = iterations;
 
             for (Size i = 0; i < bestParameters.size(); ++i)
                 this->params_[i] = bestParameters[i];
@@ -268,6 +297,24 @@ class XABRInterpolationImpl final : public Interpolation::templateImpl<I1, I2>,
         return results;
     }
 
+    // calculate weighted differences and their derivatives with
+    // respect to the model parameters
+    Array interpolationErrors(Matrix& jacobian) const {
+        const std::vector<Real> strikes(this->xBegin_, this->xEnd_);
+        const std::vector<Real> volatilities =
+            this->modelInstance_->volatilities(strikes, volatilityType_, jacobian);
+        Array results(strikes.size());
+        I2 y = this->yBegin_;
+        for (Size i = 0; i < strikes.size(); ++i, ++y) {
+            const Real sqrtWeight = std::sqrt(this->weights_[i]);
+            results[i] = (volatilities[i] - *y) * sqrtWeight;
+            std::transform(jacobian.row_begin(i), jacobian.row_end(i),
+                           jacobian.row_begin(i),
+                           [=](Real g) { return g * sqrtWeight; });
+        }
+        return results;
+    }
+
     Real interpolationError() const {
         Size n = this->xEnd_ - this->xBegin_;
         Real squaredError = interpolationSquaredError();
@@ -308,6 +355,27 @@ class XABRInterpolationImpl final : public Interpolation::templateImpl<I1, I2>,
             return xabr_->interpolationErrors();
         }
 
+        void jacobian(Matrix& jac, const Array& x) const override {
+            ++xabr_->XABRJacobianEvaluations_;
+            if constexpr (XABRAnalyticGradient<Model>::value) {
+                const Array y = Model().direct(x, xabr_->paramIsFixed_,
+                                               xabr_->params_, xabr_->forward_);
+                for (Size i = 0; i < xabr_->params_.size(); ++i)
+                    xabr_->params_[i] = y[i];
+                xabr_->updateModelInstance();
+                const Array dy = Model().directDerivative(
+                    x, xabr_->paramIsFixed_, xabr_->params_, xabr_->forward_);
+
+                Matrix gradient;
+                xabr_->interpolationErrors(gradient);
+                for (Size i = 0; i < jac.rows(); ++i)
+                    for (Size j = 0; j < jac.columns(); ++j)
+                        jac[i][j] = gradient[i][j] * dy[j];
+            } else {
+                CostFunction::jacobian(jac, x);
+            }
+        }
+
       private:
         XABRInterpolationImpl *xabr_;
     };
@@ -0,0 +1,261 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <https://www.quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+
+#include <ql/math/matrixutilities/compressedsparsematrix.hpp>
+#include <ql/utilities/null.hpp>
+#include <algorithm>
+#include <utility>
+
+namespace QuantLib {
+
+    CompressedSparseMatrix::CompressedSparseMatrix(
+        Size rows, Size columns, const std::vector<Triplet>& triplets)
+    : columns_(columns), rowStart_(rows+1, 0) {
+
+        for (const auto& t : triplets) {
+            QL_REQUIRE(t.row < rows && t.column < columns,
+                       "element (" << t.row << ", " << t.column
+                       << ") outside of a " << rows << "x" << columns
+                       << " matrix");
+            ++rowStart_[t.row+1];
+        }
+        for (Size i=0; i < rows; ++i)
+            rowStart_[i+1] += rowStart_[i];
+
+        // bucket sort by rows, then sort and merge each row
+        std::vector<std::pair<Size, Real> > elements(triplets.size());
+        std::vector<Size> next(rowStart_.begin(), rowStart_.end()-1);
+        for (const auto& t : triplets)
+            elements[next[t.row]++] = std::make_pair(t.column, t.value);
+
+        columnIndices_.reserve(elements.size());
+        values_.reserve(elements.size());
+        Size begin = 0;
+        for (Size i=0; i < rows; ++i) {
+            const Size end = rowStart_[i+1];
+            std::sort(elements.begin()+begin, elements.begin()+end,
+                      [](const std::pair<Size, Real>& a,
+                         const std::pair<Size, Real>& b) {
+                          return a.first < b.first;
+                      });
+            for (Size k=begin; k < end;) {
+                const Size j = elements[k].first;
+                Real value = 0.0;
+                for (; k < end && elements[k].first == j; ++k)
+                    value += elements[k].second;
+                if (value != 0.0) {
+                    columnIndices_.push_back(j);
+                    values_.push_back(value);
+                }
+            }
+            begin = end;
+            rowStart_[i+1] = values_.size();
+        }
+    }
+
+    CompressedSparseMatrix::CompressedSparseMatrix(const SparseMatrix& m)
+    : columns_(m.size2()), rowStart_(m.size1()+1, 0) {
+        for (auto row = m.begin1(); row != m.end1(); ++row) {
+            for (auto iter = row.begin(); iter != row.end(); ++iter) {
+                if (*iter != 0.0) {
+                    columnIndices_.push_back(iter.index2());
+                    values_.push_back(*iter);
+                    ++rowStart_[iter.index1()+1];
+                }
+            }
+        }
+        for (Size i=0; i < m.size1(); ++i)
+            rowStart_[i+1] += rowStart_[i];
+    }
+
+    Real CompressedSparseMatrix::operator()(Size i, Size j) const {
+        QL_REQUIRE(i < rows() && j < columns_,
+                   "element (" << i << ", " << j << ") outside of a "
+                   << rows() << "x" << columns_ << " matrix");
+        const auto begin = columnIndices_.begin() + rowStart_[i];
+        const auto end = columnIndices_.begin() + rowStart_[i+1];
+        const auto iter = std::lower_bound(begin, end, j);
+        return (iter != end && *iter == j) ?
+            values_[iter - columnIndices_.begin()] : 0.0;
+    }
+
+    CompressedSparseMatrix& CompressedSparseMatrix::operator*=(Real x) {
+        for (Real& v : values_)
+            v *= x;
+        return *this;
+    }
+
+    SparseMatrix CompressedSparseMatrix::toSparseMatrix() const {
+        SparseMatrix m(rows(), columns_, nonZeros());
+        for (Size i=0; i < rows(); ++i)
+            for (Size k=rowStart_[i]; k < rowStart_[i+1]; ++k)
+                m.push_back(i, columnIndices_[k], values_[k]);
+        return m;
+    }
+
+
+    Array prod(const CompressedSparseMatrix& m, const Array& x) {
+        Array y(m.rows());
+        prod(m, x, y);
+        return y;
+    }
+
+    void prod(const CompressedSparseMatrix& m, const Array& x, Array& y) {
+        QL_REQUIRE(x.size() == m.columns(),
+                   "vectors and sparse matrices with different sizes ("
+                   << x.size() << ", " << m.rows() << "x" << m.columns()
+                   << ") cannot be multiplied");
+        QL_REQUIRE(y.size() == m.rows(),
+                   "result of size " << y.size() << " given for a "
+                   << m.rows() << "x" << m.columns() << " matrix");
+        QL_REQUIRE(&x != &y, "result must not alias the vector");
+
+        // direct access to make the following code faster.
+        const Size* rowStart = m.rowStart().data();
+        const Size* columns = m.columnIndices().data();
+        const Real* values = m.values().data();
+        const Real* u = x.begin();
+        Real* result = y.begin();
+
+        #pragma omp parallel for
+        for (long i=0; i < (long)m.rows(); ++i) {
+            Real t = 0.0;
+            for (Size k=rowStart[i]; k < rowStart[i+1]; ++k)
+                t += values[k]*u[columns[k]];
+            result[i] = t;
+        }
+    }
+
+    CompressedSparseMatrix prod(const CompressedSparseMatrix& m1,
+                                const CompressedSparseMatrix& m2) {
+        QL_REQUIRE(m1.columns() == m2.rows(),
+                   "sparse matrices with different sizes ("
+                   << m1.rows() << "x" << m1.columns() << ", "
+                   << m2.rows() << "x" << m2.columns()
+                   << ") cannot be multiplied");
+
+        CompressedSparseMatrix c;
+        c.columns_ = m2.columns();
+        c.rowStart_.reserve(m1.rows()+1);
+
+        // dense accumulator for the elements of a row of the product
+        std::vector<Real> w(m2.columns(), 0.0);
+        std::vector<Size> marker(m2.columns(), Null<Size>()), nonZeros;
+        for (Size i=0; i < m1.rows(); ++i) {
+            nonZeros.clear();
+            for (Size k=m1.rowStart_[i]; k < m1.rowStart_[i+1]; ++k) {
+                const Size j = m1.columnIndices_[k];
+                for (Size l=m2.rowStart_[j]; l < m2.rowStart_[j+1]; ++l) {
+                    const Size col = m2.columnIndices_[l];
+                    if (marker[col] != i) {
+                        marker[col] = i;
+                        w[col] = 0.0;
+                        nonZeros.push_back(col);
+                    }
+                    w[col] += m1.values_[k]*m2.values_[l];
+                }
+            }
+            std::sort(nonZeros.begin(), nonZeros.end());
+            for (Size col : nonZeros) {
+                if (w[col] != 0.0) {
+                    c.columnIndices_.push_back(col);
+                    c.values_.push_back(w[col]);
+                }
+            }
+            c.rowStart_.push_back(c.values_.size());
+        }
+        return c;
+    }
+
+    CompressedSparseMatrix transpose(const CompressedSparseMatrix& m) {
+        CompressedSparseMatrix t;
+        t.columns_ = m.rows();
+        t.rowStart_.assign(m.columns()+1, 0);
+        for (Size col : m.columnIndices_)
+            ++t.rowStart_[col+1];
+        for (Size i=0; i < m.columns(); ++i)
+            t.rowStart_[i+1] += t.rowStart_[i];
+
+        t.columnIndices_.resize(m.nonZeros());
+        t.values_.resize(m.nonZeros());
+        std::vector<Size> next(t.rowStart_.begin(), t.rowStart_.end()-1);
+        for (Size i=0; i < m.rows(); ++i) {
+            for (Size k=m.rowStart_[i]; k < m.rowStart_[i+1]; ++k) {
+                const Size pos = next[m.columnIndices_[k]]++;
+                t.columnIndices_[pos] = i;
+                t.values_[pos] = m.values_[k];
+            }
+        }
+        return t;
+    }
+
+    CompressedSparseMatrix operator+(const CompressedSparseMatrix& m1,
+                                     const CompressedSparseMatrix& m2) {
+        QL_REQUIRE(m1.rows() == m2.rows() && m1.columns() == m2.columns(),
+                   "sparse matrices with different sizes ("
+                   << m1.rows() << "x" << m1.columns() << ", "
+                   << m2.rows() << "x" << m2.columns()
+                   << ") cannot be added");
+
+        CompressedSparseMatrix c;
+        c.columns_ = m1.columns();
+        c.rowStart_.reserve(m1.rows()+1);
+        c.columnIndices_.reserve(m1.nonZeros() + m2.nonZeros());
+        c.values_.reserve(m1.nonZeros() + m2.nonZeros());
+
+        const auto add = [&c](Size j, Real value) {
+            if (value != 0.0) {
+                c.columnIndices_.push_back(j);
+                c.values_.push_back(value);
+            }
+        };
+
+        for (Size i=0; i < m1.rows(); ++i) {
+            Size k1 = m1.rowStart_[i], k2 = m2.rowStart_[i];
+            const Size end1 = m1.rowStart_[i+1], end2 = m2.rowStart_[i+1];
+            while (k1 < end1 || k2 < end2) {
+                const Size j1 = (k1 < end1) ? m1.columnIndices_[k1]
+                                            : Null<Size>();
+                const Size j2 = (k2 < end2) ? m2.columnIndices_[k2]
+                                            : Null<Size>();
+                if (j1 == j2)
+                    add(j1, m1.values_[k1++] + m2.values_[k2++]);
+                else if (j1 < j2)
+                    add(j1, m1.values_[k1++]);
+                else
+                    add(j2, m2.values_[k2++]);
+            }
+            c.rowStart_.push_back(c.values_.size());
+        }
+        return c;
+    }
+
+    CompressedSparseMatrix operator*(Real x, const CompressedSparseMatrix& m) {
+        CompressedSparseMatrix c(m);
+        return c *= x;
+    }
+
+    CompressedSparseMatrix identitySparseMatrix(Size n) {
+        std::vector<CompressedSparseMatrix::Triplet> diagonal(n);
+        for (Size i=0; i < n; ++i)
+            diagonal[i] = {i, i, 1.0};
+        return CompressedSparseMatrix(n, n, diagonal);
+    }
+
+}
@@ -0,0 +1,121 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <https://www.quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+
+/*! \file compressedsparsematrix.hpp
+    \brief sparse matrix in compressed-row storage
+*/
+
+#ifndef quantlib_compressed_sparse_matrix_hpp
+#define quantlib_compressed_sparse_matrix_hpp
+
+#include <ql/math/matrixutilities/sparsematrix.hpp>
+#include <vector>
+
+namespace QuantLib {
+
+    //! sparse matrix in compressed-row (CSR) storage
+    /*! The non-zero elements of each row are stored contiguously and
+        ordered by column. Unlike SparseMatrix, the matrix is not
+        modified element by element; it is assembled in one pass from
+        a list of (row, column, value) triplets, which is linear in
+        the number of elements, and the matrix-vector product is a
+        plain loop over contiguous arrays which the compiler can
+        vectorize and which is run in parallel if OpenMP is enabled.
+
+        Conversions from and to SparseMatrix are provided for
+        compatibility with existing code.
+    */
+    class CompressedSparseMatrix {
+      public:
+        struct Triplet {
+            Size row, column;
+            Real value;
+        };
+
+        CompressedSparseMatrix() = default;
+        /*! duplicate elements are summed; elements whose sum is zero
+            are not stored.
+        */
+        CompressedSparseMatrix(Size rows,
+                               Size columns,
+                               const std::vector<Triplet>& triplets);
+        explicit CompressedSparseMatrix(const SparseMatrix& m);
+
+        //! \name Inspectors
+        //@{
+        Size rows() const { return rowStart_.size()-1; }
+        Size columns() const { return columns_; }
+        Size nonZeros() const { return values_.size(); }
+        //! element; zero if not stored
+        Real operator()(Size i, Size j) const;
+
+        //! position of the first element of each row, and end marker
+        const std::vector<Size>& rowStart() const { return rowStart_; }
+        const std::vector<Size>& columnIndices() const {
+            return columnIndices_;
+        }
+        const std::vector<Real>& values() const { return values_; }
+        //@}
+
+        CompressedSparseMatrix& operator*=(Real x);
+
+        SparseMatrix toSparseMatrix() const;
+
+      private:
+        friend CompressedSparseMatrix transpose(const CompressedSparseMatrix&);
+        friend CompressedSparseMatrix prod(const CompressedSparseMatrix&,
+                                           const CompressedSparseMatrix&);
+        friend CompressedSparseMatrix operator+(const CompressedSparseMatrix&,
+                                                const CompressedSparseMatrix&);
+
+        Size columns_ = 0;
+        std::vector<Size> rowStart_ = std::vector<Size>(1, 0);
+        std::vector<Size> columnIndices_;
+        std::vector<Real> values_;
+    };
+
+    /*! \relates CompressedSparseMatrix */
+    Array prod(const CompressedSparseMatrix& m, const Array& x);
+
+    /*! \relates CompressedSparseMatrix
+        writes the product into y, which must have the size of the
+        rows and must not be x itself.
+    */
+    void prod(const CompressedSparseMatrix& m, const Array& x, Array& y);
+
+    /*! \relates CompressedSparseMatrix */
+    CompressedSparseMatrix prod(const CompressedSparseMatrix& m1,
+                                const CompressedSparseMatrix& m2);
+
+    /*! \relates CompressedSparseMatrix */
+    CompressedSparseMatrix transpose(const CompressedSparseMatrix& m);
+
+    /*! \relates CompressedSparseMatrix */
+    CompressedSparseMatrix operator+(const CompressedSparseMatrix& m1,
+                                     const CompressedSparseMatrix& m2);
+
+    /*! \relates CompressedSparseMatrix */
+    CompressedSparseMatrix operator*(Real x, const CompressedSparseMatrix& m);
+
+    /*! \relates CompressedSparseMatrix */
+    CompressedSparseMatrix identitySparseMatrix(Size n);
+
+}
+
+#endif
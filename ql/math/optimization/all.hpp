@@ -23,4 +23,5 @@
 #include <ql/math/optimization/simulatedannealing.hpp>
 #include <ql/math/optimization/spherecylinder.hpp>
 #include <ql/math/optimization/steepestdescent.hpp>
+#include <ql/math/optimization/trustregionlevenbergmarquardt.hpp>
 
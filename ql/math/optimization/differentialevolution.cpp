@@ -21,6 +21,7 @@
 #include <ql/math/optimization/differentialevolution.hpp>
 #include <algorithm>
 #include <cmath>
+#include <string>
 
 namespace QuantLib {
 
@@ -74,8 +75,8 @@ namespace QuantLib {
                 population[i].values = configuration().initialPopulation[i];
                 QL_REQUIRE(population[i].values.size() == p.currentValue().size(),
                            "wrong values size in initial population");
-                population[i].cost = p.costFunction().value(population[i].values);
             }
+            evaluate(population, p, false);
         } else {
             population = std::vector<Candidate>(configuration().populationMembers,
                                                 Candidate(p.currentValue().size()));
@@ -293,16 +294,36 @@ namespace QuantLib {
                                - lowerBound_[memIter]);
                 }
             }
-            // evaluate objective function as soon as possible to avoid unnecessary loops
+        }
+        evaluate(population, p);
+    }
+
+    void DifferentialEvolution::evaluate(std::vector<Candidate>& population,
+                                         Problem& p,
+                                         bool penalizeErrors) const {
+        const CostFunction& costFunction = p.costFunction();
+        std::vector<std::string> errors(population.size());
+
+        #pragma omp parallel for schedule(dynamic) if(configuration().parallelEvaluation)
+        for (long i=0; i < (long)population.size(); ++i) {
+            Real& cost = population[i].cost;
             try {
-                population[popIter].cost = p.value(population[popIter].values);
-            } catch (Error&) {
-                population[popIter].cost = QL_MAX_REAL;
+                cost = costFunction.value(population[i].values);
+            } catch (Error& e) {
+                if (penalizeErrors)
+                    cost = QL_MAX_REAL;
+                else
+                    errors[i] = e.what();
+            } catch (std::exception& e) {
+                errors[i] = e.what();
             }
-            if (!std::isfinite(population[popIter].cost))
-                population[popIter].cost = QL_MAX_REAL;
-
+            if (!std::isfinite(cost))
+                cost = QL_MAX_REAL;
         }
+        p.incrementFunctionEvaluation(population.size());
+
+        for (const auto& error : errors)
+            QL_REQUIRE(error.empty(), error);
     }
 
     void DifferentialEvolution::getCrossoverMask(
@@ -377,21 +398,18 @@ namespace QuantLib {
 
     void DifferentialEvolution::fillInitialPopulation(
                                           std::vector<Candidate> & population,
-                                          const Problem& p) const {
+                                          Problem& p) const {
 
         // use initial values provided by the user
         population.front().values = p.currentValue();
-        population.front().cost = p.costFunction().value(population.front().values);
         // rest of the initial population is random
         for (Size j = 1; j < population.size(); ++j) {
             for (Size i = 0; i < p.currentValue().size(); ++i) {
                 Real l = lowerBound_[i], u = upperBound_[i];
                 population[j].values[i] = l + (u-l)*rng_.nextReal();
             }
-            population[j].cost = p.costFunction().value(population[j].values);
-            if (!std::isfinite(population[j].cost))
-                population[j].cost = QL_MAX_REAL;
         }
+        evaluate(population, p, false);
     }
 
 }
@@ -50,7 +50,17 @@ namespace QuantLib {
         3) various weights distributions for the differences (dither etc.)
         4) printFullInfo parameter usage to track the algorithm
 
+        The members of a generation can be evaluated concurrently
+        (if OpenMP is enabled); random numbers are drawn before the
+        evaluation, so that the results do not depend on the number
+        of threads.
+
         \warning This was reported to fail tests on Mac OS X 10.8.4.
+
+        \warning Concurrent evaluation requires the value() method of
+                 the cost function to be thread-safe. This is usually
+                 not the case for cost functions updating shared
+                 objects, e.g. the parameters of a calibrated model.
     */
 
 
@@ -87,6 +97,7 @@ namespace QuantLib {
             Real stepsizeWeight = 0.2, crossoverProbability = 0.9;
             unsigned long seed = 0;
             bool applyBounds = true, crossoverIsAdaptive = false;
+            bool parallelEvaluation = false;
             std::vector<Array> initialPopulation;
             Array upperBound, lowerBound;
 
@@ -157,6 +168,11 @@ namespace QuantLib {
                 strategy = s;
                 return *this;
             }
+
+            Configuration& withParallelEvaluation(bool b = true) {
+                parallelEvaluation = b;
+                return *this;
+            }
         };
 
 
@@ -177,7 +193,16 @@ namespace QuantLib {
         MersenneTwisterUniformRng rng_;
 
         void fillInitialPopulation(std::vector<Candidate>& population,
-                                   const Problem& p) const;
+                                   Problem& p) const;
+
+        //! evaluate the cost of each candidate
+        /*! If \p penalizeErrors is true, a QuantLib::Error raised
+            by the cost function makes the candidate's cost
+            QL_MAX_REAL; otherwise, it is propagated to the caller.
+        */
+        void evaluate(std::vector<Candidate>& population,
+                      Problem& p,
+                      bool penalizeErrors = true) const;
 
         void getCrossoverMask(std::vector<Array>& crossoverMask,
                               std::vector<Array>& invCrossoverMask,
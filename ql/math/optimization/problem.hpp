@@ -67,6 +67,11 @@ namespace QuantLib {
         Real valueAndGradient(Array& grad_f,
                               const Array& x);
 
+        //! call cost function jacobian computation and increment
+        //  gradient evaluation counter
+        void jacobian(Matrix& jac,
+                      const Array& x);
+
         //! Constraint
         Constraint& constraint() const { return constraint_; }
 
@@ -96,6 +101,12 @@ namespace QuantLib {
         //! number of evaluation of cost function
         Integer functionEvaluation() const { return functionEvaluation_; }
 
+        //! increment the evaluation counter for cost function values
+        //  computed directly, e.g. concurrently
+        void incrementFunctionEvaluation(Integer n) {
+            functionEvaluation_ += n;
+        }
+
         //! number of evaluation of cost function gradient
         Integer gradientEvaluation() const { return gradientEvaluation_; }
 
@@ -136,6 +147,12 @@ namespace QuantLib {
         return costFunction_.valueAndGradient(grad_f, x);
     }
 
+    inline void Problem::jacobian(Matrix& jac,
+                                  const Array& x) {
+        ++gradientEvaluation_;
+        costFunction_.jacobian(jac, x);
+    }
+
     inline void Problem::reset() {
         functionEvaluation_ = gradientEvaluation_ = 0;
         functionValue_ = squaredNorm_ = Null<Real>();
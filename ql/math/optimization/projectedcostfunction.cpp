@@ -44,4 +44,15 @@ namespace QuantLib {
         return costFunction_.values(actualParameters_);
     }
 
+    void ProjectedCostFunction::jacobian(Matrix& jac,
+                                         const Array& freeParameters) const {
+        mapFreeParameters(freeParameters);
+        Matrix fullJacobian(jac.rows(), actualParameters_.size());
+        costFunction_.jacobian(fullJacobian, actualParameters_);
+        for (Size i=0; i<jac.rows(); ++i)
+            for (Size j=0, k=0; j<actualParameters_.size(); ++j)
+                if (!fixParameters_[j])
+                    jac[i][k++] = fullJacobian[i][j];
+    }
+
 }
@@ -0,0 +1,344 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <https://www.quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+
+#include <ql/math/optimization/constraint.hpp>
+#include <ql/math/optimization/trustregionlevenbergmarquardt.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace QuantLib {
+
+    namespace {
+
+        /* Householder QR factorization of the first nf columns of a;
+           the reflection vectors are stored in the lower part of a,
+           the strictly upper part of R above the diagonal. */
+        void householderQR(Matrix& a, Size nf, Array& beta, Array& rDiag) {
+            const Size m = a.rows();
+            for (Size k=0; k < nf; ++k) {
+                Real norm = 0.0;
+                for (Size i=k; i < m; ++i)
+                    norm += a[i][k]*a[i][k];
+                norm = std::sqrt(norm);
+                if (norm == 0.0) {
+                    beta[k] = rDiag[k] = 0.0;
+                    continue;
+                }
+                const Real alpha = (a[k][k] > 0.0) ? Real(-norm) : norm;
+                a[k][k] -= alpha;
+                beta[k] = 1.0/(-alpha*a[k][k]);
+                rDiag[k] = alpha;
+
+                for (Size j=k+1; j < nf; ++j) {
+                    Real s = 0.0;
+                    for (Size i=k; i < m; ++i)
+                        s += a[i][k]*a[i][j];
+                    s *= beta[k];
+                    for (Size i=k; i < m; ++i)
+                        a[i][j] -= s*a[i][k];
+                }
+            }
+        }
+
+        void applyQt(const Matrix& a, Size nf, const Array& beta, Array& b) {
+            for (Size k=0; k < nf; ++k) {
+                if (beta[k] == 0.0)
+                    continue;
+                Real s = 0.0;
+                for (Size i=k; i < a.rows(); ++i)
+                    s += a[i][k]*b[i];
+                s *= beta[k];
+                for (Size i=k; i < a.rows(); ++i)
+                    b[i] -= s*a[i][k];
+            }
+        }
+
+        /* Triangularizes [R; sqrt(lambda) D] by Givens rotations,
+           applied to the right-hand side [Q^T r; 0] as well, and
+           returns the step solving the damped least-squares problem
+           (see qrsolv in MINPACK). */
+        void dampedStep(const Matrix& qr, const Array& rDiag,
+                        const Array& qtr, const Array& d, Size nf,
+                        Real lambda, Matrix& s, Array& z, Array& w,
+                        Array& step) {
+            for (Size j=0; j < nf; ++j) {
+                s[j][j] = rDiag[j];
+                for (Size k=j+1; k < nf; ++k)
+                    s[j][k] = qr[j][k];
+                z[j] = qtr[j];
+            }
+
+            const Real sqrtLambda = std::sqrt(lambda);
+            for (Size j=0; j < nf; ++j) {
+                std::fill(w.begin(), w.begin()+nf, 0.0);
+                w[j] = sqrtLambda*d[j];
+                Real wz = 0.0;
+                for (Size k=j; k < nf; ++k) {
+                    if (w[k] == 0.0)
+                        continue;
+                    const Real h = std::hypot(s[k][k], w[k]);
+                    const Real c = s[k][k]/h, sn = w[k]/h;
+                    for (Size l=k; l < nf; ++l) {
+                        const Real skl = s[k][l];
+                        s[k][l] = c*skl + sn*w[l];
+                        w[l] = -sn*skl + c*w[l];
+                    }
+                    const Real zk = z[k];
+                    z[k] = c*zk + sn*wz;
+                    wz = -sn*zk + c*wz;
+                }
+            }
+
+            for (Size j=nf; j-- > 0;) {
+                Real sum = z[j];
+                for (Size k=j+1; k < nf; ++k)
+                    sum += s[j][k]*step[k];
+                step[j] = -sum/s[j][j];
+            }
+        }
+
+        // solves (S^T S) x = -b for the triangular factor of dampedStep
+        void normalSolve(const Matrix& s, Size nf, const Array& b, Array& x) {
+            for (Size j=0; j < nf; ++j) {
+                Real sum = b[j];
+                for (Size k=0; k < j; ++k)
+                    sum -= s[k][j]*x[k];
+                x[j] = sum/s[j][j];
+            }
+            for (Size j=nf; j-- > 0;) {
+                Real sum = x[j];
+                for (Size k=j+1; k < nf; ++k)
+                    sum -= s[j][k]*x[k];
+                x[j] = sum/s[j][j];
+            }
+            for (Size j=0; j < nf; ++j)
+                x[j] = -x[j];
+        }
+
+        Real scaledNorm(const Array& d, const Array& x) {
+            Real sum = 0.0;
+            for (Size j=0; j < x.size(); ++j)
+                sum += d[j]*d[j]*x[j]*x[j];
+            return std::sqrt(sum);
+        }
+
+    }
+
+    TrustRegionLevenbergMarquardt::TrustRegionLevenbergMarquardt(
+        Real xtol, Real gtol, bool geodesicAcceleration,
+        Real accelerationRatio, Real initialDamping)
+    : xtol_(xtol), gtol_(gtol), geodesicAcceleration_(geodesicAcceleration),
+      accelerationRatio_(accelerationRatio), initialDamping_(initialDamping) {
+        QL_REQUIRE(xtol_ >= 0.0, "negative x tolerance");
+        QL_REQUIRE(gtol_ >= 0.0, "negative g tolerance");
+        QL_REQUIRE(accelerationRatio_ > 0.0,
+                   "positive acceleration ratio required");
+        QL_REQUIRE(initialDamping_ > 0.0, "positive damping required");
+    }
+
+    EndCriteria::Type TrustRegionLevenbergMarquardt::minimize(
+                                            Problem& P,
+                                            const EndCriteria& endCriteria) {
+        P.reset();
+        iterations_.clear();
+
+        const Real ftol = endCriteria.functionEpsilon();
+        QL_REQUIRE(ftol >= 0.0, "negative f tolerance");
+
+        const Constraint& constraint = P.constraint();
+        Array x = P.currentValue();
+        const Size n = x.size();
+        QL_REQUIRE(n > 0, "no variables given");
+
+        const Array lower = constraint.lowerBound(x);
+        const Array upper = constraint.upperBound(x);
+        for (Size j=0; j < n; ++j)
+            x[j] = std::min(std::max(x[j], lower[j]), upper[j]);
+        QL_REQUIRE(constraint.test(x),
+                   "initial guess " << x << " violates the constraint");
+
+        Array r = P.values(x);
+        const Size m = r.size();
+        QL_REQUIRE(m >= n,
+                   "less functions (" << m <<
+                   ") than available variables (" << n << ")");
+        Real f = 0.5*DotProduct(r, r);
+
+        // workspace, allocated once and reused across iterations
+        Matrix jac(m, n), qr(m, n), s(n, n);
+        Array qtr(m), g(n), d(n, 0.0), dFree(n), beta(n), rDiag(n);
+        Array z(n), w(n), stepFree(n), delta(n), trial(n), step(n);
+        Array jStep(m), accel(n), accelFree(n), rhs(n);
+        std::vector<Size> freeVariables;
+        freeVariables.reserve(n);
+
+        // finite-difference step of the directional second derivative
+        const Real h = 0.1;
+
+        Real lambda = initialDamping_, nu = 2.0;
+        Size iteration = 0;
+        EndCriteria::Type ecType = EndCriteria::None;
+
+        while (ecType == EndCriteria::None) {
+            P.jacobian(jac, x);
+            g = transpose(jac)*r;
+
+            const Real rNorm = std::sqrt(2.0*f);
+            Real gNorm = 0.0, gCosine = 0.0;
+            freeVariables.clear();
+            for (Size j=0; j < n; ++j) {
+                Real columnNorm = 0.0;
+                for (Size i=0; i < m; ++i)
+                    columnNorm += jac[i][j]*jac[i][j];
+                columnNorm = std::sqrt(columnNorm);
+                d[j] = std::max(d[j], columnNorm);
+
+                if ((x[j] <= lower[j] && g[j] > 0.0) ||
+                    (x[j] >= upper[j] && g[j] < 0.0))
+                    continue;
+
+                gNorm = std::max(gNorm, std::fabs(g[j]));
+                if (columnNorm > 0.0 && rNorm > 0.0)
+                    gCosine = std::max(gCosine,
+                                       std::fabs(g[j])/(columnNorm*rNorm));
+                freeVariables.push_back(j);
+            }
+            P.setGradientNormValue(gNorm*gNorm);
+
+            if (gCosine <= gtol_) {
+                ecType = EndCriteria::StationaryPoint;
+                break;
+            }
+
+            const Size nf = freeVariables.size();
+            for (Size k=0; k < nf; ++k) {
+                const Size j = freeVariables[k];
+                for (Size i=0; i < m; ++i)
+                    qr[i][k] = jac[i][j];
+                dFree[k] = (d[j] > 0.0) ? d[j] : Real(1.0);
+            }
+            householderQR(qr, nf, beta, rDiag);
+            std::copy(r.begin(), r.end(), qtr.begin());
+            applyQt(qr, nf, beta, qtr);
+
+            // trial steps for the current jacobian
+            bool accepted = false;
+            while (!accepted && ecType == EndCriteria::None) {
+                if (iteration >= endCriteria.maxIterations()) {
+                    ecType = EndCriteria::MaxIterations;
+                    break;
+                }
+                ++iteration;
+
+                dampedStep(qr, rDiag, qtr, dFree, nf, lambda,
+                           s, z, w, stepFree);
+                std::fill(delta.begin(), delta.end(), 0.0);
+                for (Size k=0; k < nf; ++k)
+                    delta[freeVariables[k]] = stepFree[k];
+
+                bool clipped = false;
+                for (Size j=0; j < n; ++j) {
+                    trial[j] = std::min(std::max(x[j]+delta[j], lower[j]),
+                                        upper[j]);
+                    clipped = clipped || trial[j] != x[j]+delta[j];
+                }
+
+                bool feasible = constraint.test(trial);
+                bool accelerated = false;
+                if (geodesicAcceleration_ && feasible && !clipped) {
+                    const Array xh = x + h*delta;
+                    if (constraint.test(xh)) {
+                        // second directional derivative of the residuals
+                        const Array rvv =
+                            (2.0/h)*((P.values(xh) - r)/h - jac*delta);
+                        for (Size k=0; k < nf; ++k) {
+                            Real sum = 0.0;
+                            for (Size i=0; i < m; ++i)
+                                sum += jac[i][freeVariables[k]]*rvv[i];
+                            rhs[k] = sum;
+                        }
+                        normalSolve(s, nf, rhs, accelFree);
+                        std::fill(accel.begin(), accel.end(), 0.0);
+                        for (Size k=0; k < nf; ++k)
+                            accel[freeVariables[k]] = accelFree[k];
+
+                        // the correction must be small compared to the
+                        // step for the second-order expansion to hold
+                        if (2.0*scaledNorm(d, accel)
+                            <= accelerationRatio_*scaledNorm(d, delta)) {
+                            for (Size j=0; j < n; ++j)
+                                trial[j] = std::min(
+                                    std::max(x[j]+delta[j]+0.5*accel[j],
+                                             lower[j]), upper[j]);
+                            feasible = constraint.test(trial);
+                            accelerated = true;
+                        } else {
+                            feasible = false;
+                        }
+                    }
+                }
+
+                step = trial - x;
+                const Real stepNorm = scaledNorm(d, step);
+
+                Real fNew = f, rho = -1.0, predicted = 0.0;
+                Array rNew;
+                if (feasible) {
+                    rNew = P.values(trial);
+                    fNew = 0.5*DotProduct(rNew, rNew);
+                    jStep = r + jac*step;
+                    predicted = f - 0.5*DotProduct(jStep, jStep);
+                    if (predicted > 0.0)
+                        rho = (f - fNew)/predicted;
+                }
+                accepted = rho > 0.0;
+
+                const Real damping = lambda;
+                if (accepted) {
+                    lambda *= std::max(1.0/3.0,
+                                       1.0 - std::pow(2.0*rho-1.0, 3));
+                    nu = 2.0;
+
+                    if (std::fabs(f - fNew) <= ftol*f && predicted <= ftol*f)
+                        ecType = EndCriteria::StationaryFunctionValue;
+
+                    x = trial;
+                    r = rNew;
+                    f = fNew;
+                } else {
+                    lambda *= nu;
+                    nu *= 2.0;
+                }
+
+                if (ecType == EndCriteria::None
+                    && stepNorm <= xtol_*scaledNorm(d, x))
+                    ecType = EndCriteria::StationaryPoint;
+
+                iterations_.push_back({iteration, f, gNorm, stepNorm,
+                                       damping, accepted, accelerated});
+            }
+        }
+
+        P.setCurrentValue(x);
+        P.setFunctionValue(P.costFunction().value(x));
+
+        return ecType;
+    }
+
+}
@@ -0,0 +1,113 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <https://www.quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+
+/*! \file trustregionlevenbergmarquardt.hpp
+    \brief Levenberg-Marquardt method using the cost function's jacobian
+*/
+
+#ifndef quantlib_optimization_trust_region_levenberg_marquardt_hpp
+#define quantlib_optimization_trust_region_levenberg_marquardt_hpp
+
+#include <ql/math/optimization/problem.hpp>
+#include <vector>
+
+namespace QuantLib {
+
+    //! Levenberg-Marquardt method using the cost function's jacobian
+    /*! Unlike LevenbergMarquardt, which wraps MINPACK and builds a
+        forward-difference jacobian internally, this implementation
+        works directly with the jacobian returned by the cost
+        function, so that analytic derivatives (e.g. the ones of
+        calibrated models) are used natively. The default
+        implementation of CostFunction::jacobian falls back to
+        central differences.
+
+        The damped normal equations
+        \f[ (J^T J + \lambda D^T D)\, \delta = -J^T r \f]
+        are solved with a Householder QR factorization of \f$ J \f$,
+        which is computed once per jacobian and updated by Givens
+        rotations for each trial damping parameter \f$ \lambda \f$.
+        The scaling \f$ D \f$ contains the largest column norms of
+        the jacobian seen so far, the damping is updated following
+        Nielsen, H.B. 1999, Damping parameter in Marquardt's method,
+        IMM-REP-1999-05.
+
+        Optionally, the step is corrected by the geodesic
+        acceleration of Transtrum, M.K. and Sethna, J.P. 2012,
+        Improvements to the Levenberg-Marquardt algorithm for
+        nonlinear least-squares minimization, arXiv:1201.5885, at
+        the cost of one additional function evaluation per trial
+        step.
+
+        Lower and upper bounds of the constraint are enforced by
+        projection: variables at an active bound are frozen as long
+        as the gradient points outwards and trial points are clipped
+        to the box. Trial points violating any other part of the
+        constraint are rejected and the damping is increased.
+
+        The tolerances have the same meaning as for MINPACK: the
+        function epsilon of the end criteria bounds the relative
+        reduction of the sum of squares, xtol the relative scaled
+        step size and gtol the cosine of the angle between the
+        residuals and the columns of the jacobian. The maximum
+        number of iterations bounds the number of trial steps.
+
+        \ingroup optimizers
+    */
+    class TrustRegionLevenbergMarquardt : public OptimizationMethod {
+      public:
+        //! diagnostics of a single trial step
+        struct Iteration {
+            Size iteration;
+            //! half the sum of squares after the trial step
+            Real functionValue;
+            //! infinity norm of the projected gradient
+            Real gradientNorm;
+            //! scaled norm of the trial step
+            Real stepNorm;
+            Real damping;
+            bool accepted;
+            bool accelerated;
+        };
+
+        explicit TrustRegionLevenbergMarquardt(
+            Real xtol = 1.0e-8,
+            Real gtol = 1.0e-8,
+            bool geodesicAcceleration = false,
+            Real accelerationRatio = 0.75,
+            Real initialDamping = 1.0e-3);
+
+        EndCriteria::Type minimize(Problem& P,
+                                   const EndCriteria& endCriteria) override;
+
+        //! trial steps of the last minimization
+        const std::vector<Iteration>& iterations() const {
+            return iterations_;
+        }
+
+      private:
+        const Real xtol_, gtol_;
+        const bool geodesicAcceleration_;
+        const Real accelerationRatio_, initialDamping_;
+        std::vector<Iteration> iterations_;
+    };
+
+}
+
+#endif
@@ -1,6 +1,7 @@
 /* This file is automatically generated; do not edit.     */
 /* Add the files to be included into Makefile.am instead. */
 
+#include <ql/math/statistics/binarystate.hpp>
 #include <ql/math/statistics/convergencestatistics.hpp>
 #include <ql/math/statistics/discrepancystatistics.hpp>
 #include <ql/math/statistics/gaussianstatistics.hpp>
@@ -10,4 +11,5 @@
 #include <ql/math/statistics/riskstatistics.hpp>
 #include <ql/math/statistics/sequencestatistics.hpp>
 #include <ql/math/statistics/statistics.hpp>
+#include <ql/math/statistics/streamingstatistics.hpp>
 
@@ -0,0 +1,94 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <https://www.quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file binarystate.hpp
+    \brief binary serialization of statistics accumulators
+*/
+
+#ifndef quantlib_statistics_binary_state_hpp
+#define quantlib_statistics_binary_state_hpp
+
+#include <ql/errors.hpp>
+#include <ql/types.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <string>
+
+namespace QuantLib {
+
+    namespace detail {
+
+        template <class T>
+        void writeBinary(std::ostream& out, const T& x) {
+            out.write(reinterpret_cast<const char*>(&x), sizeof(T));
+        }
+
+        template <class T>
+        void readBinary(std::istream& in, T& x) {
+            in.read(reinterpret_cast<char*>(&x), sizeof(T));
+            QL_REQUIRE(in.good(), "unable to read statistics state");
+        }
+
+        /* The state of an accumulator starts with a four-character
+           tag identifying its class, the version of its format and
+           the sizes of Real and Size, as the values are written in
+           their native binary representation.
+        */
+        inline void writeStateHeader(std::ostream& out,
+                                     const char* tag,
+                                     std::uint32_t version) {
+            out.write(tag, 4);
+            writeBinary(out, version);
+            writeBinary(out, std::uint8_t(sizeof(Real)));
+            writeBinary(out, std::uint8_t(sizeof(Size)));
+        }
+
+        inline void readStateHeader(std::istream& in,
+                                    const char* tag,
+                                    std::uint32_t version) {
+            char t[4];
+            in.read(t, 4);
+            QL_REQUIRE(in.good(), "unable to read statistics state");
+            QL_REQUIRE(std::equal(t, t+4, tag),
+                       "no " << std::string(tag, 4)
+                       << " statistics state found");
+
+            std::uint32_t v;
+            readBinary(in, v);
+            QL_REQUIRE(v == version,
+                       "unsupported " << std::string(tag, 4)
+                       << " state version " << v
+                       << " (" << version << " required)");
+
+            std::uint8_t realSize, sizeSize;
+            readBinary(in, realSize);
+            readBinary(in, sizeSize);
+            QL_REQUIRE(realSize == sizeof(Real) && sizeSize == sizeof(Size),
+                       "statistics state written with " << int(realSize)
+                       << "-byte Real and " << int(sizeSize)
+                       << "-byte Size, " << sizeof(Real) << " and "
+                       << sizeof(Size) << " bytes required");
+        }
+
+    }
+
+}
+
+#endif
@@ -18,6 +18,7 @@
  FOR A PARTICULAR PURPOSE.  See the license for more details.
 */
 
+#include <ql/math/statistics/binarystate.hpp>
 #include <ql/math/statistics/generalstatistics.hpp>
 
 namespace QuantLib {
@@ -133,4 +134,31 @@ namespace QuantLib {
         return k->first;
     }
 
+    void GeneralStatistics::save(std::ostream& out) const {
+        detail::writeStateHeader(out, "QLGS", 1);
+        detail::writeBinary(out, samples_.size());
+        for (const auto& sample : samples_) {
+            detail::writeBinary(out, sample.first);
+            detail::writeBinary(out, sample.second);
+        }
+        QL_REQUIRE(out, "unable to write statistics state");
+    }
+
+    void GeneralStatistics::load(std::istream& in) {
+        detail::readStateHeader(in, "QLGS", 1);
+        Size n;
+        detail::readBinary(in, n);
+        // the samples are appended one by one, so that a corrupted
+        // size cannot trigger a huge allocation
+        std::vector<std::pair<Real,Real> > samples;
+        for (Size i=0; i<n; ++i) {
+            std::pair<Real,Real> sample;
+            detail::readBinary(in, sample.first);
+            detail::readBinary(in, sample.second);
+            samples.push_back(sample);
+        }
+        samples_.swap(samples);
+        sorted_ = false;
+    }
+
 }
@@ -29,6 +29,7 @@
 #include <ql/errors.hpp>
 #include <vector>
 #include <algorithm>
+#include <iosfwd>
 #include <utility>
 
 namespace QuantLib {
@@ -178,6 +179,9 @@ namespace QuantLib {
                 add(*begin, *wbegin);
         }
 
+        //! adds the data collected by another instance
+        void merge(const GeneralStatistics& other);
+
         //! resets the data to a null set
         void reset();
 
@@ -187,6 +191,14 @@ namespace QuantLib {
         //! sort the data set in increasing order
         void sort() const;
         //@}
+
+        //! \name Serialization
+        //@{
+        //! writes the collected data to a binary stream
+        void save(std::ostream& out) const;
+        //! reads the collected data from a binary stream
+        void load(std::istream& in);
+        //@}
       private:
         mutable std::vector<std::pair<Real,Real> > samples_;
         mutable bool sorted_;
@@ -235,6 +247,13 @@ namespace QuantLib {
         sorted_ = false;
     }
 
+    inline void GeneralStatistics::merge(const GeneralStatistics& other) {
+        QL_REQUIRE(&other != this, "cannot merge statistics with itself");
+        samples_.insert(samples_.end(),
+                        other.samples_.begin(), other.samples_.end());
+        sorted_ = false;
+    }
+
     inline void GeneralStatistics::reset() {
         samples_ = std::vector<std::pair<Real,Real> >();
         sorted_ = true;
@@ -19,38 +19,60 @@
  FOR A PARTICULAR PURPOSE.  See the license for more details.
 */
 
+#include <ql/math/statistics/binarystate.hpp>
 #include <ql/math/statistics/incrementalstatistics.hpp>
-#include <iomanip>
+#include <algorithm>
+#include <cmath>
 
 namespace QuantLib {
 
+    namespace {
+
+        /* pairwise update of the sums of weighted third and fourth
+           powers of the deviations of a set A when a set B, whose mean
+           exceeds the one of A by delta, is merged into it; see
+           P. Pebay, Formulas for robust, one-pass parallel computation
+           of covariances and arbitrary-order statistical moments,
+           Sandia Report SAND2008-6212, 2008. */
+        void mergeHigherMoments(Real wA, Real m2A, Real& m3A, Real& m4A,
+                                Real wB, Real m2B, Real m3B, Real m4B,
+                                Real delta) {
+            Real W = wA + wB;
+            Real delta2 = delta * delta;
+            m4A += m4B
+                + delta2 * delta2 * wA * wB * (wA * wA - wA * wB + wB * wB)
+                    / (W * W * W)
+                + 6.0 * delta2 * (wA * wA * m2B + wB * wB * m2A) / (W * W)
+                + 4.0 * delta * (wA * m3B - wB * m3A) / W;
+            m3A += m3B
+                + delta2 * delta * wA * wB * (wA - wB) / (W * W)
+                + 3.0 * delta * (wA * m2B - wB * m2A) / W;
+        }
+
+    }
+
     IncrementalStatistics::IncrementalStatistics() {
         reset();
     }
 
     Size IncrementalStatistics::samples() const {
-        return boost::accumulators::extract_result<
-            boost::accumulators::tag::count>(acc_);
+        return samples_;
     }
 
     Real IncrementalStatistics::weightSum() const {
-        return boost::accumulators::extract_result<
-            boost::accumulators::tag::sum_of_weights>(acc_);
+        return weightSum_;
     }
 
     Real IncrementalStatistics::mean() const {
         QL_REQUIRE(weightSum() > 0.0, "sampleWeight_= 0, unsufficient");
-        return boost::accumulators::extract_result<
-            boost::accumulators::tag::weighted_mean>(acc_);
+        return weightedSum_ / weightSum_;
     }
 
     Real IncrementalStatistics::variance() const {
         QL_REQUIRE(weightSum() > 0.0, "sampleWeight_= 0, unsufficient");
         QL_REQUIRE(samples() > 1, "sample number <= 1, unsufficient");
         Real n = static_cast<Real>(samples());
-        return n / (n - 1.0) *
-               boost::accumulators::extract_result<
-                   boost::accumulators::tag::weighted_variance>(acc_);
+        return n / (n - 1.0) * weightedVariance_;
     }
 
     Real IncrementalStatistics::standardDeviation() const {
@@ -66,47 +88,40 @@ namespace QuantLib {
         Real n = static_cast<Real>(samples());
         Real r1 = n / (n - 2.0);
         Real r2 = (n - 1.0) / (n - 2.0);
-        return std::sqrt(r1 * r2) * 
-               boost::accumulators::extract_result<
-                   boost::accumulators::tag::weighted_skewness>(acc_);
+        Real s2 = weightedVariance_;
+        Real m3 = centralMoment3_ / weightSum_;
+        return std::sqrt(r1 * r2) * (m3 / (s2 * std::sqrt(s2)));
     }
 
     Real IncrementalStatistics::kurtosis() const {
         QL_REQUIRE(samples() > 3,
                    "sample number <= 3, unsufficient");
-        boost::accumulators::extract_result<
-            boost::accumulators::tag::weighted_kurtosis>(acc_);
         Real n = static_cast<Real>(samples());
         Real r1 = (n - 1.0) / (n - 2.0);
         Real r2 = (n + 1.0) / (n - 3.0);
         Real r3 = (n - 1.0) / (n - 3.0);
-        return ((3.0 + boost::accumulators::extract_result<
-                           boost::accumulators::tag::weighted_kurtosis>(acc_)) *
-                    r2 -
-                3.0 * r3) *
-               r1;
+        Real s2 = weightedVariance_;
+        Real m4 = centralMoment4_ / weightSum_;
+        Real excess = m4 / (s2 * s2) - 3.;
+        return ((3.0 + excess) * r2 - 3.0 * r3) * r1;
     }
 
     Real IncrementalStatistics::min() const {
         QL_REQUIRE(samples() > 0, "empty sample set");
-        return boost::accumulators::extract_result<
-            boost::accumulators::tag::min>(acc_);
+        return min_;
     }
 
     Real IncrementalStatistics::max() const {
         QL_REQUIRE(samples() > 0, "empty sample set");
-        return boost::accumulators::extract_result<
-            boost::accumulators::tag::max>(acc_);
+        return max_;
     }
 
     Size IncrementalStatistics::downsideSamples() const {
-        return boost::accumulators::extract_result<
-            boost::accumulators::tag::count>(downsideAcc_);
+        return downsideSamples_;
     }
 
     Real IncrementalStatistics::downsideWeightSum() const {
-        return boost::accumulators::extract_result<
-            boost::accumulators::tag::sum_of_weights>(downsideAcc_);
+        return downsideWeightSum_;
     }
 
     Real IncrementalStatistics::downsideVariance() const {
@@ -114,9 +129,7 @@ namespace QuantLib {
         QL_REQUIRE(downsideSamples() > 1, "sample number <= 1, unsufficient");
         Real n = static_cast<Real>(downsideSamples());
         Real r1 = n / (n - 1.0);
-        return r1 *
-               boost::accumulators::extract_result<
-                   boost::accumulators::tag::moment<2> >(downsideAcc_);
+        return r1 * (downsideWeightedMoment2_ / downsideWeightSum_);
     }
 
     Real IncrementalStatistics::downsideDeviation() const {
@@ -126,14 +139,112 @@ namespace QuantLib {
     void IncrementalStatistics::add(Real value, Real valueWeight) {
         QL_REQUIRE(valueWeight >= 0.0, "negative weight (" << valueWeight
                                                            << ") not allowed");
-        acc_(value, boost::accumulators::weight = valueWeight);
-        if(value < 0.0)
-            downsideAcc_(value, boost::accumulators::weight = valueWeight);
+        // the higher moments are updated by merging a single-point set
+        Real wA = weightSum_;
+        if (wA > 0.0 && valueWeight > 0.0)
+            mergeHigherMoments(wA, weightedVariance_ * wA,
+                               centralMoment3_, centralMoment4_,
+                               valueWeight, 0.0, 0.0, 0.0,
+                               value - weightedSum_ / wA);
+
+        ++samples_;
+        weightSum_ += valueWeight;
+        weightedSum_ += value * valueWeight;
+        Real value2 = value * value;
+        min_ = std::min(min_, value);
+        max_ = std::max(max_, value);
+
+        if (samples_ > 1) {
+            Real d = value - weightedSum_ / weightSum_;
+            weightedVariance_ =
+                weightedVariance_ * (weightSum_ - valueWeight) / weightSum_
+                + d * d * valueWeight / (weightSum_ - valueWeight);
+        }
+
+        if (value < 0.0) {
+            ++downsideSamples_;
+            downsideWeightSum_ += valueWeight;
+            downsideWeightedMoment2_ += valueWeight * value2;
+        }
+    }
+
+    void IncrementalStatistics::merge(const IncrementalStatistics& other) {
+        QL_REQUIRE(&other != this, "cannot merge statistics with itself");
+        if (other.samples_ == 0)
+            return;
+        if (samples_ == 0) {
+            *this = other;
+            return;
+        }
+
+        Real wA = weightSum_, wB = other.weightSum_, W = wA + wB;
+        if (wA > 0.0 && wB > 0.0) {
+            Real d = other.weightedSum_ / wB - weightedSum_ / wA;
+            Real m2A = weightedVariance_ * wA;
+            Real m2B = other.weightedVariance_ * wB;
+            mergeHigherMoments(wA, m2A, centralMoment3_, centralMoment4_,
+                               wB, m2B, other.centralMoment3_,
+                               other.centralMoment4_, d);
+            weightedVariance_ = (m2A + m2B) / W + d * d * (wA / W) * (wB / W);
+        } else if (wB > 0.0) {
+            weightedVariance_ = other.weightedVariance_;
+            centralMoment3_ = other.centralMoment3_;
+            centralMoment4_ = other.centralMoment4_;
+        }
+
+        samples_ += other.samples_;
+        weightSum_ = W;
+        weightedSum_ += other.weightedSum_;
+        min_ = std::min(min_, other.min_);
+        max_ = std::max(max_, other.max_);
+
+        downsideSamples_ += other.downsideSamples_;
+        downsideWeightSum_ += other.downsideWeightSum_;
+        downsideWeightedMoment2_ += other.downsideWeightedMoment2_;
     }
 
     void IncrementalStatistics::reset() {
-        acc_ = accumulator_set();
-        downsideAcc_ = downside_accumulator_set();
+        samples_ = 0;
+        weightSum_ = weightedSum_ = weightedVariance_ = 0.0;
+        centralMoment3_ = centralMoment4_ = 0.0;
+        min_ = QL_MAX_REAL;
+        max_ = QL_MIN_REAL;
+        downsideSamples_ = 0;
+        downsideWeightSum_ = downsideWeightedMoment2_ = 0.0;
+    }
+
+    void IncrementalStatistics::save(std::ostream& out) const {
+        detail::writeStateHeader(out, "QLIS", 1);
+        detail::writeBinary(out, samples_);
+        detail::writeBinary(out, weightSum_);
+        detail::writeBinary(out, weightedSum_);
+        detail::writeBinary(out, weightedVariance_);
+        detail::writeBinary(out, centralMoment3_);
+        detail::writeBinary(out, centralMoment4_);
+        detail::writeBinary(out, min_);
+        detail::writeBinary(out, max_);
+        detail::writeBinary(out, downsideSamples_);
+        detail::writeBinary(out, downsideWeightSum_);
+        detail::writeBinary(out, downsideWeightedMoment2_);
+        QL_REQUIRE(out, "unable to write statistics state");
+    }
+
+    void IncrementalStatistics::load(std::istream& in) {
+        // the state is only replaced if it was read completely
+        IncrementalStatistics s;
+        detail::readStateHeader(in, "QLIS", 1);
+        detail::readBinary(in, s.samples_);
+        detail::readBinary(in, s.weightSum_);
+        detail::readBinary(in, s.weightedSum_);
+        detail::readBinary(in, s.weightedVariance_);
+        detail::readBinary(in, s.centralMoment3_);
+        detail::readBinary(in, s.centralMoment4_);
+        detail::readBinary(in, s.min_);
+        detail::readBinary(in, s.max_);
+        detail::readBinary(in, s.downsideSamples_);
+        detail::readBinary(in, s.downsideWeightSum_);
+        detail::readBinary(in, s.downsideWeightedMoment2_);
+        *this = s;
     }
 
 }
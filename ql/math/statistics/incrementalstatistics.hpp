@@ -21,8 +21,6 @@
 
 /*! \file incrementalstatistics.hpp
     \brief statistics tool based on incremental accumulation
-           in the meantime, this is just a wrapper to the boost
-           accumulator library, kept for backward compatibility
 */
 
 #ifndef quantlib_incremental_statistics_hpp
@@ -30,24 +28,21 @@
 
 #include <ql/utilities/null.hpp>
 #include <ql/errors.hpp>
-#include <boost/accumulators/accumulators.hpp>
-#include <boost/accumulators/statistics/stats.hpp>
-#include <boost/accumulators/statistics/count.hpp>
-#include <boost/accumulators/statistics/sum.hpp>
-#include <boost/accumulators/statistics/min.hpp>
-#include <boost/accumulators/statistics/max.hpp>
-#include <boost/accumulators/statistics/weighted_mean.hpp>
-#include <boost/accumulators/statistics/weighted_variance.hpp>
-#include <boost/accumulators/statistics/weighted_skewness.hpp>
-#include <boost/accumulators/statistics/weighted_kurtosis.hpp>
-#include <boost/accumulators/statistics/weighted_moment.hpp>
+#include <iosfwd>
 
 namespace QuantLib {
 
     //! Statistics tool based on incremental accumulation
     /*! It can accumulate a set of data and return statistics (e.g: mean,
         variance, skewness, kurtosis, error estimation, etc.).
-        This class is a wrapper to the boost accumulator library.
+        The accumulation follows the same formulas as the weighted
+        statistics of the boost accumulator library, which this class
+        used to wrap.
+
+        Partial accumulators collected separately (e.g., by different
+        threads or processes) can be combined by means of the merge()
+        method, and their state can be written to and read from a
+        binary stream.
     */
 
     class IncrementalStatistics {
@@ -145,29 +140,32 @@ namespace QuantLib {
             for (;begin!=end;++begin,++wbegin)
                 add(*begin, *wbegin);
         }
+        //! merges the data collected by another instance
+        /*! The weighted central moments are combined with the
+            pairwise formulas by Pebay, so that the merged statistics
+            reproduce the ones of a single accumulator up to rounding
+            errors, even for data with a large common offset.
+        */
+        void merge(const IncrementalStatistics& other);
         //! resets the data to a null set
         void reset();
         //@}
-     private:
-       typedef boost::accumulators::accumulator_set<
-           Real,
-           boost::accumulators::stats<
-               boost::accumulators::tag::count, boost::accumulators::tag::min,
-               boost::accumulators::tag::max,
-               boost::accumulators::tag::weighted_mean,
-               boost::accumulators::tag::weighted_variance,
-               boost::accumulators::tag::weighted_skewness,
-               boost::accumulators::tag::weighted_kurtosis,
-               boost::accumulators::tag::sum_of_weights>,
-           Real> accumulator_set;
-        accumulator_set acc_;
-        typedef boost::accumulators::accumulator_set<
-            Real, boost::accumulators::stats<
-                      boost::accumulators::tag::count,
-                      boost::accumulators::tag::weighted_moment<2>,
-                      boost::accumulators::tag::sum_of_weights>,
-            Real> downside_accumulator_set;
-        downside_accumulator_set downsideAcc_;
+
+        //! \name Serialization
+        //@{
+        //! writes the accumulator state to a binary stream
+        void save(std::ostream& out) const;
+        //! reads the accumulator state from a binary stream
+        void load(std::istream& in);
+        //@}
+      private:
+        Size samples_;
+        Real weightSum_, weightedSum_, weightedVariance_;
+        // sums of weighted third and fourth powers of the deviations
+        Real centralMoment3_, centralMoment4_;
+        Real min_, max_;
+        Size downsideSamples_;
+        Real downsideWeightSum_, downsideWeightedMoment2_;
     };
 
 }
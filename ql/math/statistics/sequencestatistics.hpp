@@ -26,6 +26,7 @@
 
 #include <ql/math/statistics/statistics.hpp>
 #include <ql/math/statistics/incrementalstatistics.hpp>
+#include <ql/math/statistics/binarystate.hpp>
 #include <ql/math/matrix.hpp>
 
 namespace QuantLib {
@@ -132,19 +133,58 @@ namespace QuantLib {
                        " required, " << std::distance(begin, end) <<
                        " provided");
 
-            quadraticSum_ += weight * outerProduct(begin, end,
-                                                   begin, end);
+            // weighted co-moments about the running means, updated
+            // as in merge() with a single-point second set
+            const Real w = coMomentWeight_ + weight;
+            if (coMomentWeight_ > 0.0 && weight > 0.0) {
+                Iterator x = begin;
+                for (Size i=0; i<dimension_; ++x, ++i)
+                    delta_[i] = *x - means_[i];
+                coMoments_ += (coMomentWeight_*weight/w)
+                    * outerProduct(delta_.begin(), delta_.end(),
+                                   delta_.begin(), delta_.end());
+            }
+            if (w > 0.0) {
+                Iterator x = begin;
+                for (Size i=0; i<dimension_; ++x, ++i)
+                    means_[i] += (weight/w)*(*x - means_[i]);
+            }
+            coMomentWeight_ = w;
 
             for (Size i=0; i<dimension_; ++begin, ++i)
                 stats_[i].add(*begin, weight);
 
         }
+        //! merges the data collected by another instance
+        /*! This allows to combine partial accumulators collected
+            separately, e.g., by different threads or processes.
+            The underlying statistics class must provide a
+            corresponding merge() method.
+        */
+        void merge(const GenericSequenceStatistics& other);
+        //@}
+        //! \name Serialization
+        //@{
+        /*! writes the accumulator state to a binary stream; the
+            underlying statistics class must provide a corresponding
+            save() method.
+        */
+        void save(std::ostream& out) const;
+        /*! reads the accumulator state from a binary stream; the
+            underlying statistics class must provide a corresponding
+            load() method.
+        */
+        void load(std::istream& in);
         //@}
       protected:
         Size dimension_ = 0;
         std::vector<statistics_type> stats_;
         mutable std::vector<Real> results_;
-        Matrix quadraticSum_;
+        // sum of weights, means and sums of weighted products of the
+        // deviations from the means, combined pairwise on merge
+        Real coMomentWeight_ = 0.0;
+        std::vector<Real> means_, delta_;
+        Matrix coMoments_;
     };
 
     //! default multi-dimensional statistics tool
@@ -237,12 +277,90 @@ namespace QuantLib {
                 stats_ = std::vector<Stat>(dimension);
                 results_ = std::vector<Real>(dimension);
             }
-            quadraticSum_ = Matrix(dimension_, dimension_, 0.0);
+            coMoments_ = Matrix(dimension_, dimension_, 0.0);
+            means_ = delta_ = std::vector<Real>(dimension_, 0.0);
+            coMomentWeight_ = 0.0;
         } else {
             dimension_ = dimension;
         }
     }
 
+    template <class Stat>
+    void GenericSequenceStatistics<Stat>::merge(
+                                const GenericSequenceStatistics<Stat>& other) {
+        if (other.dimension_ == 0)
+            return;
+        if (dimension_ == 0)
+            reset(other.dimension_);
+
+        QL_REQUIRE(other.dimension_ == dimension_,
+                   "sample size mismatch: " << dimension_ <<
+                   " required, " << other.dimension_ << " provided");
+
+        const Real wA = coMomentWeight_, wB = other.coMomentWeight_;
+        const Real w = wA + wB;
+        if (wA > 0.0 && wB > 0.0) {
+            for (Size i=0; i<dimension_; ++i)
+                delta_[i] = other.means_[i] - means_[i];
+            coMoments_ += other.coMoments_;
+            coMoments_ += (wA*wB/w)
+                * outerProduct(delta_.begin(), delta_.end(),
+                               delta_.begin(), delta_.end());
+            for (Size i=0; i<dimension_; ++i)
+                means_[i] += (wB/w)*delta_[i];
+        } else if (wB > 0.0) {
+            coMoments_ = other.coMoments_;
+            means_ = other.means_;
+        }
+        coMomentWeight_ = w;
+
+        for (Size i=0; i<dimension_; ++i)
+            stats_[i].merge(other.stats_[i]);
+    }
+
+    template <class Stat>
+    void GenericSequenceStatistics<Stat>::save(std::ostream& out) const {
+        detail::writeStateHeader(out, "QLSQ", 1);
+        detail::writeBinary(out, dimension_);
+        for (Size i=0; i<dimension_; ++i)
+            stats_[i].save(out);
+        detail::writeBinary(out, coMomentWeight_);
+        for (Size i=0; i<dimension_; ++i)
+            detail::writeBinary(out, means_[i]);
+        for (Size i=0; i<dimension_; ++i)
+            for (Size j=0; j<dimension_; ++j)
+                detail::writeBinary(out, coMoments_[i][j]);
+        QL_REQUIRE(out, "unable to write statistics state");
+    }
+
+    template <class Stat>
+    void GenericSequenceStatistics<Stat>::load(std::istream& in) {
+        // the state is only replaced if it was read completely
+        detail::readStateHeader(in, "QLSQ", 1);
+        Size dimension;
+        detail::readBinary(in, dimension);
+        std::vector<Stat> stats;
+        for (Size i=0; i<dimension; ++i) {
+            stats.emplace_back();
+            stats.back().load(in);
+        }
+        Real coMomentWeight;
+        detail::readBinary(in, coMomentWeight);
+        std::vector<Real> means(dimension);
+        for (Size i=0; i<dimension; ++i)
+            detail::readBinary(in, means[i]);
+        Matrix coMoments(dimension, dimension);
+        for (Size i=0; i<dimension; ++i)
+            for (Size j=0; j<dimension; ++j)
+                detail::readBinary(in, coMoments[i][j]);
+
+        reset(dimension);
+        stats_.swap(stats);
+        coMomentWeight_ = coMomentWeight;
+        means_.swap(means);
+        coMoments_ = coMoments;
+    }
+
     template <class Stat>
     Matrix GenericSequenceStatistics<Stat>::covariance() const {
         Real sampleWeight = weightSum();
@@ -253,13 +371,7 @@ namespace QuantLib {
         QL_REQUIRE(sampleNumber > 1.0,
                    "sample number <=1, unsufficient");
 
-        std::vector<Real> m = mean();
-        Real inv = 1.0/sampleWeight;
-
-        Matrix result = inv*quadraticSum_;
-        result -= outerProduct(m.begin(), m.end(),
-                               m.begin(), m.end());
-
+        Matrix result = (1.0/sampleWeight)*coMoments_;
         result *= (sampleNumber/(sampleNumber-1.0));
         return result;
     }
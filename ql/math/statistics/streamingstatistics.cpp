@@ -0,0 +1,219 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <https://www.quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/math/statistics/binarystate.hpp>
+#include <ql/math/statistics/streamingstatistics.hpp>
+#include <ql/math/comparison.hpp>
+#include <ql/mathconstants.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace QuantLib {
+
+    namespace {
+
+        // the t-digest buffer is flushed when it holds this many
+        // times the compression parameter
+        const Real bufferFactor = 2.0;
+
+        // k_1 scale function and its inverse; centroids are allowed
+        // to span a unit interval in k.
+        Real scale(Real q, Real delta) {
+            return delta/(2.0*M_PI) * std::asin(2.0*q-1.0);
+        }
+
+        Real inverseScale(Real k, Real delta) {
+            if (k >= 0.25*delta)
+                return 1.0;
+            return 0.5*(std::sin(2.0*M_PI*k/delta) + 1.0);
+        }
+
+    }
+
+    StreamingStatistics::StreamingStatistics(Real compression)
+    : compression_(compression) {
+        QL_REQUIRE(compression_ >= 10.0,
+                   "compression (" << compression_
+                   << ") must be at least 10");
+        reset();
+    }
+
+    Real StreamingStatistics::percentile(Real percent) const {
+
+        QL_REQUIRE(percent > 0.0 && percent <= 1.0,
+                   "percentile (" << percent << ") must be in (0.0, 1.0]");
+        QL_REQUIRE(weightSum() > 0.0,
+                   "empty sample set");
+
+        compress();
+
+        const Size n = centroids_.size();
+        const Real target = percent*digestWeight_;
+
+        // the weight of each centroid is assumed to be spread
+        // symmetrically around its mean; the tails are interpolated
+        // towards the exact minimum and maximum.
+        const Centroid& first = centroids_.front();
+        if (target < 0.5*first.weight) {
+            if (first.count == 1)
+                return first.mean;
+            return min() + (first.mean-min()) * target/(0.5*first.weight);
+        }
+
+        const Centroid& last = centroids_.back();
+        if (target > digestWeight_ - 0.5*last.weight) {
+            if (last.count == 1)
+                return last.mean;
+            return max() - (max()-last.mean)
+                * (digestWeight_-target)/(0.5*last.weight);
+        }
+
+        Real weightSoFar = 0.5*first.weight;
+        for (Size i=0; i<n-1; ++i) {
+            const Centroid& left = centroids_[i];
+            const Centroid& right = centroids_[i+1];
+            Real dw = 0.5*(left.weight + right.weight);
+            if (weightSoFar + dw > target) {
+                Real z = (target - weightSoFar)/dw;
+                return left.mean + z*(right.mean-left.mean);
+            }
+            weightSoFar += dw;
+        }
+        return last.mean;
+    }
+
+    Real StreamingStatistics::topPercentile(Real percent) const {
+
+        QL_REQUIRE(percent > 0.0 && percent <= 1.0,
+                   "percentile (" << percent << ") must be in (0.0, 1.0]");
+
+        if (close_enough(percent, 1.0))
+            return min();
+        return percentile(1.0-percent);
+    }
+
+    void StreamingStatistics::add(Real value, Real weight) {
+        moments_.add(value, weight);
+        if (weight == 0.0)
+            return;
+
+        buffer_.push_back({value, weight, 1});
+        digestWeight_ += weight;
+        if (buffer_.size() >= bufferFactor*compression_)
+            compress();
+    }
+
+    void StreamingStatistics::merge(const StreamingStatistics& other) {
+        QL_REQUIRE(&other != this, "cannot merge statistics with itself");
+        moments_.merge(other.moments_);
+
+        buffer_.insert(buffer_.end(),
+                       other.centroids_.begin(), other.centroids_.end());
+        buffer_.insert(buffer_.end(),
+                       other.buffer_.begin(), other.buffer_.end());
+        digestWeight_ += other.digestWeight_;
+        compress();
+    }
+
+    void StreamingStatistics::reset() {
+        moments_.reset();
+        centroids_.clear();
+        buffer_.clear();
+        buffer_.reserve(Size(bufferFactor*compression_));
+        digestWeight_ = 0.0;
+    }
+
+    void StreamingStatistics::save(std::ostream& out) const {
+        compress();
+        detail::writeStateHeader(out, "QLSS", 1);
+        moments_.save(out);
+        detail::writeBinary(out, compression_);
+        detail::writeBinary(out, digestWeight_);
+        detail::writeBinary(out, centroids_.size());
+        for (const auto& c : centroids_) {
+            detail::writeBinary(out, c.mean);
+            detail::writeBinary(out, c.weight);
+            detail::writeBinary(out, c.count);
+        }
+        QL_REQUIRE(out, "unable to write statistics state");
+    }
+
+    void StreamingStatistics::load(std::istream& in) {
+        // the state is only replaced if it was read completely
+        detail::readStateHeader(in, "QLSS", 1);
+        IncrementalStatistics moments;
+        moments.load(in);
+        Real compression, digestWeight;
+        detail::readBinary(in, compression);
+        detail::readBinary(in, digestWeight);
+        QL_REQUIRE(compression >= 10.0,
+                   "invalid compression (" << compression
+                   << ") in statistics state");
+        Size n;
+        detail::readBinary(in, n);
+        std::vector<Centroid> centroids;
+        for (Size i=0; i<n; ++i) {
+            Centroid c;
+            detail::readBinary(in, c.mean);
+            detail::readBinary(in, c.weight);
+            detail::readBinary(in, c.count);
+            centroids.push_back(c);
+        }
+
+        reset();
+        compression_ = compression;
+        moments_ = moments;
+        digestWeight_ = digestWeight;
+        centroids_.swap(centroids);
+    }
+
+    void StreamingStatistics::compress() const {
+        if (buffer_.empty())
+            return;
+
+        buffer_.insert(buffer_.end(), centroids_.begin(), centroids_.end());
+        std::sort(buffer_.begin(), buffer_.end(),
+                  [](const Centroid& a, const Centroid& b) {
+                      return a.mean < b.mean;
+                  });
+        centroids_.clear();
+
+        const Real W = digestWeight_;
+        Real weightSoFar = 0.0;
+        Real weightLimit = W*inverseScale(scale(0.0, compression_) + 1.0,
+                                          compression_);
+        Centroid current = buffer_.front();
+        for (auto c = buffer_.begin()+1; c != buffer_.end(); ++c) {
+            if (weightSoFar + current.weight + c->weight <= weightLimit) {
+                current.weight += c->weight;
+                current.mean += (c->mean - current.mean)
+                    * c->weight/current.weight;
+                current.count += c->count;
+            } else {
+                weightSoFar += current.weight;
+                centroids_.push_back(current);
+                weightLimit = W*inverseScale(
+                    scale(weightSoFar/W, compression_) + 1.0, compression_);
+                current = *c;
+            }
+        }
+        centroids_.push_back(current);
+        buffer_.clear();
+    }
+
+}
@@ -0,0 +1,294 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <https://www.quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file streamingstatistics.hpp
+    \brief statistics tool with bounded memory requirements
+*/
+
+#ifndef quantlib_streaming_statistics_hpp
+#define quantlib_streaming_statistics_hpp
+
+#include <ql/math/statistics/incrementalstatistics.hpp>
+#include <ql/math/statistics/riskstatistics.hpp>
+#include <ql/utilities/null.hpp>
+#include <ql/errors.hpp>
+#include <iosfwd>
+#include <vector>
+#include <utility>
+
+namespace QuantLib {
+
+    //! Statistics tool with bounded memory requirements
+    /*! This class can be used as a drop-in replacement for
+        GeneralStatistics when the number of samples is too large
+        to be stored, e.g., in Monte Carlo simulations with millions
+        of paths used for value-at-risk or expected-shortfall
+        calculations.
+
+        Moments are accumulated by an IncrementalStatistics instance
+        and are exact up to rounding errors.  The
+        empirical distribution is summarized by a merging t-digest
+        (Dunning and Ertl, 2019) whose size is bounded by the
+        compression parameter \f$ \delta \f$ independently of the
+        number of samples; percentiles and expectation values are
+        therefore approximated.  The rank error of a percentile is of
+        order \f$ \sqrt{q(1-q)}/\delta \f$, i.e., it is smaller in the
+        tails which are the relevant region for risk measures.  With
+        the default \f$ \delta = 500 \f$ (about 300 centroids) and
+        \f$ 10^6 \f$ Gaussian samples, percentiles between 1% and
+        99% are reproduced within 0.5% of the standard deviation and
+        the 0.1% and 99.9% percentiles within 1.5%, where the mean of
+        the few samples in a tail centroid overstates the extremes;
+        value-at-risk is reproduced within 0.1% and expected shortfall
+        within 1.5%;
+        results obtained by merging partial accumulators are of
+        comparable accuracy.
+
+        Two instances (e.g., accumulated by different threads on
+        separate sets of paths) can be combined by means of the
+        merge() method.
+
+        \test the results are checked against the ones returned by
+              GeneralStatistics on the same samples.
+    */
+    class StreamingStatistics {
+      public:
+        typedef Real value_type;
+        explicit StreamingStatistics(Real compression = 500.0);
+        //! \name Inspectors
+        //@{
+        //! number of samples collected
+        Size samples() const;
+
+        //! sum of data weights
+        Real weightSum() const;
+
+        /*! returns the mean, defined as
+            \f[ \langle x \rangle = \frac{\sum w_i x_i}{\sum w_i}. \f]
+        */
+        Real mean() const;
+
+        /*! returns the variance, defined as
+            \f[ \sigma^2 = \frac{N}{N-1} \left\langle \left(
+                x-\langle x \rangle \right)^2 \right\rangle. \f]
+        */
+        Real variance() const;
+
+        /*! returns the standard deviation \f$ \sigma \f$, defined as the
+            square root of the variance.
+        */
+        Real standardDeviation() const;
+
+        /*! returns the error estimate on the mean value, defined as
+            \f$ \epsilon = \sigma/\sqrt{N}. \f$
+        */
+        Real errorEstimate() const;
+
+        /*! returns the skewness, defined as
+            \f[ \frac{N^2}{(N-1)(N-2)} \frac{\left\langle \left(
+                x-\langle x \rangle \right)^3 \right\rangle}{\sigma^3}. \f]
+            The above evaluates to 0 for a Gaussian distribution.
+        */
+        Real skewness() const;
+
+        /*! returns the excess kurtosis, defined as
+            \f[ \frac{N^2(N+1)}{(N-1)(N-2)(N-3)}
+                \frac{\left\langle \left(x-\langle x \rangle \right)^4
+                \right\rangle}{\sigma^4} - \frac{3(N-1)^2}{(N-2)(N-3)}. \f]
+            The above evaluates to 0 for a Gaussian distribution.
+        */
+        Real kurtosis() const;
+
+        /*! returns the minimum sample value */
+        Real min() const;
+
+        /*! returns the maximum sample value */
+        Real max() const;
+
+        //! compression parameter of the underlying t-digest
+        Real compression() const;
+
+        //! number of centroids currently used to summarize the data
+        Size centroids() const;
+
+        /*! Approximated expectation value of a function \f$ f \f$ on
+            a given range \f$ \mathcal{R} \f$, i.e.,
+            \f[ \mathrm{E}\left[f \;|\; \mathcal{R}\right] \simeq
+                \frac{\sum_{c_j \in \mathcal{R}} f(c_j) w_j}{
+                      \sum_{c_j \in \mathcal{R}} w_j} \f]
+            where \f$ c_j \f$ and \f$ w_j \f$ are the means and the
+            weights of the t-digest centroids.
+
+            The function returns a pair made of the result and
+            the number of observations summarized by the centroids
+            in the given range.
+        */
+        template <class Func, class Predicate>
+        std::pair<Real,Size> expectationValue(const Func& f,
+                                              const Predicate& inRange) const {
+            compress();
+            Real num = 0.0, den = 0.0;
+            Size N = 0;
+            for (const auto& c : centroids_) {
+                if (inRange(c.mean)) {
+                    num += f(c.mean)*c.weight;
+                    den += c.weight;
+                    N += c.count;
+                }
+            }
+            if (N == 0 || den == 0.0)
+                return std::make_pair<Real,Size>(Null<Real>(),0);
+            else
+                return std::make_pair(num/den,N);
+        }
+
+        /*! Approximated expectation value of a function \f$ f \f$
+            over the whole set of samples; equivalent to passing the
+            other overload a range function always returning
+            <tt>true</tt>.
+        */
+        template <class Func>
+        std::pair<Real,Size> expectationValue(const Func& f) const {
+            return expectationValue(f, [](Real) { return true; });
+        }
+
+        /*! approximated \f$ y \f$-th percentile, defined as the value
+            \f$ \bar{x} \f$ such that
+            \f[ y = \frac{\sum_{x_i < \bar{x}} w_i}{
+                          \sum_i w_i} \f]
+
+            \pre \f$ y \f$ must be in the range \f$ (0-1]. \f$
+        */
+        Real percentile(Real y) const;
+
+        /*! approximated \f$ y \f$-th top percentile, defined as the
+            value \f$ \bar{x} \f$ such that
+            \f[ y = \frac{\sum_{x_i > \bar{x}} w_i}{
+                          \sum_i w_i} \f]
+
+            \pre \f$ y \f$ must be in the range \f$ (0-1]. \f$
+        */
+        Real topPercentile(Real y) const;
+        //@}
+
+        //! \name Modifiers
+        //@{
+        //! adds a datum to the set, possibly with a weight
+        /*! \pre weight must be positive or null */
+        void add(Real value, Real weight = 1.0);
+        //! adds a sequence of data to the set, with default weight
+        template <class DataIterator>
+        void addSequence(DataIterator begin, DataIterator end) {
+            for (;begin!=end;++begin)
+                add(*begin);
+        }
+        //! adds a sequence of data to the set, each with its weight
+        /*! \pre weights must be positive or null */
+        template <class DataIterator, class WeightIterator>
+        void addSequence(DataIterator begin, DataIterator end,
+                         WeightIterator wbegin) {
+            for (;begin!=end;++begin,++wbegin)
+                add(*begin, *wbegin);
+        }
+        //! merges the data collected by another instance
+        void merge(const StreamingStatistics& other);
+
+        //! resets the data to a null set
+        void reset();
+        //@}
+
+        //! \name Serialization
+        //@{
+        //! writes the accumulator state to a binary stream
+        void save(std::ostream& out) const;
+        //! reads the accumulator state from a binary stream
+        void load(std::istream& in);
+        //@}
+      private:
+        struct Centroid {
+            Real mean, weight;
+            Size count;
+        };
+        void compress() const;
+
+        Real compression_;
+        IncrementalStatistics moments_;
+        mutable std::vector<Centroid> centroids_, buffer_;
+        mutable Real digestWeight_;
+    };
+
+    //! risk statistics with bounded memory requirements
+    typedef GenericRiskStatistics<StreamingStatistics>
+                                                    StreamingRiskStatistics;
+
+
+    // inline definitions
+
+    inline Size StreamingStatistics::samples() const {
+        return moments_.samples();
+    }
+
+    inline Real StreamingStatistics::weightSum() const {
+        return moments_.weightSum();
+    }
+
+    inline Real StreamingStatistics::mean() const {
+        return moments_.mean();
+    }
+
+    inline Real StreamingStatistics::variance() const {
+        return moments_.variance();
+    }
+
+    inline Real StreamingStatistics::standardDeviation() const {
+        return moments_.standardDeviation();
+    }
+
+    inline Real StreamingStatistics::errorEstimate() const {
+        return moments_.errorEstimate();
+    }
+
+    inline Real StreamingStatistics::skewness() const {
+        return moments_.skewness();
+    }
+
+    inline Real StreamingStatistics::kurtosis() const {
+        return moments_.kurtosis();
+    }
+
+    inline Real StreamingStatistics::min() const {
+        return moments_.min();
+    }
+
+    inline Real StreamingStatistics::max() const {
+        return moments_.max();
+    }
+
+    inline Real StreamingStatistics::compression() const {
+        return compression_;
+    }
+
+    inline Size StreamingStatistics::centroids() const {
+        compress();
+        return centroids_.size();
+    }
+
+}
+
+
+#endif
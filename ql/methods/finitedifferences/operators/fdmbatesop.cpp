@@ -21,7 +21,6 @@
     \brief Bates linear operator
 */
 
-#include <ql/math/interpolations/linearinterpolation.hpp>
 #include <ql/math/matrix.hpp>
 #include <ql/methods/finitedifferences/meshers/fdmmesher.hpp>
 #include <ql/methods/finitedifferences/operators/fdmbatesop.hpp>
@@ -30,6 +29,7 @@
 #include <ql/processes/batesprocess.hpp>
 #include <ql/quotes/simplequote.hpp>
 #include <ql/termstructures/yield/zerospreadedtermstructure.hpp>
+#include <algorithm>
 #include <utility>
 
 namespace QuantLib {
@@ -56,18 +56,43 @@ namespace QuantLib {
               batesProcess->theta(),
               batesProcess->sigma(),
               batesProcess->rho()),
-          quantoHelper)) {}
+          quantoHelper)) {
+        QL_REQUIRE(mesher_->layout()->dim().size() == 2, "invalid layout dimension");
+
+        x_ = Array(mesher_->layout()->dim()[0]);
+        f_ = Matrix(mesher_->layout()->dim()[1], mesher_->layout()->dim()[0]);
+
+        for (const auto& iter : *mesher_->layout())
+            x_[iter.coordinates()[0]] = mesher_->location(iter, 0);
+    }
 
     FdmBatesOp::IntegroIntegrand::IntegroIntegrand(
-                    const ext::shared_ptr<LinearInterpolation>& interpl,
+                    const Array& grid,
+                    Matrix::const_row_iterator values,
                     const FdmBoundaryConditionSet& bcSet,
                     Real x, Real delta, Real nu)
     : x_(x), delta_(delta), nu_(nu), 
-      bcSet_(bcSet), interpl_(interpl) { }
+      bcSet_(bcSet), grid_(grid), values_(values) { }
+
+    Real FdmBatesOp::IntegroIntegrand::interpolate(Real x) const {
+        // linear interpolation with linear extrapolation at both ends
+        const Size n = grid_.size();
+        Size i;
+        if (x < grid_[0])
+            i = 0;
+        else if (x >= grid_[n-1])
+            i = n-2;
+        else
+            i = Size(std::upper_bound(grid_.begin(), grid_.end()-1, x)
+                     - grid_.begin()) - 1;
+
+        const Real s = (values_[i+1]-values_[i])/(grid_[i+1]-grid_[i]);
+        return values_[i] + (x-grid_[i])*s;
+    }
                     
     Real FdmBatesOp::IntegroIntegrand::operator()(Real y) const {
         const Real x = x_ + M_SQRT2*delta_*y + nu_;
-        Real valueOfDerivative = (*interpl_)(x, true);
+        Real valueOfDerivative = interpolate(x);
 
         for (auto iter = bcSet_.begin(); iter < bcSet_.end(); ++iter) {
 
@@ -85,36 +110,25 @@ namespace QuantLib {
     }
     
     Array FdmBatesOp::integro(const Array& r) const {
-        QL_REQUIRE(mesher_->layout()->dim().size() == 2, "invalid layout dimension");
+        Array result(r.size(), 0.0);
+        add_integro_into(r, result);
+        return result;
+    }
+
+    void FdmBatesOp::add_integro_into(const Array& r, Array& result) const {
+        for (const auto& iter : *mesher_->layout())
+            f_[iter.coordinates()[1]][iter.coordinates()[0]] = r[iter.index()];
 
-        Array x(mesher_->layout()->dim()[0]);
-        Matrix f(mesher_->layout()->dim()[1], mesher_->layout()->dim()[0]);
-        
-        for (const auto& iter : *mesher_->layout()) {
-            const Size i = iter.coordinates()[0];
-            const Size j = iter.coordinates()[1];
-            
-            x[i]    = mesher_->location(iter, 0);
-            f[j][i] = r[iter.index()];
-            
-        }
-        std::vector<ext::shared_ptr<LinearInterpolation> > interpl(f.rows());
-        for (Size i=0; i < f.rows(); ++i) {
-            interpl[i] = ext::make_shared<LinearInterpolation>(
-                x.begin(), x.end(), f.row_begin(i));
-        }
-        
-        Array integral(r.size());
         for (const auto& iter : *mesher_->layout()) {
             const Size i = iter.coordinates()[0];
             const Size j = iter.coordinates()[1];
 
-            integral[iter.index()] = M_1_SQRTPI* 
-                gaussHermiteIntegration_(
-                      IntegroIntegrand(interpl[j], bcSet_, x[i], delta_, nu_));
-        }
+            const Real integral = M_1_SQRTPI*
+                gaussHermiteIntegration_(IntegroIntegrand(
+                    x_, f_.row_begin(j), bcSet_, x_[i], delta_, nu_));
 
-        return lambda_*(integral-r);
+            result[iter.index()] += lambda_*(integral - r[iter.index()]);
+        }
     }
 
     std::vector<SparseMatrix> FdmBatesOp::toMatrixDecomp() const {
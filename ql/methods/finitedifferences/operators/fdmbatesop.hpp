@@ -25,12 +25,12 @@
 #define quantlib_fdm_bates_op_hpp
 
 #include <ql/math/integrals/gaussianquadratures.hpp>
+#include <ql/math/matrix.hpp>
 #include <ql/methods/finitedifferences/operators/fdmhestonop.hpp>
 #include <ql/methods/finitedifferences/utilities/fdmboundaryconditionset.hpp>
 
 namespace QuantLib {
 
-    class LinearInterpolation;
     class BatesProcess;
     
     class FdmBatesOp : public FdmLinearOpComposite {
@@ -52,25 +52,44 @@ namespace QuantLib {
         Array solve_splitting(Size direction, const Array& r, Real s) const override;
         Array preconditioner(const Array& r, Real s) const override;
 
+        void apply_into(const Array& r, Array& result) const override;
+        void apply_mixed_into(const Array& r, Array& result) const override;
+        void apply_direction_into(Size direction,
+                                  const Array& r,
+                                  Array& result) const override;
+        void solve_splitting_into(Size direction,
+                                  const Array& r, Real s,
+                                  Array& result) const override;
+        void preconditioner_into(const Array& r, Real s,
+                                 Array& result) const override;
+
         std::vector<SparseMatrix> toMatrixDecomp() const override;
 
       private:
         class IntegroIntegrand {
           public:
-            IntegroIntegrand(const ext::shared_ptr<LinearInterpolation>& i,
+            IntegroIntegrand(const Array& grid,
+                             Matrix::const_row_iterator values,
                              const FdmBoundaryConditionSet& bcSet,
                              Real x, Real delta, Real nu);
             Real operator()(Real y) const;
             
           private:
+            Real interpolate(Real x) const;
+
             const Real x_, delta_, nu_;
             const FdmBoundaryConditionSet& bcSet_;
-            const ext::shared_ptr<LinearInterpolation>& interpl_;
+            const Array& grid_;
+            const Matrix::const_row_iterator values_;
         };
           
         Array integro(const Array& r) const;  
+        // adds the integro part to result without allocating
+        void add_integro_into(const Array& r, Array& result) const;
         
-        Array x_, weights_;
+        Array x_;
+        // scratch space, not reentrant (see FdmLinearOpComposite)
+        mutable Matrix f_;
         
         const Real lambda_, delta_, nu_, m_;
         GaussHermiteIntegration gaussHermiteIntegration_;
@@ -112,6 +131,34 @@ namespace QuantLib {
                                             Real s) const {
         return hestonOp_->preconditioner(r, s);
     }
+
+    inline void FdmBatesOp::apply_into(const Array& r, Array& result) const {
+        hestonOp_->apply_into(r, result);
+        add_integro_into(r, result);
+    }
+
+    inline void FdmBatesOp::apply_mixed_into(const Array& r,
+                                             Array& result) const {
+        hestonOp_->apply_mixed_into(r, result);
+        add_integro_into(r, result);
+    }
+
+    inline void FdmBatesOp::apply_direction_into(Size direction,
+                                                 const Array& r,
+                                                 Array& result) const {
+        hestonOp_->apply_direction_into(direction, r, result);
+    }
+
+    inline void FdmBatesOp::solve_splitting_into(Size direction,
+                                                 const Array& r, Real s,
+                                                 Array& result) const {
+        hestonOp_->solve_splitting_into(direction, r, s, result);
+    }
+
+    inline void FdmBatesOp::preconditioner_into(const Array& r, Real s,
+                                                Array& result) const {
+        hestonOp_->preconditioner_into(r, s, result);
+    }
     
 }
 
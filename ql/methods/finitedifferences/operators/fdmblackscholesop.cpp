@@ -21,14 +21,41 @@
 
 #include <ql/instruments/payoffs.hpp>
 #include <ql/math/functional.hpp>
-#include <ql/methods/finitedifferences/meshers/fdmmesher.hpp>
+#include <ql/methods/finitedifferences/meshers/fdmmeshercomposite.hpp>
+#include <ql/methods/finitedifferences/meshers/predefined1dmesher.hpp>
 #include <ql/methods/finitedifferences/operators/fdmblackscholesop.hpp>
 #include <ql/methods/finitedifferences/operators/fdmlinearoplayout.hpp>
 #include <ql/methods/finitedifferences/operators/secondderivativeop.hpp>
+#include <map>
 #include <utility>
 
 namespace QuantLib {
 
+    namespace {
+
+        ext::shared_ptr<FdmMesher> batchLineMesher(
+            const ext::shared_ptr<FdmMesher>& mesher,
+            Size direction, Size strikeDirection) {
+            const std::vector<Size>& dim = mesher->layout()->dim();
+            QL_REQUIRE(dim.size() == 2,
+                       "batch operator requires a two-dimensional mesher");
+            QL_REQUIRE(direction < 2 && strikeDirection < 2
+                       && strikeDirection != direction,
+                       "strike and equity directions must differ");
+
+            const Size stride = mesher->layout()->spacing()[direction];
+            const Array x = mesher->locations(direction);
+
+            std::vector<Real> locations(dim[direction]);
+            for (Size j=0; j < locations.size(); ++j)
+                locations[j] = x[j*stride];
+
+            return ext::make_shared<FdmMesherComposite>(
+                ext::make_shared<Predefined1dMesher>(locations));
+        }
+
+    }
+
     FdmBlackScholesOp::FdmBlackScholesOp(
         const ext::shared_ptr<FdmMesher>& mesher,
         const ext::shared_ptr<GeneralizedBlackScholesProcess>& bsProcess,
@@ -48,26 +75,67 @@ namespace QuantLib {
       illegalLocalVolOverwrite_(illegalLocalVolOverwrite), direction_(direction),
       quantoHelper_(std::move(quantoHelper)) {}
 
-    void FdmBlackScholesOp::setTime(Time t1, Time t2) {
-        const Rate r = rTS_->forwardRate(t1, t2, Continuous).rate();
-        const Rate q = qTS_->forwardRate(t1, t2, Continuous).rate();
-
-        if (localVol_ != nullptr) {
-            Array v(mesher_->layout()->size());
-            for (const auto& iter : *mesher_->layout()) {
-                const Size i = iter.index();
+    FdmBlackScholesOp::FdmBlackScholesOp(
+        const ext::shared_ptr<FdmMesher>& mesher,
+        const ext::shared_ptr<GeneralizedBlackScholesProcess>& bsProcess,
+        std::vector<Real> strikes,
+        Size strikeDirection,
+        bool localVol,
+        Real illegalLocalVolOverwrite,
+        Size direction,
+        ext::shared_ptr<FdmQuantoHelper> quantoHelper)
+    : mesher_(mesher), rTS_(bsProcess->riskFreeRate().currentLink()),
+      qTS_(bsProcess->dividendYield().currentLink()),
+      volTS_(bsProcess->blackVolatility().currentLink()),
+      localVol_((localVol) ? bsProcess->localVolatility().currentLink() :
+                             ext::shared_ptr<LocalVolTermStructure>()),
+      lineMesher_(batchLineMesher(mesher, direction, strikeDirection)),
+      x_((localVol) ? Array(Exp(lineMesher_->locations(0))) : Array()),
+      dxMap_(FirstDerivativeOp(0, lineMesher_)),
+      dxxMap_(SecondDerivativeOp(0, lineMesher_)),
+      mapT_(0, lineMesher_), strike_(Null<Real>()),
+      illegalLocalVolOverwrite_(illegalLocalVolOverwrite), direction_(direction),
+      quantoHelper_(std::move(quantoHelper)), strikes_(std::move(strikes)),
+      lineStride_(mesher->layout()->spacing()[direction]),
+      columnStride_(mesher->layout()->spacing()[strikeDirection]),
+      lineMap_(strikes_.size(), 0),
+      lineMaps_(1, mapT_), lineVariances_(1, Null<Real>()),
+      lineFactorizations_(1),
+      lineIn_(lineMesher_->layout()->size()),
+      lineOut_(lineMesher_->layout()->size()) {
+        QL_REQUIRE(strikes_.size()
+                       == mesher->layout()->dim()[strikeDirection],
+                   "number of strikes (" << strikes_.size()
+                   << ") does not match the grid size ("
+                   << mesher->layout()->dim()[strikeDirection]
+                   << ") along the strike direction");
+    }
 
-                if (illegalLocalVolOverwrite_ < 0.0) {
+    Array FdmBlackScholesOp::localVariance(Time t1, Time t2) const {
+        Array v(x_.size());
+        for (Size i=0; i < v.size(); ++i) {
+            if (illegalLocalVolOverwrite_ < 0.0) {
+                v[i] = squared(localVol_->localVol(0.5*(t1+t2), x_[i], true));
+            }
+            else {
+                try {
                     v[i] = squared(localVol_->localVol(0.5*(t1+t2), x_[i], true));
-                }
-                else {
-                    try {
-                        v[i] = squared(localVol_->localVol(0.5*(t1+t2), x_[i], true));
-                    } catch (Error&) {
-                        v[i] = squared(illegalLocalVolOverwrite_);
-                    }
+                } catch (Error&) {
+                    v[i] = squared(illegalLocalVolOverwrite_);
                 }
             }
+        }
+        return v;
+    }
+
+    void FdmBlackScholesOp::setTime(Time t1, Time t2) {
+        const Rate r = rTS_->forwardRate(t1, t2, Continuous).rate();
+        const Rate q = qTS_->forwardRate(t1, t2, Continuous).rate();
+
+        if (!strikes_.empty()) {
+            setBatchTime(r, q, t1, t2);
+        } else if (localVol_ != nullptr) {
+            const Array v = localVariance(t1, t2);
 
             if (quantoHelper_ != nullptr) {
                 mapT_.axpyb(r - q - 0.5*v
@@ -89,24 +157,106 @@ namespace QuantLib {
                     dxMap_,
                     dxxMap_.mult(0.5*Array(mesher_->layout()->size(), v)),
                     Array(1, -r));
-            } else {
+            } else if (r != r_ || q != q_ || v != v_) {
+                // flat term structures lead to the same operator at
+                // each step; it is only rebuilt if it changed, which
+                // also keeps its cached factorization.
                 mapT_.axpyb(Array(1, r - q - 0.5*v), dxMap_,
                     dxxMap_.mult(0.5*Array(mesher_->layout()->size(), v)),
                     Array(1, -r));
+                r_ = r;
+                q_ = q;
+                v_ = v;
             }
         }
     }
 
+    void FdmBlackScholesOp::setBatchTime(Rate r, Rate q, Time t1, Time t2) {
+        if (localVol_ != nullptr) {
+            // the coefficients do not depend on the strike
+            const Array v = localVariance(t1, t2);
+            std::fill(lineMap_.begin(), lineMap_.end(), 0);
+
+            if (quantoHelper_ != nullptr) {
+                lineMaps_[0].axpyb(r - q - 0.5*v
+                    - quantoHelper_->quantoAdjustment(Sqrt(v), t1, t2),
+                    dxMap_, dxxMap_.mult(0.5*v), Array(1, -r));
+            } else {
+                lineMaps_[0].axpyb(r - q - 0.5*v, dxMap_,
+                                   dxxMap_.mult(0.5*v), Array(1, -r));
+            }
+            return;
+        }
+
+        // options with the same variance share their operator
+        std::map<Real, Size> lines;
+        for (Size k=0; k < strikes_.size(); ++k) {
+            const Real v = volTS_->blackForwardVariance(t1, t2, strikes_[k])
+                / (t2-t1);
+            lineMap_[k] = lines.emplace(v, lines.size()).first->second;
+        }
+
+        while (lineMaps_.size() < lines.size()) {
+            lineMaps_.emplace_back(0, lineMesher_);
+            lineVariances_.push_back(Null<Real>());
+        }
+        lineFactorizations_.resize(lineMaps_.size());
+
+        const Size n = lineMesher_->layout()->size();
+        for (const auto& line : lines) {
+            const Real v = line.first;
+            const Size l = line.second;
+
+            if (quantoHelper_ != nullptr) {
+                lineMaps_[l].axpyb(
+                    Array(1, r - q - 0.5*v)
+                        - quantoHelper_->quantoAdjustment(
+                            Array(1, std::sqrt(v)), t1, t2),
+                    dxMap_, dxxMap_.mult(0.5*Array(n, v)), Array(1, -r));
+            } else if (r != r_ || q != q_ || v != lineVariances_[l]) {
+                // as above, unchanged operators keep their factorization
+                lineMaps_[l].axpyb(Array(1, r - q - 0.5*v), dxMap_,
+                                   dxxMap_.mult(0.5*Array(n, v)),
+                                   Array(1, -r));
+                lineVariances_[l] = v;
+            }
+        }
+        // operators unused at this step may be stale at the next one
+        std::fill(lineVariances_.begin() + lines.size(),
+                  lineVariances_.end(), Null<Real>());
+        r_ = r;
+        q_ = q;
+    }
+
+    void FdmBlackScholesOp::getLine(const Array& r, Size column,
+                                    Array& line) const {
+        const Real* p = r.begin() + column*columnStride_;
+        for (Size j=0; j < line.size(); ++j)
+            line[j] = p[j*lineStride_];
+    }
+
+    void FdmBlackScholesOp::setLine(const Array& line, Size column,
+                                    Array& r) const {
+        Real* p = r.begin() + column*columnStride_;
+        for (Size j=0; j < line.size(); ++j)
+            p[j*lineStride_] = line[j];
+    }
+
     Size FdmBlackScholesOp::size() const { return 1U; }
 
     Array FdmBlackScholesOp::apply(const Array& u) const {
-        return mapT_.apply(u);
+        if (strikes_.empty())
+            return mapT_.apply(u);
+
+        Array retVal(u.size());
+        apply_into(u, retVal);
+        return retVal;
     }
 
     Array FdmBlackScholesOp::apply_direction(Size direction,
                                              const Array& r) const {
         if (direction == direction_)
-            return mapT_.apply(r);
+            return apply(r);
         else {
             return Array(r.size(), 0.0);
         }
@@ -118,8 +268,14 @@ namespace QuantLib {
 
     Array FdmBlackScholesOp::solve_splitting(Size direction,
                                              const Array& r, Real dt) const {
-        if (direction == direction_)
-            return mapT_.solve_splitting(r, dt, 1.0);
+        if (direction == direction_) {
+            if (strikes_.empty())
+                return mapT_.solve_splitting(r, dt, 1.0);
+
+            Array retVal(r.size());
+            solve_splitting_into(direction, r, dt, retVal);
+            return retVal;
+        }
         else {
             return r;
         }
@@ -130,8 +286,85 @@ namespace QuantLib {
         return solve_splitting(direction_, r, dt);
     }
 
+    void FdmBlackScholesOp::apply_into(const Array& r, Array& result) const {
+        if (strikes_.empty()) {
+            mapT_.apply_into(r, result);
+        } else {
+            for (Size k=0; k < strikes_.size(); ++k) {
+                getLine(r, k, lineIn_);
+                lineMaps_[lineMap_[k]].apply_into(lineIn_, lineOut_);
+                setLine(lineOut_, k, result);
+            }
+        }
+    }
+
+    void FdmBlackScholesOp::apply_direction_into(Size direction,
+                                                 const Array& r,
+                                                 Array& result) const {
+        if (direction == direction_)
+            apply_into(r, result);
+        else
+            std::fill(result.begin(), result.end(), 0.0);
+    }
+
+    void FdmBlackScholesOp::apply_mixed_into(const Array&,
+                                             Array& result) const {
+        std::fill(result.begin(), result.end(), 0.0);
+    }
+
+    void FdmBlackScholesOp::solve_splitting_into(Size direction,
+                                                 const Array& r, Real dt,
+                                                 Array& result) const {
+        if (direction != direction_) {
+            std::copy(r.begin(), r.end(), result.begin());
+        } else if (strikes_.empty()) {
+            mapT_.solve_splitting_into(r, result, factorization_, dt, 1.0);
+        } else {
+            // columns sharing an operator also share its factorization
+            for (Size k=0; k < strikes_.size(); ++k) {
+                const Size l = lineMap_[k];
+                getLine(r, k, lineIn_);
+                lineMaps_[l].solve_splitting_into(
+                    lineIn_, lineOut_, lineFactorizations_[l], dt, 1.0);
+                setLine(lineOut_, k, result);
+            }
+        }
+    }
+
+    void FdmBlackScholesOp::preconditioner_into(const Array& r, Real dt,
+                                                Array& result) const {
+        solve_splitting_into(direction_, r, dt, result);
+    }
+
     std::vector<SparseMatrix> FdmBlackScholesOp::toMatrixDecomp() const {
-        return std::vector<SparseMatrix>(1, mapT_.toMatrix());
+        if (strikes_.empty())
+            return std::vector<SparseMatrix>(1, mapT_.toMatrix());
+
+        std::vector<SparseMatrix> lineMatrices;
+        for (const auto& lineMap : lineMaps_)
+            lineMatrices.push_back(lineMap.toMatrix());
+
+        const Size n = mesher_->layout()->size();
+        SparseMatrix retVal(n, n, 3*n);
+        for (Size k=0; k < strikes_.size(); ++k) {
+            const Size offset = k*columnStride_;
+            const SparseMatrix& m = lineMatrices[lineMap_[k]];
+            for (auto row = m.begin1(); row != m.end1(); ++row)
+                for (auto col = row.begin(); col != row.end(); ++col)
+                    retVal(offset + col.index1()*lineStride_,
+                           offset + col.index2()*lineStride_) += *col;
+        }
+
+        return std::vector<SparseMatrix>(1, retVal);
+    }
+
+    std::vector<CompressedSparseMatrix>
+    FdmBlackScholesOp::toCompressedMatrixDecomp() const {
+        if (!strikes_.empty())
+            return FdmLinearOpComposite::toCompressedMatrixDecomp();
+
+        return std::vector<CompressedSparseMatrix>(
+            1, mapT_.toCompressedMatrix());
     }
 
 }
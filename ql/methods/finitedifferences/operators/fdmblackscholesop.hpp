@@ -46,6 +46,28 @@ namespace QuantLib {
             Size direction = 0,
             ext::shared_ptr<FdmQuantoHelper> quantoHelper = ext::shared_ptr<FdmQuantoHelper>());
 
+        /*! operator for a batch of options stacked along the
+            direction strikeDirection of a two-dimensional mesher, the
+            option at coordinate i having strike strikes[i].  Unless a
+            local volatility is used, the variance of each option is
+            taken at its own strike.
+
+            The options whose coefficients coincide at a given time
+            step share a single one-dimensional operator, which is
+            therefore only assembled and factorized once per step.
+            With a local volatility or a volatility independent of the
+            strike, all of them do.
+        */
+        FdmBlackScholesOp(
+            const ext::shared_ptr<FdmMesher>& mesher,
+            const ext::shared_ptr<GeneralizedBlackScholesProcess>& process,
+            std::vector<Real> strikes,
+            Size strikeDirection,
+            bool localVol = false,
+            Real illegalLocalVolOverwrite = -Null<Real>(),
+            Size direction = 0,
+            ext::shared_ptr<FdmQuantoHelper> quantoHelper = ext::shared_ptr<FdmQuantoHelper>());
+
         Size size() const override;
         void setTime(Time t1, Time t2) override;
 
@@ -55,13 +77,33 @@ namespace QuantLib {
         Array solve_splitting(Size direction, const Array& r, Real s) const override;
         Array preconditioner(const Array& r, Real s) const override;
 
+        void apply_into(const Array& r, Array& result) const override;
+        void apply_mixed_into(const Array& r, Array& result) const override;
+        void apply_direction_into(Size direction,
+                                  const Array& r,
+                                  Array& result) const override;
+        void solve_splitting_into(Size direction,
+                                  const Array& r, Real s,
+                                  Array& result) const override;
+        void preconditioner_into(const Array& r, Real s,
+                                 Array& result) const override;
+
         std::vector<SparseMatrix> toMatrixDecomp() const override;
+        std::vector<CompressedSparseMatrix>
+        toCompressedMatrixDecomp() const override;
 
       private:
+        Array localVariance(Time t1, Time t2) const;
+        void setBatchTime(Rate r, Rate q, Time t1, Time t2);
+        void getLine(const Array& r, Size column, Array& line) const;
+        void setLine(const Array& line, Size column, Array& r) const;
+
         const ext::shared_ptr<FdmMesher> mesher_;
         const ext::shared_ptr<YieldTermStructure> rTS_, qTS_;
         const ext::shared_ptr<BlackVolTermStructure> volTS_;
         const ext::shared_ptr<LocalVolTermStructure> localVol_;
+        // single line along the equity direction in batch mode
+        const ext::shared_ptr<FdmMesher> lineMesher_;
         const Array x_;
         const FirstDerivativeOp  dxMap_;
         const TripleBandLinearOp dxxMap_;
@@ -70,6 +112,20 @@ namespace QuantLib {
         const Real illegalLocalVolOverwrite_;
         const Size direction_;
         const ext::shared_ptr<FdmQuantoHelper> quantoHelper_;
+        Real r_ = Null<Real>(), q_ = Null<Real>(), v_ = Null<Real>();
+        // scratch space, not reentrant (see FdmLinearOpComposite)
+        mutable TripleBandLinearOp::SplittingFactorization factorization_;
+
+        // batch mode: column k uses the line operator lineMaps_[lineMap_[k]]
+        const std::vector<Real> strikes_;
+        Size lineStride_ = 0, columnStride_ = 0;
+        std::vector<Size> lineMap_;
+        std::vector<TripleBandLinearOp> lineMaps_;
+        std::vector<Real> lineVariances_;
+        // scratch space, not reentrant (see FdmLinearOpComposite)
+        mutable std::vector<TripleBandLinearOp::SplittingFactorization>
+            lineFactorizations_;
+        mutable Array lineIn_, lineOut_;
     };
 }
 
@@ -52,7 +52,8 @@ namespace QuantLib {
                           model->rho()*model->sigma()*model->eta()))),
       mapX_(direction1, mesher),
       mapY_(direction2, mesher),
-      model_(model) {
+      model_(model),
+      work_(mesher->layout()->size()) {
     }
 
     Size FdmG2Op::size() const { return 2U; }
@@ -106,6 +107,43 @@ namespace QuantLib {
         return solve_splitting(direction1_, r, dt);
     }
 
+    void FdmG2Op::apply_into(const Array& r, Array& result) const {
+        mapX_.apply_into(r, result);
+        mapY_.apply_into(r, work_);
+        result += work_;
+        corrMap_.apply_into(r, work_);
+        result += work_;
+    }
+
+    void FdmG2Op::apply_mixed_into(const Array& r, Array& result) const {
+        corrMap_.apply_into(r, result);
+    }
+
+    void FdmG2Op::apply_direction_into(Size direction, const Array& r,
+                                       Array& result) const {
+        if (direction == direction1_)
+            mapX_.apply_into(r, result);
+        else if (direction == direction2_)
+            mapY_.apply_into(r, result);
+        else
+            std::fill(result.begin(), result.end(), 0.0);
+    }
+
+    void FdmG2Op::solve_splitting_into(Size direction, const Array& r,
+                                       Real a, Array& result) const {
+        if (direction == direction1_)
+            mapX_.solve_splitting_into(r, result, xFactorization_, a, 1.0);
+        else if (direction == direction2_)
+            mapY_.solve_splitting_into(r, result, yFactorization_, a, 1.0);
+        else
+            std::fill(result.begin(), result.end(), 0.0);
+    }
+
+    void FdmG2Op::preconditioner_into(const Array& r, Real dt,
+                                      Array& result) const {
+        solve_splitting_into(direction1_, r, dt, result);
+    }
+
     std::vector<SparseMatrix> FdmG2Op::toMatrixDecomp() const {
         return {
             mapX_.toMatrix(),
@@ -50,6 +50,17 @@ namespace QuantLib {
         Array solve_splitting(Size direction, const Array& r, Real s) const override;
         Array preconditioner(const Array& r, Real s) const override;
 
+        void apply_into(const Array& r, Array& result) const override;
+        void apply_mixed_into(const Array& r, Array& result) const override;
+        void apply_direction_into(Size direction,
+                                  const Array& r,
+                                  Array& result) const override;
+        void solve_splitting_into(Size direction,
+                                  const Array& r, Real s,
+                                  Array& result) const override;
+        void preconditioner_into(const Array& r, Real s,
+                                 Array& result) const override;
+
         std::vector<SparseMatrix> toMatrixDecomp() const override;
 
       private:
@@ -61,6 +72,9 @@ namespace QuantLib {
         TripleBandLinearOp mapX_, mapY_;
 
         const ext::shared_ptr<G2> model_;
+        // scratch space, not reentrant (see FdmLinearOpComposite)
+        mutable Array work_;
+        mutable TripleBandLinearOp::SplittingFactorization xFactorization_, yFactorization_;
     };
 }
 
@@ -83,7 +83,8 @@ namespace QuantLib {
                  .mult(0.5 * sigma_ * sigma_ * mesher->locations(1))
                  .add(FirstDerivativeOp(1, mesher).mult(kappa_ * (theta_ - mesher->locations(1))))),
       dxMap_(mesher, hwModel_, hestonProcess->dividendYield().currentLink()),
-      hullWhiteOp_(mesher, hwModel_, 2) {
+      hullWhiteOp_(mesher, hwModel_, 2),
+      work_(mesher->layout()->size()) {
 
         QL_REQUIRE(  equityShortRateCorrelation*equityShortRateCorrelation
                    + hestonProcess->rho()*hestonProcess->rho() <= 1.0,
@@ -141,6 +142,57 @@ namespace QuantLib {
         return solve_splitting(0, r, dt);
     }
 
+    void FdmHestonHullWhiteOp::apply_into(const Array& u,
+                                          Array& result) const {
+        dyMap_.apply_into(u, result);
+        dxMap_.getMap().apply_into(u, work_);
+        result += work_;
+        hullWhiteOp_.apply_into(u, work_);
+        result += work_;
+        hestonCorrMap_.apply_into(u, work_);
+        result += work_;
+        equityIrCorrMap_.apply_into(u, work_);
+        result += work_;
+    }
+
+    void FdmHestonHullWhiteOp::apply_direction_into(Size direction,
+                                                    const Array& r,
+                                                    Array& result) const {
+        if (direction == 0)
+            dxMap_.getMap().apply_into(r, result);
+        else if (direction == 1)
+            dyMap_.apply_into(r, result);
+        else if (direction == 2)
+            hullWhiteOp_.apply_into(r, result);
+        else
+            QL_FAIL("direction too large");
+    }
+
+    void FdmHestonHullWhiteOp::apply_mixed_into(const Array& r,
+                                                Array& result) const {
+        hestonCorrMap_.apply_into(r, result);
+        equityIrCorrMap_.apply_into(r, work_);
+        result += work_;
+    }
+
+    void FdmHestonHullWhiteOp::solve_splitting_into(Size direction,
+                                                    const Array& r, Real a,
+                                                    Array& result) const {
+        if (direction == 0)
+            dxMap_.getMap().solve_splitting_into(r, result, xFactorization_, a, 1.0);
+        else if (direction == 1)
+            dyMap_.solve_splitting_into(r, result, yFactorization_, a, 1.0);
+        else if (direction == 2)
+            hullWhiteOp_.solve_splitting_into(2, r, a, result);
+        else
+            QL_FAIL("direction too large");
+    }
+
+    void FdmHestonHullWhiteOp::preconditioner_into(const Array& r, Real dt,
+                                                   Array& result) const {
+        solve_splitting_into(0, r, dt, result);
+    }
+
     std::vector<SparseMatrix> FdmHestonHullWhiteOp::toMatrixDecomp() const {
         return {
             dxMap_.getMap().toMatrix(),
@@ -150,4 +202,15 @@ namespace QuantLib {
         };
     }
 
+    std::vector<CompressedSparseMatrix>
+    FdmHestonHullWhiteOp::toCompressedMatrixDecomp() const {
+        return {
+            dxMap_.getMap().toCompressedMatrix(),
+            dyMap_.toCompressedMatrix(),
+            hullWhiteOp_.toCompressedMatrixDecomp().front(),
+            hestonCorrMap_.toCompressedMatrix()
+                + equityIrCorrMap_.toCompressedMatrix()
+        };
+    }
+
 }
@@ -77,7 +77,20 @@ namespace QuantLib {
         Array solve_splitting(Size direction, const Array& r, Real s) const override;
         Array preconditioner(const Array& r, Real s) const override;
 
+        void apply_into(const Array& r, Array& result) const override;
+        void apply_mixed_into(const Array& r, Array& result) const override;
+        void apply_direction_into(Size direction,
+                                  const Array& r,
+                                  Array& result) const override;
+        void solve_splitting_into(Size direction,
+                                  const Array& r, Real s,
+                                  Array& result) const override;
+        void preconditioner_into(const Array& r, Real s,
+                                 Array& result) const override;
+
         std::vector<SparseMatrix> toMatrixDecomp() const override;
+        std::vector<CompressedSparseMatrix>
+        toCompressedMatrixDecomp() const override;
 
       private:
         const Real v0_, kappa_, theta_, sigma_, rho_;
@@ -88,6 +101,9 @@ namespace QuantLib {
         TripleBandLinearOp dyMap_;
         FdmHestonHullWhiteEquityPart dxMap_;
         FdmHullWhiteOp hullWhiteOp_;
+        // scratch space, not reentrant (see FdmLinearOpComposite)
+        mutable Array work_;
+        mutable TripleBandLinearOp::SplittingFactorization xFactorization_, yFactorization_;
     };
 }
 
@@ -136,7 +136,8 @@ namespace QuantLib {
       dxMap_(mesher,
              hestonProcess->riskFreeRate().currentLink(), 
              hestonProcess->dividendYield().currentLink(),
-             quantoHelper, leverageFct) {
+             quantoHelper, leverageFct),
+      work_(mesher->layout()->size()) {
     }
 
 
@@ -185,6 +186,51 @@ namespace QuantLib {
         return solve_splitting(1, solve_splitting(0, r, dt), dt) ;
     }
 
+    void FdmHestonOp::apply_into(const Array& u, Array& result) const {
+        dyMap_.getMap().apply_into(u, result);
+        dxMap_.getMap().apply_into(u, work_);
+        result += work_;
+        correlationMap_.apply_into(u, work_);
+        const Array& L = dxMap_.getL();
+        for (Size i=0; i < result.size(); ++i)
+            result[i] += L[i]*work_[i];
+    }
+
+    void FdmHestonOp::apply_direction_into(Size direction,
+                                           const Array& r,
+                                           Array& result) const {
+        if (direction == 0)
+            dxMap_.getMap().apply_into(r, result);
+        else if (direction == 1)
+            dyMap_.getMap().apply_into(r, result);
+        else
+            QL_FAIL("direction too large");
+    }
+
+    void FdmHestonOp::apply_mixed_into(const Array& r, Array& result) const {
+        correlationMap_.apply_into(r, result);
+        const Array& L = dxMap_.getL();
+        for (Size i=0; i < result.size(); ++i)
+            result[i] = L[i]*result[i];
+    }
+
+    void FdmHestonOp::solve_splitting_into(Size direction,
+                                           const Array& r, Real a,
+                                           Array& result) const {
+        if (direction == 0)
+            dxMap_.getMap().solve_splitting_into(r, result, xFactorization_, a, 1.0);
+        else if (direction == 1)
+            dyMap_.getMap().solve_splitting_into(r, result, yFactorization_, a, 1.0);
+        else
+            QL_FAIL("direction too large");
+    }
+
+    void FdmHestonOp::preconditioner_into(const Array& r, Real dt,
+                                          Array& result) const {
+        solve_splitting_into(0, r, dt, work_);
+        solve_splitting_into(1, work_, dt, result);
+    }
+
     std::vector<SparseMatrix> FdmHestonOp::toMatrixDecomp() const {
         return {
             dxMap_.getMap().toMatrix(),
@@ -193,4 +239,13 @@ namespace QuantLib {
         };
     }
 
+    std::vector<CompressedSparseMatrix>
+    FdmHestonOp::toCompressedMatrixDecomp() const {
+        return {
+            dxMap_.getMap().toCompressedMatrix(),
+            dyMap_.getMap().toCompressedMatrix(),
+            correlationMap_.toCompressedMatrix()
+        };
+    }
+
 }
@@ -85,9 +85,47 @@ namespace QuantLib {
         return solve_splitting(direction_, r, dt);
     }
 
+    void FdmHullWhiteOp::apply_into(const Array& r, Array& result) const {
+        mapT_.apply_into(r, result);
+    }
+
+    void FdmHullWhiteOp::apply_mixed_into(const Array&,
+                                          Array& result) const {
+        std::fill(result.begin(), result.end(), 0.0);
+    }
+
+    void FdmHullWhiteOp::apply_direction_into(Size direction,
+                                              const Array& r,
+                                              Array& result) const {
+        if (direction == direction_)
+            mapT_.apply_into(r, result);
+        else
+            std::fill(result.begin(), result.end(), 0.0);
+    }
+
+    void FdmHullWhiteOp::solve_splitting_into(Size direction,
+                                              const Array& r, Real a,
+                                              Array& result) const {
+        if (direction == direction_)
+            mapT_.solve_splitting_into(r, result, factorization_, a, 1.0);
+        else
+            std::fill(result.begin(), result.end(), 0.0);
+    }
+
+    void FdmHullWhiteOp::preconditioner_into(const Array& r, Real dt,
+                                             Array& result) const {
+        solve_splitting_into(direction_, r, dt, result);
+    }
+
     std::vector<SparseMatrix> FdmHullWhiteOp::toMatrixDecomp() const {
         return std::vector<SparseMatrix>(1, mapT_.toMatrix());
     }
 
+    std::vector<CompressedSparseMatrix>
+    FdmHullWhiteOp::toCompressedMatrixDecomp() const {
+        return std::vector<CompressedSparseMatrix>(
+            1, mapT_.toCompressedMatrix());
+    }
+
 }
 
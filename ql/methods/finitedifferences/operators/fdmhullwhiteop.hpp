@@ -51,7 +51,20 @@ namespace QuantLib {
         Array solve_splitting(Size direction, const Array& r, Real s) const override;
         Array preconditioner(const Array& r, Real s) const override;
 
+        void apply_into(const Array& r, Array& result) const override;
+        void apply_mixed_into(const Array& r, Array& result) const override;
+        void apply_direction_into(Size direction,
+                                  const Array& r,
+                                  Array& result) const override;
+        void solve_splitting_into(Size direction,
+                                  const Array& r, Real s,
+                                  Array& result) const override;
+        void preconditioner_into(const Array& r, Real s,
+                                 Array& result) const override;
+
         std::vector<SparseMatrix> toMatrixDecomp() const override;
+        std::vector<CompressedSparseMatrix>
+        toCompressedMatrixDecomp() const override;
 
       private:
         const Size direction_;
@@ -59,6 +72,8 @@ namespace QuantLib {
         const TripleBandLinearOp dzMap_;
         TripleBandLinearOp mapT_;
         const ext::shared_ptr<HullWhite> model_;
+        // scratch space, not reentrant (see FdmLinearOpComposite)
+        mutable TripleBandLinearOp::SplittingFactorization factorization_;
     };
 }
 
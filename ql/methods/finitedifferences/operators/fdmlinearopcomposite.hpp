@@ -45,6 +45,45 @@ namespace QuantLib {
         virtual Array solve_splitting(Size direction, const Array& r, Real s) const = 0;
         virtual Array preconditioner(const Array& r, Real s) const = 0;
 
+        //! \name Allocation-free interface
+        /*! The following methods write their results into an array
+            provided by the caller, which must have the same size as
+            the input and must not be the input array itself.
+
+            The default implementations forward the calls to the
+            methods above; operators used in performance-critical code
+            override them, using persistent scratch space, so that no
+            heap allocation takes place during a time step.
+
+            \warning operators keeping scratch space or tridiagonal
+                     factorizations as mutable members are not
+                     reentrant, even through their const methods: a
+                     single instance must not be used by several
+                     threads at the same time.
+        */
+        //@{
+        virtual void apply_into(const Array& r, Array& result) const {
+            result = apply(r);
+        }
+        virtual void apply_mixed_into(const Array& r, Array& result) const {
+            result = apply_mixed(r);
+        }
+        virtual void apply_direction_into(Size direction,
+                                          const Array& r,
+                                          Array& result) const {
+            result = apply_direction(direction, r);
+        }
+        virtual void solve_splitting_into(Size direction,
+                                          const Array& r, Real s,
+                                          Array& result) const {
+            result = solve_splitting(direction, r, s);
+        }
+        virtual void preconditioner_into(const Array& r, Real s,
+                                         Array& result) const {
+            result = preconditioner(r, s);
+        }
+        //@}
+
         virtual std::vector<SparseMatrix> toMatrixDecomp() const {
             QL_FAIL(" ublas representation is not implemented");
         }
@@ -55,6 +94,19 @@ namespace QuantLib {
                                    SparseMatrix(dcmp.front()));
         }
 
+        virtual std::vector<CompressedSparseMatrix>
+        toCompressedMatrixDecomp() const {
+            const std::vector<SparseMatrix> dcmp = toMatrixDecomp();
+            return std::vector<CompressedSparseMatrix>(dcmp.begin(),
+                                                       dcmp.end());
+        }
+
+        CompressedSparseMatrix toCompressedMatrix() const override {
+            const std::vector<CompressedSparseMatrix> dcmp
+                = toCompressedMatrixDecomp();
+            return std::accumulate(dcmp.begin()+1, dcmp.end(), dcmp.front());
+        }
+
     };
 }
 
@@ -20,6 +20,9 @@
 */
 
 #include <ql/methods/finitedifferences/operators/fdmlinearoplayout.hpp>
+#include <ql/errors.hpp>
+#include <algorithm>
+#include <numeric>
 
 namespace QuantLib {
 
@@ -84,4 +87,35 @@ namespace QuantLib {
                                    index(coordinates));
     }
 
+    const ext::shared_ptr<const FdmLinearOpLayout::Neighbours>&
+    FdmLinearOpLayout::neighbours(Size direction) const {
+        QL_REQUIRE(direction < dim_.size(), "direction too large");
+
+        std::call_once(neighbours_->initialized[direction], [&]() {
+            std::vector<Size> newDim(dim_);
+            std::iter_swap(newDim.begin(), newDim.begin()+direction);
+            std::vector<Size> newSpacing = FdmLinearOpLayout(newDim).spacing();
+            std::iter_swap(newSpacing.begin(), newSpacing.begin()+direction);
+
+            auto n = ext::make_shared<Neighbours>();
+            n->lower.resize(size_);
+            n->upper.resize(size_);
+            n->reverseIndex.resize(size_);
+            for (const auto& iter : *this) {
+                const Size i = iter.index();
+                n->lower[i] = neighbourhood(iter, direction, -1);
+                n->upper[i] = neighbourhood(iter, direction,  1);
+
+                const std::vector<Size>& coordinates = iter.coordinates();
+                const Size newIndex =
+                    std::inner_product(coordinates.begin(), coordinates.end(),
+                                       newSpacing.begin(), Size(0));
+                n->reverseIndex[newIndex] = i;
+            }
+            neighbours_->tables[direction] = n;
+        });
+
+        return neighbours_->tables[direction];
+    }
+
 }
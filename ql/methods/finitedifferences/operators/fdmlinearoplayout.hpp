@@ -27,14 +27,18 @@
 #define quantlib_linear_op_layout_hpp
 
 #include <ql/methods/finitedifferences/operators/fdmlinearopiterator.hpp>
+#include <ql/shared_ptr.hpp>
 #include <functional>
+#include <memory>
+#include <mutex>
 
 namespace QuantLib {
 
     class FdmLinearOpLayout {
       public:
         explicit FdmLinearOpLayout(std::vector<Size> dim)
-        : dim_(std::move(dim)), spacing_(dim_.size()) {
+        : dim_(std::move(dim)), spacing_(dim_.size()),
+          neighbours_(ext::make_shared<NeighbourCache>(dim_.size())) {
             spacing_[0] = 1;
             std::partial_sum(dim_.begin(), dim_.end()-1,
                 spacing_.begin()+1, std::multiplies<>());
@@ -79,9 +83,31 @@ namespace QuantLib {
         FdmLinearOpIterator iter_neighbourhood(
             const FdmLinearOpIterator& iterator, Size i, Integer offset) const;
 
+        //! indices of the lower and upper neighbours along a direction
+        /*! reverseIndex maps the position of a point in the ordering
+            having the given direction as fastest-changing index to its
+            index in this layout.
+        */
+        struct Neighbours {
+            std::vector<Size> lower, upper, reverseIndex;
+        };
+        /*! The tables are calculated on first use and shared by all
+            operators built on this layout and on its copies. It is
+            safe to call this method from several threads.
+        */
+        const ext::shared_ptr<const Neighbours>& neighbours(Size direction) const;
+
       private:
         Size size_;
         std::vector<Size> dim_, spacing_;
+
+        struct NeighbourCache {
+            explicit NeighbourCache(Size n)
+            : initialized(new std::once_flag[n]), tables(n) {}
+            std::unique_ptr<std::once_flag[]> initialized;
+            std::vector<ext::shared_ptr<const Neighbours> > tables;
+        };
+        ext::shared_ptr<NeighbourCache> neighbours_;
     };
 }
 
@@ -31,6 +31,32 @@ namespace QuantLib {
 
     class ModTripleBandLinearOp : public TripleBandLinearOp {
       public:
+        //! reference to a coefficient
+        /*! Writing through it drops cached factorizations of the
+            operator, reading does not.
+        */
+        class Coefficient {
+          public:
+            operator Real() const { return value_; }
+            Coefficient& operator=(Real x) {
+                op_.invalidateFactorization();
+                value_ = x;
+                return *this;
+            }
+            Coefficient& operator=(const Coefficient& c) {
+                return *this = Real(c);
+            }
+            Coefficient& operator+=(Real x) { return *this = value_ + x; }
+            Coefficient& operator-=(Real x) { return *this = value_ - x; }
+            Coefficient& operator*=(Real x) { return *this = value_ * x; }
+          private:
+            friend class ModTripleBandLinearOp;
+            Coefficient(ModTripleBandLinearOp& op, Real& value)
+            : op_(op), value_(value) {}
+            ModTripleBandLinearOp& op_;
+            Real& value_;
+        };
+
         ModTripleBandLinearOp(Size direction,
                               const ext::shared_ptr<FdmMesher>& mesher)
         : TripleBandLinearOp(direction, mesher) { }
@@ -39,11 +65,24 @@ namespace QuantLib {
         : TripleBandLinearOp(m) { }
 
         Real lower(Size i) const { return lower_[i]; }
-        Real& lower(Size i) { return lower_[i]; }
+        Coefficient lower(Size i) { return {*this, lower_[i]}; }
         Real diag(Size i) const { return diag_[i]; }
-        Real& diag(Size i) { return diag_[i]; }
+        Coefficient diag(Size i) { return {*this, diag_[i]}; }
         Real upper(Size i) const { return upper_[i]; }
-        Real& upper(Size i) { return upper_[i]; }
+        Coefficient upper(Size i) { return {*this, upper_[i]}; }
+
+        void setLower(Size i, Real value) {
+            invalidateFactorization();
+            lower_[i] = value;
+        }
+        void setDiag(Size i, Real value) {
+            invalidateFactorization();
+            diag_[i] = value;
+        }
+        void setUpper(Size i, Real value) {
+            invalidateFactorization();
+            upper_[i] = value;
+        }
     };
 }
 
@@ -108,11 +108,17 @@ namespace QuantLib {
     }
 
     Array NinePointLinearOp::apply(const Array& u) const {
+        Array retVal(u.size());
+        apply_into(u, retVal);
+        return retVal;
+    }
+
+    void NinePointLinearOp::apply_into(const Array& u, Array& retVal) const {
 
         QL_REQUIRE(u.size() == mesher_->layout()->size(),"inconsistent length of r "
                     << u.size() << " vs " << mesher_->layout()->size());
+        QL_REQUIRE(retVal.size() == u.size(), "inconsistent length of result");
 
-        Array retVal(u.size());
         // direct access to make the following code faster.
         const Real *a00(a00_.get()), *a01(a01_.get()), *a02(a02_.get());
         const Real *a10(a10_.get()), *a11(a11_.get()), *a12(a12_.get());
@@ -121,8 +127,8 @@ namespace QuantLib {
         const Size *i10(i10_.get()),                   *i12(i12_.get());
         const Size *i20(i20_.get()), *i21(i21_.get()), *i22(i22_.get());
 
-        //#pragma omp parallel for
-        for (Size i=0; i < retVal.size(); ++i) {
+        #pragma omp parallel for
+        for (long i=0; i < (long)retVal.size(); ++i) {
             retVal[i] =   a00[i]*u[i00[i]]
                         + a01[i]*u[i01[i]]
                         + a02[i]*u[i02[i]]
@@ -133,26 +139,30 @@ namespace QuantLib {
                         + a21[i]*u[i21[i]]
                         + a22[i]*u[i22[i]];
         }
-        return retVal;
     }
 
     SparseMatrix NinePointLinearOp::toMatrix() const {
+        return toCompressedMatrix().toSparseMatrix();
+    }
+
+    CompressedSparseMatrix NinePointLinearOp::toCompressedMatrix() const {
         const Size n = mesher_->layout()->size();
 
-        SparseMatrix retVal(n, n, 9*n);
-        for (Size i=0; i < mesher_->layout()->size(); ++i) {
-            retVal(i, i00_[i]) += a00_[i];
-            retVal(i, i01_[i]) += a01_[i];
-            retVal(i, i02_[i]) += a02_[i];
-            retVal(i, i10_[i]) += a10_[i];
-            retVal(i, i      ) += a11_[i];
-            retVal(i, i12_[i]) += a12_[i];
-            retVal(i, i20_[i]) += a20_[i];
-            retVal(i, i21_[i]) += a21_[i];
-            retVal(i, i22_[i]) += a22_[i];
+        std::vector<CompressedSparseMatrix::Triplet> triplets;
+        triplets.reserve(9*n);
+        for (Size i=0; i < n; ++i) {
+            triplets.push_back({i, i00_[i], a00_[i]});
+            triplets.push_back({i, i01_[i], a01_[i]});
+            triplets.push_back({i, i02_[i], a02_[i]});
+            triplets.push_back({i, i10_[i], a10_[i]});
+            triplets.push_back({i, i,       a11_[i]});
+            triplets.push_back({i, i12_[i], a12_[i]});
+            triplets.push_back({i, i20_[i], a20_[i]});
+            triplets.push_back({i, i21_[i], a21_[i]});
+            triplets.push_back({i, i22_[i], a22_[i]});
         }
 
-        return retVal;
+        return CompressedSparseMatrix(n, n, triplets);
     }
 
 
@@ -45,11 +45,14 @@ namespace QuantLib {
         ~NinePointLinearOp() override = default;
 
         Array apply(const Array& r) const override;
+        //! result must not be the same array as r
+        void apply_into(const Array& r, Array& result) const;
         NinePointLinearOp mult(const Array& u) const;
 
         void swap(NinePointLinearOp& m) noexcept;
 
         SparseMatrix toMatrix() const override;
+        CompressedSparseMatrix toCompressedMatrix() const override;
 
       protected:
         NinePointLinearOp() = default;
@@ -24,54 +24,39 @@
 #include <ql/methods/finitedifferences/tridiagonaloperator.hpp>
 #include <ql/methods/finitedifferences/operators/fdmlinearoplayout.hpp>
 #include <ql/methods/finitedifferences/operators/triplebandlinearop.hpp>
+#include <atomic>
 
 namespace QuantLib {
 
+    namespace {
+
+        Size newCoefficientsId() {
+            static std::atomic<Size> counter(0);
+            return ++counter;
+        }
+
+    }
+
     TripleBandLinearOp::TripleBandLinearOp(
         Size direction,
         const ext::shared_ptr<FdmMesher>& mesher)
     : direction_(direction),
-      i0_       (new Size[mesher->layout()->size()]),
-      i2_       (new Size[mesher->layout()->size()]),
-      reverseIndex_ (new Size[mesher->layout()->size()]),
+      neighbours_(mesher->layout()->neighbours(direction)),
       lower_    (new Real[mesher->layout()->size()]),
       diag_     (new Real[mesher->layout()->size()]),
       upper_    (new Real[mesher->layout()->size()]),
-      mesher_(mesher) {
-
-        std::vector<Size> newDim(mesher->layout()->dim());
-        std::iter_swap(newDim.begin(), newDim.begin()+direction_);
-        std::vector<Size> newSpacing = FdmLinearOpLayout(newDim).spacing();
-        std::iter_swap(newSpacing.begin(), newSpacing.begin()+direction_);
-
-        for (const auto& iter : *mesher->layout()) {
-            const Size i = iter.index();
-
-            i0_[i] = mesher->layout()->neighbourhood(iter, direction, -1);
-            i2_[i] = mesher->layout()->neighbourhood(iter, direction,  1);
-
-            const std::vector<Size>& coordinates = iter.coordinates();
-            const Size newIndex =
-                  std::inner_product(coordinates.begin(), coordinates.end(),
-                                     newSpacing.begin(), Size(0));
-            reverseIndex_[newIndex] = i;
-        }
-    }
+      mesher_(mesher),
+      coefficients_(newCoefficientsId()) {}
 
     TripleBandLinearOp::TripleBandLinearOp(const TripleBandLinearOp& m)
     : direction_(m.direction_),
-      i0_   (new Size[m.mesher_->layout()->size()]),
-      i2_   (new Size[m.mesher_->layout()->size()]),
-      reverseIndex_(new Size[m.mesher_->layout()->size()]),
+      neighbours_(m.neighbours_),
       lower_(new Real[m.mesher_->layout()->size()]),
       diag_ (new Real[m.mesher_->layout()->size()]),
       upper_(new Real[m.mesher_->layout()->size()]),
-      mesher_(m.mesher_) {
+      mesher_(m.mesher_),
+      coefficients_(m.coefficients_) {
         const Size len = m.mesher_->layout()->size();
-        std::copy(m.i0_.get(), m.i0_.get() + len, i0_.get());
-        std::copy(m.i2_.get(), m.i2_.get() + len, i2_.get());
-        std::copy(m.reverseIndex_.get(), m.reverseIndex_.get()+len,
-                  reverseIndex_.get());
         std::copy(m.lower_.get(), m.lower_.get() + len, lower_.get());
         std::copy(m.diag_.get(),  m.diag_.get() + len,  diag_.get());
         std::copy(m.upper_.get(), m.upper_.get() + len, upper_.get());
@@ -81,9 +66,14 @@ namespace QuantLib {
         mesher_.swap(m.mesher_);
         std::swap(direction_, m.direction_);
 
-        i0_.swap(m.i0_); i2_.swap(m.i2_);
-        reverseIndex_.swap(m.reverseIndex_);
+        neighbours_.swap(m.neighbours_);
         lower_.swap(m.lower_); diag_.swap(m.diag_); upper_.swap(m.upper_);
+
+        std::swap(coefficients_, m.coefficients_);
+    }
+
+    void TripleBandLinearOp::invalidateFactorization() {
+        coefficients_ = newCoefficientsId();
     }
 
     void TripleBandLinearOp::axpyb(const Array& a,
@@ -100,23 +90,30 @@ namespace QuantLib {
         const Real *y_lower(y.lower_.get());
         const Real *y_upper(y.upper_.get());
 
+        // operators are typically rebuilt by setTime at every step;
+        // factorizations stay valid if the coefficients did not
+        // change, i.e., if the operator is time-homogeneous.
+        bool changed = false;
+        const auto assign = [&](Real& target, Real value) {
+            changed = changed || (target != value);
+            target = value;
+        };
+
         if (a.empty()) {
             if (b.empty()) {
-                //#pragma omp parallel for
                 for (Size i=0; i < size; ++i) {
-                    diag[i]  = y_diag[i];
-                    lower[i] = y_lower[i];
-                    upper[i] = y_upper[i];
+                    assign(diag[i],  y_diag[i]);
+                    assign(lower[i], y_lower[i]);
+                    assign(upper[i], y_upper[i]);
                 }
             }
             else {
                 Array::const_iterator bptr(b.begin());
                 const Size binc = (b.size() > 1) ? 1 : 0;
-                //#pragma omp parallel for
                 for (Size i=0; i < size; ++i) {
-                    diag[i]  = y_diag[i] + bptr[i*binc];
-                    lower[i] = y_lower[i];
-                    upper[i] = y_upper[i];
+                    assign(diag[i],  y_diag[i] + bptr[i*binc]);
+                    assign(lower[i], y_lower[i]);
+                    assign(upper[i], y_upper[i]);
                 }
             }
         }
@@ -128,12 +125,11 @@ namespace QuantLib {
             const Real *x_lower(x.lower_.get());
             const Real *x_upper(x.upper_.get());
 
-            //#pragma omp parallel for
             for (Size i=0; i < size; ++i) {
                 const Real s = aptr[i*ainc];
-                diag[i]  = y_diag[i]  + s*x_diag[i];
-                lower[i] = y_lower[i] + s*x_lower[i];
-                upper[i] = y_upper[i] + s*x_upper[i];
+                assign(diag[i],  y_diag[i]  + s*x_diag[i]);
+                assign(lower[i], y_lower[i] + s*x_lower[i]);
+                assign(upper[i], y_upper[i] + s*x_upper[i]);
             }
         }
         else {
@@ -147,14 +143,16 @@ namespace QuantLib {
             const Real *x_lower(x.lower_.get());
             const Real *x_upper(x.upper_.get());
 
-            //#pragma omp parallel for
             for (Size i=0; i < size; ++i) {
                 const Real s = aptr[i*ainc];
-                diag[i]  = y_diag[i]  + s*x_diag[i] + bptr[i*binc];
-                lower[i] = y_lower[i] + s*x_lower[i];
-                upper[i] = y_upper[i] + s*x_upper[i];
+                assign(diag[i],  y_diag[i]  + s*x_diag[i] + bptr[i*binc]);
+                assign(lower[i], y_lower[i] + s*x_lower[i]);
+                assign(upper[i], y_upper[i] + s*x_upper[i]);
             }
         }
+
+        if (changed)
+            invalidateFactorization();
     }
 
     TripleBandLinearOp TripleBandLinearOp::add(const TripleBandLinearOp& m) const {
@@ -222,39 +220,57 @@ namespace QuantLib {
     }
 
     Array TripleBandLinearOp::apply(const Array& r) const {
+        array_type retVal(r.size());
+        apply_into(r, retVal);
+        return retVal;
+    }
+
+    void TripleBandLinearOp::apply_into(const Array& r, Array& retVal) const {
         QL_REQUIRE(r.size() == mesher_->layout()->size(), "inconsistent length of r");
+        QL_REQUIRE(retVal.size() == r.size(), "inconsistent length of result");
 
         const Real* lptr = lower_.get();
         const Real* dptr = diag_.get();
         const Real* uptr = upper_.get();
-        const Size* i0ptr = i0_.get();
-        const Size* i2ptr = i2_.get();
+        const Size* i0ptr = neighbours_->lower.data();
+        const Size* i2ptr = neighbours_->upper.data();
 
-        array_type retVal(r.size());
-        //#pragma omp parallel for
-        for (Size i=0; i < mesher_->layout()->size(); ++i) {
+        #pragma omp parallel for
+        for (long i=0; i < (long)mesher_->layout()->size(); ++i) {
             retVal[i] = r[i0ptr[i]]*lptr[i]+r[i]*dptr[i]+r[i2ptr[i]]*uptr[i];
         }
-
-        return retVal;
     }
 
     SparseMatrix TripleBandLinearOp::toMatrix() const {
+        return toCompressedMatrix().toSparseMatrix();
+    }
+
+    CompressedSparseMatrix TripleBandLinearOp::toCompressedMatrix() const {
         const Size n = mesher_->layout()->size();
 
-        SparseMatrix retVal(n, n, 3*n);
+        std::vector<CompressedSparseMatrix::Triplet> triplets(3*n);
         for (Size i=0; i < n; ++i) {
-            retVal(i, i0_[i]) += lower_[i];
-            retVal(i, i     ) += diag_[i];
-            retVal(i, i2_[i]) += upper_[i];
+            triplets[3*i  ] = {i, neighbours_->lower[i], lower_[i]};
+            triplets[3*i+1] = {i, i, diag_[i]};
+            triplets[3*i+2] = {i, neighbours_->upper[i], upper_[i]};
         }
 
-        return retVal;
+        return CompressedSparseMatrix(n, n, triplets);
     }
 
 
     Array TripleBandLinearOp::solve_splitting(const Array& r, Real a, Real b) const {
+        Array retVal(r.size());
+        SplittingFactorization factorization;
+        solve_splitting_into(r, retVal, factorization, a, b);
+        return retVal;
+    }
+
+    void TripleBandLinearOp::solve_splitting_into(
+        const Array& r, Array& retVal,
+        SplittingFactorization& factorization, Real a, Real b) const {
         QL_REQUIRE(r.size() == mesher_->layout()->size(), "inconsistent size of rhs");
+        QL_REQUIRE(retVal.size() == r.size(), "inconsistent size of result");
 
 #ifdef QL_EXTRA_SAFETY_CHECKS
         for (const auto& iter : *mesher_->layout()) {
@@ -266,8 +282,6 @@ namespace QuantLib {
         }
 #endif
 
-        Array retVal(r.size()), tmp(r.size());
-
         const Real* lptr = lower_.get();
         const Real* dptr = diag_.get();
         const Real* uptr = upper_.get();
@@ -275,27 +289,98 @@ namespace QuantLib {
         // Thomson algorithm to solve a tridiagonal system.
         // Example code taken from Tridiagonalopertor and
         // changed to fit for the triple band operator.
-        Size rim1 = reverseIndex_[0];
-        Real bet=1.0/(a*dptr[rim1]+b);
-        QL_REQUIRE(bet != 0.0, "division by zero");
-        retVal[reverseIndex_[0]] = r[rim1]*bet;
-
-        for (Size j=1; j<=mesher_->layout()->size()-1; j++){
-            const Size ri = reverseIndex_[j];
-            tmp[j] = a*uptr[rim1]*bet;
-
-            bet=b+a*(dptr[ri]-tmp[j]*lptr[ri]);
-            QL_ENSURE(bet != 0.0, "division by zero");
-            bet=1.0/bet;
+        //
+        // The lines along the given direction do not couple with each
+        // other. With the row-major layout, the points of all lines of
+        // a block [offset, offset+stride) are contiguous for each
+        // position j along the direction, so that the recursion is run
+        // on tiles of adjacent lines with unit-stride inner loops
+        // instead of walking each line with a stride. Each line is
+        // processed by a single thread and in the same order as in a
+        // line-by-line solve, hence the result does not depend on the
+        // tiling or on the number of threads.
+        //
+        // The inverse pivots and the multipliers of the elimination
+        // are stored in the factorization; if it was computed for the
+        // same coefficients of the operator and the same a and b, only
+        // the forward and backward substitutions are performed.
+        const Size n = mesher_->layout()->dim()[direction_];
+        const Size stride = mesher_->layout()->spacing()[direction_];
+        const Size nBlocks = mesher_->layout()->size()/(n*stride);
+        const Size tileSize = std::min(stride, Size(64));
+        const Size nTiles = (stride+tileSize-1)/tileSize;
+        Real* x = retVal.begin();
+        const Real* y = r.begin();
+
+        if (factorization.pivots_.size() != r.size()) {
+            factorization.pivots_ = Array(r.size());
+            factorization.multipliers_ = Array(r.size());
+            factorization.coefficients_ = 0;
+        }
+        Real* p = factorization.pivots_.begin();
+        Real* t = factorization.multipliers_.begin();
+
+        if (factorization.coefficients_ == coefficients_
+            && a == factorization.a_ && b == factorization.b_) {
+            #pragma omp parallel for if(nBlocks*nTiles > 1)
+            for (long k=0; k < (long)(nBlocks*nTiles); ++k) {
+                const Size offset = (k/nTiles)*n*stride + (k%nTiles)*tileSize;
+                const Size width = std::min(tileSize, stride-(k%nTiles)*tileSize);
+
+                for (Size i=offset; i < offset+width; ++i)
+                    x[i] = y[i]*p[i];
+                for (Size j=1; j < n; ++j) {
+                    const Size start = offset + j*stride;
+                    for (Size i=start; i < start+width; ++i)
+                        x[i] = (y[i]-a*lptr[i]*x[i-stride])*p[i];
+                }
+                for (Size j=n-1; j > 0; --j) {
+                    const Size start = offset + j*stride;
+                    for (Size i=start; i < start+width; ++i)
+                        x[i-stride] -= t[i]*x[i];
+                }
+            }
+            return;
+        }
 
-            retVal[ri] = (r[ri]-a*lptr[ri]*retVal[rim1])*bet;
-            rim1 = ri;
+        factorization.coefficients_ = 0;
+        bool singular = false;
+
+        #pragma omp parallel for reduction(||:singular) if(nBlocks*nTiles > 1)
+        for (long k=0; k < (long)(nBlocks*nTiles); ++k) {
+            const Size offset = (k/nTiles)*n*stride + (k%nTiles)*tileSize;
+            const Size width = std::min(tileSize, stride-(k%nTiles)*tileSize);
+
+            for (Size i=offset; i < offset+width; ++i) {
+                Real bet = a*dptr[i]+b;
+                singular = singular || (bet == 0.0);
+                p[i] = bet = 1.0/bet;
+                x[i] = y[i]*bet;
+                if (n > 1)
+                    t[i+stride] = a*uptr[i]*bet;
+            }
+            for (Size j=1; j < n; ++j) {
+                const Size start = offset + j*stride;
+                for (Size i=start; i < start+width; ++i) {
+                    Real bet = b+a*(dptr[i]-t[i]*lptr[i]);
+                    singular = singular || (bet == 0.0);
+                    p[i] = bet = 1.0/bet;
+
+                    x[i] = (y[i]-a*lptr[i]*x[i-stride])*bet;
+                    if (j < n-1)
+                        t[i+stride] = a*uptr[i]*bet;
+                }
+            }
+            for (Size j=n-1; j > 0; --j) {
+                const Size start = offset + j*stride;
+                for (Size i=start; i < start+width; ++i)
+                    x[i-stride] -= t[i]*x[i];
+            }
         }
-        // cannot be j>=0 with Size j
-        for (Size j=mesher_->layout()->size()-2; j>0; --j)
-            retVal[reverseIndex_[j]] -= tmp[j+1]*retVal[reverseIndex_[j+1]];
-        retVal[reverseIndex_[0]] -= tmp[1]*retVal[reverseIndex_[1]];
+        QL_ENSURE(!singular, "division by zero");
 
-        return retVal;
+        factorization.coefficients_ = coefficients_;
+        factorization.a_ = a;
+        factorization.b_ = b;
     }
 }
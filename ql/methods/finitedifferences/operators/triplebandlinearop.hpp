@@ -28,6 +28,8 @@
 #define quantlib_triple_band_linear_op_hpp
 
 #include <ql/methods/finitedifferences/operators/fdmlinearop.hpp>
+#include <ql/methods/finitedifferences/operators/fdmlinearoplayout.hpp>
+#include <ql/utilities/null.hpp>
 #include <memory>
 
 namespace QuantLib {
@@ -36,6 +38,22 @@ namespace QuantLib {
     
     class TripleBandLinearOp : public FdmLinearOp {
       public:
+        //! LU factorization of b + a*L used by solve_splitting_into
+        /*! The factorization is filled by a solve and reused by later
+            solves with the same a, b and operator coefficients, which
+            is the common case for time-homogeneous operators. As it is
+            kept by the caller, the operator itself is not modified by
+            a solve; threads sharing an operator must use separate
+            factorizations.
+        */
+        class SplittingFactorization {
+          private:
+            friend class TripleBandLinearOp;
+            Size coefficients_ = 0;
+            Real a_ = Null<Real>(), b_ = Null<Real>();
+            Array pivots_, multipliers_;
+        };
+
         TripleBandLinearOp(Size direction,
                            const ext::shared_ptr<FdmMesher>& mesher);
 
@@ -48,6 +66,16 @@ namespace QuantLib {
         Array apply(const Array& r) const override;
         Array solve_splitting(const Array& r, Real a, Real b = 1.0) const;
 
+        //! \name Allocation-free interface
+        //@{
+        //! result must not be the same array as r
+        void apply_into(const Array& r, Array& result) const;
+        //! result can be the same array as r
+        void solve_splitting_into(const Array& r, Array& result,
+                                  SplittingFactorization& factorization,
+                                  Real a, Real b = 1.0) const;
+        //@}
+
         TripleBandLinearOp mult(const Array& u) const;
         // interpret u as the diagonal of a diagonal matrix, multiplied on LHS
         TripleBandLinearOp multR(const Array& u) const;
@@ -62,18 +90,42 @@ namespace QuantLib {
         void swap(TripleBandLinearOp& m) noexcept;
 
         SparseMatrix toMatrix() const override;
+        CompressedSparseMatrix toCompressedMatrix() const override;
 
       protected:
         TripleBandLinearOp() = default;
+        //! to be called by derived classes changing the coefficients
+        void invalidateFactorization();
+
+        /*! \deprecated Use neighbours_->lower instead.
+                        Deprecated in version 1.41.
+        */
+        [[deprecated("Use neighbours_->lower instead")]]
+        const Size* i0() const { return neighbours_->lower.data(); }
+        /*! \deprecated Use neighbours_->upper instead.
+                        Deprecated in version 1.41.
+        */
+        [[deprecated("Use neighbours_->upper instead")]]
+        const Size* i2() const { return neighbours_->upper.data(); }
+        /*! \deprecated Use neighbours_->reverseIndex instead.
+                        Deprecated in version 1.41.
+        */
+        [[deprecated("Use neighbours_->reverseIndex instead")]]
+        const Size* reverseIndex() const {
+            return neighbours_->reverseIndex.data();
+        }
 
         Size direction_;
-        std::unique_ptr<Size[]> i0_, i2_;
-        std::unique_ptr<Size[]> reverseIndex_;
+        ext::shared_ptr<const FdmLinearOpLayout::Neighbours> neighbours_;
         std::unique_ptr<Real[]> lower_, diag_, upper_;
 
         ext::shared_ptr<FdmMesher> mesher_;
-    };
 
+      private:
+        // identifies the current coefficients; copies share it, every
+        // change of the coefficients draws a new one.
+        Size coefficients_ = 0;
+    };
 
     inline TripleBandLinearOp::TripleBandLinearOp(TripleBandLinearOp&& m) noexcept {
         swap(m);
@@ -56,6 +56,7 @@ namespace QuantLib {
         const Real mu_;
         const ext::shared_ptr<FdmLinearOpComposite> map_;
         const BoundaryConditionSchemeHelper bcSet_;
+        Array y_, y0_, yt_, rhs_, work_;
     };
 }
 
@@ -37,7 +37,11 @@ namespace QuantLib {
         bcSet_.setTime(std::max(0.0, t-dt_));
 
         bcSet_.applyBeforeApplying(*map_);
-        a += (theta*dt_) * map_->apply(a);
+        if (work_.size() != a.size())
+            work_ = Array(a.size());
+        map_->apply_into(a, work_);
+        for (Size k=0; k < a.size(); ++k)
+            a[k] += (theta*dt_) * work_[k];
         bcSet_.applyAfterApplying(a);
     }
 
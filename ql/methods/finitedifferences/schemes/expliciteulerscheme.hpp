@@ -55,6 +55,7 @@ namespace QuantLib {
         Time dt_;
         const ext::shared_ptr<FdmLinearOpComposite> map_;
         const BoundaryConditionSchemeHelper bcSet_;
+        Array work_;
     };
 }
 
@@ -20,6 +20,7 @@
 */
 
 #include <ql/methods/finitedifferences/schemes/hundsdorferscheme.hpp>
+#include <algorithm>
 #include <utility>
 
 namespace QuantLib {
@@ -36,28 +37,47 @@ namespace QuantLib {
         map_->setTime(std::max(0.0, t-dt_), t);
         bcSet_.setTime(std::max(0.0, t-dt_));
 
+        const Size n = a.size();
+        if (y_.size() != n) {
+            y_ = Array(n);
+            rhs_ = Array(n);
+            y0_ = Array(n);
+            yt_ = Array(n);
+            work_ = Array(n);
+        }
+
         bcSet_.applyBeforeApplying(*map_);
-        Array y = a + dt_*map_->apply(a);
-        bcSet_.applyAfterApplying(y);
+        map_->apply_into(a, work_);
+        for (Size k=0; k < n; ++k)
+            y_[k] = a[k] + dt_*work_[k];
+        bcSet_.applyAfterApplying(y_);
 
-        Array y0 = y;
+        std::copy(y_.begin(), y_.end(), y0_.begin());
 
         for (Size i=0; i < map_->size(); ++i) {
-            Array rhs = y - theta_*dt_*map_->apply_direction(i, a);
-            y = map_->solve_splitting(i, rhs, -theta_*dt_);
+            map_->apply_direction_into(i, a, work_);
+            for (Size k=0; k < n; ++k)
+                rhs_[k] = y_[k] - (theta_*dt_)*work_[k];
+            map_->solve_splitting_into(i, rhs_, -theta_*dt_, y_);
         }
 
         bcSet_.applyBeforeApplying(*map_);
-        Array yt = y0 + mu_*dt_*map_->apply(y-a);
-        bcSet_.applyAfterApplying(yt);
+        for (Size k=0; k < n; ++k)
+            rhs_[k] = y_[k] - a[k];
+        map_->apply_into(rhs_, work_);
+        for (Size k=0; k < n; ++k)
+            yt_[k] = y0_[k] + (mu_*dt_)*work_[k];
+        bcSet_.applyAfterApplying(yt_);
 
         for (Size i=0; i < map_->size(); ++i) {
-            Array rhs = yt - theta_*dt_*map_->apply_direction(i, y);
-            yt = map_->solve_splitting(i, rhs, -theta_*dt_);
+            map_->apply_direction_into(i, y_, work_);
+            for (Size k=0; k < n; ++k)
+                rhs_[k] = yt_[k] - (theta_*dt_)*work_[k];
+            map_->solve_splitting_into(i, rhs_, -theta_*dt_, yt_);
         }
-        bcSet_.applyAfterSolving(yt);
+        bcSet_.applyAfterSolving(yt_);
 
-        a = yt;
+        a.swap(yt_);
     }
 
     void HundsdorferScheme::setStep(Time dt) {
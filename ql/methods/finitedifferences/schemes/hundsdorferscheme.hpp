@@ -60,6 +60,7 @@ namespace QuantLib {
 
         const ext::shared_ptr<FdmLinearOpComposite> map_;
         const BoundaryConditionSchemeHelper bcSet_;
+        Array y_, y0_, yt_, rhs_, work_;
     };
 }
 
@@ -22,17 +22,21 @@
 #include <ql/math/matrixutilities/bicgstab.hpp>
 #include <ql/math/matrixutilities/gmres.hpp>
 #include <ql/methods/finitedifferences/schemes/impliciteulerscheme.hpp>
+#include <ql/methods/finitedifferences/utilities/fdmlinearoppreconditioner.hpp>
 #include <functional>
 #include <utility>
 
 namespace QuantLib {
 
-    ImplicitEulerScheme::ImplicitEulerScheme(ext::shared_ptr<FdmLinearOpComposite> map,
-                                             const bc_set& bcSet,
-                                             Real relTol,
-                                             SolverType solverType)
+    ImplicitEulerScheme::ImplicitEulerScheme(
+        ext::shared_ptr<FdmLinearOpComposite> map,
+        const bc_set& bcSet,
+        Real relTol,
+        SolverType solverType,
+        ext::shared_ptr<FdmLinearOpPreconditioner> preconditioner)
     : dt_(Null<Real>()), iterations_(ext::make_shared<Size>(0U)), relTol_(relTol),
-      map_(std::move(map)), bcSet_(bcSet), solverType_(solverType) {}
+      map_(std::move(map)), bcSet_(bcSet), solverType_(solverType),
+      preconditioner_(std::move(preconditioner)) {}
 
     Array ImplicitEulerScheme::apply(const Array& r, Real theta) const {
         return r - (theta*dt_)*map_->apply(r);
@@ -53,7 +57,13 @@ namespace QuantLib {
             a = map_->solve_splitting(0, a, -theta*dt_);
         }
         else {
-            auto preconditioner = [&](const Array& _a){ return map_->preconditioner(_a, -theta*dt_); };
+            std::function<Array(const Array&)> preconditioner;
+            if (preconditioner_ != nullptr) {
+                preconditioner_->setup(*map_, -theta*dt_);
+                preconditioner = [&](const Array& _a){ return preconditioner_->apply(_a); };
+            }
+            else
+                preconditioner = [&](const Array& _a){ return map_->preconditioner(_a, -theta*dt_); };
             auto applyF = [&](const Array& _a){ return apply(_a, theta); };
 
             if (solverType_ == BiCGstab) {
@@ -32,6 +32,8 @@
 
 namespace QuantLib {
 
+    class FdmLinearOpPreconditioner;
+
     class ImplicitEulerScheme {
       public:
         enum SolverType { BiCGstab, GMRES };
@@ -44,10 +46,18 @@ namespace QuantLib {
         typedef traits::condition_type condition_type;
 
         // constructors
-        explicit ImplicitEulerScheme(ext::shared_ptr<FdmLinearOpComposite> map,
-                                     const bc_set& bcSet = bc_set(),
-                                     Real relTol = 1e-8,
-                                     SolverType solverType = BiCGstab);
+        /*! if no preconditioner is given, the directional splitting
+            provided by the operator is used to precondition the
+            Krylov solver in more than one dimension. Schemes created
+            by FdmBackwardSolver from an FdmSchemeDesc always use the
+            directional splitting.
+        */
+        explicit ImplicitEulerScheme(
+            ext::shared_ptr<FdmLinearOpComposite> map,
+            const bc_set& bcSet = bc_set(),
+            Real relTol = 1e-8,
+            SolverType solverType = BiCGstab,
+            ext::shared_ptr<FdmLinearOpPreconditioner> preconditioner = {});
 
         void step(array_type& a, Time t);
         void setStep(Time dt);
@@ -66,6 +76,7 @@ namespace QuantLib {
         const ext::shared_ptr<FdmLinearOpComposite> map_;
         const BoundaryConditionSchemeHelper bcSet_;
         const SolverType solverType_;
+        const ext::shared_ptr<FdmLinearOpPreconditioner> preconditioner_;
     };
 }
 
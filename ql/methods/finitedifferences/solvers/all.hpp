@@ -15,5 +15,6 @@
 #include <ql/methods/finitedifferences/solvers/fdmhullwhitesolver.hpp>
 #include <ql/methods/finitedifferences/solvers/fdmndimsolver.hpp>
 #include <ql/methods/finitedifferences/solvers/fdmsimple2dbssolver.hpp>
+#include <ql/methods/finitedifferences/solvers/fdmsparsegridsolver.hpp>
 #include <ql/methods/finitedifferences/solvers/fdmsolverdesc.hpp>
 
@@ -56,8 +56,7 @@ namespace QuantLib {
         std::copy(initialValues_.begin(), initialValues_.end(), rhs.begin());
 
         FdmBackwardSolver(op_, solverDesc_.bcSet, conditions_, schemeDesc_)
-            .rollback(rhs, solverDesc_.maturity, 0.0,
-                      solverDesc_.timeSteps, solverDesc_.dampingSteps);
+            .rollback(rhs, solverDesc_.maturity, 0.0, solverDesc_);
 
         std::copy(rhs.begin(), rhs.end(), resultValues_.begin());
         interpolation_ = ext::make_shared<MonotonicCubicNaturalSpline>(x_.begin(), x_.end(),
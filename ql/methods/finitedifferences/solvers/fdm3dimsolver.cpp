@@ -73,8 +73,7 @@ namespace QuantLib {
         std::copy(initialValues_.begin(), initialValues_.end(), rhs.begin());
 
         FdmBackwardSolver(op_, solverDesc_.bcSet, conditions_, schemeDesc_)
-             .rollback(rhs, solverDesc_.maturity, 0.0,
-                       solverDesc_.timeSteps, solverDesc_.dampingSteps);
+             .rollback(rhs, solverDesc_.maturity, 0.0, solverDesc_);
 
         for (Size i=0; i < z_.size(); ++i) {
             std::copy(rhs.begin()+i    *y_.size()*x_.size(),
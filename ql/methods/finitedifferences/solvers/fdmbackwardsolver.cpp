@@ -35,6 +35,9 @@
 #include <ql/methods/finitedifferences/solvers/fdmbackwardsolver.hpp>
 #include <ql/methods/finitedifferences/stepconditions/fdmstepconditioncomposite.hpp>
 #include <ql/mathconstants.hpp>
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
 #include <utility>
 
 
@@ -89,56 +92,68 @@ namespace QuantLib {
                          std::list<std::vector<Time> >(), FdmStepConditionComposite::Conditions())),
       schemeDesc_(schemeDesc) {}
 
-    void FdmBackwardSolver::rollback(FdmBackwardSolver::array_type& rhs, 
-                                     Time from, Time to,
-                                     Size steps, Size dampingSteps) {
-
-        const Time deltaT = from - to;
-        const Size allSteps = steps + dampingSteps;
-        const Time dampingTo = from - (deltaT*dampingSteps)/allSteps;
+    FdmAdaptiveStepping::FdmAdaptiveStepping(Real tolerance,
+                                             Time initialStep,
+                                             Time minStep,
+                                             Time maxStep)
+    : tolerance(tolerance), initialStep(initialStep),
+      minStep(minStep), maxStep(maxStep) {
+        QL_REQUIRE(tolerance > 0.0, "positive tolerance required");
+        QL_REQUIRE(initialStep == Null<Time>() || initialStep > 0.0,
+                   "positive initial step required");
+        QL_REQUIRE(minStep == Null<Time>() || minStep > 0.0,
+                   "positive minimum step required");
+        QL_REQUIRE(maxStep == Null<Time>() || maxStep > 0.0,
+                   "positive maximum step required");
+        QL_REQUIRE(minStep == Null<Time>() || maxStep == Null<Time>()
+                   || minStep <= maxStep,
+                   "minimum step (" << minStep << ") exceeds maximum step ("
+                   << maxStep << ")");
+    }
 
-        if ((dampingSteps != 0U) && schemeDesc_.type != FdmSchemeDesc::ImplicitEulerType) {
-            ImplicitEulerScheme implicitEvolver(map_, bcSet_);    
-            FiniteDifferenceModel<ImplicitEulerScheme> 
-                    dampingModel(implicitEvolver, condition_->stoppingTimes());
-            dampingModel.rollback(rhs, from, dampingTo, 
-                                  dampingSteps, *condition_);
+    namespace {
+        // convergence order of the schemes, used by the error control
+        Size schemeOrder(const FdmSchemeDesc& desc) {
+            switch (desc.type) {
+              case FdmSchemeDesc::ImplicitEulerType:
+              case FdmSchemeDesc::ExplicitEulerType:
+                return 1;
+              case FdmSchemeDesc::DouglasType:
+              case FdmSchemeDesc::CrankNicolsonType:
+                return (desc.theta == 0.5) ? 2 : 1;
+              default:
+                return 2;
+            }
         }
+    }
 
+    template <class F>
+    void FdmBackwardSolver::withScheme(const F& f) const {
         switch (schemeDesc_.type) {
           case FdmSchemeDesc::HundsdorferType:
             {
                 HundsdorferScheme hsEvolver(schemeDesc_.theta, schemeDesc_.mu, 
                                             map_, bcSet_);
-                FiniteDifferenceModel<HundsdorferScheme> 
-                               hsModel(hsEvolver, condition_->stoppingTimes());
-                hsModel.rollback(rhs, dampingTo, to, steps, *condition_);
+                f(hsEvolver);
             }
             break;
           case FdmSchemeDesc::DouglasType:
             {
                 DouglasScheme dsEvolver(schemeDesc_.theta, map_, bcSet_);
-                FiniteDifferenceModel<DouglasScheme> 
-                               dsModel(dsEvolver, condition_->stoppingTimes());
-                dsModel.rollback(rhs, dampingTo, to, steps, *condition_);
+                f(dsEvolver);
             }
             break;
           case FdmSchemeDesc::CrankNicolsonType:
             {
-              CrankNicolsonScheme cnEvolver(schemeDesc_.theta, map_, bcSet_);
-              FiniteDifferenceModel<CrankNicolsonScheme>
-                             cnModel(cnEvolver, condition_->stoppingTimes());
-              cnModel.rollback(rhs, dampingTo, to, steps, *condition_);
-
+                CrankNicolsonScheme cnEvolver(schemeDesc_.theta, map_, bcSet_);
+                f(cnEvolver);
             }
             break;
           case FdmSchemeDesc::CraigSneydType:
             {
                 CraigSneydScheme csEvolver(schemeDesc_.theta, schemeDesc_.mu, 
                                            map_, bcSet_);
-                FiniteDifferenceModel<CraigSneydScheme> 
-                               csModel(csEvolver, condition_->stoppingTimes());
-                csModel.rollback(rhs, dampingTo, to, steps, *condition_);
+                f(csEvolver);
             }
             break;
           case FdmSchemeDesc::ModifiedCraigSneydType:
@@ -146,34 +161,26 @@ namespace QuantLib {
                 ModifiedCraigSneydScheme csEvolver(schemeDesc_.theta, 
                                                    schemeDesc_.mu,
                                                    map_, bcSet_);
-                FiniteDifferenceModel<ModifiedCraigSneydScheme> 
-                              mcsModel(csEvolver, condition_->stoppingTimes());
-                mcsModel.rollback(rhs, dampingTo, to, steps, *condition_);
+                f(csEvolver);
             }
             break;
           case FdmSchemeDesc::ImplicitEulerType:
             {
                 ImplicitEulerScheme implicitEvolver(map_, bcSet_);
-                FiniteDifferenceModel<ImplicitEulerScheme> 
-                   implicitModel(implicitEvolver, condition_->stoppingTimes());
-                implicitModel.rollback(rhs, from, to, allSteps, *condition_);
+                f(implicitEvolver);
             }
             break;
           case FdmSchemeDesc::ExplicitEulerType:
             {
                 ExplicitEulerScheme explicitEvolver(map_, bcSet_);
-                FiniteDifferenceModel<ExplicitEulerScheme> 
-                   explicitModel(explicitEvolver, condition_->stoppingTimes());
-                explicitModel.rollback(rhs, dampingTo, to, steps, *condition_);
+                f(explicitEvolver);
             }
             break;
           case FdmSchemeDesc::MethodOfLinesType:
             {
                 MethodOfLinesScheme methodOfLines(
                     schemeDesc_.theta, schemeDesc_.mu, map_, bcSet_);
-                FiniteDifferenceModel<MethodOfLinesScheme>
-                   molModel(methodOfLines, condition_->stoppingTimes());
-                molModel.rollback(rhs, dampingTo, to, steps, *condition_);
+                f(methodOfLines);
             }
             break;
           case FdmSchemeDesc::TrBDF2Type:
@@ -187,14 +194,184 @@ namespace QuantLib {
 
                 TrBDF2Scheme<CraigSneydScheme> trBDF2(
                     schemeDesc_.theta, map_, hsEvolver, bcSet_,schemeDesc_.mu);
-
-                FiniteDifferenceModel<TrBDF2Scheme<CraigSneydScheme> >
-                   trBDF2Model(trBDF2, condition_->stoppingTimes());
-                trBDF2Model.rollback(rhs, dampingTo, to, steps, *condition_);
+                f(trBDF2);
             }
             break;
           default:
             QL_FAIL("Unknown scheme type");
         }
     }
+
+    void FdmBackwardSolver::rollback(FdmBackwardSolver::array_type& rhs, 
+                                     Time from, Time to,
+                                     Size steps, Size dampingSteps) {
+
+        const Time deltaT = from - to;
+        const Size allSteps = steps + dampingSteps;
+        Time dampingTo = from - (deltaT*dampingSteps)/allSteps;
+
+        if ((dampingSteps != 0U) && schemeDesc_.type != FdmSchemeDesc::ImplicitEulerType) {
+            ImplicitEulerScheme implicitEvolver(map_, bcSet_);    
+            FiniteDifferenceModel<ImplicitEulerScheme> 
+                    dampingModel(implicitEvolver, condition_->stoppingTimes());
+            dampingModel.rollback(rhs, from, dampingTo, 
+                                  dampingSteps, *condition_);
+        }
+        else if (schemeDesc_.type == FdmSchemeDesc::ImplicitEulerType) {
+            dampingTo = from;
+            steps = allSteps;
+        }
+
+        withScheme([&](auto& evolver) {
+            typedef std::decay_t<decltype(evolver)> Evolver;
+            FiniteDifferenceModel<Evolver>
+                model(evolver, condition_->stoppingTimes());
+            model.rollback(rhs, dampingTo, to, steps, *condition_);
+        });
+
+        diagnostics_ = FdmRollbackDiagnostics();
+        diagnostics_.steps = allSteps;
+    }
+
+    void FdmBackwardSolver::rollback(FdmBackwardSolver::array_type& rhs,
+                                     Time from, Time to,
+                                     const FdmAdaptiveStepping& stepping,
+                                     Size dampingSteps) {
+        QL_REQUIRE(from >= to,
+                   "trying to roll back from " << from << " to " << to);
+
+        diagnostics_ = FdmRollbackDiagnostics();
+        diagnostics_.estimatedError = 0.0;
+
+        const Time deltaT = from - to;
+        if (deltaT == 0.0)
+            return;
+
+        Time dt = std::min(deltaT, (stepping.initialStep != Null<Time>())
+                                   ? stepping.initialStep : 0.01*deltaT);
+        if (stepping.maxStep != Null<Time>())
+            dt = std::min(dt, stepping.maxStep);
+
+        Time dampingTo = from;
+        if (dampingSteps != 0U) {
+            dampingTo = std::max(to, from - dampingSteps*dt);
+            ImplicitEulerScheme implicitEvolver(map_, bcSet_);
+            FiniteDifferenceModel<ImplicitEulerScheme>
+                    dampingModel(implicitEvolver, condition_->stoppingTimes());
+            dampingModel.rollback(rhs, from, dampingTo,
+                                  dampingSteps, *condition_);
+            diagnostics_.steps = dampingSteps;
+        }
+
+        withScheme([&](auto& evolver) {
+            adaptiveRollback(evolver, rhs, dampingTo, to, dt, stepping);
+        });
+    }
+
+    template <class Evolver>
+    void FdmBackwardSolver::adaptiveRollback(
+        Evolver& evolver, array_type& a, Time from, Time to, Time& dt,
+        const FdmAdaptiveStepping& stepping) {
+
+        // step-size controller constants
+        const Real safety = 0.9, minScale = 0.2, maxScale = 4.0;
+
+        const Time deltaT = from - to;
+        const Time minStep = (stepping.minStep != Null<Time>())
+            ? stepping.minStep : 1e-6*deltaT;
+        const Time maxStep = (stepping.maxStep != Null<Time>())
+            ? stepping.maxStep : deltaT;
+        const Size p = schemeOrder(schemeDesc_);
+        const Real errorScale = 1.0/(std::pow(2.0, Real(p)) - 1.0);
+
+        std::vector<Time> stoppingTimes = condition_->stoppingTimes();
+        std::sort(stoppingTimes.begin(), stoppingTimes.end());
+
+        if (!stoppingTimes.empty() && stoppingTimes.back() == from)
+            condition_->applyTo(a, from);
+
+        dt = std::max(minStep, std::min(dt, maxStep));
+
+        array_type full(a.size()), half(a.size());
+        Time t = from;
+        while (t > to) {
+            // next time that must be hit exactly
+            Time target = to;
+            for (auto iter = stoppingTimes.rbegin();
+                 iter != stoppingTimes.rend(); ++iter) {
+                if (*iter < t && *iter > target) {
+                    target = *iter;
+                    break;
+                }
+            }
+
+            // avoid slivers in front of the target
+            const Time remaining = t - target;
+            Time h = dt;
+            if (h >= remaining*(1.0-std::sqrt(QL_EPSILON)))
+                h = remaining;
+            else if (2.0*h > remaining)
+                h = 0.5*remaining;
+            const Time next = (h == remaining) ? target : t - h;
+
+            std::copy(a.begin(), a.end(), full.begin());
+            evolver.setStep(h);
+            evolver.step(full, t);
+            condition_->applyTo(full, next);
+
+            std::copy(a.begin(), a.end(), half.begin());
+            const Time mid = t - 0.5*h;
+            evolver.setStep(0.5*h);
+            evolver.step(half, t);
+            condition_->applyTo(half, mid);
+            evolver.step(half, mid);
+            condition_->applyTo(half, next);
+
+            Real diff = 0.0, norm = 1.0;
+            for (Size i=0; i < a.size(); ++i) {
+                diff = std::max(diff, std::fabs(half[i] - full[i]));
+                norm = std::max(norm, std::fabs(half[i]));
+            }
+            const Real error = errorScale*diff/norm;
+
+            const Real scale = (error > 0.0)
+                ? safety*std::pow(stepping.tolerance/error, 1.0/(p+1))
+                : maxScale;
+
+            // the controller can not go below minStep, accept the step
+            // even if it was stretched to hit the target exactly
+            if (error <= stepping.tolerance || dt <= minStep) {
+                a.swap(half);
+                t = next;
+                ++diagnostics_.steps;
+                if (error > stepping.tolerance)
+                    ++diagnostics_.forcedSteps;
+                diagnostics_.estimatedError += error*norm;
+
+                // a step shortened by a stopping time does not say
+                // anything about the step size that can be used next
+                if (h == dt || error > stepping.tolerance)
+                    dt *= std::min(maxScale, std::max(minScale, scale));
+            } else {
+                ++diagnostics_.rejectedSteps;
+                dt = h*std::min(1.0, std::max(minScale, scale));
+            }
+            dt = std::max(minStep, std::min(dt, maxStep));
+        }
+    }
+
+    void FdmBackwardSolver::rollback(FdmBackwardSolver::array_type& rhs,
+                                     Time from, Time to,
+                                     const FdmSolverDesc& solverDesc) {
+        if (solverDesc.adaptiveStepping != nullptr)
+            rollback(rhs, from, to, *solverDesc.adaptiveStepping,
+                     solverDesc.dampingSteps);
+        else
+            rollback(rhs, from, to,
+                     solverDesc.timeSteps, solverDesc.dampingSteps);
+    }
+
+    const FdmRollbackDiagnostics& FdmBackwardSolver::diagnostics() const {
+        return diagnostics_;
+    }
 }
@@ -25,7 +25,9 @@
 #ifndef quantlib_fdm_backward_solver_hpp
 #define quantlib_fdm_backward_solver_hpp
 
+#include <ql/methods/finitedifferences/solvers/fdmsolverdesc.hpp>
 #include <ql/methods/finitedifferences/utilities/fdmboundaryconditionset.hpp>
+#include <ql/utilities/null.hpp>
 
 namespace QuantLib {
 
@@ -57,7 +59,44 @@ namespace QuantLib {
             Real eps=0.001, Real relInitStepSize=0.01);
         static FdmSchemeDesc TrBDF2();
     };
-        
+
+    //! parameters of the adaptive time stepping
+    /*! The local error of a step is estimated by step doubling,
+        i.e., by comparing a full step with two half steps of the
+        chosen scheme. The step is accepted if the estimate, measured
+        in the maximum norm relative to max(1, |u|), does not exceed
+        the tolerance; the step size is then adjusted within the
+        given bounds. Null bounds are replaced by defaults derived
+        from the length of the rollback interval.
+
+        A step of the minimum size is accepted even if its error
+        estimate exceeds the tolerance, so that the rollback always
+        terminates; such steps are counted in
+        FdmRollbackDiagnostics::forcedSteps.
+    */
+    struct FdmAdaptiveStepping {
+        explicit FdmAdaptiveStepping(Real tolerance = 1e-4,
+                                     Time initialStep = Null<Time>(),
+                                     Time minStep = Null<Time>(),
+                                     Time maxStep = Null<Time>());
+
+        const Real tolerance;
+        const Time initialStep, minStep, maxStep;
+    };
+
+    //! diagnostics of the last rollback
+    struct FdmRollbackDiagnostics {
+        //! accepted steps, damping steps included
+        Size steps = 0;
+        //! steps rejected by the error control
+        Size rejectedSteps = 0;
+        //! steps of minimum size accepted above the tolerance
+        Size forcedSteps = 0;
+        //! sum of the local error estimates of the accepted steps
+        Real estimatedError = Null<Real>();
+    };
+
+
     class FdmBackwardSolver {
       public:
         typedef FdmLinearOp::array_type array_type;
@@ -71,11 +110,40 @@ namespace QuantLib {
                       Time from, Time to,
                       Size steps, Size dampingSteps);
 
+        /*! rolls back with adaptive time steps; stopping times of the
+            step conditions are always hit exactly. The damping steps
+            are implicit Euler steps of the initial step size.
+        */
+        void rollback(array_type& a,
+                      Time from, Time to,
+                      const FdmAdaptiveStepping& stepping,
+                      Size dampingSteps = 0);
+
+        /*! rolls back with the adaptive stepping of the solver
+            description if it is given, with its fixed number of time
+            steps otherwise.
+        */
+        void rollback(array_type& a,
+                      Time from, Time to,
+                      const FdmSolverDesc& solverDesc);
+
+        const FdmRollbackDiagnostics& diagnostics() const;
+
       protected:
         const ext::shared_ptr<FdmLinearOpComposite> map_;
         const FdmBoundaryConditionSet bcSet_;
         const ext::shared_ptr<FdmStepConditionComposite> condition_;
         const FdmSchemeDesc schemeDesc_;
+
+      private:
+        template <class F>
+        void withScheme(const F& f) const;
+        template <class Evolver>
+        void adaptiveRollback(Evolver& evolver, array_type& a,
+                              Time from, Time to, Time& dt,
+                              const FdmAdaptiveStepping& stepping);
+
+        FdmRollbackDiagnostics diagnostics_;
     };
 }
 
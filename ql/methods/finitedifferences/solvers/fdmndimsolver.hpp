@@ -116,8 +116,7 @@ namespace QuantLib {
         std::copy(initialValues_.begin(), initialValues_.end(), rhs.begin());
 
         FdmBackwardSolver(op_, solverDesc_.bcSet, conditions_, schemeDesc_)
-                 .rollback(rhs, solverDesc_.maturity, 0.0,
-                           solverDesc_.timeSteps, solverDesc_.dampingSteps);
+                 .rollback(rhs, solverDesc_.maturity, 0.0, solverDesc_);
 
         for (const auto& iter : *solverDesc_.mesher->layout()) {
             setValue(*f_, iter.coordinates(), rhs[iter.index()]);
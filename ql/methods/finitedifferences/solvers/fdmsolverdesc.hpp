@@ -31,6 +31,7 @@ namespace QuantLib {
     class FdmInnerValueCalculator;
     class FdmStepConditionComposite;
     class FdmInnerValueCalculator;
+    struct FdmAdaptiveStepping;
 
     struct FdmSolverDesc {
         const ext::shared_ptr<FdmMesher> mesher;
@@ -40,6 +41,8 @@ namespace QuantLib {
         const Time maturity;
         const Size timeSteps;
         const Size dampingSteps;
+        //! if given, replaces the fixed timeSteps
+        const ext::shared_ptr<const FdmAdaptiveStepping> adaptiveStepping = {};
     };
 }
 
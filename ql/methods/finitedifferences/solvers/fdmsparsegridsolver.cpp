@@ -0,0 +1,190 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <https://www.quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+
+#include <ql/math/distributions/binomialdistribution.hpp>
+#include <ql/methods/finitedifferences/meshers/fdmmesher.hpp>
+#include <ql/methods/finitedifferences/operators/fdmlinearoplayout.hpp>
+#include <ql/methods/finitedifferences/solvers/fdmsparsegridsolver.hpp>
+#include <ql/methods/finitedifferences/utilities/fdminnervaluecalculator.hpp>
+#include <algorithm>
+#include <string>
+#include <utility>
+
+namespace QuantLib {
+
+    namespace {
+
+        // all multi-indices with l_i >= minLevel and |l|_1 == sum
+        void addLevels(std::vector<Size>& l, Size i, Size sum, Size minLevel,
+                       std::vector<std::vector<Size> >& result) {
+            if (i == l.size()-1) {
+                l[i] = sum;
+                result.push_back(l);
+                return;
+            }
+            const Size remaining = l.size()-i-1;
+            for (l[i]=minLevel; l[i] + remaining*minLevel <= sum; ++l[i])
+                addLevels(l, i+1, sum-l[i], minLevel, result);
+        }
+
+    }
+
+    FdmSparseGridSolver::FdmSparseGridSolver(
+        Size dimensions,
+        const FdmSparseGridDesc& sparseGridDesc,
+        SolverDescGenerator solverDescGenerator,
+        OperatorGenerator operatorGenerator,
+        const FdmSchemeDesc& schemeDesc)
+    : dimensions_(dimensions), sparseGridDesc_(sparseGridDesc),
+      solverDescGenerator_(std::move(solverDescGenerator)),
+      operatorGenerator_(std::move(operatorGenerator)),
+      schemeDesc_(schemeDesc) {
+
+        const Size d = dimensions_;
+        const Size n = sparseGridDesc_.level, m = sparseGridDesc_.minLevel;
+        QL_REQUIRE(d > 0, "at least one dimension required");
+        QL_REQUIRE(m >= 2, "minimum level (" << m << ") must be "
+                   "at least 2");
+        QL_REQUIRE(n >= m, "level (" << n << ") must not be smaller "
+                   "than minimum level (" << m << ")");
+
+        std::vector<Size> l(d);
+        for (Size q=0; q < d && q <= n-m; ++q) {
+            const Real coefficient = ((q % 2 == 0) ? 1.0 : -1.0)
+                * binomialCoefficient(d-1, q);
+
+            std::vector<std::vector<Size> > levels;
+            addLevels(l, 0, n + (d-1)*m - q, m, levels);
+
+            for (const auto& level : levels) {
+                Grid grid;
+                grid.coefficient = coefficient;
+                for (Size li : level)
+                    grid.dim.push_back((Size(1) << li) + 1);
+                grids_.push_back(std::move(grid));
+            }
+        }
+    }
+
+    Size FdmSparseGridSolver::numberOfGrids() const {
+        return grids_.size();
+    }
+
+    Size FdmSparseGridSolver::numberOfPoints() const {
+        Size points = 0;
+        for (const auto& grid : grids_) {
+            Size p = 1;
+            for (Size n : grid.dim)
+                p *= n;
+            points += p;
+        }
+        return points;
+    }
+
+    void FdmSparseGridSolver::performCalculations() const {
+        const auto solve = [this](Grid& grid) {
+            const FdmSolverDesc desc = solverDescGenerator_(grid.dim);
+            const ext::shared_ptr<FdmLinearOpLayout> layout
+                = desc.mesher->layout();
+            QL_REQUIRE(layout->dim() == grid.dim,
+                       "mesher does not match the requested grid sizes");
+
+            grid.locations.resize(dimensions_);
+            for (Size i=0; i < dimensions_; ++i) {
+                const Array x = desc.mesher->locations(i);
+                grid.locations[i].resize(grid.dim[i]);
+                for (Size j=0; j < grid.dim[i]; ++j)
+                    grid.locations[i][j] = x[j*layout->spacing()[i]];
+            }
+
+            Array rhs(layout->size());
+            for (const auto& iter : *layout)
+                rhs[iter.index()] = desc.calculator->avgInnerValue(
+                    iter, desc.maturity);
+
+            FdmBackwardSolver(operatorGenerator_(desc.mesher), desc.bcSet,
+                              desc.condition, schemeDesc_)
+                .rollback(rhs, desc.maturity, 0.0, desc);
+
+            grid.values = std::move(rhs);
+        };
+
+        solve(grids_.front());
+
+        const Size n = grids_.size();
+        std::vector<std::string> errors(n);
+
+        #pragma omp parallel for schedule(dynamic) if(sparseGridDesc_.parallel)
+        for (long i=1; i < (long)n; ++i) {
+            try {
+                solve(grids_[i]);
+            } catch (std::exception& e) {
+                errors[i] = e.what();
+            }
+        }
+        for (Size i=1; i < n; ++i)
+            QL_REQUIRE(errors[i].empty(),
+                       "grid " << i << " failed: " << errors[i]);
+    }
+
+    Real FdmSparseGridSolver::interpolateAt(const std::vector<Real>& x) const {
+        QL_REQUIRE(x.size() == dimensions_,
+                   "point has " << x.size() << " coordinates, "
+                   << dimensions_ << " expected");
+        calculate();
+
+        Real value = 0.0;
+        for (const auto& grid : grids_)
+            value += grid.coefficient*interpolateAt(grid, x);
+        return value;
+    }
+
+    Real FdmSparseGridSolver::interpolateAt(
+        const Grid& grid, const std::vector<Real>& x) const {
+
+        // multi-linear interpolation, flat extrapolation
+        std::vector<Size> lower(dimensions_), spacing(dimensions_, 1);
+        std::vector<Real> weight(dimensions_);
+        for (Size i=0; i < dimensions_; ++i) {
+            const std::vector<Real>& xi = grid.locations[i];
+            const Real y = std::min(std::max(x[i], xi.front()), xi.back());
+            const Size j = std::upper_bound(xi.begin()+1, xi.end()-1, y)
+                - xi.begin();
+            lower[i] = j-1;
+            weight[i] = (y - xi[j-1])/(xi[j] - xi[j-1]);
+            if (i > 0)
+                spacing[i] = spacing[i-1]*grid.dim[i-1];
+        }
+
+        Real value = 0.0;
+        for (Size corner=0; corner < (Size(1) << dimensions_); ++corner) {
+            Size index = 0;
+            Real w = 1.0;
+            for (Size i=0; i < dimensions_; ++i) {
+                const bool upper = ((corner >> i) & 1U) != 0U;
+                index += (lower[i] + (upper ? 1 : 0))*spacing[i];
+                w *= upper ? weight[i] : 1.0-weight[i];
+            }
+            if (w != 0.0)
+                value += w*grid.values[index];
+        }
+        return value;
+    }
+
+}
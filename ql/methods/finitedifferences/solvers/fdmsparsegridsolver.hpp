@@ -0,0 +1,125 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <https://www.quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+
+/*! \file fdmsparsegridsolver.hpp
+    \brief sparse-grid combination technique for multi-dimensional PDEs
+*/
+
+#ifndef quantlib_fdm_sparse_grid_solver_hpp
+#define quantlib_fdm_sparse_grid_solver_hpp
+
+#include <ql/methods/finitedifferences/solvers/fdmbackwardsolver.hpp>
+#include <ql/methods/finitedifferences/solvers/fdmsolverdesc.hpp>
+#include <ql/patterns/lazyobject.hpp>
+#include <functional>
+
+namespace QuantLib {
+
+    class FdmMesher;
+
+    struct FdmSparseGridDesc {
+        //! the finest grids have \f$ 2^{level}+1 \f$ points per direction
+        Size level;
+        /*! the coarsest grids have \f$ 2^{minLevel}+1 \f$ points;
+            it must be at least 2, since grids with three points have
+            a single interior point in that direction and cannot
+            resolve the second-order operator and the boundaries
+        */
+        Size minLevel = 2;
+        /*! whether the full grids are solved in parallel (requires
+            OpenMP and thread-safe generators, see FdmSparseGridSolver)
+        */
+        bool parallel = false;
+    };
+
+    //! sparse-grid solver based on the combination technique
+    /*! Instead of a single full grid with \f$ (2^n+1)^d \f$ points,
+        the PDE is solved on all anisotropic full grids with
+        \f$ 2^{l_i}+1 \f$ points in direction \f$ i \f$, where
+        \f$ l_i \geq m \f$ and
+        \f$ |l|_1 = n + (d-1)m - q \f$ for \f$ q = 0, \dots, d-1 \f$,
+        and the interpolated solutions are combined with weights
+        \f$ (-1)^q \binom{d-1}{q} \f$. The number of grid points
+        grows like \f$ 2^n n^{d-1} \f$ instead of \f$ 2^{nd} \f$,
+        while for sufficiently smooth solutions the error is
+        comparable to the one on the full grid up to a logarithmic
+        factor.
+
+        The meshers, conditions and operators of the full grids are
+        created by the given generators, which receive the number of
+        points in each direction. The full grids are independent and
+        can be solved in parallel; the solutions are interpolated
+        multi-linearly.
+
+        \warning If the grids are solved in parallel, the generators
+                 and the operators and conditions they return must be
+                 safe to use concurrently after the first grid has
+                 been solved, which triggers any lazy calculation.
+
+        References:
+        Griebel, M., Schneider, M., Zenger, C. 1992. A combination
+        technique for the solution of sparse grid problems.
+        Reisinger, C., Wittum, G. 2007. Efficient hierarchical
+        approximation of high-dimensional option pricing problems.
+        SIAM Journal on Scientific Computing 29(1), 440-458.
+    */
+    class FdmSparseGridSolver : public LazyObject {
+      public:
+        typedef std::function<FdmSolverDesc(const std::vector<Size>&)>
+            SolverDescGenerator;
+        typedef std::function<ext::shared_ptr<FdmLinearOpComposite>(
+            const ext::shared_ptr<FdmMesher>&)> OperatorGenerator;
+
+        FdmSparseGridSolver(Size dimensions,
+                            const FdmSparseGridDesc& sparseGridDesc,
+                            SolverDescGenerator solverDescGenerator,
+                            OperatorGenerator operatorGenerator,
+                            const FdmSchemeDesc& schemeDesc);
+
+        Real interpolateAt(const std::vector<Real>& x) const;
+
+        //! number of full grids in the combination
+        Size numberOfGrids() const;
+        //! total number of grid points of all full grids
+        Size numberOfPoints() const;
+
+      protected:
+        void performCalculations() const override;
+
+      private:
+        struct Grid {
+            std::vector<Size> dim;
+            Real coefficient;
+            std::vector<std::vector<Real> > locations;
+            Array values;
+        };
+
+        Real interpolateAt(const Grid& grid, const std::vector<Real>& x) const;
+
+        const Size dimensions_;
+        const FdmSparseGridDesc sparseGridDesc_;
+        const SolverDescGenerator solverDescGenerator_;
+        const OperatorGenerator operatorGenerator_;
+        const FdmSchemeDesc schemeDesc_;
+
+        mutable std::vector<Grid> grids_;
+    };
+}
+
+#endif
@@ -0,0 +1,130 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <https://www.quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/methods/finitedifferences/utilities/fdmilupreconditioner.hpp>
+#include <set>
+
+namespace QuantLib {
+
+    FdmILUPreconditioner::FdmILUPreconditioner(Size fillLevel)
+    : fillLevel_(fillLevel) {}
+
+    void FdmILUPreconditioner::build(const CompressedSparseMatrix& a) {
+        factorize(a);
+    }
+
+    void FdmILUPreconditioner::factorize(const CompressedSparseMatrix& a) {
+        QL_REQUIRE(a.rows() == a.columns(), "square matrix required");
+        const Size n = a.rows();
+        const std::vector<Size>& rowStart = a.rowStart();
+        const std::vector<Size>& columns = a.columnIndices();
+        const std::vector<Real>& values = a.values();
+
+        lStart_.assign(1, 0);
+        uStart_.assign(1, 0);
+        lColumns_.clear(); lValues_.clear();
+        uColumns_.clear(); uValues_.clear();
+        invDiag_.resize(n);
+
+        // levels of fill of the rows of U, needed for the fill-in of
+        // the following rows
+        std::vector<Size> uLevels;
+
+        std::vector<Real> w(n, 0.0);
+        std::vector<Size> level(n);
+        std::set<Size> pattern;
+
+        for (Size i=0; i < n; ++i) {
+            pattern.clear();
+            for (Size k=rowStart[i]; k < rowStart[i+1]; ++k) {
+                const Size j = columns[k];
+                w[j] = values[k];
+                level[j] = 0;
+                pattern.insert(j);
+            }
+            if (pattern.insert(i).second) {
+                w[i] = 0.0;
+                level[i] = 0;
+            }
+
+            // elements inserted during the iteration are larger than
+            // the current column and are visited later on
+            for (auto iter = pattern.begin(); *iter < i; ++iter) {
+                const Size j = *iter;
+                const Real fact = w[j] *= invDiag_[j];
+
+                for (Size k=uStart_[j]+1; k < uStart_[j+1]; ++k) {
+                    const Size c = uColumns_[k];
+                    const Size lev = level[j] + uLevels[k] + 1;
+                    if (pattern.count(c) != 0U) {
+                        w[c] -= fact*uValues_[k];
+                        level[c] = std::min(level[c], lev);
+                    }
+                    else if (lev <= fillLevel_) {
+                        pattern.insert(c);
+                        w[c] = -fact*uValues_[k];
+                        level[c] = lev;
+                    }
+                }
+            }
+
+            for (Size j : pattern) {
+                if (j < i) {
+                    lColumns_.push_back(j);
+                    lValues_.push_back(w[j]);
+                }
+                else {
+                    uColumns_.push_back(j);
+                    uValues_.push_back(w[j]);
+                    uLevels.push_back(level[j]);
+                }
+            }
+            lStart_.push_back(lColumns_.size());
+            uStart_.push_back(uColumns_.size());
+
+            QL_REQUIRE(w[i] != 0.0, "zero pivot in row " << i);
+            invDiag_[i] = 1.0/w[i];
+        }
+    }
+
+    Array FdmILUPreconditioner::apply(const Array& r) const {
+        Array x(r);
+        solve(x);
+        return x;
+    }
+
+    void FdmILUPreconditioner::solve(Array& x) const {
+        const Size n = invDiag_.size();
+        QL_REQUIRE(x.size() == n, "inconsistent size of rhs");
+
+        for (Size i=0; i < n; ++i) {
+            Real s = x[i];
+            for (Size k=lStart_[i]; k < lStart_[i+1]; ++k)
+                s -= lValues_[k]*x[lColumns_[k]];
+            x[i] = s;
+        }
+        for (Size i=n; i-- > 0;) {
+            Real s = x[i];
+            // the first element of each row of U is the diagonal
+            for (Size k=uStart_[i]+1; k < uStart_[i+1]; ++k)
+                s -= uValues_[k]*x[uColumns_[k]];
+            x[i] = s*invDiag_[i];
+        }
+    }
+
+}
@@ -0,0 +1,64 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <https://www.quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file fdmilupreconditioner.hpp
+    \brief incomplete LU preconditioner for implicit FD schemes
+*/
+
+#ifndef quantlib_fdm_ilu_preconditioner_hpp
+#define quantlib_fdm_ilu_preconditioner_hpp
+
+#include <ql/methods/finitedifferences/utilities/fdmlinearoppreconditioner.hpp>
+
+namespace QuantLib {
+
+    //! ILU(k) preconditioner
+    /*! Incomplete LU factorization with level-of-fill k, see
+        Saad, Yousef. 2003, Iterative methods for sparse linear
+        systems, 2nd edition, section 10.3. ILU(0) keeps the sparsity
+        pattern of the matrix.
+
+        Unlike SparseILUPreconditioner, the factorization works on
+        a CompressedSparseMatrix and its cost is proportional to the number
+        of non-zero elements, which makes it usable for
+        three-dimensional problems.
+    */
+    class FdmILUPreconditioner : public FdmLinearOpPreconditioner {
+      public:
+        explicit FdmILUPreconditioner(Size fillLevel = 0);
+
+        Array apply(const Array& r) const override;
+
+        //! overwrites x with the solution of LU y = x
+        void solve(Array& x) const;
+
+        void factorize(const CompressedSparseMatrix& a);
+
+      protected:
+        void build(const CompressedSparseMatrix& a) override;
+
+      private:
+        const Size fillLevel_;
+        // strictly lower part of L (unit diagonal) and upper part of U
+        std::vector<Size> lStart_, lColumns_, uStart_, uColumns_;
+        std::vector<Real> lValues_, uValues_, invDiag_;
+    };
+
+}
+
+#endif
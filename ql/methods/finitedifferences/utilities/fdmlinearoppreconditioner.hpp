@@ -0,0 +1,66 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <https://www.quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file fdmlinearoppreconditioner.hpp
+    \brief algebraic preconditioners for implicit finite-difference schemes
+*/
+
+#ifndef quantlib_fdm_linear_op_preconditioner_hpp
+#define quantlib_fdm_linear_op_preconditioner_hpp
+
+#include <ql/methods/finitedifferences/operators/fdmlinearopcomposite.hpp>
+#include <ql/utilities/null.hpp>
+
+namespace QuantLib {
+
+    //! preconditioner for the linear systems of implicit schemes
+    /*! Implicit schemes solve systems of the form \f$ (I + sL) x = r \f$
+        with Krylov methods. Derived classes build an approximate
+        inverse of \f$ I + sL \f$ from the sparse matrix representation
+        of the operator \f$ L \f$. As the factorization is expensive
+        compared to a single time step, it is reused as long as
+        \f$ s \f$ does not change; time dependence of the operator in
+        between is ignored, which only affects the number of
+        iterations and not the solution.
+    */
+    class FdmLinearOpPreconditioner {
+      public:
+        virtual ~FdmLinearOpPreconditioner() = default;
+
+        //! prepares the preconditioner for the matrix I + s*map
+        void setup(const FdmLinearOpComposite& map, Real s) {
+            if (s != s_) {
+                const CompressedSparseMatrix m = map.toCompressedMatrix();
+                build(s*m + identitySparseMatrix(m.rows()));
+                s_ = s;
+            }
+        }
+
+        //! approximate solution of (I + s*map) x = r
+        virtual Array apply(const Array& r) const = 0;
+
+      protected:
+        virtual void build(const CompressedSparseMatrix& a) = 0;
+
+      private:
+        Real s_ = Null<Real>();
+    };
+
+}
+
+#endif
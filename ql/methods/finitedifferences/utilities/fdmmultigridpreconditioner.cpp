@@ -0,0 +1,205 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <https://www.quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/methods/finitedifferences/meshers/fdmmesher.hpp>
+#include <ql/methods/finitedifferences/operators/fdmlinearoplayout.hpp>
+#include <ql/methods/finitedifferences/utilities/fdmmultigridpreconditioner.hpp>
+#include <algorithm>
+#include <numeric>
+#include <utility>
+
+namespace QuantLib {
+
+    FdmMultigridPreconditioner::FdmMultigridPreconditioner(
+        ext::shared_ptr<FdmMesher> mesher,
+        Size smoothingSteps, Size maxCoarsestSize)
+    : mesher_(std::move(mesher)),
+      smoothingSteps_(smoothingSteps), maxCoarsestSize_(maxCoarsestSize) {
+        QL_REQUIRE(maxCoarsestSize_ > 0, "positive coarsest size required");
+    }
+
+    Size FdmMultigridPreconditioner::levels() const {
+        return levels_.size();
+    }
+
+    void FdmMultigridPreconditioner::build(const CompressedSparseMatrix& m) {
+        const ext::shared_ptr<FdmLinearOpLayout> layout = mesher_->layout();
+        QL_REQUIRE(m.rows() == layout->size() && m.columns() == layout->size(),
+                   "inconsistent size of operator and mesher");
+
+        levels_.clear();
+        levels_.emplace_back();
+        levels_.back().a = m;
+        levels_.back().dim = layout->dim();
+        for (Size d=0; d < layout->dim().size(); ++d) {
+            const Array x = mesher_->locations(d);
+            std::vector<Real> locations(layout->dim()[d]);
+            for (Size j=0; j < locations.size(); ++j)
+                locations[j] = x[j*layout->spacing()[d]];
+            levels_.back().locations.push_back(locations);
+        }
+
+        while (true) {
+            Level& fine = levels_.back();
+            const Size n = fine.a.rows();
+            const Size nDim = fine.dim.size();
+
+            bool coarsen = false;
+            for (Size d=0; d < nDim; ++d)
+                coarsen = coarsen || fine.dim[d] >= 5;
+            if (!coarsen || n <= maxCoarsestSize_)
+                break;
+
+            // one-dimensional interpolation weights; every other point
+            // is kept, the last one always.
+            Level coarse;
+            std::vector<std::vector<std::vector<std::pair<Size, Real> > > >
+                weights(nDim);
+            for (Size d=0; d < nDim; ++d) {
+                const std::vector<Real>& x = fine.locations[d];
+                const Size nd = fine.dim[d];
+                weights[d].resize(nd);
+
+                if (nd < 5) {
+                    for (Size j=0; j < nd; ++j)
+                        weights[d][j].emplace_back(j, 1.0);
+                    coarse.dim.push_back(nd);
+                    coarse.locations.push_back(x);
+                    continue;
+                }
+
+                std::vector<Real> xc;
+                for (Size j=0; j < nd; ++j) {
+                    if (j % 2 == 0 || j == nd-1) {
+                        weights[d][j].emplace_back(xc.size(), 1.0);
+                        xc.push_back(x[j]);
+                    }
+                }
+                for (Size j=1; j < nd-1; j+=2) {
+                    const Size left = j/2;
+                    const Real wr = (x[j]-x[j-1])/(x[j+1]-x[j-1]);
+                    weights[d][j].emplace_back(left, 1.0-wr);
+                    weights[d][j].emplace_back(left+1, wr);
+                }
+                coarse.dim.push_back(xc.size());
+                coarse.locations.push_back(xc);
+            }
+
+            // tensor product of the one-dimensional prolongations
+            std::vector<Size> coarseSpacing(nDim, 1);
+            for (Size d=1; d < nDim; ++d)
+                coarseSpacing[d] = coarseSpacing[d-1]*coarse.dim[d-1];
+            const Size nc = coarseSpacing.back()*coarse.dim.back();
+
+            std::vector<CompressedSparseMatrix::Triplet> triplets;
+            std::vector<Size> coordinates(nDim, 0);
+            std::vector<std::pair<Size, Real> > row, next;
+            for (Size i=0; i < n; ++i) {
+                row.assign(1, std::make_pair(Size(0), 1.0));
+                for (Size d=0; d < nDim; ++d) {
+                    next.clear();
+                    for (const auto& r : row)
+                        for (const auto& w : weights[d][coordinates[d]])
+                            next.emplace_back(
+                                r.first + w.first*coarseSpacing[d],
+                                r.second*w.second);
+                    row.swap(next);
+                }
+                for (const auto& r : row)
+                    triplets.push_back({i, r.first, r.second});
+
+                for (Size d=0; d < nDim && ++coordinates[d] == fine.dim[d]; ++d)
+                    coordinates[d] = 0;
+            }
+            fine.p = CompressedSparseMatrix(n, nc, triplets);
+            fine.r = transpose(fine.p);
+
+            coarse.a = prod(fine.r, prod(fine.a, fine.p));
+            levels_.push_back(std::move(coarse));
+        }
+
+        for (Size l=0; l+1 < levels_.size(); ++l) {
+            levels_[l].smoother.factorize(levels_[l].a);
+            levels_[l].residual = Array(levels_[l].a.rows());
+        }
+        for (Size l=1; l < levels_.size(); ++l) {
+            levels_[l].b = Array(levels_[l].a.rows());
+            levels_[l].x = Array(levels_[l].a.rows());
+        }
+
+        const CompressedSparseMatrix& a = levels_.back().a;
+        Matrix coarsest(a.rows(), a.columns(), 0.0);
+        for (Size i=0; i < a.rows(); ++i)
+            for (Size k=a.rowStart()[i]; k < a.rowStart()[i+1]; ++k)
+                coarsest[i][a.columnIndices()[k]] = a.values()[k];
+        coarsestInverse_ = inverse(coarsest);
+    }
+
+    void FdmMultigridPreconditioner::smooth(
+        const Level& level, const Array& b, Array& x) const {
+
+        Array& r = level.residual;
+        for (Size s=0; s < smoothingSteps_; ++s) {
+            prod(level.a, x, r);
+            for (Size i=0; i < r.size(); ++i)
+                r[i] = b[i] - r[i];
+            level.smoother.solve(r);
+            x += r;
+        }
+    }
+
+    void FdmMultigridPreconditioner::vCycle(
+        Size l, const Array& b, Array& x) const {
+
+        if (l == levels_.size()-1) {
+            for (Size i=0; i < x.size(); ++i)
+                x[i] = std::inner_product(coarsestInverse_.row_begin(i),
+                                          coarsestInverse_.row_end(i),
+                                          b.begin(), Real(0.0));
+            return;
+        }
+
+        const Level& level = levels_[l];
+        const Level& coarse = levels_[l+1];
+
+        smooth(level, b, x);
+
+        Array& r = level.residual;
+        prod(level.a, x, r);
+        for (Size i=0; i < r.size(); ++i)
+            r[i] = b[i] - r[i];
+        prod(level.r, r, coarse.b);
+        std::fill(coarse.x.begin(), coarse.x.end(), 0.0);
+        vCycle(l+1, coarse.b, coarse.x);
+        prod(level.p, coarse.x, r);
+        x += r;
+
+        smooth(level, b, x);
+    }
+
+    Array FdmMultigridPreconditioner::apply(const Array& r) const {
+        QL_REQUIRE(!levels_.empty(), "preconditioner not set up");
+        QL_REQUIRE(r.size() == levels_.front().a.rows(),
+                   "inconsistent size of rhs");
+
+        Array x(r.size(), 0.0);
+        vCycle(0, r, x);
+        return x;
+    }
+
+}
@@ -0,0 +1,101 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <https://www.quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file fdmmultigridpreconditioner.hpp
+    \brief geometric multigrid preconditioner for implicit FD schemes
+*/
+
+#ifndef quantlib_fdm_multigrid_preconditioner_hpp
+#define quantlib_fdm_multigrid_preconditioner_hpp
+
+#include <ql/math/matrix.hpp>
+#include <ql/methods/finitedifferences/utilities/fdmilupreconditioner.hpp>
+
+namespace QuantLib {
+
+    class FdmMesher;
+
+    //! geometric multigrid preconditioner
+    /*! One V-cycle on a hierarchy of grids obtained by dropping every
+        other point of the mesher along each direction with at least
+        five points. Prolongation is linear interpolation in the mesher
+        locations, restriction its transpose, and the coarse operators
+        are the Galerkin products \f$ R A P \f$, hence non-uniform
+        meshers and mixed derivatives are handled without further
+        information. Incomplete LU factorizations are used for
+        smoothing, as Gauss-Seidel sweeps diverge for the
+        convection-dominated operators with mixed derivatives
+        typical of stochastic volatility models; the coarsest system
+        is solved directly.
+
+        The cost of an application is proportional to the number of
+        grid points, which makes the preconditioner suitable for
+        three-dimensional problems where the directional splitting
+        needs many iterations. The work arrays of all levels are
+        allocated when the hierarchy is built, hence an application
+        only allocates its result.
+
+        The preconditioner is passed to ImplicitEulerScheme or
+        CrankNicolsonScheme on construction; it is not available
+        through FdmSchemeDesc and the engines, as it needs the mesher
+        of the problem.
+
+        \warning The work arrays are shared by all applications, hence
+                 the same instance must not be applied concurrently.
+    */
+    class FdmMultigridPreconditioner : public FdmLinearOpPreconditioner {
+      public:
+        explicit FdmMultigridPreconditioner(
+            ext::shared_ptr<FdmMesher> mesher,
+            Size smoothingSteps = 2,
+            Size maxCoarsestSize = 512);
+
+        Array apply(const Array& r) const override;
+
+        //! number of grids, the finest one included
+        Size levels() const;
+
+      protected:
+        void build(const CompressedSparseMatrix& a) override;
+
+      private:
+        struct Level {
+            CompressedSparseMatrix a;
+            FdmILUPreconditioner smoother;
+            // prolongation to this level from the next coarser one
+            // and restriction from this level to the coarser one
+            CompressedSparseMatrix p, r;
+            std::vector<Size> dim;
+            std::vector<std::vector<Real> > locations;
+            // work arrays: right-hand side and solution on the coarser
+            // levels, residual and correction on all but the coarsest
+            mutable Array b, x, residual;
+        };
+
+        void vCycle(Size l, const Array& b, Array& x) const;
+        void smooth(const Level& level, const Array& b, Array& x) const;
+
+        const ext::shared_ptr<FdmMesher> mesher_;
+        const Size smoothingSteps_, maxCoarsestSize_;
+        std::vector<Level> levels_;
+        Matrix coarsestInverse_;
+    };
+
+}
+
+#endif
@@ -16,5 +16,6 @@
 #include <ql/methods/montecarlo/path.hpp>
 #include <ql/methods/montecarlo/pathgenerator.hpp>
 #include <ql/methods/montecarlo/pathpricer.hpp>
+#include <ql/methods/montecarlo/pathwisegreeks.hpp>
 #include <ql/methods/montecarlo/sample.hpp>
 
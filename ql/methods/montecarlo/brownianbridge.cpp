@@ -109,5 +109,44 @@ namespace QuantLib {
         }
     }
 
+    void BrownianBridge::transformBlock(const Real* input,
+                                        Real* output,
+                                        Size paths) const {
+        // We use output to store the paths...
+        Real* last = output + (size_-1)*paths;
+        const Real sigma0 = stdDev_[0];
+        for (Size p=0; p<paths; ++p)
+            last[p] = sigma0 * input[p];
+        for (Size i=1; i<size_; ++i) {
+            // the coefficients are copied into local variables so
+            // that they don't need to be reloaded after each store
+            const Size j = leftIndex_[i];
+            const Real wl = leftWeight_[i], wr = rightWeight_[i];
+            const Real sigma = stdDev_[i];
+            const Real* in = input + i*paths;
+            const Real* right = output + rightIndex_[i]*paths;
+            Real* out = output + bridgeIndex_[i]*paths;
+            if (j != 0) {
+                const Real* left = output + (j-1)*paths;
+                for (Size p=0; p<paths; ++p)
+                    out[p] = wl * left[p] + wr * right[p] + sigma * in[p];
+            } else {
+                for (Size p=0; p<paths; ++p)
+                    out[p] = wr * right[p] + sigma * in[p];
+            }
+        }
+        // ...after which, we calculate the variations and
+        // normalize to unit times
+        for (Size i=size_-1; i>=1; --i) {
+            const Real sqrtdt = sqrtdt_[i];
+            Real* current = output + i*paths;
+            const Real* previous = current - paths;
+            for (Size p=0; p<paths; ++p)
+                current[p] = (current[p] - previous[p]) / sqrtdt;
+        }
+        const Real sqrtdt0 = sqrtdt_[0];
+        for (Size p=0; p<paths; ++p)
+            output[p] /= sqrtdt0;
+    }
 }
 
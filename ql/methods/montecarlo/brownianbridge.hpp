@@ -135,6 +135,23 @@ namespace QuantLib {
             }
             output[0] /= sqrtdt_[0];
         }
+
+        //! Brownian-bridge generator function for a block of paths
+        /*! Transforms the random variates of several paths at once.
+            Both input and output are stored variate by variate,
+            i.e., the i-th variate of the p-th path is found at
+            position <tt>i*paths+p</tt>; the inner loops run over
+            contiguous memory and can be vectorized by the compiler.
+            The results are the same that would be obtained by
+            transforming each path separately.
+
+            \param input  The input sequences (size()*paths values).
+            \param output The output sequences (size()*paths values);
+                          it must not overlap with the input.
+            \param paths  The number of paths in the block.
+        */
+        void transformBlock(const Real* input, Real* output,
+                            Size paths) const;
       private:
         void initialize();
         Size size_;
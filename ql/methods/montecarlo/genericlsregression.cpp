@@ -18,7 +18,6 @@
 */
 
 #include <ql/methods/montecarlo/genericlsregression.hpp>
-#include <ql/math/statistics/sequencestatistics.hpp>
 #include <ql/math/matrixutilities/svd.hpp>
 
 namespace QuantLib {
@@ -30,38 +29,69 @@ namespace QuantLib {
         Size steps = simulationData.size();
         basisCoefficients.resize(steps-1);
 
+        // means of the basis function values (and deflated cash-flows)
+        // and sums of the products of their deviations; only the lower
+        // triangle is accumulated. They are allocated once and reused
+        // for all exercise dates.
+        std::vector<Real> means, deltas, coMoments;
+
         for (Size i=steps-1; i!=0; --i) {
 
             std::vector<NodeData>& exerciseData = simulationData[i];
 
             // 1) find the covariance matrix of basis function values and
-            //    deflated cash-flows
+            //    deflated cash-flows.  The moments are updated path by
+            //    path as in Welford's algorithm rather than through
+            //    SequenceStatistics, which would store every sample and
+            //    allocate an outer-product matrix per path.
             Size N = exerciseData.front().values.size();
-            std::vector<Real> temp(N+1);
-            SequenceStatistics stats(N+1);
+            means.assign(N+1, 0.0);
+            deltas.resize(N+1);
+            coMoments.assign((N+1)*(N+2)/2, 0.0);
+            Size samples = 0;
 
             Size j;
             for (j=0; j<exerciseData.size(); ++j) {
                 if (exerciseData[j].isValid) {
-                    std::copy(exerciseData[j].values.begin(),
-                              exerciseData[j].values.end(),
-                              temp.begin());
-                    temp.back() = exerciseData[j].cumulatedCashFlows
-                                - exerciseData[j].controlValue;
-
-                    stats.add(temp);
+                    const std::vector<Real>& values = exerciseData[j].values;
+                    const Real y = exerciseData[j].cumulatedCashFlows
+                                 - exerciseData[j].controlValue;
+
+                    ++samples;
+                    const Real w = 1.0/samples;
+                    for (Size k=0; k<N; ++k) {
+                        deltas[k] = values[k] - means[k];
+                        means[k] += w*deltas[k];
+                    }
+                    deltas[N] = y - means[N];
+                    means[N] += w*deltas[N];
+
+                    // the deviation from the updated mean is (1-w)*delta
+                    Real* q = &coMoments[0];
+                    for (Size k=0; k<=N; ++k) {
+                        const Real dk = (1.0-w)*deltas[k];
+                        for (Size l=0; l<=k; ++l)
+                            *q++ += dk*deltas[l];
+                    }
                 }
             }
 
-            std::vector<Real> means = stats.mean();
-            Matrix covariance = stats.covariance();
+            QL_REQUIRE(samples > 0, "sampleWeight=0, unsufficient");
+            QL_REQUIRE(samples > 1, "sample number <=1, unsufficient");
+
+            // unbiased covariance plus means*means, as previously
+            // obtained from SequenceStatistics
+            const Real inv = 1.0/(samples-1.0);
+            auto secondMoment = [&](Size k, Size l) -> Real {
+                return coMoments[k*(k+1)/2 + l]*inv + means[k]*means[l];
+            };
 
             Matrix C(N,N);
             Array target(N);
             for (Size k=0; k<N; ++k) {
-                target[k] = covariance[k][N] + means[k]*means[N];
+                target[k] = secondMoment(N, k);
                 for (Size l=0; l<=k; ++l)
-                    C[k][l] = C[l][k] = covariance[k][l] + means[k]*means[l];
+                    C[k][l] = C[l][k] = secondMoment(k, l);
             }
 
             // 2) solve for least squares regression
@@ -99,12 +129,13 @@ namespace QuantLib {
 
         // the value of the product can now be estimated by averaging
         // over all paths
-        Statistics estimate;
-        std::vector<NodeData>& estimatedData = simulationData[0];
-        for (auto& j : estimatedData)
-            estimate.add(j.cumulatedCashFlows);
+        const std::vector<NodeData>& estimatedData = simulationData[0];
+        QL_REQUIRE(!estimatedData.empty(), "empty sample set");
+        Real sum = 0.0;
+        for (const auto& j : estimatedData)
+            sum += j.cumulatedCashFlows;
 
-        return estimate.mean();
+        return sum/estimatedData.size();
     }
 
 }
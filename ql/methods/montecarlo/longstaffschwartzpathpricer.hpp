@@ -44,6 +44,10 @@ namespace QuantLib {
         by Simulation: A Simple Least-Squares Approach, The Review of
         Financial Studies, Volume 14, No. 1, 113-147
 
+        \warning When OpenMP is enabled, the basis functions are
+                 evaluated concurrently on the in-the-money paths;
+                 they must therefore be thread-safe.
+
         \ingroup mcarlo
 
         \test the correctness of the returned value is tested by
@@ -169,21 +173,33 @@ namespace QuantLib {
                 }
             }
 
-            if (v_.size() <=  x.size()) {
-                coeff_[i-1] = GeneralLinearLeastSquares(x, y, v_).coefficients();
+            // evaluate the basis functions only once per itm path; the
+            // values are used both for the regression and for the
+            // continuation values below
+            const Size m = v_.size();
+            Matrix basisValues(x.size(), m);
+            #pragma omp parallel for
+            for (long k=0; k<(long)x.size(); ++k) {
+                for (Size l=0; l<m; ++l)
+                    basisValues[k][l] = v_[l](x[k]);
+            }
+
+            if (m <= x.size()) {
+                coeff_[i-1] =
+                    GeneralLinearLeastSquares(basisValues, y).coefficients();
             }
             else {
             // if number of itm paths is smaller then the number of
             // calibration functions then early exercise if exerciseValue > 0
-                coeff_[i-1] = Array(v_.size(), 0.0);
+                coeff_[i-1] = Array(m, 0.0);
             }
 
             for (Size j=0, k=0; j<n; ++j) {
                 prices[j]*=dF_[i];
                 if (exercise[j]>0.0) {
                     Real continuationValue = 0.0;
-                    for (Size l=0; l<v_.size(); ++l) {
-                        continuationValue += coeff_[i-1][l] * v_[l](x[k]);
+                    for (Size l=0; l<m; ++l) {
+                        continuationValue += coeff_[i-1][l] * basisValues[k][l];
                     }
                     if (continuationValue < exercise[j]) {
                         prices[j] = exercise[j];
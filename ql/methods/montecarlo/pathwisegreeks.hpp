@@ -0,0 +1,137 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <https://www.quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file pathwisegreeks.hpp
+    \brief accumulator for Greeks estimated path by path
+*/
+
+#ifndef quantlib_montecarlo_pathwise_greeks_hpp
+#define quantlib_montecarlo_pathwise_greeks_hpp
+
+#include <ql/any.hpp>
+#include <ql/math/statistics/incrementalstatistics.hpp>
+#include <ql/utilities/null.hpp>
+#include <map>
+#include <string>
+
+namespace QuantLib {
+
+    //! accumulator for Greeks estimated path by path
+    /*! Path pricers can feed an instance of this class with the
+        derivatives of the discounted payoff on each simulated path
+        (either pathwise derivatives or likelihood-ratio estimators),
+        so that delta, vega and rho are obtained in the same sweep as
+        the price and from the same random numbers.
+
+        When antithetic variates are used, MonteCarloModel calls the
+        path pricer on each path and on its antithetic in sequence;
+        the two estimators are averaged before being accumulated so
+        that the error estimates are consistent with the one of the
+        price.
+
+        \ingroup mcarlo
+    */
+    class PathwiseGreeks {
+      public:
+        explicit PathwiseGreeks(bool antitheticVariate = false)
+        : antitheticVariate_(antitheticVariate) {}
+        //! \name Modifiers
+        //@{
+        /*! adds the estimators obtained on a single path; a null
+            value marks a Greek which is not available.
+        */
+        void add(Real delta, Real vega, Real rho);
+        void reset();
+        //@}
+        //! \name Inspectors
+        //@{
+        const IncrementalStatistics& delta() const { return delta_; }
+        const IncrementalStatistics& vega() const { return vega_; }
+        const IncrementalStatistics& rho() const { return rho_; }
+        //@}
+        /*! writes the estimated Greeks (as "delta", "vega" and "rho")
+            and, if required, their error estimates (as "deltaError",
+            "vegaError" and "rhoError") into the given results.
+        */
+        void addTo(std::map<std::string, ext::any>& results,
+                   bool withErrorEstimates) const;
+      private:
+        static void add(IncrementalStatistics& stats, Real value) {
+            if (value != Null<Real>())
+                stats.add(value);
+        }
+        static void addTo(std::map<std::string, ext::any>& results,
+                          const std::string& name,
+                          const IncrementalStatistics& stats,
+                          bool withErrorEstimate) {
+            if (stats.samples() == 0)
+                return;
+            results[name] = stats.mean();
+            if (withErrorEstimate && stats.samples() > 1)
+                results[name + "Error"] = stats.errorEstimate();
+        }
+        bool antitheticVariate_;
+        bool pending_ = false;
+        Real pendingDelta_, pendingVega_, pendingRho_;
+        IncrementalStatistics delta_, vega_, rho_;
+    };
+
+
+    // inline definitions
+
+    inline void PathwiseGreeks::add(Real delta, Real vega, Real rho) {
+        if (!antitheticVariate_) {
+            add(delta_, delta);
+            add(vega_, vega);
+            add(rho_, rho);
+        } else if (!pending_) {
+            pendingDelta_ = delta;
+            pendingVega_ = vega;
+            pendingRho_ = rho;
+            pending_ = true;
+        } else {
+            auto average = [](Real x, Real y) {
+                return (x == Null<Real>() || y == Null<Real>()) ?
+                    Null<Real>() : Real((x+y)/2.0);
+            };
+            add(delta_, average(pendingDelta_, delta));
+            add(vega_, average(pendingVega_, vega));
+            add(rho_, average(pendingRho_, rho));
+            pending_ = false;
+        }
+    }
+
+    inline void PathwiseGreeks::reset() {
+        pending_ = false;
+        delta_.reset();
+        vega_.reset();
+        rho_.reset();
+    }
+
+    inline void PathwiseGreeks::addTo(
+                                std::map<std::string, ext::any>& results,
+                                bool withErrorEstimates) const {
+        addTo(results, "delta", delta_, withErrorEstimates);
+        addTo(results, "vega", vega_, withErrorEstimates);
+        addTo(results, "rho", rho_, withErrorEstimates);
+    }
+
+}
+
+
+#endif
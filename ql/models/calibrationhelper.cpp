@@ -20,6 +20,8 @@
 
 #include <ql/models/calibrationhelper.hpp>
 #include <ql/math/solvers1d/brent.hpp>
+#include <ql/instrument.hpp>
+#include <ql/pricingengines/modelgradientengine.hpp>
 
 namespace QuantLib {
 
@@ -36,14 +38,32 @@ namespace QuantLib {
     }
 
     Real BlackCalibrationHelper::calibrationError() {
-        Real error;
+        return calibrationError(modelValue(), nullptr);
+    }
+
+    Real BlackCalibrationHelper::calibrationErrorAndGradient(Array& gradient) {
+        const Real modelPrice = modelValueAndGradient(gradient);
+        if (gradient.empty())
+            return calibrationError(modelPrice, nullptr);
+
+        Real dErrorDPrice;
+        const Real error = calibrationError(modelPrice, &dErrorDPrice);
+        gradient *= dErrorDPrice;
+        return error;
+    }
+
+    Real BlackCalibrationHelper::calibrationError(
+        Real modelPrice, Real* dErrorDPrice) const {
+        Real error, dError;
         
         switch (calibrationErrorType_) {
           case RelativePriceError:
-            error = std::fabs(marketValue() - modelValue())/marketValue();
+            error = std::fabs(marketValue() - modelPrice)/marketValue();
+            dError = ((marketValue() > modelPrice) ? -1.0 : 1.0)/marketValue();
             break;
           case PriceError:
-            error = marketValue() - modelValue();
+            error = marketValue() - modelPrice;
+            dError = -1.0;
             break;
           case ImpliedVolError: 
             {
@@ -51,23 +71,66 @@ namespace QuantLib {
               Real maxVol = volatilityType_ == ShiftedLognormal ? 10.0 : 0.50;
               const Real lowerPrice = blackPrice(minVol);
               const Real upperPrice = blackPrice(maxVol);
-              const Real modelPrice = modelValue();
 
               Volatility implied;
+              dError = 0.0;
               if (modelPrice <= lowerPrice)
                   implied = minVol;
               else if (modelPrice >= upperPrice)
                   implied = maxVol;
-              else
+              else {
                   implied = this->impliedVolatility(
                                           modelPrice, 1e-12, 5000, minVol, maxVol);
+                  if (dErrorDPrice != nullptr) {
+                      // the Black price is cheap, hence the vega is
+                      // taken from central differences
+                      const Real h = 1e-4*implied;
+                      dError = 2.0*h/(blackPrice(implied + h)
+                                      - blackPrice(implied - h));
+                  }
+              }
               error = implied - volatility_->value();
             }
             break;
           default:
             QL_FAIL("unknown Calibration Error Type");
         }
-        
+
+        if (dErrorDPrice != nullptr)
+            *dErrorDPrice = dError;
+
         return error;
     }
+
+    Real BlackCalibrationHelper::instrumentValueAndGradient(
+        Instrument& instrument, Array& gradient) const {
+
+        gradient = Array();
+        const ext::shared_ptr<ModelGradientEngine> gradientEngine =
+            ext::dynamic_pointer_cast<ModelGradientEngine>(engine_);
+        if (gradientEngine == nullptr) {
+            instrument.setPricingEngine(engine_);
+            return instrument.NPV();
+        }
+
+        gradientEngine->enableModelGradient();
+        Real value;
+        try {
+            // setting the engine forces the recalculation
+            instrument.setPricingEngine(engine_);
+            value = instrument.NPV();
+        } catch (...) {
+            gradientEngine->enableModelGradient(false);
+            throw;
+        }
+        gradientEngine->enableModelGradient(false);
+
+        const std::map<std::string, ext::any>& results =
+            instrument.additionalResults();
+        const auto iter = results.find("modelParameterGradient");
+        if (iter != results.end())
+            gradient = ext::any_cast<Array>(iter->second);
+
+        return value;
+    }
 }
@@ -25,6 +25,7 @@
 #ifndef quantlib_interest_rate_modelling_calibration_helper_h
 #define quantlib_interest_rate_modelling_calibration_helper_h
 
+#include <ql/math/array.hpp>
 #include <ql/patterns/lazyobject.hpp>
 #include <ql/quote.hpp>
 #include <ql/termstructures/volatility/volatilitytype.hpp>
@@ -34,6 +35,7 @@
 
 namespace QuantLib {
 
+    class Instrument;
     class PricingEngine;
 
     //! abstract base class for calibration helpers
@@ -42,6 +44,15 @@ namespace QuantLib {
         virtual ~CalibrationHelper() = default;
         //! returns the error resulting from the model valuation
         virtual Real calibrationError() = 0;
+        //! returns the error and its derivatives w.r.t. the model parameters
+        /*! The derivatives are ordered as in CalibratedModel::params().
+            The default implementation returns an empty gradient, i.e.,
+            the derivatives are not available.
+        */
+        virtual Real calibrationErrorAndGradient(Array& gradient) {
+            gradient = Array();
+            return calibrationError();
+        }
     };
 
     //! liquid Black76 market instrument used during calibration
@@ -69,15 +80,31 @@ namespace QuantLib {
         //! returns the volatility type
         VolatilityType volatilityType() const { return volatilityType_; }
 
+        //! returns the calibration error type
+        CalibrationErrorType calibrationErrorType() const {
+            return calibrationErrorType_;
+        }
+
         //! returns the actual price of the instrument (from volatility)
         Real marketValue() const { calculate(); return marketValue_; }
 
         //! returns the price of the instrument according to the model
         virtual Real modelValue() const = 0;
 
+        //! returns the model price and its derivatives w.r.t. the model parameters
+        /*! The gradient is left empty if the derivatives are not
+            available, which is the default.
+        */
+        virtual Real modelValueAndGradient(Array& gradient) const {
+            gradient = Array();
+            return modelValue();
+        }
+
         //! returns the error resulting from the model valuation
         Real calibrationError() override;
 
+        Real calibrationErrorAndGradient(Array& gradient) override;
+
         virtual void addTimesTo(std::list<Time>& times) const = 0;
 
         //! Black volatility implied by the model
@@ -95,6 +122,13 @@ namespace QuantLib {
         }
 
       protected:
+        /*! value of the instrument priced by the engine and, if the
+            engine is a ModelGradientEngine providing them, its
+            derivatives w.r.t. the model parameters
+        */
+        Real instrumentValueAndGradient(Instrument& instrument,
+                                        Array& gradient) const;
+
         mutable Real marketValue_;
         Handle<Quote> volatility_;
         ext::shared_ptr<PricingEngine> engine_;
@@ -102,6 +136,8 @@ namespace QuantLib {
         const Real shift_;
 
       private:
+        Real calibrationError(Real modelPrice, Real* dErrorDPrice) const;
+
         const CalibrationErrorType calibrationErrorType_;
     };
 
@@ -3,6 +3,7 @@
 
 #include <ql/models/equity/batesmodel.hpp>
 #include <ql/models/equity/gjrgarchmodel.hpp>
+#include <ql/models/equity/hestoncharacteristicfunction.hpp>
 #include <ql/models/equity/hestonmodel.hpp>
 #include <ql/models/equity/hestonmodelhelper.hpp>
 #include <ql/models/equity/hestonslvfdmmodel.hpp>
@@ -0,0 +1,78 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <https://www.quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/models/equity/hestoncharacteristicfunction.hpp>
+
+namespace QuantLib {
+
+    namespace detail {
+
+        std::complex<Real> hestonLnChF(const std::complex<Real>& z, Time t,
+                                       Real theta, Real kappa, Real sigma,
+                                       Real rho, Real v0,
+                                       std::complex<Real>* dLnChF) {
+            typedef std::complex<Real> Complex;
+
+            const Complex iz = Complex(0.0, 1.0)*z;
+            const Complex zz = z*z + iz;
+            const Real sigma2 = sigma*sigma;
+
+            const Complex xi = kappa - sigma*rho*iz;
+            const Complex d = std::sqrt(xi*xi + sigma2*zz);
+            const Complex g = (xi - d)/(xi + d);
+            const Complex e = std::exp(-d*t);
+            const Complex ge = 1.0 - g*e;
+
+            const Complex L = std::log(ge/(1.0 - g));
+            const Complex Q = (1.0 - e)/ge;
+
+            const Real a = kappa*theta/sigma2, b = v0/sigma2;
+
+            // forward mode, seeding theta, kappa, sigma, rho and v0
+            for (Size p=0; p < 5 && dLnChF != nullptr; ++p) {
+                const Real dTheta = (p == 0) ? 1.0 : 0.0;
+                const Real dKappa = (p == 1) ? 1.0 : 0.0;
+                const Real dSigma = (p == 2) ? 1.0 : 0.0;
+                const Real dRho   = (p == 3) ? 1.0 : 0.0;
+                const Real dV0    = (p == 4) ? 1.0 : 0.0;
+
+                const Complex dXi = dKappa - (dSigma*rho + sigma*dRho)*iz;
+                const Complex dD = (xi*dXi + sigma*dSigma*zz)/d;
+                const Complex dG = ((dXi - dD) - g*(dXi + dD))/(xi + d);
+                const Complex dE = -t*dD*e;
+                const Complex dGe = -(dG*e + g*dE);
+
+                const Complex dL = dGe/ge + dG/(1.0 - g);
+                const Complex dQ = (-dE*ge - (1.0 - e)*dGe)/(ge*ge);
+
+                const Real dA = (dKappa*theta + kappa*dTheta)/sigma2
+                    - 2.0*a*dSigma/sigma;
+                const Real dB = dV0/sigma2 - 2.0*b*dSigma/sigma;
+
+                dLnChF[p] = dA*((xi - d)*t - 2.0*L)
+                    + a*((dXi - dD)*t - 2.0*dL)
+                    + dB*(xi - d)*Q
+                    + b*((dXi - dD)*Q + (xi - d)*dQ);
+            }
+
+            return a*((xi - d)*t - 2.0*L) + b*(xi - d)*Q;
+        }
+
+    }
+
+}
@@ -0,0 +1,53 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <https://www.quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+
+/*! \file hestoncharacteristicfunction.hpp
+    \brief Heston characteristic function and its parameter derivatives
+*/
+
+#ifndef quantlib_heston_characteristic_function_hpp
+#define quantlib_heston_characteristic_function_hpp
+
+#include <ql/types.hpp>
+#include <complex>
+
+namespace QuantLib {
+
+    namespace detail {
+
+        /*! returns the logarithm of the characteristic function of
+            \f$ \ln(S_t/F) \f$ in the Heston model, using the
+            rotation-count-free form of Albrecher et al. If given,
+            dLnChF[0..4] is filled with its derivatives with respect to
+            theta, kappa, sigma, rho and v0, the order of
+            HestonModel::params().
+
+            \warning The derivatives are not defined for vanishing
+                     vol-of-vol.
+        */
+        std::complex<Real> hestonLnChF(const std::complex<Real>& z, Time t,
+                                       Real theta, Real kappa, Real sigma,
+                                       Real rho, Real v0,
+                                       std::complex<Real>* dLnChF = nullptr);
+
+    }
+
+}
+
+#endif
@@ -83,6 +83,11 @@ namespace QuantLib {
         return option_->NPV();
     }
 
+    Real HestonModelHelper::modelValueAndGradient(Array& gradient) const {
+        calculate();
+        return instrumentValueAndGradient(*option_, gradient);
+    }
+
     Real HestonModelHelper::blackPrice(Real volatility) const {
         calculate();
         const Real stdDev = volatility * std::sqrt(maturity());
@@ -56,8 +56,19 @@ namespace QuantLib {
         void addTimesTo(std::list<Time>&) const override {}
         void performCalculations() const override;
         Real modelValue() const override;
+        Real modelValueAndGradient(Array& gradient) const override;
         Real blackPrice(Real volatility) const override;
         Time maturity() const  { calculate(); return tau_; }
+        Real strike() const { return strikePrice_; }
+        const Handle<Quote>& spot() const { return s0_; }
+        const Handle<YieldTermStructure>& riskFreeRate() const {
+            return riskFreeRate_;
+        }
+        const Handle<YieldTermStructure>& dividendYield() const {
+            return dividendYield_;
+        }
+        //! type of the out-of-the-money option used for calibration
+        Option::Type optionType() const { calculate(); return type_; }
       private:
         const Period maturity_;
         const Calendar calendar_;
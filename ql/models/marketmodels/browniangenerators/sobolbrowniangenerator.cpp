@@ -18,7 +18,7 @@
 */
 
 #include <ql/models/marketmodels/browniangenerators/sobolbrowniangenerator.hpp>
-#include <boost/iterator/permutation_iterator.hpp>
+#include <algorithm>
 
 namespace QuantLib {
 
@@ -112,7 +112,8 @@ namespace QuantLib {
                                                    Ordering ordering)
     : factors_(factors), steps_(steps), ordering_(ordering),
       bridge_(steps), orderedIndices_(factors, std::vector<Size>(steps)),
-      bridgedVariates_(factors, std::vector<Real>(steps)) {
+      permutation_(factors*steps), orderedVariates_(factors*steps),
+      bridgedVariates_(factors*steps) {
 
         switch (ordering_) {
           case Factors:
@@ -127,21 +128,21 @@ namespace QuantLib {
           default:
             QL_FAIL("unknown ordering");
         }
+
+        for (Size i=0; i<factors_; ++i)
+            for (Size j=0; j<steps_; ++j)
+                permutation_[j*factors_+i] = orderedIndices_[i][j];
     }
 
 
     Real SobolBrownianGeneratorBase::nextPath() {
         const auto& sample = nextSequence();
-        // Brownian-bridge the variates according to the ordered indices
-        for (Size i=0; i<factors_; ++i) {
-            bridge_.transform(boost::make_permutation_iterator(
-                                                  sample.value.begin(),
-                                                  orderedIndices_[i].begin()),
-                              boost::make_permutation_iterator(
-                                                  sample.value.begin(),
-                                                  orderedIndices_[i].end()),
-                              bridgedVariates_[i].begin());
-        }
+        // Brownian-bridge the variates according to the ordered
+        // indices; the factors are bridged together as a block
+        for (Size k=0; k<permutation_.size(); ++k)
+            orderedVariates_[k] = sample.value[permutation_[k]];
+        bridge_.transformBlock(orderedVariates_.data(),
+                               bridgedVariates_.data(), factors_);
         lastStep_ = 0;
         return sample.weight;
     }
@@ -158,28 +159,25 @@ namespace QuantLib {
         QL_REQUIRE(   (variates.size() == factors_*steps_),
                    "inconsistent variate vector");
 
-        const Size dim    = factors_*steps_;
         const Size nPaths = variates.front().size();
         
         std::vector<std::vector<Real> > 
                        retVal(factors_, std::vector<Real>(nPaths*steps_));
-        
-        for (Size j=0; j < nPaths; ++j) {
-            std::vector<Real> sample(steps_*factors_);
-            for (Size k=0; k < dim; ++k) {
-                sample[k] = variates[k][j];
-            }
-            for (Size i=0; i<factors_; ++i) {
-                bridge_.transform(boost::make_permutation_iterator(
-                                                  sample.begin(),
-                                                  orderedIndices_[i].begin()),
-                          boost::make_permutation_iterator(
-                                                  sample.begin(),
-                                                  orderedIndices_[i].end()),
-                          retVal[i].begin()+j*steps_);
+
+        // all paths of a given factor are bridged as a block
+        std::vector<Real> input(steps_*nPaths), output(steps_*nPaths);
+        for (Size i=0; i<factors_; ++i) {
+            for (Size j=0; j<steps_; ++j) {
+                const std::vector<Real>& v = variates[orderedIndices_[i][j]];
+                QL_REQUIRE(v.size() == nPaths, "inconsistent variate vector");
+                std::copy(v.begin(), v.end(), input.begin()+j*nPaths);
             }
+            bridge_.transformBlock(input.data(), output.data(), nPaths);
+            for (Size j=0; j<steps_; ++j)
+                for (Size k=0; k<nPaths; ++k)
+                    retVal[i][k*steps_+j] = output[j*nPaths+k];
         }
-        
+
         return retVal;
     }
 
@@ -188,8 +186,9 @@ namespace QuantLib {
         QL_REQUIRE(output.size() == factors_, "size mismatch");
         QL_REQUIRE(lastStep_<steps_, "sequence exhausted");
         #endif
-        for (Size i=0; i<factors_; ++i)
-            output[i] = bridgedVariates_[i][lastStep_];
+        std::copy(bridgedVariates_.begin() + lastStep_*factors_,
+                  bridgedVariates_.begin() + (lastStep_+1)*factors_,
+                  output.begin());
         ++lastStep_;
         return 1.0;
     }
@@ -34,6 +34,10 @@ namespace QuantLib {
     //! Sobol Brownian generator for market-model simulations
     /*! Incremental Brownian generator using a Sobol generator,
         inverse-cumulative Gaussian method, and Brownian bridging.
+
+        The variates of all factors are bridged together in a single
+        pass, using the block interface of BrownianBridge with the
+        factors laid out contiguously for each step.
     */
     class SobolBrownianGeneratorBase : public BrownianGenerator {
       public:
@@ -73,7 +77,10 @@ namespace QuantLib {
         // work variables
         Size lastStep_ = 0;
         std::vector<std::vector<Size> > orderedIndices_;
-        std::vector<std::vector<Real> > bridgedVariates_;
+        // variate used for the j-th step of the i-th factor, stored
+        // at position j*factors+i
+        std::vector<Size> permutation_;
+        std::vector<Real> orderedVariates_, bridgedVariates_;
     };
 
     class SobolBrownianGenerator : public SobolBrownianGeneratorBase {
@@ -63,13 +63,76 @@ namespace QuantLib {
             return values;
         }
 
+        void gradient(Array& grad, const Array& params) const override {
+            valueAndGradient(grad, params);
+        }
+
+        Real valueAndGradient(Array& grad, const Array& params) const override {
+            Array values;
+            Matrix jac;
+            if (!analyticValuesAndJacobian(values, jac, params)) {
+                CostFunction::gradient(grad, params);
+                return value(params);
+            }
+
+            const Real value = std::sqrt(DotProduct(values, values));
+            grad = Array(params.size(), 0.0);
+            if (value > 0.0)
+                for (Size i=0; i<values.size(); ++i)
+                    for (Size j=0; j<params.size(); ++j)
+                        grad[j] += values[i]*jac[i][j]/value;
+            return value;
+        }
+
+        void jacobian(Matrix& jac, const Array& params) const override {
+            Array values;
+            if (!analyticValuesAndJacobian(values, jac, params))
+                CostFunction::jacobian(jac, params);
+        }
+
+        Array valuesAndJacobian(Matrix& jac, const Array& params) const override {
+            Array values;
+            if (!analyticValuesAndJacobian(values, jac, params)) {
+                CostFunction::jacobian(jac, params);
+                return this->values(params);
+            }
+            return values;
+        }
+
         Real finiteDifferenceEpsilon() const override { return 1e-6; }
 
       private:
+        /* returns false, without touching jac, if not all instruments
+           provide the derivatives of their calibration errors */
+        bool analyticValuesAndJacobian(Array& values, Matrix& jac,
+                                       const Array& params) const {
+            if (!analyticJacobian_)
+                return false;
+
+            model_->setParams(projection_.include(params));
+            values = Array(instruments_.size());
+            Matrix analyticJac(instruments_.size(), params.size());
+            Array gradient;
+            for (Size i=0; i<instruments_.size(); i++) {
+                const Real w = std::sqrt(weights_[i]);
+                values[i] = instruments_[i]->calibrationErrorAndGradient(gradient)*w;
+                if (gradient.empty()) {
+                    analyticJacobian_ = false;
+                    return false;
+                }
+                const Array projected = projection_.project(gradient);
+                for (Size j=0; j<params.size(); ++j)
+                    analyticJac[i][j] = projected[j]*w;
+            }
+            jac = analyticJac;
+            return true;
+        }
+
         ext::shared_ptr<CalibratedModel> model_;
         const vector<ext::shared_ptr<CalibrationHelper> >& instruments_;
         vector<Real> weights_;
         const Projection projection_;
+        mutable bool analyticJacobian_ = true;
     };
 
     void CalibratedModel::calibrate(
@@ -61,6 +61,22 @@ namespace QuantLib {
                                         Time maturity,
                                         Time bondStart,
                                         Time bondMaturity) const;
+
+        //! derivatives of discountBondOption w.r.t. the model parameters
+        /*! The derivatives are taken at fixed strike and ordered as in
+            CalibratedModel::params(). An empty array is returned if they
+            are not available, which is the default.
+        */
+        virtual Array discountBondOptionGradient(Option::Type type,
+                                                 Real strike,
+                                                 Time maturity,
+                                                 Time bondMaturity) const;
+
+        virtual Array discountBondOptionGradient(Option::Type type,
+                                                 Real strike,
+                                                 Time maturity,
+                                                 Time bondStart,
+                                                 Time bondMaturity) const;
     };
 
 
@@ -95,6 +111,13 @@ namespace QuantLib {
         //! Calibrate to a set of market instruments (usually caps/swaptions)
         /*! An additional constraint can be passed which must be
             satisfied in addition to the constraints of the model.
+
+            If all instruments provide the derivatives of their
+            calibration errors, see
+            CalibrationHelper::calibrationErrorAndGradient, the cost
+            function returns the analytic Jacobian and gradient instead
+            of finite differences. LevenbergMarquardt uses it only if
+            useCostFunctionsJacobian is set.
         */
         virtual void calibrate(
                 const std::vector<ext::shared_ptr<CalibrationHelper> >&,
@@ -156,6 +179,21 @@ namespace QuantLib {
         return discountBondOption(type, strike, maturity, bondMaturity);
     }
 
+    inline Array AffineModel::discountBondOptionGradient(Option::Type,
+                                                         Real,
+                                                         Time,
+                                                         Time) const {
+        return {};
+    }
+
+    inline Array AffineModel::discountBondOptionGradient(Option::Type type,
+                                                         Real strike,
+                                                         Time maturity,
+                                                         Time,
+                                                         Time bondMaturity) const {
+        return discountBondOptionGradient(type, strike, maturity, bondMaturity);
+    }
+
     inline const ext::shared_ptr<Constraint>&
     CalibratedModel::constraint() const {
         return constraint_;
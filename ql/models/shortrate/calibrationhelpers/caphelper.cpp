@@ -66,6 +66,11 @@ namespace QuantLib {
         return cap_->NPV();
     }
 
+    Real CapHelper::modelValueAndGradient(Array& gradient) const {
+        calculate();
+        return instrumentValueAndGradient(*cap_, gradient);
+    }
+
     Real CapHelper::blackPrice(Volatility sigma) const {
         calculate();
         Handle<Quote> vol(ext::shared_ptr<Quote>(new SimpleQuote(sigma)));
@@ -48,6 +48,7 @@ namespace QuantLib {
                   Real shift = 0.0);
         void addTimesTo(std::list<Time>& times) const override;
         Real modelValue() const override;
+        Real modelValueAndGradient(Array& gradient) const override;
         Real blackPrice(Volatility volatility) const override;
 
       private:
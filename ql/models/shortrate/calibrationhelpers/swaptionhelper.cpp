@@ -126,6 +126,11 @@ namespace QuantLib {
         return swaption_->NPV();
     }
 
+    Real SwaptionHelper::modelValueAndGradient(Array& gradient) const {
+        calculate();
+        return instrumentValueAndGradient(*swaption_, gradient);
+    }
+
     Real SwaptionHelper::blackPrice(Volatility sigma) const {
         calculate();
         Handle<Quote> vol(ext::shared_ptr<Quote>(new SimpleQuote(sigma)));
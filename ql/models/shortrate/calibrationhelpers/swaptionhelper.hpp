@@ -91,6 +91,7 @@ namespace QuantLib {
 
         void addTimesTo(std::list<Time>& times) const override;
         Real modelValue() const override;
+        Real modelValueAndGradient(Array& gradient) const override;
         Real blackPrice(Volatility volatility) const override;
 
         const ext::shared_ptr<FixedVsFloatingSwap>& underlying() const {
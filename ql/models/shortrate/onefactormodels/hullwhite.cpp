@@ -130,6 +130,82 @@ namespace QuantLib {
         return blackFormula(type, k, f, v);
     }
 
+    Array HullWhite::discountBondOptionGradient(Option::Type,
+                                                Real strike,
+                                                Time maturity,
+                                                Time bondMaturity) const {
+
+        const Real _a = a();
+        const Real b = B(maturity, bondMaturity);
+        const Time tau = bondMaturity - maturity;
+
+        // v = sigma*b*s, derivatives of b and s w.r.t. a
+        Real s, dB, dS;
+        if (_a < std::sqrt(QL_EPSILON)) {
+            s = std::sqrt(maturity);
+            dB = -0.5*tau*tau;
+            dS = -0.5*maturity*s;
+        } else {
+            s = std::sqrt(0.5*(1.0 - std::exp(-2.0*_a*maturity))/_a);
+            dB = (tau*std::exp(-_a*tau) - b)/_a;
+            dS = (s > 0.0)
+                ? (maturity*std::exp(-2.0*_a*maturity) - s*s)/(2.0*_a*s)
+                : 0.0;
+        }
+        const Real v = sigma()*b*s;
+
+        const Real f = termStructure()->discount(bondMaturity);
+        const Real k = termStructure()->discount(maturity)*strike;
+        const Real vega = blackFormulaStdDevDerivative(k, f, v);
+
+        Array gradient(2);
+        gradient[0] = vega*sigma()*(dB*s + b*dS);
+        gradient[1] = vega*b*s;
+        return gradient;
+    }
+
+    Array HullWhite::discountBondOptionGradient(Option::Type,
+                                                Real strike,
+                                                Time maturity,
+                                                Time bondStart,
+                                                Time bondMaturity) const {
+
+        // v = sigma*u, derivative of u w.r.t. a
+        const Real _a = a();
+        Real u, dU;
+        if (_a < std::sqrt(QL_EPSILON)) {
+            const Time tau = bondMaturity - bondStart;
+            u = B(bondStart, bondMaturity)*std::sqrt(maturity);
+            dU = -0.5*tau*tau*std::sqrt(maturity);
+        } else {
+            const Time s = bondStart, e = bondMaturity, m = maturity;
+            const Real c = exp(-2.0*_a*(s-m))
+                - exp(-2.0*_a*s)
+                -2.0*(exp(-_a*(s+e-2.0*m))
+                      - exp(-_a*(s+e)))
+                + exp(-2.0*_a*(e-m))
+                - exp(-2.0*_a*e);
+            const Real dC = -2.0*(s-m)*exp(-2.0*_a*(s-m))
+                + 2.0*s*exp(-2.0*_a*s)
+                +2.0*((s+e-2.0*m)*exp(-_a*(s+e-2.0*m))
+                      - (s+e)*exp(-_a*(s+e)))
+                - 2.0*(e-m)*exp(-2.0*_a*(e-m))
+                + 2.0*e*exp(-2.0*_a*e);
+            u = sqrt(std::max(c, 0.0))/(_a*sqrt(2.0*_a));
+            dU = (c > 0.0) ? u*(0.5*dC/c - 1.5/_a) : 0.0;
+        }
+        const Real v = sigma()*u;
+
+        const Real f = termStructure()->discount(bondMaturity);
+        const Real k = termStructure()->discount(bondStart)*strike;
+        const Real vega = blackFormulaStdDevDerivative(k, f, v);
+
+        Array gradient(2);
+        gradient[0] = vega*sigma()*dU;
+        gradient[1] = vega*u;
+        return gradient;
+    }
+
     Rate HullWhite::convexityBias(Real futuresPrice,
                                   Time t,
                                   Time T,
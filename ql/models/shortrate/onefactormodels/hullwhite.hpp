@@ -66,6 +66,18 @@ namespace QuantLib {
                                 Time bondStart,
                                 Time bondMaturity) const override;
 
+        //! derivatives w.r.t. a and sigma
+        Array discountBondOptionGradient(Option::Type type,
+                                         Real strike,
+                                         Time maturity,
+                                         Time bondMaturity) const override;
+
+        Array discountBondOptionGradient(Option::Type type,
+                                         Real strike,
+                                         Time maturity,
+                                         Time bondStart,
+                                         Time bondMaturity) const override;
+
         /*! Futures convexity bias (i.e., the difference between
             futures implied rate and forward rate) calculated as in
             G. Kirikos, D. Novak, "Convexity Conundrums", Risk
@@ -20,6 +20,7 @@
 
 #include <ql/pricingengines/asian/mc_discr_geom_av_price.hpp>
 #include <ql/pricingengines/asian/mc_discr_arith_av_price.hpp>
+#include <cmath>
 
 namespace QuantLib {
 
@@ -33,22 +34,68 @@ namespace QuantLib {
             "strike less than zero not allowed");
     }
 
+    ArithmeticAPOPathPricer::ArithmeticAPOPathPricer(
+                                   Option::Type type,
+                                   Real strike, DiscountFactor discount,
+                                   Real runningSum, Size pastFixings,
+                                   ext::shared_ptr<PathwiseGreeks> greeks,
+                                   Time maturity, Volatility volatility,
+                                   std::vector<Real> forwards)
+    : payoff_(type, strike), discount_(discount),
+      runningSum_(runningSum), pastFixings_(pastFixings),
+      greeks_(std::move(greeks)), maturity_(maturity),
+      volatility_(volatility), forwards_(std::move(forwards)) {
+        QL_REQUIRE(strike>=0.0,
+            "strike less than zero not allowed");
+        QL_REQUIRE(volatility_ > 0.0,
+                   "positive volatility required for Greeks");
+    }
+
     Real ArithmeticAPOPathPricer::operator()(const Path& path) const  {
         Size n = path.length();
         QL_REQUIRE(n>1, "the path cannot be empty");
 
-        Real sum;
+        Size first;
         Size fixings;
         if (path.timeGrid().mandatoryTimes()[0]==0.0) {
             // include initial fixing
-            sum = std::accumulate(path.begin(),path.end(),runningSum_);
+            first = 0;
             fixings = pastFixings_ + n;
         } else {
-            sum = std::accumulate(path.begin()+1,path.end(),runningSum_);
+            first = 1;
             fixings = pastFixings_ + n - 1;
         }
+        Real sum = std::accumulate(path.begin()+first,path.end(),runningSum_);
         Real averagePrice = sum/fixings;
-        return discount_ * payoff_(averagePrice);
+        Real value = discount_ * payoff_(averagePrice);
+
+        if (greeks_) {
+            // pathwise derivatives of the discounted payoff; for a
+            // geometric Brownian motion, dS_t/dS_0 = S_t/S_0,
+            // dS_t/dsigma = S_t (W_t - sigma t) and dS_t/dr = S_t t.
+            QL_REQUIRE(forwards_.size() == n,
+                       "forwards and path size mismatch");
+            Real omega = payoff_.optionType() == Option::Call ? 1.0 : -1.0;
+            if (omega*(averagePrice-payoff_.strike()) > 0.0) {
+                const TimeGrid& grid = path.timeGrid();
+                Real sigma2 = volatility_*volatility_;
+                Real dSum = 0.0, vSum = 0.0, rSum = 0.0;
+                for (Size i=first; i<n; ++i) {
+                    dSum += path[i];
+                    vSum += path[i] * (std::log(path[i]/forwards_[i])
+                                       - 0.5*sigma2*grid[i]);
+                    rSum += path[i] * grid[i];
+                }
+                Real factor = omega * discount_ / fixings;
+                greeks_->add(factor * dSum/path.front(),
+                             factor * vSum/volatility_,
+                             factor * rSum - maturity_*value);
+            } else {
+                greeks_->add(0.0, 0.0, 0.0);
+            }
+        }
+
+        return value;
     }
 
 }
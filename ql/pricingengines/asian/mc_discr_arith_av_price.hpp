@@ -26,9 +26,11 @@
 #define quantlib_mc_discrete_arithmetic_average_price_asian_engine_hpp
 
 #include <ql/exercise.hpp>
+#include <ql/methods/montecarlo/pathwisegreeks.hpp>
 #include <ql/pricingengines/asian/analytic_discr_geom_av_price.hpp>
 #include <ql/pricingengines/asian/mc_discr_geom_av_price.hpp>
 #include <ql/processes/blackscholesprocess.hpp>
+#include <ql/termstructures/volatility/equityfx/blackconstantvol.hpp>
 #include <utility>
 
 namespace QuantLib {
@@ -40,10 +42,20 @@ namespace QuantLib {
          AnalyticDiscreteGeometricAveragePriceAsianEngine (analytic discrete
          arithmetic average price engine) for control variation.
 
+         If required, pathwise estimators of delta, vega and rho are
+         calculated in the same sweep as the price and returned as
+         additional results (see PathwiseGreeks) together with their
+         error estimates; control variation, if enabled, is only
+         applied to the price.
+
+         \pre Greeks can only be calculated when the process has a
+              constant volatility.
+
          \ingroup asianengines
 
          \test the correctness of the returned value is tested by
-               reproducing results available in literature.
+               reproducing results available in literature; the
+               Greeks are checked against finite differences.
     */
     template <class RNG = PseudoRandom, class S = Statistics>
     class MCDiscreteArithmeticAPEngine
@@ -66,7 +78,15 @@ namespace QuantLib {
              Size requiredSamples,
              Real requiredTolerance,
              Size maxSamples,
-             BigNatural seed);
+             BigNatural seed,
+             bool pathwiseGreeks = false);
+        void calculate() const override {
+            greeks_.reset();
+            MCDiscreteAveragingAsianEngineBase<SingleVariate,RNG,S>::calculate();
+            if (greeks_)
+                greeks_->addTo(this->results_.additionalResults,
+                               RNG::allowsErrorEstimate);
+        }
       protected:
         ext::shared_ptr<path_pricer_type> pathPricer() const override;
         ext::shared_ptr<path_pricer_type> controlPathPricer() const override;
@@ -78,6 +98,9 @@ namespace QuantLib {
             return ext::shared_ptr<PricingEngine>(new
                 AnalyticDiscreteGeometricAveragePriceAsianEngine(process));
         }
+      private:
+        bool pathwiseGreeks_;
+        mutable ext::shared_ptr<PathwiseGreeks> greeks_;
     };
 
 
@@ -88,6 +111,21 @@ namespace QuantLib {
                                 DiscountFactor discount,
                                 Real runningSum = 0.0,
                                 Size pastFixings = 0);
+        /*! The delta, vega and rho of each path are added to the
+            given accumulator.  The paths are assumed to be generated
+            by a geometric Brownian motion with constant volatility;
+            the forward values of the underlying at the nodes of the
+            time grid must be passed.
+        */
+        ArithmeticAPOPathPricer(Option::Type type,
+                                Real strike,
+                                DiscountFactor discount,
+                                Real runningSum,
+                                Size pastFixings,
+                                ext::shared_ptr<PathwiseGreeks> greeks,
+                                Time maturity,
+                                Volatility volatility,
+                                std::vector<Real> forwards);
         Real operator()(const Path& path) const override;
 
       private:
@@ -95,6 +133,10 @@ namespace QuantLib {
         DiscountFactor discount_;
         Real runningSum_;
         Size pastFixings_;
+        ext::shared_ptr<PathwiseGreeks> greeks_;
+        Time maturity_ = 0.0;
+        Volatility volatility_ = 0.0;
+        std::vector<Real> forwards_;
     };
 
 
@@ -110,7 +152,8 @@ namespace QuantLib {
              Size requiredSamples,
              Real requiredTolerance,
              Size maxSamples,
-             BigNatural seed)
+             BigNatural seed,
+             bool pathwiseGreeks)
     : MCDiscreteAveragingAsianEngineBase<SingleVariate,RNG,S>(process,
                                                               brownianBridge,
                                                               antitheticVariate,
@@ -118,7 +161,8 @@ namespace QuantLib {
                                                               requiredSamples,
                                                               requiredTolerance,
                                                               maxSamples,
-                                                              seed) {}
+                                                              seed),
+      pathwiseGreeks_(pathwiseGreeks) {}
 
     template <class RNG, class S>
     inline
@@ -141,6 +185,28 @@ namespace QuantLib {
                 this->process_);
         QL_REQUIRE(process, "Black-Scholes process required");
 
+        if (!pathwiseGreeks_)
+            return ext::shared_ptr<typename
+                MCDiscreteArithmeticAPEngine<RNG,S>::path_pricer_type>(
+                    new ArithmeticAPOPathPricer(
+                        payoff->optionType(),
+                        payoff->strike(),
+                        process->riskFreeRate()->discount(exercise->lastDate()),
+                        this->arguments_.runningAccumulator,
+                        this->arguments_.pastFixings));
+
+        QL_REQUIRE(ext::dynamic_pointer_cast<BlackConstantVol>(
+                                          *(process->blackVolatility())),
+                   "constant volatility required for pathwise Greeks");
+
+        TimeGrid grid = this->timeGrid();
+        std::vector<Real> forwards(grid.size());
+        for (Size i=0; i<grid.size(); ++i)
+            forwards[i] = process->x0()
+                * process->dividendYield()->discount(grid[i])
+                / process->riskFreeRate()->discount(grid[i]);
+
+        greeks_ = ext::make_shared<PathwiseGreeks>(this->antitheticVariate_);
         return ext::shared_ptr<typename
             MCDiscreteArithmeticAPEngine<RNG,S>::path_pricer_type>(
                 new ArithmeticAPOPathPricer(
@@ -148,7 +214,12 @@ namespace QuantLib {
                     payoff->strike(),
                     process->riskFreeRate()->discount(exercise->lastDate()),
                     this->arguments_.runningAccumulator,
-                    this->arguments_.pastFixings));
+                    this->arguments_.pastFixings,
+                    greeks_,
+                    process->time(exercise->lastDate()),
+                    process->blackVolatility()->blackVol(grid.back(),
+                                                         payoff->strike()),
+                    std::move(forwards)));
     }
 
     template <class RNG, class S>
@@ -196,6 +267,7 @@ namespace QuantLib {
         MakeMCDiscreteArithmeticAPEngine& withSeed(BigNatural seed);
         MakeMCDiscreteArithmeticAPEngine& withAntitheticVariate(bool b = true);
         MakeMCDiscreteArithmeticAPEngine& withControlVariate(bool b = true);
+        MakeMCDiscreteArithmeticAPEngine& withPathwiseGreeks(bool b = true);
         // conversion to pricing engine
         operator ext::shared_ptr<PricingEngine>() const;
       private:
@@ -205,6 +277,7 @@ namespace QuantLib {
         Real tolerance_;
         bool brownianBridge_ = true;
         BigNatural seed_ = 0;
+        bool pathwiseGreeks_ = false;
     };
 
     template <class RNG, class S>
@@ -270,6 +343,13 @@ namespace QuantLib {
         return *this;
     }
 
+    template <class RNG, class S>
+    inline MakeMCDiscreteArithmeticAPEngine<RNG,S>&
+    MakeMCDiscreteArithmeticAPEngine<RNG,S>::withPathwiseGreeks(bool b) {
+        pathwiseGreeks_ = b;
+        return *this;
+    }
+
     template <class RNG, class S>
     inline
     MakeMCDiscreteArithmeticAPEngine<RNG,S>::operator ext::shared_ptr<PricingEngine>()
@@ -280,7 +360,8 @@ namespace QuantLib {
                                                 antithetic_, controlVariate_,
                                                 samples_, tolerance_,
                                                 maxSamples_,
-                                                seed_));
+                                                seed_,
+                                                pathwiseGreeks_));
     }
 
 
@@ -99,7 +99,9 @@ namespace QuantLib {
       xGrids_(std::move(xGrids)),
       tGrid_(tGrid),
       dampingSteps_(dampingSteps),
-      schemeDesc_(schemeDesc) {
+      schemeDesc_(schemeDesc),
+      sparseGrid_(false),
+      sparseGridDesc_({0}) {
 
         QL_REQUIRE(!processes_.empty(), "no Black-Scholes process is given.");
         QL_REQUIRE(rho_.size1() == rho_.size2()
@@ -120,12 +122,35 @@ namespace QuantLib {
         std::move(processes), std::move(rho), std::vector<Size>(1, xGrid), tGrid, dampingSteps, schemeDesc)
     {}
 
+    FdndimBlackScholesVanillaEngine::FdndimBlackScholesVanillaEngine(
+        std::vector<ext::shared_ptr<GeneralizedBlackScholesProcess> > processes,
+        Matrix rho,
+        const FdmSparseGridDesc& sparseGridDesc,
+        Size tGrid, Size dampingSteps,
+        const FdmSchemeDesc& schemeDesc)
+    : processes_(std::move(processes)),
+      rho_(std::move(rho)),
+      tGrid_(tGrid),
+      dampingSteps_(dampingSteps),
+      schemeDesc_(schemeDesc),
+      sparseGrid_(true),
+      sparseGridDesc_(sparseGridDesc) {
+
+        QL_REQUIRE(!processes_.empty(), "no Black-Scholes process is given.");
+        QL_REQUIRE(rho_.size1() == rho_.size2()
+                && rho_.size1() == processes_.size(),
+                "correlation matrix has the wrong size.");
+
+        std::for_each(processes_.begin(), processes_.end(),
+            [this](const auto& p) { registerWith(p); });
+    }
+
 
     void FdndimBlackScholesVanillaEngine::calculate() const {
         #ifndef PDE_MAX_SUPPORTED_DIM
         #define PDE_MAX_SUPPORTED_DIM 4
         #endif
-        QL_REQUIRE(processes_.size() <= PDE_MAX_SUPPORTED_DIM,
+        QL_REQUIRE(sparseGrid_ || processes_.size() <= PDE_MAX_SUPPORTED_DIM,
             "This engine does not support " << processes_.size() << " underlyings. "
             << "Max number of underlyings is " << PDE_MAX_SUPPORTED_DIM << ". "
             << "Please change preprocessor constant PDE_MAX_SUPPORTED_DIM and recompile "
@@ -146,28 +171,6 @@ namespace QuantLib {
         const Matrix& Q = schur.eigenvectors();
         const Array& l = schur.eigenvalues();
 
-        const Real eps = 1e-4;
-        std::vector<ext::shared_ptr<Fdm1dMesher> > meshers;
-
-        for (Size i=0; i < processes_.size(); ++i) {
-            const Size xGrid = (xGrids_.size() > 1)
-                ? xGrids_[i]
-                : std::max(Size(4), Size(xGrids_[0]*std::pow(l[i]/l[0], 0.1)));
-            QL_REQUIRE(xGrid >= 4, "minimum grid size is four");
-
-            const Real xStepStize = (1.0-2*eps)/(xGrid-1);
-
-            std::vector<Real> x(xGrid);
-            for (Size j=0; j < xGrid; ++j)
-                x[j] = 1.3*std::sqrt(l[i])*sqrtT
-                    *InverseCumulativeNormal()(eps + j*xStepStize);
-
-            meshers.emplace_back(ext::make_shared<Predefined1dMesher>(x));
-        }
-
-        const ext::shared_ptr<FdmMesherComposite> mesher =
-            ext::make_shared<FdmMesherComposite>(meshers);
-
         const ext::shared_ptr<BasketPayoff> payoff
             = ext::dynamic_pointer_cast<BasketPayoff>(arguments_.payoff);
         QL_REQUIRE(payoff, "basket payoff expected");
@@ -179,44 +182,98 @@ namespace QuantLib {
         for (Size i=0; i < processes_.size(); ++i)
             qTS[i] = processes_[i]->dividendYield().currentLink();
 
-        const ext::shared_ptr<FdmInnerValueCalculator> calculator =
-            ext::make_shared<detail::FdmPCABasketInnerValue>(
-                payoff, mesher,
-                Log(s), stdDev/sqrtT,
-                qTS, rTS,
-                Q, l
-            );
-
-        const ext::shared_ptr<FdmStepConditionComposite> conditions
-            = FdmStepConditionComposite::vanillaComposite(
-                DividendSchedule(), arguments_.exercise,
-                mesher, calculator,
-                rTS->referenceDate(), rTS->dayCounter());
-
-        const FdmBoundaryConditionSet boundaries;
-        const FdmSolverDesc solverDesc
-            = { mesher, boundaries, conditions, calculator,
-                maturity, tGrid_, dampingSteps_ };
-
         const bool isEuropean =
             ext::dynamic_pointer_cast<EuropeanExercise>(arguments_.exercise) != nullptr;
-        const ext::shared_ptr<FdmWienerOp> op =
-            ext::make_shared<FdmWienerOp>(
-                mesher,
-                (isEuropean)? ext::shared_ptr<YieldTermStructure>() : rTS,
-                l);
-
-        switch(processes_.size()) {
-            #define BOOST_PP_LOCAL_MACRO(n) \
-                case n : \
-                    results_.value = ext::make_shared<FdmNdimSolver<n>>( \
-                        solverDesc, schemeDesc_, op)->interpolateAt( \
-                            std::vector<Real>(processes_.size(), 0.0)); \
-                break;
-            #define BOOST_PP_LOCAL_LIMITS (1, PDE_MAX_SUPPORTED_DIM)
-            #include BOOST_PP_LOCAL_ITERATE()
-          default:
-            QL_FAIL("Not implemented for " << processes_.size() << " processes");
+
+        // the sparse-grid solver might call the generators concurrently;
+        // the data they share is calculated here and captured by value.
+        // Afterwards, the term structures are only asked for discount
+        // factors and rates; their lazy calculations, if any, are
+        // triggered by the first grid, which is always solved serially.
+        const Date referenceDate = rTS->referenceDate();
+        const DayCounter dayCounter = rTS->dayCounter();
+        const Array logS0 = Log(s);
+        const ext::shared_ptr<Exercise> exercise = arguments_.exercise;
+        const Size nProcesses = processes_.size();
+        const Size tGrid = tGrid_, dampingSteps = dampingSteps_;
+
+        const auto solverDescGenerator = [=](const std::vector<Size>& xGrids) {
+            const Real eps = 1e-4;
+            std::vector<ext::shared_ptr<Fdm1dMesher> > meshers;
+
+            for (Size i=0; i < nProcesses; ++i) {
+                const Size xGrid = xGrids[i];
+                QL_REQUIRE(xGrid >= 4, "minimum grid size is four");
+
+                const Real xStepStize = (1.0-2*eps)/(xGrid-1);
+
+                std::vector<Real> x(xGrid);
+                for (Size j=0; j < xGrid; ++j)
+                    x[j] = 1.3*std::sqrt(l[i])*sqrtT
+                        *InverseCumulativeNormal()(eps + j*xStepStize);
+
+                meshers.emplace_back(ext::make_shared<Predefined1dMesher>(x));
+            }
+
+            const ext::shared_ptr<FdmMesherComposite> mesher =
+                ext::make_shared<FdmMesherComposite>(meshers);
+
+            const ext::shared_ptr<FdmInnerValueCalculator> calculator =
+                ext::make_shared<detail::FdmPCABasketInnerValue>(
+                    payoff, mesher,
+                    logS0, vols,
+                    qTS, rTS,
+                    Q, l
+                );
+
+            const ext::shared_ptr<FdmStepConditionComposite> conditions
+                = FdmStepConditionComposite::vanillaComposite(
+                    DividendSchedule(), exercise,
+                    mesher, calculator,
+                    referenceDate, dayCounter);
+
+            const FdmBoundaryConditionSet boundaries;
+            return FdmSolverDesc{ mesher, boundaries, conditions, calculator,
+                                  maturity, tGrid, dampingSteps };
+        };
+
+        const auto operatorGenerator =
+            [=](const ext::shared_ptr<FdmMesher>& mesher) {
+                return ext::make_shared<FdmWienerOp>(
+                    mesher,
+                    (isEuropean)? ext::shared_ptr<YieldTermStructure>() : rTS,
+                    l);
+            };
+
+        if (sparseGrid_) {
+            results_.value = FdmSparseGridSolver(
+                processes_.size(), sparseGridDesc_,
+                solverDescGenerator, operatorGenerator, schemeDesc_)
+                .interpolateAt(std::vector<Real>(processes_.size(), 0.0));
+        }
+        else {
+            std::vector<Size> xGrids(processes_.size());
+            for (Size i=0; i < processes_.size(); ++i)
+                xGrids[i] = (xGrids_.size() > 1)
+                    ? xGrids_[i]
+                    : std::max(Size(4), Size(xGrids_[0]*std::pow(l[i]/l[0], 0.1)));
+
+            const FdmSolverDesc solverDesc = solverDescGenerator(xGrids);
+            const ext::shared_ptr<FdmLinearOpComposite> op
+                = operatorGenerator(solverDesc.mesher);
+
+            switch(processes_.size()) {
+                #define BOOST_PP_LOCAL_MACRO(n) \
+                    case n : \
+                        results_.value = ext::make_shared<FdmNdimSolver<n>>( \
+                            solverDesc, schemeDesc_, op)->interpolateAt( \
+                                std::vector<Real>(processes_.size(), 0.0)); \
+                    break;
+                #define BOOST_PP_LOCAL_LIMITS (1, PDE_MAX_SUPPORTED_DIM)
+                #include BOOST_PP_LOCAL_ITERATE()
+              default:
+                QL_FAIL("Not implemented for " << processes_.size() << " processes");
+            }
         }
 
         if (isEuropean)
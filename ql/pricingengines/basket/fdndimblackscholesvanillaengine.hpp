@@ -27,6 +27,7 @@
 #include <ql/math/matrix.hpp>
 #include <ql/instruments/basketoption.hpp>
 #include <ql/methods/finitedifferences/solvers/fdmbackwardsolver.hpp>
+#include <ql/methods/finitedifferences/solvers/fdmsparsegridsolver.hpp>
 
 namespace QuantLib {
 
@@ -57,6 +58,22 @@ namespace QuantLib {
             Size xGrid, Size tGrid = 50, Size dampingSteps = 0,
             const FdmSchemeDesc& schemeDesc = FdmSchemeDesc::Douglas());
 
+        /*! Sparse-grid combination technique, see FdmSparseGridSolver.
+            The number of underlyings is not limited by
+            PDE_MAX_SUPPORTED_DIM in this case.
+
+            \warning If the grids are solved in parallel, the yield
+                     term structures of the processes are queried
+                     concurrently; they must not be modified while the
+                     engine is calculating.
+        */
+        FdndimBlackScholesVanillaEngine(
+            std::vector<ext::shared_ptr<GeneralizedBlackScholesProcess> > processes,
+            Matrix rho,
+            const FdmSparseGridDesc& sparseGridDesc,
+            Size tGrid = 50, Size dampingSteps = 0,
+            const FdmSchemeDesc& schemeDesc = FdmSchemeDesc::Douglas());
+
         void calculate() const override;
 
       private:
@@ -65,6 +82,8 @@ namespace QuantLib {
         const std::vector<Size> xGrids_;
         const Size tGrid_, dampingSteps_;
         const FdmSchemeDesc schemeDesc_;
+        const bool sparseGrid_;
+        const FdmSparseGridDesc sparseGridDesc_;
     };
 }
 
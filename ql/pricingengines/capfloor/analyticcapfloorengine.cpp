@@ -48,6 +48,18 @@ namespace QuantLib {
         }
 
         Real value = 0.0;
+        Array gradient;
+        bool gradientAvailable = modelGradientEnabled();
+        const auto addGradient = [&](Real weight, const Array& dboGradient) {
+            if (dboGradient.empty())
+                gradientAvailable = false;
+            else if (gradientAvailable) {
+                if (gradient.empty())
+                    gradient = Array(dboGradient.size(), 0.0);
+                gradient += weight*dboGradient;
+            }
+        };
+
         CapFloor::Type type = arguments_.type;
         Size nPeriods = arguments_.endDates.size();
 
@@ -76,6 +88,10 @@ namespace QuantLib {
                 Time tenor = arguments_.accrualTimes[i];
                 Rate fixing = arguments_.forwards[i];
                 if (fixingTime <= 0.0) {
+                    // only term-structure consistent models keep the
+                    // discount factors independent of their parameters
+                    if (tsmodel == nullptr)
+                        gradientAvailable = false;
                     if (type == CapFloor::Cap || type == CapFloor::Collar) {
                         DiscountFactor discount = model_->discount(paymentTime);
                         Rate strike = arguments_.capRates[i];
@@ -101,6 +117,11 @@ namespace QuantLib {
                             arguments_.gearings[i] * temp *
                             model_->discountBondOption(Option::Put, 1.0/temp,
                                                        maturity, paymentTime);
+                        if (gradientAvailable)
+                            addGradient(
+                                arguments_.nominals[i]*arguments_.gearings[i]*temp,
+                                model_->discountBondOptionGradient(
+                                    Option::Put, 1.0/temp, maturity, paymentTime));
                     }
                     if (type == CapFloor::Floor || type == CapFloor::Collar) {
                         Real temp = 1.0+arguments_.floorRates[i]*tenor;
@@ -109,12 +130,19 @@ namespace QuantLib {
                             arguments_.gearings[i] * temp * mult *
                             model_->discountBondOption(Option::Call, 1.0/temp,
                                                        maturity, paymentTime);
+                        if (gradientAvailable)
+                            addGradient(
+                                arguments_.nominals[i]*arguments_.gearings[i]*temp*mult,
+                                model_->discountBondOptionGradient(
+                                    Option::Call, 1.0/temp, maturity, paymentTime));
                     }
                 }
             }
         }
 
         results_.value = value;
+        if (gradientAvailable && !gradient.empty())
+            results_.additionalResults["modelParameterGradient"] = gradient;
     }
 
 }
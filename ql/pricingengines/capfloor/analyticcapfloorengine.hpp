@@ -26,16 +26,22 @@
 
 #include <ql/instruments/capfloor.hpp>
 #include <ql/pricingengines/genericmodelengine.hpp>
+#include <ql/pricingengines/modelgradientengine.hpp>
 #include <ql/models/model.hpp>
 
 namespace QuantLib {
 
     //! Analytic engine for cap/floor
-    /*! \ingroup capfloorengines */
+    /*! If enabled, the derivatives w.r.t. the model parameters are
+        calculated from AffineModel::discountBondOptionGradient.
+
+        \ingroup capfloorengines
+    */
     class AnalyticCapFloorEngine
         : public GenericModelEngine<AffineModel,
                                     CapFloor::arguments,
-                                    CapFloor::results > {
+                                    CapFloor::results >,
+          public ModelGradientEngine {
       public:
         /*! \note the term structure is only needed when the short-rate
                   model cannot provide one itself.
@@ -0,0 +1,56 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <https://www.quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+
+/*! \file modelgradientengine.hpp
+    \brief interface of engines providing derivatives w.r.t. model parameters
+*/
+
+#ifndef quantlib_model_gradient_engine_hpp
+#define quantlib_model_gradient_engine_hpp
+
+#include <ql/types.hpp>
+
+namespace QuantLib {
+
+    //! pricing engine calculating derivatives w.r.t. the model parameters
+    /*! Once enabled, the engine stores the derivatives of the instrument
+        value with respect to the model parameters, ordered as in
+        CalibratedModel::params(), as an Array in the
+        "modelParameterGradient" additional result. Engines omit the
+        result if the derivatives are not available for the model at
+        hand. As the calculation is usually more expensive than the
+        value alone, it is disabled by default.
+
+        Calibration helpers enable it when the calibration asks for the
+        Jacobian of the calibration errors.
+    */
+    class ModelGradientEngine {
+      public:
+        virtual ~ModelGradientEngine() = default;
+
+        void enableModelGradient(bool flag = true) { modelGradient_ = flag; }
+        bool modelGradientEnabled() const { return modelGradient_; }
+
+      private:
+        bool modelGradient_ = false;
+    };
+
+}
+
+#endif
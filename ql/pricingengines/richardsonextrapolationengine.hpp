@@ -0,0 +1,196 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <https://www.quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file richardsonextrapolationengine.hpp
+    \brief Richardson extrapolation of engines on refined grids
+*/
+
+#ifndef quantlib_richardson_extrapolation_engine_hpp
+#define quantlib_richardson_extrapolation_engine_hpp
+
+#include <ql/math/richardsonextrapolation.hpp>
+#include <ql/option.hpp>
+#include <ql/pricingengine.hpp>
+#include <cmath>
+#include <functional>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace QuantLib {
+
+    //! Richardson extrapolation of grid-based pricing engines
+    /*! The wrapped engine is run on a sequence of refined grids and
+        the NPV and, where available, the Greeks are extrapolated to
+        the limit of vanishing grid spacing.
+
+        The engine generator is called once for each level with the
+        refinement factor \f$ r \f$ of the level, i.e., \f$ 1, t \f$
+        for a known order of convergence and \f$ 1, t, t^2 \f$
+        otherwise, where \f$ t \f$ is the scaling factor. It must
+        return an engine whose grid spacings are reduced by
+        \f$ r \f$; e.g., for a finite-difference engine with tGrid
+        time steps and xGrid points, an engine with r*tGrid steps and
+        r*xGrid points.
+
+        The difference between the extrapolated NPV and the one on
+        the finest grid is returned as error estimate.
+
+        \warning If the levels are calculated in parallel, the wrapped
+                 engines and the market data they use must be safe to
+                 use concurrently after the coarsest level has been
+                 calculated, which triggers any lazy calculation.
+
+        \test the extrapolated NPV of a European option is checked
+              against the analytic result.
+    */
+    template <class ArgumentsType, class ResultsType>
+    class RichardsonExtrapolationEngine
+        : public GenericEngine<ArgumentsType, ResultsType> {
+      public:
+        typedef std::function<ext::shared_ptr<PricingEngine>(Real)>
+            EngineGenerator;
+
+        /*! \param order order of convergence of the wrapped engine;
+                   if null, it is estimated from three levels.
+            \param parallel whether the finer levels are calculated
+                   in parallel (requires OpenMP).
+        */
+        explicit RichardsonExtrapolationEngine(
+            const EngineGenerator& generator,
+            Real order = 2.0,
+            Real scalingFactor = 2.0,
+            bool parallel = false);
+
+        void calculate() const override;
+
+      private:
+        Real extrapolate(const std::vector<Real>& values) const;
+
+        std::vector<ext::shared_ptr<PricingEngine> > engines_;
+        const Real order_, scalingFactor_;
+        const bool parallel_;
+    };
+
+
+    // template definitions
+
+    template <class A, class R>
+    inline RichardsonExtrapolationEngine<A, R>::RichardsonExtrapolationEngine(
+        const EngineGenerator& generator,
+        Real order, Real scalingFactor, bool parallel)
+    : order_(order), scalingFactor_(scalingFactor), parallel_(parallel) {
+        QL_REQUIRE(scalingFactor_ > 1.0,
+                   "scaling factor must be greater than 1");
+        QL_REQUIRE(order_ == Null<Real>() || order_ > 0.0,
+                   "positive order of convergence required");
+
+        const Size levels = (order_ == Null<Real>()) ? 3 : 2;
+        Real r = 1.0;
+        for (Size i=0; i < levels; ++i, r *= scalingFactor_) {
+            engines_.push_back(generator(r));
+            QL_REQUIRE(engines_.back(), "null engine given");
+            this->registerWith(engines_.back());
+        }
+    }
+
+    template <class A, class R>
+    inline Real RichardsonExtrapolationEngine<A, R>::extrapolate(
+                                    const std::vector<Real>& values) const {
+        const Real t = scalingFactor_;
+
+        // values[i] is the result on the grid spacing t^{-i}
+        const std::function<Real(Real)> f = [&](Real h) {
+            return values[std::lround(-std::log(h)/std::log(t))];
+        };
+
+        if (order_ != Null<Real>())
+            return RichardsonExtrapolation(f, 1.0, order_)(t);
+        else
+            return RichardsonExtrapolation(f, 1.0)(t*t, t);
+    }
+
+    template <class A, class R>
+    inline void RichardsonExtrapolationEngine<A, R>::calculate() const {
+        const Size n = engines_.size();
+
+        for (const auto& engine : engines_) {
+            engine->reset();
+            auto* arguments = dynamic_cast<A*>(engine->getArguments());
+            QL_REQUIRE(arguments != nullptr, "wrong engine type");
+            *arguments = this->arguments_;
+        }
+
+        std::vector<R> results(n);
+        std::vector<std::string> errors(n);
+        const auto calculateLevel = [&](Size i) {
+            engines_[i]->calculate();
+            const auto* r = dynamic_cast<const R*>(engines_[i]->getResults());
+            QL_REQUIRE(r != nullptr, "wrong engine type");
+            results[i] = *r;
+        };
+
+        calculateLevel(0);
+
+        #pragma omp parallel for if(parallel_)
+        for (long i=1; i < (long)n; ++i) {
+            try {
+                calculateLevel(i);
+            } catch (std::exception& e) {
+                errors[i] = e.what();
+            }
+        }
+        for (Size i=1; i < n; ++i)
+            QL_REQUIRE(errors[i].empty(),
+                       "level " << i << " failed: " << errors[i]);
+
+        this->results_ = results.back();
+
+        std::vector<Real> values(n);
+        for (Size i=0; i < n; ++i)
+            values[i] = results[i].value;
+        this->results_.value = extrapolate(values);
+        this->results_.errorEstimate =
+            std::fabs(this->results_.value - results.back().value);
+
+        if constexpr (std::is_base_of<Greeks, R>::value) {
+            for (Real Greeks::* greek : { &Greeks::delta, &Greeks::gamma,
+                                          &Greeks::theta, &Greeks::vega,
+                                          &Greeks::rho, &Greeks::dividendRho }) {
+                bool available = true;
+                for (Size i=0; i < n; ++i) {
+                    values[i] = results[i].*greek;
+                    available = available && (values[i] != Null<Real>());
+                }
+                if (!available)
+                    continue;
+
+                try {
+                    this->results_.*greek = extrapolate(values);
+                } catch (Error&) {
+                    // the order of convergence of a Greek can fail to
+                    // be estimated; the finest result is kept then.
+                }
+            }
+        }
+    }
+
+}
+
+
+#endif
@@ -110,6 +110,8 @@ namespace QuantLib {
         Size size = arguments_.fixedCoupons.size();
 
         Real value = 0.0;
+        Array gradient;
+        bool gradientAvailable = modelGradientEnabled();
         Real B = model_->discountBond(maturity, valueTime, rStar);
         for (Size i=0; i<size; i++) {
             Real fixedPayTime =
@@ -123,8 +125,21 @@ namespace QuantLib {
                                                w, strike, maturity, valueTime,
                                                fixedPayTime);
             value += amounts[i]*dboValue;
+
+            if (gradientAvailable) {
+                const Array dboGradient = model_->discountBondOptionGradient(
+                    w, strike, maturity, valueTime, fixedPayTime);
+                if (dboGradient.empty())
+                    gradientAvailable = false;
+                else if (gradient.empty())
+                    gradient = amounts[i]*dboGradient;
+                else
+                    gradient += amounts[i]*dboGradient;
+            }
         }
         results_.value = value;
+        if (gradientAvailable)
+            results_.additionalResults["modelParameterGradient"] = gradient;
     }
 
 }
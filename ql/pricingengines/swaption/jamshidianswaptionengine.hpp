@@ -29,12 +29,19 @@
 #include <ql/instruments/swaption.hpp>
 #include <ql/models/shortrate/onefactormodel.hpp>
 #include <ql/pricingengines/genericmodelengine.hpp>
+#include <ql/pricingengines/modelgradientengine.hpp>
 #include <utility>
 
 namespace QuantLib {
 
     //! Jamshidian swaption engine
-    /*! \ingroup swaptionengines
+    /*! If enabled, the derivatives w.r.t. the model parameters are
+        calculated from AffineModel::discountBondOptionGradient. All
+        bond options of the decomposition are exercised on the same
+        event, hence the derivatives of the value w.r.t. the strikes
+        sum up to zero and the strikes can be kept fixed.
+
+        \ingroup swaptionengines
         \warning The engine might assume that the exercise date equals the
                  start date of the passed swap unless the model provides
                  an implementation of the discountBondOption method with
@@ -44,7 +51,8 @@ namespace QuantLib {
     class JamshidianSwaptionEngine
         : public GenericModelEngine<OneFactorAffineModel,
                                     Swaption::arguments,
-                                    Swaption::results > {
+                                    Swaption::results >,
+          public ModelGradientEngine {
       public:
         /*! \note the term structure is only needed when the short-rate
                   model cannot provide one itself.
@@ -34,13 +34,16 @@
 #include <ql/math/solvers1d/brent.hpp>
 #include <ql/math/expm1.hpp>
 #include <ql/math/functional.hpp>
+#include <ql/models/equity/hestoncharacteristicfunction.hpp>
 #include <ql/pricingengines/blackcalculator.hpp>
+#include <ql/pricingengines/blackformula.hpp>
 #include <ql/pricingengines/vanilla/analytichestonengine.hpp>
 #include <boost/math/tools/minima.hpp>
 #include <boost/math/special_functions/sign.hpp>
 #include <functional>
 #include <cmath>
 #include <limits>
+#include <map>
 #include <utility>
 
 #if defined(QL_PATCH_MSVC)
@@ -502,6 +505,71 @@ namespace QuantLib {
           default:
             QL_FAIL("unknown control variate");
         }
+
+        theta_ = theta; kappa_ = kappa; sigma_ = sigma; rho_ = rho; v0_ = v0;
+
+        // derivatives of the control variate parameters, see gradient()
+        dVAvg_.fill(0.0);
+        dPhi_.fill(0.0);
+        dPsi_.fill(0.0);
+        switch(cpxLog_) {
+          case AndersenPiterbarg:
+          case AngledContour:
+          case AsymptoticChF: {
+              const Real ekt = std::exp(-kappa*term);
+              const Real f = (1-ekt)/(kappa*term);
+              dVAvg_ = {1-f, (v0-theta)*(ekt-f)/kappa, 0.0, 0.0, f};
+
+              if (cpxLog_ == AsymptoticChF) {
+                  const Real s = std::sqrt(1-rho*rho);
+                  const std::complex<Real> sr(s, rho);
+                  const Real w = v0 + term*kappa*theta;
+                  const Real dW[] = {term*kappa, term*theta, 0.0, 0.0, 1.0};
+                  const Real dSigma[] = {0.0, 0.0, 1.0, 0.0, 0.0};
+                  const std::complex<Real> dSr[] = {
+                      0.0, 0.0, 0.0, std::complex<Real>(-rho/s, 1.0), 0.0};
+
+                  // psi = (a + i*b)/sigma^2
+                  const Real logR = std::log(4*(1-rho*rho));
+                  const Real atanR = std::atan(rho/s);
+                  const Real c = (0.5*rho*rho*sigma - kappa*rho)/s;
+                  const Real dC[] = {
+                      0.0, -rho/s, 0.5*rho*rho/s,
+                      (rho*sigma - kappa)/s + c*rho/(s*s), 0.0};
+                  const Real dA[] = {
+                      (kappa - 0.5*rho*sigma)*dW[0] + kappa*logR,
+                      w + (kappa - 0.5*rho*sigma)*dW[1] + theta*logR,
+                      -0.5*rho*w,
+                      -0.5*sigma*w - 2*rho*kappa*theta/(1-rho*rho),
+                      (kappa - 0.5*rho*sigma)*dW[4]};
+                  const Real dB[] = {
+                      -c*dW[0] + 2*kappa*atanR,
+                      -dC[1]*w - c*dW[1] + 2*theta*atanR,
+                      -dC[2]*w,
+                      -dC[3]*w + 2*kappa*theta/s,
+                      -c*dW[4]};
+
+                  for (Size p=0; p < 5; ++p) {
+                      dPhi_[p] = -(dW[p]*sr + w*dSr[p])/sigma
+                          + w*sr*dSigma[p]/(sigma*sigma);
+                      dPsi_[p] = std::complex<Real>(dA[p], dB[p])/(sigma*sigma)
+                          - 2.0*psi_*dSigma[p]/sigma;
+                  }
+              }
+            }
+            break;
+          case AndersenPiterbargOptCV: {
+              std::complex<Real> dLnChF[5];
+              const std::complex<Real> chF = std::exp(detail::hestonLnChF(
+                  std::complex<Real>(0, alpha_), term,
+                  theta, kappa, sigma, rho, v0, dLnChF));
+              for (Size p=0; p < 5; ++p)
+                  dVAvg_[p] = -8.0*(chF*dLnChF[p]).real()/(chF.real()*term);
+            }
+            break;
+          default:
+            break;
+        }
     }
 
     Real AnalyticHestonEngine::AP_Helper::operator()(Real u) const {
@@ -575,6 +643,98 @@ namespace QuantLib {
             QL_FAIL("unknown control variate");
     }
 
+    void AnalyticHestonEngine::AP_Helper::gradient(
+        Real u, Real* dIntegrand) const {
+
+        constexpr std::complex<double> i(0, 1);
+        std::complex<Real> dLnChF[5];
+
+        if (cpxLog_ == AngledContour || cpxLog_ == AngledContourNoCV || cpxLog_ == AsymptoticChF) {
+            const std::complex<Real> h_u(u, u*tanPhi_ - alpha_);
+            const std::complex<Real> hPrime(h_u-i);
+
+            const std::complex<Real> chF = std::exp(detail::hestonLnChF(
+                hPrime, term_, theta_, kappa_, sigma_, rho_, v0_, dLnChF));
+
+            std::complex<Real> phiBS(0.0);
+            if (cpxLog_ == AngledContour)
+                phiBS = std::exp(-0.5*vAvg_*term_*(hPrime*hPrime + i*hPrime));
+            else if (cpxLog_ == AsymptoticChF)
+                phiBS = std::exp(u*std::complex<Real>(1, tanPhi_)*phi_ + psi_);
+
+            const std::complex<Real> f = std::exp(-u*tanPhi_*freq_)
+                *std::exp(std::complex<Real>(0.0, u*freq_))
+                *std::complex<Real>(1, tanPhi_)/(h_u*hPrime)*s_alpha_;
+
+            for (Size p=0; p < 5; ++p) {
+                std::complex<Real> dPhiBS(0.0);
+                if (cpxLog_ == AngledContour)
+                    dPhiBS = -0.5*term_*(hPrime*hPrime + i*hPrime)
+                        *dVAvg_[p]*phiBS;
+                else if (cpxLog_ == AsymptoticChF)
+                    dPhiBS = (u*std::complex<Real>(1, tanPhi_)*dPhi_[p]
+                              + dPsi_[p])*phiBS;
+
+                dIntegrand[p] = (f*(dPhiBS - chF*dLnChF[p])).real();
+            }
+        }
+        else if (cpxLog_ == AndersenPiterbarg || cpxLog_ == AndersenPiterbargOptCV) {
+            const std::complex<Real> z(u, -alpha_);
+            const std::complex<Real> zPrime(u, -alpha_-1);
+
+            const std::complex<Real> chF = std::exp(detail::hestonLnChF(
+                zPrime, term_, theta_, kappa_, sigma_, rho_, v0_, dLnChF));
+            const std::complex<Real> phiBS =
+                std::exp(-0.5*vAvg_*term_*(zPrime*zPrime + i*zPrime));
+
+            const std::complex<Real> f =
+                std::exp(std::complex<Real>(0.0, u*freq_))/(z*zPrime)*s_alpha_;
+
+            for (Size p=0; p < 5; ++p) {
+                const std::complex<Real> dPhiBS =
+                    -0.5*term_*(zPrime*zPrime + i*zPrime)*dVAvg_[p]*phiBS;
+                dIntegrand[p] = (f*(dPhiBS - chF*dLnChF[p])).real();
+            }
+        }
+        else
+            QL_FAIL("unknown control variate");
+    }
+
+    void AnalyticHestonEngine::AP_Helper::controlVariateGradient(
+        Real* dValue) const {
+        if (   cpxLog_ == AngledContour
+            || cpxLog_ == AndersenPiterbarg || cpxLog_ == AndersenPiterbargOptCV) {
+            const Real stdDev = std::sqrt(vAvg_*term_);
+            const Real dValueDVAvg = blackFormulaStdDevDerivative(
+                strike_, fwd_, stdDev)*0.5*term_/stdDev;
+            for (Size p=0; p < 5; ++p)
+                dValue[p] = dValueDVAvg*dVAvg_[p];
+        }
+        else if (cpxLog_ == AsymptoticChF) {
+            const std::complex<Real> phiFreq(phi_.real(), phi_.imag() + freq_);
+
+            using namespace ExponentialIntegral;
+            const std::complex<Real> ci = Ci(-0.5*phiFreq);
+            const std::complex<Real> si = Si(0.5*phiFreq);
+            const std::complex<Real> g =
+                -2.0*ci*std::sin(0.5*phiFreq)
+                + std::cos(0.5*phiFreq)*(M_PI+2.0*si);
+            // the derivatives of Ci and Si cancel each other
+            const std::complex<Real> dG =
+                -ci*std::cos(0.5*phiFreq)
+                - 0.5*std::sin(0.5*phiFreq)*(M_PI+2.0*si);
+
+            for (Size p=0; p < 5; ++p)
+                dValue[p] = -std::sqrt(strike_*fwd_)/M_PI*(
+                    std::exp(psi_)*(dPsi_[p]*g + dG*dPhi_[p])).real();
+        }
+        else if (cpxLog_ == AngledContourNoCV) {
+            std::fill(dValue, dValue + 5, 0.0);
+        }
+        else
+            QL_FAIL("unknown control variate");
+    }
+
     std::complex<Real> AnalyticHestonEngine::chF(
         const std::complex<Real>& z, Time t) const {
         if (model_->sigma() > 1e-6 || model_->kappa() < 1e-8) {
@@ -747,10 +907,13 @@ namespace QuantLib {
 
     Real AnalyticHestonEngine::priceVanillaPayoff(
         const ext::shared_ptr<PlainVanillaPayoff>& payoff,
-        Time maturity, Real fwd) const {
+        Time maturity, Real fwd, Array* gradient) const {
 
         Real value;
 
+        if (gradient != nullptr)
+            *gradient = Array();
+
         const ext::shared_ptr<HestonProcess>& process = model_->process();
         const DiscountFactor dr = process->riskFreeRate()->discount(maturity);
 
@@ -838,6 +1001,32 @@ namespace QuantLib {
 
             evaluations_ += integration_->numberOfEvaluations();
 
+            if (gradient != nullptr) {
+                // the puts have the same derivatives as the calls
+                Real dCvValue[5];
+                cvHelper.controlVariateGradient(dCvValue);
+
+                // the derivatives for all parameters are calculated at
+                // once and reused by the integrations of the others
+                std::map<Real, std::array<Real, 5> > dIntegrand;
+                *gradient = Array(5);
+                for (Size p=0; p < 5; ++p) {
+                    const Real dH_cv = fwd/M_PI*integration_->calculate(
+                        c_inf,
+                        [&](Real u) -> Real {
+                            auto iter = dIntegrand.find(u);
+                            if (iter == dIntegrand.end()) {
+                                std::array<Real, 5> d;
+                                cvHelper.gradient(u, d.data());
+                                iter = dIntegrand.emplace(u, d).first;
+                            }
+                            return iter->second[p];
+                        },
+                        uM, scalingFactor);
+                    (*gradient)[p] = (dCvValue[p] + dH_cv)*dr;
+                }
+            }
+
             switch (payoff->optionType())
             {
               case Option::Call:
@@ -871,7 +1060,26 @@ namespace QuantLib {
 
         const Date exerciseDate = arguments_.exercise->lastDate();
 
-        results_.value = priceVanillaPayoff(payoff, exerciseDate);
+        const ext::shared_ptr<HestonProcess>& process = model_->process();
+        const Time t = process->time(exerciseDate);
+
+        // the derivatives are only available for the plain Heston model
+        if (!modelGradientEnabled()
+            || model_->params().size() != 5 || model_->sigma() <= 1e-6
+            || addOnTerm(1.0, t, 1) != std::complex<Real>(0.0)
+            || addOnTerm(1.0, t, 2) != std::complex<Real>(0.0)) {
+            results_.value = priceVanillaPayoff(payoff, exerciseDate);
+            return;
+        }
+
+        const Real fwd = process->s0()->value()
+             * process->dividendYield()->discount(exerciseDate)
+             / process->riskFreeRate()->discount(exerciseDate);
+
+        Array gradient;
+        results_.value = priceVanillaPayoff(payoff, t, fwd, &gradient);
+        if (!gradient.empty())
+            results_.additionalResults["modelParameterGradient"] = gradient;
     }
 
 
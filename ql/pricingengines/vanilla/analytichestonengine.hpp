@@ -29,8 +29,10 @@
 #include <ql/math/integrals/integral.hpp>
 #include <ql/math/integrals/gaussianquadratures.hpp>
 #include <ql/pricingengines/genericmodelengine.hpp>
+#include <ql/pricingengines/modelgradientengine.hpp>
 #include <ql/models/equity/hestonmodel.hpp>
 #include <ql/instruments/vanillaoption.hpp>
+#include <array>
 #include <functional>
 #include <complex>
 
@@ -82,6 +84,15 @@ namespace QuantLib {
         Contour Deformations and Double-Exponential Quadrature,
         https://papers.ssrn.com/sol3/papers.cfm?abstract_id=3231626
 
+        If enabled, the derivatives w.r.t. the parameters of a plain
+        Heston model are calculated by integrating the derivatives of
+        the integrand with the integration algorithm of the engine.
+        The integration contour and limits are kept fixed, hence the
+        derivatives are those of the engine's value up to the
+        integration accuracy. They are available for the
+        Andersen-Piterbarg and angled-contour formulas and for
+        OptimalCV, but not for Gatheral and BranchCorrection.
+
         \ingroup vanillaengines
 
         \test the correctness of the returned value is tested by
@@ -91,7 +102,8 @@ namespace QuantLib {
     class AnalyticHestonEngine
         : public GenericModelEngine<HestonModel,
                                     VanillaOption::arguments,
-                                    VanillaOption::results> {
+                                    VanillaOption::results>,
+          public ModelGradientEngine {
       public:
         class Integration;
         class OptimalAlpha;
@@ -183,9 +195,12 @@ namespace QuantLib {
       private:
         class Fj_Helper;
 
+        /* if given, the gradient is filled with the derivatives
+           w.r.t. the model parameters or left empty if they are not
+           available for the complex log formula */
         Real priceVanillaPayoff(
            const ext::shared_ptr<PlainVanillaPayoff>& payoff,
-           Time maturity, Real fwd) const;
+           Time maturity, Real fwd, Array* gradient = nullptr) const;
 
 
         mutable Size evaluations_;
@@ -264,6 +279,13 @@ namespace QuantLib {
         Real operator()(Real u) const;
         Real controlVariateValue() const;
 
+        /*! derivatives of the integrand at u and of the control variate
+            w.r.t. the parameters of a plain Heston model, ordered as in
+            HestonModel::params(). The integration contour is kept fixed.
+        */
+        void gradient(Real u, Real* dIntegrand) const;
+        void controlVariateGradient(Real* dValue) const;
+
       private:
         const Time term_;
         const Real fwd_, strike_, freq_;
@@ -272,6 +294,10 @@ namespace QuantLib {
         const Real alpha_, s_alpha_;
         Real vAvg_, tanPhi_;
         std::complex<Real> phi_, psi_;
+
+        Real theta_, kappa_, sigma_, rho_, v0_;
+        std::array<Real, 5> dVAvg_;
+        std::array<std::complex<Real>, 5> dPhi_, dPsi_;
     };
 
 
@@ -0,0 +1,233 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <https://www.quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/exercise.hpp>
+#include <ql/math/integrals/gaussianquadratures.hpp>
+#include <ql/models/equity/hestoncharacteristicfunction.hpp>
+#include <ql/pricingengines/blackformula.hpp>
+#include <ql/pricingengines/vanilla/analytichestonsliceengine.hpp>
+#include <algorithm>
+#include <complex>
+#include <string>
+
+namespace QuantLib {
+
+    namespace {
+
+        typedef std::complex<Real> Complex;
+
+    }
+
+    HestonSlicePricer::HestonSlicePricer(Size integrationOrder) {
+        QL_REQUIRE(integrationOrder > 0, "positive integration order required");
+        GaussLegendreIntegration quadrature(integrationOrder);
+        x_ = quadrature.x();
+        w_ = quadrature.weights();
+    }
+
+    Array HestonSlicePricer::callPrices(Time t,
+                                        Real forward,
+                                        Real discount,
+                                        const std::vector<Real>& strikes,
+                                        const Array& params,
+                                        Matrix* gradient) const {
+        QL_REQUIRE(t > 0.0, "positive maturity required");
+        QL_REQUIRE(params.size() == 5, "five Heston parameters required");
+
+        const Real theta = params[0], kappa = params[1], sigma = params[2],
+            rho = params[3], v0 = params[4];
+
+        const Size n = x_.size(), m = strikes.size();
+        const Size nParams = (gradient != nullptr) ? 5 : 0;
+
+        // Black-Scholes control variate with the average variance
+        const Real ekt = std::exp(-kappa*t);
+        const Real f = (1.0 - ekt)/(kappa*t);
+        const Real vAvg = f*(v0 - theta) + theta;
+        const Real dVAvg[] = { 1.0 - f,
+                               (v0 - theta)*(ekt - f)/kappa,
+                               0.0, 0.0, f };
+
+        /* the asymptotic decay rate overestimates the decay of the
+           integrand for small vol-of-vol, in which case the scale of
+           the Black-Scholes characteristic function is used */
+        const Real c_inf = std::min(
+            std::sqrt(1.0-rho*rho)*(v0 + kappa*theta*t)/sigma,
+            0.25*std::sqrt(vAvg*t));
+        QL_REQUIRE(c_inf > 0.0, "degenerate Heston parameters");
+
+        /* node values: u, integration weight times 1/(u^2+1/4) and the
+           difference between the Black-Scholes and the Heston
+           characteristic function at u - i/2, real and imaginary part */
+        Array u(n), a(n);
+        std::vector<Array> re(1+nParams, Array(n)), im(1+nParams, Array(n));
+        Complex dLnChF[5];
+        for (Size j=0; j < n; ++j) {
+            u[j] = -std::log(0.5 - 0.5*x_[j])/c_inf;
+            a[j] = w_[j]/((1.0 - x_[j])*c_inf*(u[j]*u[j] + 0.25));
+
+            const Real phiBS = std::exp(-0.5*vAvg*t*(u[j]*u[j] + 0.25));
+            const Complex phi = std::exp(detail::hestonLnChF(
+                Complex(u[j], -0.5), t, theta, kappa, sigma, rho, v0,
+                (nParams != 0) ? dLnChF : nullptr));
+
+            re[0][j] = phiBS - phi.real();
+            im[0][j] = -phi.imag();
+            for (Size p=0; p < nParams; ++p) {
+                const Real dPhiBS = -0.5*t*(u[j]*u[j] + 0.25)*phiBS*dVAvg[p];
+                const Complex dPhi = phi*dLnChF[p];
+                re[p+1][j] = dPhiBS - dPhi.real();
+                im[p+1][j] = -dPhi.imag();
+            }
+        }
+
+        if (gradient != nullptr)
+            *gradient = Matrix(m, nParams, 0.0);
+
+        const Real stdDev = std::sqrt(vAvg*t);
+        Array prices(m);
+        Array h(1+nParams);
+        for (Size i=0; i < m; ++i) {
+            const Real k = strikes[i];
+            QL_REQUIRE(k > 0.0, "positive strike required");
+            const Real freq = std::log(forward/k);
+
+            std::fill(h.begin(), h.end(), 0.0);
+            for (Size j=0; j < n; ++j) {
+                const Real c = a[j]*std::cos(u[j]*freq);
+                const Real s = a[j]*std::sin(u[j]*freq);
+                for (Size p=0; p <= nParams; ++p)
+                    h[p] += c*re[p][j] - s*im[p][j];
+            }
+
+            const Real scale = forward/M_PI*std::exp(-0.5*freq);
+            prices[i] = discount*(
+                blackFormula(Option::Call, k, forward, stdDev) + scale*h[0]);
+
+            if (nParams != 0) {
+                const Real vega = blackFormulaStdDevDerivative(
+                    k, forward, stdDev)*0.5*t/stdDev;
+                for (Size p=0; p < nParams; ++p)
+                    (*gradient)[i][p] =
+                        discount*(vega*dVAvg[p] + scale*h[p+1]);
+            }
+        }
+
+        return prices;
+    }
+
+
+    AnalyticHestonSliceEngine::AnalyticHestonSliceEngine(
+        const ext::shared_ptr<HestonModel>& model,
+        Size integrationOrder,
+        bool parallel)
+    : GenericModelEngine<HestonModel,
+                         VanillaOption::arguments,
+                         VanillaOption::results>(model),
+      pricer_(integrationOrder), parallel_(parallel) {}
+
+    void AnalyticHestonSliceEngine::update() {
+        upToDate_ = false;
+        GenericModelEngine<HestonModel,
+                           VanillaOption::arguments,
+                           VanillaOption::results>::update();
+    }
+
+    void AnalyticHestonSliceEngine::calculate() const {
+        // this is a european option pricer
+        QL_REQUIRE(arguments_.exercise->type() == Exercise::European,
+                   "not an European option");
+
+        // plain vanilla
+        const ext::shared_ptr<PlainVanillaPayoff> payoff =
+            ext::dynamic_pointer_cast<PlainVanillaPayoff>(arguments_.payoff);
+        QL_REQUIRE(payoff, "non plain vanilla payoff given");
+
+        // the cache is reset on notifications, the comparison of the
+        // parameters covers notifications deferred by ObservableSettings
+        const Array params = model_->params();
+        if (!upToDate_ || params != params_
+            || (modelGradientEnabled() && !withGradient_)) {
+            for (auto& slice : slices_)
+                slice.second.calls = Array();
+            params_ = params;
+            withGradient_ = modelGradientEnabled();
+            upToDate_ = true;
+        }
+
+        Slice& slice = slices_[arguments_.exercise->lastDate()];
+        const Real strike = payoff->strike();
+        const Size i = std::find(slice.strikes.begin(), slice.strikes.end(),
+                                 strike) - slice.strikes.begin();
+        if (i == slice.strikes.size()) {
+            slice.strikes.push_back(strike);
+            slice.calls = Array();
+        }
+
+        if (slice.calls.empty())
+            calculateSlices();
+
+        results_.value = (payoff->optionType() == Option::Call)
+            ? slice.calls[i]
+            : slice.calls[i] - slice.discount*(slice.forward - strike);
+
+        if (modelGradientEnabled())
+            results_.additionalResults["modelParameterGradient"] =
+                Array(slice.gradient.row_begin(i), slice.gradient.row_end(i));
+    }
+
+    void AnalyticHestonSliceEngine::calculateSlices() const {
+        const ext::shared_ptr<HestonProcess>& process = model_->process();
+
+        // market data is read before the parallel section
+        std::vector<std::pair<Date, Slice*> > stale;
+        for (auto& iter : slices_) {
+            Slice& slice = iter.second;
+            if (slice.calls.empty()) {
+                const Date& exerciseDate = iter.first;
+                slice.t = process->time(exerciseDate);
+                slice.discount =
+                    process->riskFreeRate()->discount(exerciseDate);
+                slice.forward = process->s0()->value()
+                    *process->dividendYield()->discount(exerciseDate)
+                    /slice.discount;
+                stale.emplace_back(exerciseDate, &slice);
+            }
+        }
+
+        std::vector<std::string> errors(stale.size());
+
+        #pragma omp parallel for schedule(dynamic) if(parallel_ && stale.size() > 1)
+        for (long l=0; l < (long)stale.size(); ++l) {
+            Slice& slice = *stale[l].second;
+            try {
+                slice.calls = pricer_.callPrices(
+                    slice.t, slice.forward, slice.discount, slice.strikes,
+                    params_, withGradient_ ? &slice.gradient : nullptr);
+            } catch (std::exception& e) {
+                errors[l] = e.what();
+            }
+        }
+
+        for (Size l=0; l < stale.size(); ++l)
+            QL_REQUIRE(errors[l].empty(),
+                       "slice with exercise date " << stale[l].first
+                       << ": " << errors[l]);
+    }
+
+}
@@ -0,0 +1,143 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <https://www.quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file analytichestonsliceengine.hpp
+    \brief Heston engine pricing all strikes of a maturity slice at once
+*/
+
+#ifndef quantlib_analytic_heston_slice_engine_hpp
+#define quantlib_analytic_heston_slice_engine_hpp
+
+#include <ql/instruments/vanillaoption.hpp>
+#include <ql/math/matrix.hpp>
+#include <ql/models/equity/hestonmodel.hpp>
+#include <ql/pricingengines/genericmodelengine.hpp>
+#include <ql/pricingengines/modelgradientengine.hpp>
+#include <map>
+
+namespace QuantLib {
+
+    //! Heston prices of European options sharing the same maturity
+    /*! The Andersen-Piterbarg representation with a Black-Scholes
+        control variate and \f$ \alpha = -\frac{1}{2} \f$ is integrated
+        by a Gauss-Legendre quadrature after the transformation
+        \f$ u = -\ln(\frac{1-x}{2})/c \f$, see AnalyticHestonEngine.
+        Here \f$ c \f$ is the smaller of the asymptotic decay rate
+        \f$ c_\infty \f$ and \f$ \frac{1}{4}\sqrt{\bar{v}t} \f$.
+        Neither the nodes nor the characteristic function depend on the
+        strike, hence the characteristic function is evaluated once per
+        node and shared by all strikes.
+
+        The derivatives with respect to the model parameters, ordered as
+        in HestonModel::params(), are calculated along with the prices
+        by differentiating the characteristic function in forward mode.
+        They are the derivatives of the quadrature with fixed nodes:
+        \f$ c \f$ depends on the model parameters but is not
+        differentiated, hence they agree with the derivatives of the
+        prices only up to the integration accuracy.
+
+        \warning For large vol-of-vol together with small variance and
+                 short maturities the integrand decays slowly and the
+                 integration order must be increased.
+    */
+    class HestonSlicePricer {
+      public:
+        explicit HestonSlicePricer(Size integrationOrder = 128);
+
+        /*! returns the call prices for the given strikes and the
+            Heston parameters theta, kappa, sigma, rho and v0. If given,
+            the gradient matrix is resized to strikes times parameters.
+        */
+        Array callPrices(Time t,
+                         Real forward,
+                         Real discount,
+                         const std::vector<Real>& strikes,
+                         const Array& params,
+                         Matrix* gradient = nullptr) const;
+
+        Size integrationOrder() const { return x_.size(); }
+
+      private:
+        Array x_, w_;
+    };
+
+
+    //! Heston engine pricing all strikes of a maturity slice at once
+    /*! The engine keeps track of the strikes it has been asked to price
+        for each exercise date. Whenever the model or the market data
+        change, all known slices are repriced by HestonSlicePricer on
+        the first request, and the following requests for the same
+        parameters are served from the cache. The slices are distributed
+        over OpenMP threads.
+
+        The engine is meant for calibrations, in which the same set of
+        options is repriced for many parameter sets: setting it on all
+        HestonModelHelper instruments prices every slice once per
+        parameter set. As a ModelGradientEngine it provides the
+        derivatives of the prices with respect to the model parameters,
+        which CalibratedModel::calibrate turns into the Jacobian of the
+        calibration errors, e.g. for LevenbergMarquardt with
+        useCostFunctionsJacobian set. As described for
+        HestonSlicePricer, this Jacobian is approximate up to the
+        integration accuracy.
+
+        \warning The cache is not protected against concurrent
+                 calculations with the same engine.
+
+        \test prices and derivatives are checked against
+              AnalyticHestonEngine and finite differences, the
+              calibration against the engine-based calibration.
+    */
+    class AnalyticHestonSliceEngine
+        : public GenericModelEngine<HestonModel,
+                                    VanillaOption::arguments,
+                                    VanillaOption::results>,
+          public ModelGradientEngine {
+      public:
+        explicit AnalyticHestonSliceEngine(
+            const ext::shared_ptr<HestonModel>& model,
+            Size integrationOrder = 128,
+            bool parallel = true);
+
+        void update() override;
+        void calculate() const override;
+
+        //! number of maturity slices known to the engine
+        Size numberOfSlices() const { return slices_.size(); }
+
+      private:
+        struct Slice {
+            Time t;
+            Real forward, discount;
+            std::vector<Real> strikes;
+            Array calls;
+            Matrix gradient;
+        };
+        void calculateSlices() const;
+
+        const HestonSlicePricer pricer_;
+        const bool parallel_;
+
+        mutable std::map<Date, Slice> slices_;
+        mutable Array params_;
+        mutable bool upToDate_ = false, withGradient_ = false;
+    };
+
+}
+
+#endif
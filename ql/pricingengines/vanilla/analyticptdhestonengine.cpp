@@ -24,6 +24,7 @@
 #include <ql/math/functional.hpp>
 #include <ql/instruments/payoffs.hpp>
 #include <ql/pricingengines/vanilla/analyticptdhestonengine.hpp>
+#include <ql/pricingengines/vanilla/coshestonengine.hpp>
 #include <ql/pricingengines/blackcalculator.hpp>
 
 namespace QuantLib {
@@ -408,4 +409,35 @@ namespace QuantLib {
     Size AnalyticPTDHestonEngine::numberOfEvaluations() const {
         return evaluations_;
     }
+
+    Array AnalyticPTDHestonEngine::cosChainPrices(
+        const Date& maturityDate, const std::vector<Real>& strikes,
+        Option::Type type, Real L, Size N) const {
+
+        const Real spot = model_->s0();
+        QL_REQUIRE(spot > 0.0, "negative or null underlying given");
+
+        const Time maturity
+            = model_->riskFreeRate()->dayCounter().yearFraction(
+                model_->riskFreeRate()->referenceDate(), maturityDate);
+
+        const DiscountFactor df
+            = model_->riskFreeRate()->discount(maturityDate);
+        const DiscountFactor qf
+            = model_->dividendYield()->discount(maturityDate);
+
+        // cumulant generating function K(h) = lnChF(-ih)
+        const Real h = 1e-3;
+        const Real kUp
+            = lnChF(std::complex<Real>(0.0, -h), maturity).real();
+        const Real kDown
+            = lnChF(std::complex<Real>(0.0, h), maturity).real();
+
+        return COSHestonEngine::chainPrices(
+            [&](Real u) {
+                return chF(std::complex<Real>(u, 0.0), maturity);
+            },
+            (kUp - kDown)/(2*h), (kUp + kDown)/(h*h),
+            spot*qf/df, df, strikes, type, L, N);
+    }
 }
@@ -83,6 +83,16 @@ namespace QuantLib {
         void calculate() const override;
         Size numberOfEvaluations() const;
 
+        //! COS prices of european options with common maturity
+        /*! The characteristic function is evaluated once for the whole
+            chain, see COSHestonEngine::chainPrices. The first two
+            cumulants are taken from finite differences of lnChF.
+        */
+        Array cosChainPrices(const Date& maturityDate,
+                             const std::vector<Real>& strikes,
+                             Option::Type type,
+                             Real L = 16, Size N = 200) const;
+
         // normalized characteristic function
         std::complex<Real> chF(const std::complex<Real>& z, Time t) const;
         std::complex<Real> lnChF(const std::complex<Real>& z, Time t) const;
@@ -19,6 +19,7 @@
 */
 
 #include <ql/math/functional.hpp>
+#include <ql/models/equity/batesmodel.hpp>
 #include <ql/pricingengines/vanilla/coshestonengine.hpp>
 
 namespace QuantLib {
@@ -33,7 +34,9 @@ namespace QuantLib {
     theta_(model_->theta()),
     sigma_(model_->sigma()),
     rho_  (model_->rho())  ,
-    v0_   (model_->v0()) { }
+    v0_   (model_->v0()) {
+        setJumpParameters();
+    }
 
 
     void COSHestonEngine::update() {
@@ -42,6 +45,7 @@ namespace QuantLib {
         sigma_ = model_->sigma();
         rho_   = model_->rho();
         v0_    = model_->v0();
+        setJumpParameters();
 
         GenericModelEngine<HestonModel,
                            VanillaOption::arguments,
@@ -49,6 +53,21 @@ namespace QuantLib {
     }
 
 
+    void COSHestonEngine::setJumpParameters() {
+        QL_REQUIRE(!ext::dynamic_pointer_cast<BatesDetJumpModel>(*model_)
+                   && !ext::dynamic_pointer_cast<BatesDoubleExpModel>(*model_),
+                   "jump model not supported");
+
+        const ext::shared_ptr<BatesModel> batesModel =
+            ext::dynamic_pointer_cast<BatesModel>(*model_);
+        if (batesModel != nullptr) {
+            lambda_ = batesModel->lambda();
+            nu_     = batesModel->nu();
+            delta_  = batesModel->delta();
+        }
+    }
+
+
     void COSHestonEngine::calculate() const {
 
         // this is a european option pricer
@@ -60,18 +79,19 @@ namespace QuantLib {
             ext::dynamic_pointer_cast<PlainVanillaPayoff>(arguments_.payoff);
         QL_REQUIRE(payoff, "non plain vanilla payoff given");
 
+        results_.value = chainPrices(arguments_.exercise->lastDate(),
+                                     std::vector<Real>(1, payoff->strike()),
+                                     payoff->optionType())[0];
+    }
+
+
+    Array COSHestonEngine::chainPrices(const Date& maturityDate,
+                                       const std::vector<Real>& strikes,
+                                       Option::Type type) const {
         const ext::shared_ptr<HestonProcess> process = model_->process();
 
-        const Date maturityDate = arguments_.exercise->lastDate();
         const Time maturity = process->time(maturityDate);
 
-        const Real cum1 = c1(maturity);
-        const Real w = std::sqrt(std::fabs(c2(maturity))
-            // the 4th order doesn't necessarily improve the precision
-            // + std::sqrt(std::fabs(c4(maturity)))
-        );
-
-        const Real k = payoff->strike();
         const Real spot = process->s0()->value();
         QL_REQUIRE(spot > 0.0, "negative or null underlying given");
 
@@ -79,49 +99,87 @@ namespace QuantLib {
             = process->riskFreeRate()->discount(maturityDate);
         const DiscountFactor qf
             = process->dividendYield()->discount(maturityDate);
-        const Real fwd = spot*qf/df;
-        const Real x = std::log(fwd/k);
-
-        const Real a = x + cum1 - L_*w;
-        const Real b = x + cum1 + L_*w;
-        
-        // Check if it exceeds the truncation bound
-        
-        if (x >= b/2 || x <= a/2) {
-            //returns lower/upper bounds
-            if (payoff->optionType() == Option::Put)
-                results_.value = std::max(-spot*qf+k*df,0.0);
-            else if (payoff->optionType() == Option::Call)
-           	    results_.value = std::max(spot*qf-k*df,0.0);
-       	    else
-                QL_FAIL("unknown payoff type");
-            return;
-        }
-		
 
-        const Real d = 1.0/(b-a);
+        // the 4th order cumulant doesn't necessarily improve the
+        // precision of the truncation range
+        return chainPrices(
+            [&](Real u) { return chF(u, maturity); },
+            c1(maturity), c2(maturity),
+            spot*qf/df, df, strikes, type, L_, N_);
+    }
 
-        const Real expA = std::exp(a);
-        Real s = chF(0, maturity).real()*(expA-1-a)*d;
 
-        for (Size n=1; n < N_; ++n) {
+    Array COSHestonEngine::chainPrices(
+        const std::function<std::complex<Real>(Real)>& chF,
+        Real cum1, Real cum2, Real fwd, DiscountFactor df,
+        const std::vector<Real>& strikes, Option::Type type,
+        Real L, Size N) {
+
+        QL_REQUIRE(type == Option::Call || type == Option::Put,
+                   "unknown payoff type");
+        QL_REQUIRE(N > 0, "positive number of expansion terms required");
+
+        const Real w = std::sqrt(std::fabs(cum2));
+
+        // the interval [a, b] is centered around the log-moneyness,
+        // hence its length, the frequencies and the phase
+        // r*(x - a) do not depend on the strike.
+        const Real d = 1.0/(2.0*L*w);
+
+        Array phi(N);
+        phi[0] = chF(0.0).real();
+        for (Size n=1; n < N; ++n) {
             const Real r = n*M_PI*d;
-            const Real U_n = 2.0*d*( 1.0/(1.0 + r*r)
-                *(expA + r*std::sin(r*a) - std::cos(r*a)) - 1.0/r*std::sin(r*a));
+            phi[n] = (chF(r)
+                      *std::exp(std::complex<Real>(0, r*(L*w - cum1)))).real();
+        }
 
-            s += U_n*(chF(r, maturity)
-                     *std::exp(std::complex<Real>(0, r*(x-a)))).real();
+        Array results(strikes.size());
+        std::vector<Size> inRange;
+        for (Size i=0; i < strikes.size(); ++i) {
+            const Real k = strikes[i];
+            const Real x = std::log(fwd/k);
+
+            const Real a = x + cum1 - L*w;
+            const Real b = x + cum1 + L*w;
+
+            // Check if it exceeds the truncation bound
+            if (x >= b/2 || x <= a/2)
+                //returns lower/upper bounds
+                results[i] = (type == Option::Put)
+                    ? std::max(-fwd*df+k*df, 0.0)
+                    : std::max(fwd*df-k*df, 0.0);
+            else
+                inRange.push_back(i);
         }
 
-        if (payoff->optionType() == Option::Put)
-            results_.value = k*df*s;
-        else if (payoff->optionType() == Option::Call) {
-            const DiscountFactor qf
-                = process->dividendYield()->discount(maturityDate);
-            results_.value = spot*qf - k*df*(1-s);
+        // cosine coefficients of the put payoff, the sines and
+        // cosines of r*a are advanced by rotation
+        Matrix u(inRange.size(), N);
+        for (Size l=0; l < inRange.size(); ++l) {
+            const Real a = std::log(fwd/strikes[inRange[l]]) + cum1 - L*w;
+            const Real expA = std::exp(a);
+            u[l][0] = (expA-1-a)*d;
+
+            const std::complex<Real> rotation
+                = std::exp(std::complex<Real>(0, M_PI*d*a));
+            std::complex<Real> e = rotation;
+            for (Size n=1; n < N; ++n, e *= rotation) {
+                const Real r = n*M_PI*d;
+                u[l][n] = 2.0*d*( 1.0/(1.0 + r*r)
+                    *(expA + r*e.imag() - e.real()) - 1.0/r*e.imag());
+            }
         }
-        else
-            QL_FAIL("unknown payoff type");
+
+        const Array s = u*phi;
+        for (Size l=0; l < inRange.size(); ++l) {
+            const Real k = strikes[inRange[l]];
+            results[inRange[l]] = (type == Option::Put)
+                ? k*df*s[l]
+                : fwd*df - k*df*(1-s[l]);
+        }
+
+        return results;
     }
 
     Real COSHestonEngine::muT(Time t) const {
@@ -141,10 +199,17 @@ namespace QuantLib {
 
         const std::complex<Real> G = (g-D)/(g+D);
 
+        const std::complex<Real> i(0.0, 1.0);
+        const std::complex<Real> jumps = (lambda_ != 0.0)
+            ? lambda_*t*(std::exp(i*u*nu_ - 0.5*delta_*delta_*u*u) - 1.0
+                         - i*u*(std::exp(nu_ + 0.5*delta_*delta_) - 1.0))
+            : std::complex<Real>(0.0);
+
         return std::exp(
               v0_/(sigma2)*(1.0-std::exp(-D*t))/(1.0-G*std::exp(-D*t))
              *(g-D) + kappa_*theta_/sigma2*((g-D)*t
                 -2.0*std::log((1.0-G*std::exp(-D*t))/(1.0-G)))
+             + jumps
             );
    }
 
@@ -174,10 +239,17 @@ namespace QuantLib {
          rho [Element] {-1, 1} && i^2 == -1]]
     */
 
+   /*
+    The log-normal jumps of the Bates model add lambda*t*E[J^n] to the
+    n-th cumulant, J ~ N(nu, delta^2), and the compensator
+    -lambda*t*(exp(nu + delta^2/2) - 1) to the first one.
+   */
+
    Real COSHestonEngine::c1(Time t) const {
        return (-theta_ + std::exp(kappa_*t)
            *( theta_ - kappa_*t*theta_ -
-               v0_) + v0_)/(2*std::exp(kappa_*t)*kappa_);
+               v0_) + v0_)/(2*std::exp(kappa_*t)*kappa_)
+           + lambda_*t*(nu_ - std::exp(nu_ + 0.5*delta_*delta_) + 1.0);
    }
 
    Real COSHestonEngine::c2(Time t) const {
@@ -193,7 +265,8 @@ namespace QuantLib {
            4*std::exp(kappa_*t)*(sigma2*theta_ -
            2*kappa2*(-1 + rho_*sigma_*t)*(theta_ - v0_) +
            kappa_*sigma_*(sigma_*t*(theta_ - v0_) + 2*rho_*(-2*theta_ +
-           v0_))))/(8.*std::exp(2*kappa_*t)*kappa3);
+           v0_))))/(8.*std::exp(2*kappa_*t)*kappa3)
+           + lambda_*t*(nu_*nu_ + delta_*delta_);
    }
 
    Real COSHestonEngine::c3(Time t) const {
@@ -222,7 +295,8 @@ namespace QuantLib {
            sigma2*t*t)*v0_) + 2*kappa2*sigma_*((8
            + 24*rho2 - 16*rho_*sigma_*t + sigma2*t*t)*theta_ - (8*rho2 -
            8*rho_*sigma_*t + sigma2*t*t)*v0_))))/(16.*std::exp(3*kappa_*t)*
-           kappa_*kappa4);
+           kappa_*kappa4)
+           + lambda_*t*nu_*(nu_*nu_ + 3*delta_*delta_);
    }
 
    Real COSHestonEngine::c4(Time t) const {
@@ -282,7 +356,9 @@ namespace QuantLib {
            rho_*(4*sigma_*t + rho_*(-8 + sigma_*t*(4*rho_ - sigma_*t))))*theta_ + (2 +
            rho_*(-4*sigma_*t + rho_*(4 + sigma_*t*(-2*rho_ + sigma_*t))))*v0_) +
            3*kappa_*sigma3*(sigma_*t*(-9*theta_ + v0_) + 10*rho_*(6*theta_
-           + v0_)))))/(64.*std::exp(4*kappa_*t)*kappa7);
+           + v0_)))))/(64.*std::exp(4*kappa_*t)*kappa7)
+           + lambda_*t*(squared(nu_*nu_) + 6*nu_*nu_*delta_*delta_
+                        + 3*squared(delta_*delta_));
    }
 
    Real COSHestonEngine::mu(Time t) const {
@@ -29,6 +29,8 @@
 #include <ql/pricingengines/genericmodelengine.hpp>
 
 #include <complex>
+#include <functional>
+#include <vector>
 
 namespace QuantLib {
 
@@ -44,6 +46,12 @@ namespace QuantLib {
         Calibration,
         https://papers.ssrn.com/sol3/papers2.cfm?abstract_id=2362968
 
+        The engine also supports the log-normal jumps of the BatesModel.
+
+        The characteristic function does not depend on the strike,
+        hence chainPrices() evaluates it once per maturity and prices
+        a whole chain of strikes by a single matrix-vector product.
+
         \ingroup vanillaengines
 
         \test the correctness of the returned value is tested by
@@ -61,6 +69,22 @@ namespace QuantLib {
         void update() override;
         void calculate() const override;
 
+        //! prices of european options with common maturity
+        Array chainPrices(const Date& maturityDate,
+                          const std::vector<Real>& strikes,
+                          Option::Type type) const;
+
+        //! COS expansion for a chain of strikes
+        /*! chF is the normalized characteristic function of
+            \f$ \ln(S_T/F) \f$ at maturity, c1 and c2 are its first
+            two cumulants, which determine the truncation range.
+        */
+        static Array chainPrices(
+            const std::function<std::complex<Real>(Real)>& chF,
+            Real c1, Real c2, Real forward, DiscountFactor discount,
+            const std::vector<Real>& strikes, Option::Type type,
+            Real L = 16, Size N = 200);
+
         // normalized characteristic function
         std::complex<Real> chF(Real u, Real t) const;
 
@@ -76,10 +100,12 @@ namespace QuantLib {
 
       private:
         Real muT(Time t) const;
+        void setJumpParameters();
 
         const Real L_;
         const Size N_;
         Real kappa_, theta_, sigma_, rho_, v0_;
+        Real lambda_ = 0.0, nu_ = 0.0, delta_ = 0.0;
     };
 }
 
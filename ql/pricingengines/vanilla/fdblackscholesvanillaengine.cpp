@@ -20,20 +20,54 @@
 */
 
 #include <ql/exercise.hpp>
+#include <ql/math/interpolations/cubicinterpolation.hpp>
 #include <ql/methods/finitedifferences/meshers/fdmblackscholesmesher.hpp>
+#include <ql/methods/finitedifferences/meshers/predefined1dmesher.hpp>
 #include <ql/methods/finitedifferences/utilities/escroweddividendadjustment.hpp>
 #include <ql/methods/finitedifferences/meshers/fdmmeshercomposite.hpp>
 #include <ql/methods/finitedifferences/operators/fdmlinearoplayout.hpp>
+#include <ql/methods/finitedifferences/operators/fdmblackscholesop.hpp>
 #include <ql/methods/finitedifferences/solvers/fdmblackscholessolver.hpp>
+#include <ql/methods/finitedifferences/stepconditions/fdmsnapshotcondition.hpp>
 #include <ql/methods/finitedifferences/stepconditions/fdmstepconditioncomposite.hpp>
 #include <ql/methods/finitedifferences/utilities/fdminnervaluecalculator.hpp>
 #include <ql/methods/finitedifferences/utilities/fdmescrowedloginnervaluecalculator.hpp>
 #include <ql/methods/finitedifferences/utilities/fdmquantohelper.hpp>
 #include <ql/pricingengines/vanilla/fdblackscholesvanillaengine.hpp>
 #include <ql/processes/blackscholesprocess.hpp>
+#include <algorithm>
 
 namespace QuantLib {
 
+    namespace {
+
+        // inner values of a batch of options stacked along a direction
+        class FdmBatchInnerValue : public FdmInnerValueCalculator {
+          public:
+            FdmBatchInnerValue(
+                std::vector<ext::shared_ptr<FdmInnerValueCalculator> >
+                                                                calculators,
+                Size direction)
+            : calculators_(std::move(calculators)), direction_(direction) {}
+
+            Real innerValue(const FdmLinearOpIterator& iter, Time t) override {
+                return calculators_[iter.coordinates()[direction_]]
+                    ->innerValue(iter, t);
+            }
+            Real avgInnerValue(const FdmLinearOpIterator& iter,
+                               Time t) override {
+                return calculators_[iter.coordinates()[direction_]]
+                    ->avgInnerValue(iter, t);
+            }
+
+          private:
+            const std::vector<ext::shared_ptr<FdmInnerValueCalculator> >
+                                                                calculators_;
+            const Size direction_;
+        };
+
+    }
+
     FdBlackScholesVanillaEngine::FdBlackScholesVanillaEngine(
         ext::shared_ptr<GeneralizedBlackScholesProcess> process,
         Size tGrid,
@@ -108,6 +142,20 @@ namespace QuantLib {
 
     void FdBlackScholesVanillaEngine::calculate() const {
 
+        if (fetchCachedResults())
+            return;
+
+        const ext::shared_ptr<PlainVanillaPayoff> plainPayoff =
+            ext::dynamic_pointer_cast<PlainVanillaPayoff>(arguments_.payoff);
+        if (plainPayoff != nullptr
+            && std::find(strikes_.begin(), strikes_.end(),
+                         plainPayoff->strike()) != strikes_.end()) {
+            calculateMultipleStrikes();
+            QL_ENSURE(fetchCachedResults(),
+                      "option not found in multiple strikes results");
+            return;
+        }
+
         // 0. Cash dividend model
         const Date exerciseDate = arguments_.exercise->lastDate();
         const Time maturity = process_->time(exerciseDate);
@@ -214,6 +262,165 @@ namespace QuantLib {
         results_.theta = solver->thetaAt(spot);
     }
 
+    bool FdBlackScholesVanillaEngine::fetchCachedResults() const {
+        const ext::shared_ptr<PlainVanillaPayoff> p1 =
+            ext::dynamic_pointer_cast<PlainVanillaPayoff>(arguments_.payoff);
+        if (p1 == nullptr)
+            return false;
+
+        for (const auto& cachedArgs2result : cachedArgs2results_) {
+            const VanillaOption::arguments& args = cachedArgs2result.first;
+            if (args.exercise->type() == arguments_.exercise->type() &&
+                args.exercise->dates() == arguments_.exercise->dates()) {
+                const ext::shared_ptr<PlainVanillaPayoff> p2 =
+                    ext::dynamic_pointer_cast<PlainVanillaPayoff>(args.payoff);
+
+                if (p1->strike() == p2->strike() &&
+                    p1->optionType() == p2->optionType()) {
+                    results_ = cachedArgs2result.second;
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    void FdBlackScholesVanillaEngine::calculateMultipleStrikes() const {
+        QL_REQUIRE(cashDividendModel_ == Spot || dividends_.empty(),
+                   "multiple strikes caching requires the spot "
+                   "cash dividend model");
+
+        const Date exerciseDate = arguments_.exercise->lastDate();
+        const Time maturity = process_->time(exerciseDate);
+        const Real spot = process_->x0();
+
+        // one column per strike, for the requested option type only
+        const Option::Type optionType =
+            ext::dynamic_pointer_cast<PlainVanillaPayoff>(
+                arguments_.payoff)->optionType();
+        const Size nColumns = strikes_.size();
+        std::vector<ext::shared_ptr<PlainVanillaPayoff> > payoffs(nColumns);
+        for (Size i=0; i < nColumns; ++i)
+            payoffs[i] =
+                ext::make_shared<PlainVanillaPayoff>(optionType, strikes_[i]);
+
+        // 1. Mesher
+        // all options are evaluated at the spot, hence the grid is
+        // concentrated there; its width is set by the strike with
+        // the largest volatility.
+        Real widthStrike = strikes_.front();
+        Volatility maxVol = 0.0;
+        for (Real strike : strikes_) {
+            const Volatility vol =
+                process_->blackVolatility()->blackVol(maturity, strike);
+            if (vol > maxVol) {
+                maxVol = vol;
+                widthStrike = strike;
+            }
+        }
+
+        const ext::shared_ptr<Fdm1dMesher> equityMesher =
+            ext::make_shared<FdmBlackScholesMesher>(
+                    xGrid_, process_, maturity, widthStrike,
+                    Null<Real>(), Null<Real>(), 0.0001, 1.5,
+                    std::pair<Real, Real>(spot, 0.1),
+                    dividends_, quantoHelper_);
+
+        std::vector<Real> columns(nColumns);
+        for (Size i=0; i < nColumns; ++i)
+            columns[i] = Real(i);
+
+        const ext::shared_ptr<FdmMesher> mesher =
+            ext::make_shared<FdmMesherComposite>(
+                equityMesher, ext::make_shared<Predefined1dMesher>(columns));
+
+        // 2. Calculator
+        std::vector<ext::shared_ptr<FdmInnerValueCalculator> >
+                                                    calculators(nColumns);
+        for (Size i=0; i < nColumns; ++i)
+            calculators[i] =
+                ext::make_shared<FdmLogInnerValue>(payoffs[i], mesher, 0);
+
+        const ext::shared_ptr<FdmInnerValueCalculator> calculator =
+            ext::make_shared<FdmBatchInnerValue>(calculators, 1);
+
+        // 3. Step conditions
+        const ext::shared_ptr<FdmStepConditionComposite> vanillaConditions =
+            FdmStepConditionComposite::vanillaComposite(
+                dividends_, arguments_.exercise, mesher, calculator,
+                process_->riskFreeRate()->referenceDate(),
+                process_->riskFreeRate()->dayCounter());
+
+        const ext::shared_ptr<FdmSnapshotCondition> thetaCondition =
+            ext::make_shared<FdmSnapshotCondition>(
+                0.99*std::min(1.0/365.0,
+                              vanillaConditions->stoppingTimes().empty()
+                              ? maturity
+                              : vanillaConditions->stoppingTimes().front()));
+
+        const ext::shared_ptr<FdmStepConditionComposite> conditions =
+            FdmStepConditionComposite::joinConditions(thetaCondition,
+                                                      vanillaConditions);
+
+        // 4. Boundary conditions
+        const FdmBoundaryConditionSet boundaries;
+
+        // 5. Solver
+        Array rhs(mesher->layout()->size());
+        for (const auto& iter : *mesher->layout())
+            rhs[iter.index()] = calculator->avgInnerValue(iter, maturity);
+
+        const ext::shared_ptr<FdmLinearOpComposite> op =
+            ext::make_shared<FdmBlackScholesOp>(
+                mesher, process_, strikes_, 1,
+                localVol_, illegalLocalVolOverwrite_, 0, quantoHelper_);
+
+        FdmBackwardSolver(op, boundaries, conditions, schemeDesc_)
+            .rollback(rhs, maturity, 0.0, tGrid_, dampingSteps_);
+
+        // 6. Results
+        const std::vector<Real>& x = equityMesher->locations();
+        const Real lnSpot = std::log(spot);
+        const bool withTheta = conditions->stoppingTimes().front() != 0.0;
+        const Array& thetaValues = thetaCondition->getValues();
+
+        for (Size i=0; i < nColumns; ++i) {
+            const Real* values = rhs.begin() + i*xGrid_;
+            const MonotonicCubicNaturalSpline interpolation(
+                x.begin(), x.end(), values);
+
+            VanillaOption::arguments args;
+            args.payoff = payoffs[i];
+            args.exercise = arguments_.exercise;
+
+            VanillaOption::results results;
+            results.reset();
+            results.value = interpolation(lnSpot);
+            results.delta = interpolation.derivative(lnSpot)/spot;
+            results.gamma = (interpolation.secondDerivative(lnSpot)
+                             - interpolation.derivative(lnSpot))/(spot*spot);
+            if (withTheta) {
+                const Real thetaValue = MonotonicCubicNaturalSpline(
+                    x.begin(), x.end(), thetaValues.begin() + i*xGrid_)(lnSpot);
+                results.theta =
+                    (thetaValue - results.value)/thetaCondition->getTime();
+            }
+
+            cachedArgs2results_.emplace_back(args, results);
+        }
+    }
+
+    void FdBlackScholesVanillaEngine::update() {
+        cachedArgs2results_.clear();
+        VanillaOption::engine::update();
+    }
+
+    void FdBlackScholesVanillaEngine::enableMultipleStrikesCaching(
+                                        const std::vector<Real>& strikes) {
+        strikes_ = strikes;
+        cachedArgs2results_.clear();
+    }
+
     MakeFdBlackScholesVanillaEngine::MakeFdBlackScholesVanillaEngine(
         ext::shared_ptr<GeneralizedBlackScholesProcess> process)
     : process_(std::move(process)),
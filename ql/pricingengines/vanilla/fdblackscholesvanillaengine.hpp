@@ -36,7 +36,20 @@ namespace QuantLib {
     class GeneralizedBlackScholesProcess;
 
     //! Finite-differences Black Scholes vanilla option engine
-    /*! \ingroup vanillaengines
+    /*! When multiple strikes caching is enabled, the first
+        calculation for a plain-vanilla option whose strike is among
+        the given ones rolls back the options of the same type on all
+        the strikes in a single backward sweep, stacking their payoffs
+        along a second grid direction so that they share the mesher,
+        the step conditions and, where their coefficients coincide,
+        the factorized operator.  The results of the other options
+        with the same type and exercise are cached and returned by
+        later calculations until the engine is notified of a
+        change.  In this case the grid is concentrated around the
+        spot rather than around the strike, and the variance of each
+        option is still taken at its own strike.
+
+        \ingroup vanillaengines
 
         \test the correctness of the returned value is tested by
               reproducing results available in web/literature
@@ -95,7 +108,14 @@ namespace QuantLib {
 
         void calculate() const override;
 
+        // multiple strikes caching engine
+        void update() override;
+        void enableMultipleStrikesCaching(const std::vector<Real>& strikes);
+
       private:
+        bool fetchCachedResults() const;
+        void calculateMultipleStrikes() const;
+
         ext::shared_ptr<GeneralizedBlackScholesProcess> process_;
         DividendSchedule dividends_;
         Size tGrid_, xGrid_, dampingSteps_;
@@ -104,6 +124,11 @@ namespace QuantLib {
         Real illegalLocalVolOverwrite_;
         ext::shared_ptr<FdmQuantoHelper> quantoHelper_;
         CashDividendModel cashDividendModel_;
+
+        std::vector<Real> strikes_;
+        mutable std::vector<std::pair<VanillaOption::arguments,
+                                      VanillaOption::results> >
+                                                            cachedArgs2results_;
     };
 
 
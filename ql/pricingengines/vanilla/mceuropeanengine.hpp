@@ -26,6 +26,7 @@
 #ifndef quantlib_montecarlo_european_engine_hpp
 #define quantlib_montecarlo_european_engine_hpp
 
+#include <ql/methods/montecarlo/pathwisegreeks.hpp>
 #include <ql/pricingengines/vanilla/mcvanillaengine.hpp>
 #include <ql/processes/blackscholesprocess.hpp>
 #include <ql/termstructures/volatility/equityfx/blackconstantvol.hpp>
@@ -34,10 +35,23 @@
 namespace QuantLib {
 
     //! European option pricing engine using Monte Carlo simulation
-    /*! \ingroup vanillaengines
-
-        \test the correctness of the returned value is tested by
-              checking it against analytic results.
+    /*! If required, delta, vega and rho are estimated in the same
+        sweep as the price and returned as additional results (see
+        PathwiseGreeks) together with their error estimates.  Pathwise
+        derivatives are used for plain-vanilla payoffs, and
+        likelihood-ratio estimators for other striked payoffs (e.g.,
+        digitals) whose payoff is not differentiable.  Vega and rho
+        are the sensitivities to the volatility and to a parallel
+        shift of the continuously-compounded risk-free zero rates.
+
+        \pre Greeks can only be calculated when the process has a
+             constant volatility, i.e., when the simulated paths are
+             a geometric Brownian motion.
+
+        \ingroup vanillaengines
+
+        \test the correctness of the returned value and Greeks is
+              tested by checking them against analytic results.
     */
     template <class RNG = PseudoRandom, class S = Statistics>
     class MCEuropeanEngine : public MCVanillaEngine<SingleVariate,RNG,S> {
@@ -60,9 +74,20 @@ namespace QuantLib {
              Size requiredSamples,
              Real requiredTolerance,
              Size maxSamples,
-             BigNatural seed);
+             BigNatural seed,
+             bool pathwiseGreeks = false);
+        void calculate() const override {
+            greeks_.reset();
+            MCVanillaEngine<SingleVariate,RNG,S>::calculate();
+            if (greeks_)
+                greeks_->addTo(this->results_.additionalResults,
+                               RNG::allowsErrorEstimate);
+        }
       protected:
         ext::shared_ptr<path_pricer_type> pathPricer() const override;
+      private:
+        bool pathwiseGreeks_;
+        mutable ext::shared_ptr<PathwiseGreeks> greeks_;
     };
 
     //! Monte Carlo European engine factory
@@ -79,6 +104,7 @@ namespace QuantLib {
         MakeMCEuropeanEngine& withMaxSamples(Size samples);
         MakeMCEuropeanEngine& withSeed(BigNatural seed);
         MakeMCEuropeanEngine& withAntitheticVariate(bool b = true);
+        MakeMCEuropeanEngine& withPathwiseGreeks(bool b = true);
         // conversion to pricing engine
         operator ext::shared_ptr<PricingEngine>() const;
       private:
@@ -88,6 +114,7 @@ namespace QuantLib {
         Real tolerance_;
         bool brownianBridge_ = false;
         BigNatural seed_ = 0;
+        bool pathwiseGreeks_ = false;
     };
 
     class EuropeanPathPricer : public PathPricer<Path> {
@@ -95,11 +122,26 @@ namespace QuantLib {
         EuropeanPathPricer(Option::Type type,
                            Real strike,
                            DiscountFactor discount);
+        /*! If an accumulator is passed, the delta, vega and rho of
+            each path are added to it; in this case, the paths are
+            assumed to be generated by a geometric Brownian motion
+            with the given forward value and constant volatility.
+        */
+        EuropeanPathPricer(ext::shared_ptr<StrikedTypePayoff> payoff,
+                           DiscountFactor discount,
+                           ext::shared_ptr<PathwiseGreeks> greeks =
+                                          ext::shared_ptr<PathwiseGreeks>(),
+                           Real forward = Null<Real>(),
+                           Volatility volatility = Null<Volatility>());
         Real operator()(const Path& path) const override;
 
       private:
-        PlainVanillaPayoff payoff_;
+        ext::shared_ptr<StrikedTypePayoff> payoff_;
         DiscountFactor discount_;
+        ext::shared_ptr<PathwiseGreeks> greeks_;
+        Real forward_;
+        Volatility volatility_;
+        bool plainVanilla_;
     };
 
 
@@ -116,7 +158,8 @@ namespace QuantLib {
              Size requiredSamples,
              Real requiredTolerance,
              Size maxSamples,
-             BigNatural seed)
+             BigNatural seed,
+             bool pathwiseGreeks)
     : MCVanillaEngine<SingleVariate,RNG,S>(process,
                                            timeSteps,
                                            timeStepsPerYear,
@@ -126,7 +169,8 @@ namespace QuantLib {
                                            requiredSamples,
                                            requiredTolerance,
                                            maxSamples,
-                                           seed) {}
+                                           seed),
+      pathwiseGreeks_(pathwiseGreeks) {}
 
 
     template <class RNG, class S>
@@ -134,22 +178,39 @@ namespace QuantLib {
     ext::shared_ptr<typename MCEuropeanEngine<RNG,S>::path_pricer_type>
     MCEuropeanEngine<RNG,S>::pathPricer() const {
 
-        ext::shared_ptr<PlainVanillaPayoff> payoff =
-            ext::dynamic_pointer_cast<PlainVanillaPayoff>(
+        ext::shared_ptr<StrikedTypePayoff> payoff =
+            ext::dynamic_pointer_cast<StrikedTypePayoff>(
                 this->arguments_.payoff);
-        QL_REQUIRE(payoff, "non-plain payoff given");
+        QL_REQUIRE(payoff, "non-striked payoff given");
 
         ext::shared_ptr<GeneralizedBlackScholesProcess> process =
             ext::dynamic_pointer_cast<GeneralizedBlackScholesProcess>(
                 this->process_);
         QL_REQUIRE(process, "Black-Scholes process required");
 
+        Time maturity = this->timeGrid().back();
+        DiscountFactor discount = process->riskFreeRate()->discount(maturity);
+
+        if (!pathwiseGreeks_)
+            return ext::shared_ptr<
+                       typename MCEuropeanEngine<RNG,S>::path_pricer_type>(
+                new EuropeanPathPricer(payoff, discount));
+
+        QL_REQUIRE(ext::dynamic_pointer_cast<BlackConstantVol>(
+                                          *(process->blackVolatility())),
+                   "constant volatility required for pathwise Greeks");
+        QL_REQUIRE(maturity > 0.0, "expired option");
+
+        Real forward = process->x0()
+            * process->dividendYield()->discount(maturity) / discount;
+        Volatility volatility =
+            process->blackVolatility()->blackVol(maturity, payoff->strike());
+
+        greeks_ = ext::make_shared<PathwiseGreeks>(this->antitheticVariate_);
         return ext::shared_ptr<
                        typename MCEuropeanEngine<RNG,S>::path_pricer_type>(
-          new EuropeanPathPricer(
-              payoff->optionType(),
-              payoff->strike(),
-              process->riskFreeRate()->discount(this->timeGrid().back())));
+            new EuropeanPathPricer(payoff, discount,
+                                   greeks_, forward, volatility));
     }
 
 
@@ -222,6 +283,13 @@ namespace QuantLib {
         return *this;
     }
 
+    template <class RNG, class S>
+    inline MakeMCEuropeanEngine<RNG,S>&
+    MakeMCEuropeanEngine<RNG,S>::withPathwiseGreeks(bool b) {
+        pathwiseGreeks_ = b;
+        return *this;
+    }
+
     template <class RNG, class S>
     inline
     MakeMCEuropeanEngine<RNG,S>::operator ext::shared_ptr<PricingEngine>()
@@ -238,7 +306,8 @@ namespace QuantLib {
                                     antithetic_,
                                     samples_, tolerance_,
                                     maxSamples_,
-                                    seed_));
+                                    seed_,
+                                    pathwiseGreeks_));
     }
 
 
@@ -246,14 +315,67 @@ namespace QuantLib {
     inline EuropeanPathPricer::EuropeanPathPricer(Option::Type type,
                                                   Real strike,
                                                   DiscountFactor discount)
-    : payoff_(type, strike), discount_(discount) {
-        QL_REQUIRE(strike>=0.0,
+    : EuropeanPathPricer(ext::make_shared<PlainVanillaPayoff>(type, strike),
+                         discount) {}
+
+    inline EuropeanPathPricer::EuropeanPathPricer(
+                               ext::shared_ptr<StrikedTypePayoff> payoff,
+                               DiscountFactor discount,
+                               ext::shared_ptr<PathwiseGreeks> greeks,
+                               Real forward,
+                               Volatility volatility)
+    : payoff_(std::move(payoff)), discount_(discount),
+      greeks_(std::move(greeks)), forward_(forward), volatility_(volatility),
+      plainVanilla_(ext::dynamic_pointer_cast<PlainVanillaPayoff>(payoff_)
+                    != nullptr) {
+        QL_REQUIRE(payoff_->strike()>=0.0,
                    "strike less than zero not allowed");
+        if (greeks_) {
+            QL_REQUIRE(forward_ != Null<Real>() && forward_ > 0.0,
+                       "positive forward required for Greeks");
+            QL_REQUIRE(volatility_ != Null<Volatility>() && volatility_ > 0.0,
+                       "positive volatility required for Greeks");
+        }
     }
 
     inline Real EuropeanPathPricer::operator()(const Path& path) const {
         QL_REQUIRE(!path.empty(), "the path cannot be empty");
-        return payoff_(path.back()) * discount_;
+        Real underlying = path.back();
+        Real value = (*payoff_)(underlying) * discount_;
+
+        if (greeks_) {
+            Real x0 = path.front();
+            Time T = path.timeGrid().back();
+            Real strike = payoff_->strike();
+            Real delta, vega, rho;
+            if (plainVanilla_) {
+                // pathwise derivatives of the discounted payoff;
+                // for a geometric Brownian motion, dS_T/dS_0 = S_T/S_0,
+                // dS_T/dsigma = S_T (W_T - sigma T), dS_T/dr = S_T T.
+                Real omega = payoff_->optionType() == Option::Call ? 1.0 : -1.0;
+                if (omega*(underlying-strike) > 0.0) {
+                    delta = omega * discount_ * underlying/x0;
+                    vega = omega * discount_ * underlying
+                        * (std::log(underlying/forward_)
+                           - 0.5*volatility_*volatility_*T) / volatility_;
+                    rho = omega * discount_ * T * strike;
+                } else {
+                    delta = vega = rho = 0.0;
+                }
+            } else {
+                // likelihood-ratio estimators, i.e., the payoff times
+                // the derivatives of the log-density of S_T
+                Real stdDev = volatility_*std::sqrt(T);
+                Real z = (std::log(underlying/forward_) + 0.5*stdDev*stdDev)
+                    / stdDev;
+                delta = value * z / (x0*stdDev);
+                vega = value * ((z*z-1.0)/volatility_ - z*std::sqrt(T));
+                rho = value * T * (z/stdDev - 1.0);
+            }
+            greeks_->add(delta, vega, rho);
+        }
+
+        return value;
     }
 
 }
@@ -34,8 +34,10 @@
 #include <ql/termstructures/yieldtermstructure.hpp>
 #include <ql/timegrid.hpp>
 #include <ql/utilities/null.hpp>
+#include <algorithm>
 #include <cmath>
 #include <limits>
+#include <string>
 #include <utility>
 
 namespace QuantLib {
@@ -75,7 +77,8 @@ namespace QuantLib {
             return d2CdK2_.apply(c);
         }
 
-        Array solveFor(Time dT, const Array& sig, const Array& b) const {
+        // local volatility on the grid, a linear function of sig
+        Array gridVolatilities(const Array& sig) const {
 
             Array x(lnMarketStrikes_.size());
             Interpolation sigInterpl;
@@ -103,21 +106,28 @@ namespace QuantLib {
                 QL_FAIL("unknown interpolation type");
             }
 
-            Array z(mesher_->layout()->size());
+            Array vol(mesher_->layout()->size());
             for (const auto& iter : *mesher_->layout()) {
-                const Size i = iter.index();
                 const Real lnStrike = mesher_->location(iter, 0);
 
-                const Real vol = sigInterpl(
+                vol[iter.index()] = sigInterpl(
                     std::min(std::max(lnStrike, lnMarketStrikes_.front()),
                             lnMarketStrikes_.back()), true);
-
-                z[i] = 0.5*vol*vol;
             }
+            return vol;
+        }
+
+        Array solveFor(Time dT, const Array& sig, const Array& b) const {
+            const Array vol = gridVolatilities(sig);
+            const Array z = 0.5*vol*vol;
 
+            // the operator is updated in place, its factorization is
+            // kept if sig did not change since the last call
             mapT_.axpyb(z, dxMap_, dxxMap_.mult(-z), Array());
-            return mapT_.mult(Array(z.size(), dT)).solve_splitting(b, 1.0);
 
+            Array x(b.size());
+            mapT_.solve_splitting_into(b, x, factorization_, dT, 1.0);
+            return x;
         }
 
         Array apply(const Array& c) const {
@@ -141,6 +151,66 @@ namespace QuantLib {
             return retVal;
         }
 
+        /* The prices on the grid solve (I - dT Z M) c = b with
+           Z = diag(sig_loc^2/2) and M = d^2/dk^2 - d/dk, hence
+           dc/dz_k = (I - dT Z M)^{-1} dT e_k (M c)_k. The monotonic
+           spline used in values() is not differentiated analytically,
+           its derivative along dc is approximated by a forward
+           difference. As the monotonicity filter only takes minima and
+           maxima of linear functions of the grid values, the spline is
+           piecewise linear in them and the approximation is exact
+           unless the step crosses a switch of the filter.
+        */
+        void jacobian(Matrix& jac, const Array& sig) const override {
+            const Array vol = gridVolatilities(sig);
+            const Array c = solveFor(dT_, sig, previousNPVs_);
+            const Array dCdZ = dT_*d2CdK2(c);
+
+            const std::vector<Real>& gridPoints =
+                mesher_->getFdm1dMeshers().front()->locations();
+
+            const MonotonicCubicNaturalSpline interpl(
+                gridPoints.begin(), gridPoints.end(), c.begin());
+            Array npvs(lnMarketStrikes_.size());
+            for (Size i=0; i < npvs.size(); ++i)
+                npvs[i] = interpl(lnMarketStrikes_[i]);
+
+            const Real scale = std::max(
+                std::fabs(*std::max_element(c.begin(), c.end())),
+                std::fabs(*std::min_element(c.begin(), c.end())));
+
+            Array e(sig.size(), 0.0), rhs(c.size()), dC(c.size());
+            Array shifted(c.size());
+            for (Size m=0; m < sig.size(); ++m) {
+                e[m] = 1.0;
+                const Array dVol = gridVolatilities(e);
+                e[m] = 0.0;
+
+                for (Size i=0; i < rhs.size(); ++i)
+                    rhs[i] = dCdZ[i]*vol[i]*dVol[i];
+                mapT_.solve_splitting_into(rhs, dC, factorization_, dT_, 1.0);
+
+                const Real dCMax = std::max(
+                    std::fabs(*std::max_element(dC.begin(), dC.end())),
+                    std::fabs(*std::min_element(dC.begin(), dC.end())));
+                if (dCMax == 0.0) {
+                    for (Size i=0; i < lnMarketStrikes_.size(); ++i)
+                        jac[i][m] = 0.0;
+                    continue;
+                }
+
+                const Real h = 1e-6*std::max(scale, dCMax)/dCMax;
+                for (Size i=0; i < c.size(); ++i)
+                    shifted[i] = c[i] + h*dC[i];
+
+                const MonotonicCubicNaturalSpline shiftedInterpl(
+                    gridPoints.begin(), gridPoints.end(), shifted.begin());
+                for (Size i=0; i < lnMarketStrikes_.size(); ++i)
+                    jac[i][m] =
+                        (shiftedInterpl(lnMarketStrikes_[i]) - npvs[i])/h;
+            }
+        }
+
         Array vegaCalibrationError(const Array& sig) const {
             return values(sig)/marketVegas_;
         }
@@ -163,6 +233,7 @@ namespace QuantLib {
         const TripleBandLinearOp dxxMap_;
         const TripleBandLinearOp d2CdK2_;
         mutable TripleBandLinearOp mapT_;
+        mutable TripleBandLinearOp::SplittingFactorization factorization_;
     };
 
     class CombinedCostFunction : public CostFunction {
@@ -173,12 +244,26 @@ namespace QuantLib {
 
         Array values(const Array& sig) const override {
             if ((putCostFct_ != nullptr) && (callCostFct_ != nullptr)) {
-                const Array pv = putCostFct_->values(sig);
-                const Array cv = callCostFct_->values(sig);
+                // the put and the call side are independent
+                Array pv, cv;
+                std::vector<std::string> errors(2);
+                #pragma omp parallel for
+                for (long i=0; i < 2; ++i) {
+                    try {
+                        if (i == 0)
+                            pv = putCostFct_->values(sig);
+                        else
+                            cv = callCostFct_->values(sig);
+                    } catch (std::exception& e) {
+                        errors[i] = e.what();
+                    }
+                }
+                for (const auto& error : errors)
+                    QL_REQUIRE(error.empty(), error);
 
                 Array retVal(pv.size() + cv.size());
                 std::copy(pv.begin(), pv.end(), retVal.begin());
-                std::copy(cv.begin(), cv.end(), retVal.begin() + cv.size());
+                std::copy(cv.begin(), cv.end(), retVal.begin() + pv.size());
 
                 return retVal;
             } else if (putCostFct_ != nullptr)
@@ -189,6 +274,35 @@ namespace QuantLib {
                 QL_FAIL("internal error: cost function not set");
         }
 
+        void jacobian(Matrix& jac, const Array& sig) const override {
+            if ((putCostFct_ != nullptr) && (callCostFct_ != nullptr)) {
+                const Size n = sig.size();
+                Matrix pj(n, n), cj(n, n);
+                std::vector<std::string> errors(2);
+                #pragma omp parallel for
+                for (long i=0; i < 2; ++i) {
+                    try {
+                        if (i == 0)
+                            putCostFct_->jacobian(pj, sig);
+                        else
+                            callCostFct_->jacobian(cj, sig);
+                    } catch (std::exception& e) {
+                        errors[i] = e.what();
+                    }
+                }
+                for (const auto& error : errors)
+                    QL_REQUIRE(error.empty(), error);
+
+                std::copy(pj.begin(), pj.end(), jac.begin());
+                std::copy(cj.begin(), cj.end(), jac.begin() + pj.size1()*n);
+            } else if (putCostFct_ != nullptr)
+                putCostFct_->jacobian(jac, sig);
+            else if (callCostFct_ != nullptr)
+                callCostFct_->jacobian(jac, sig);
+            else
+                QL_FAIL("internal error: cost function not set");
+        }
+
         Array initialValues() const {
             if ((putCostFct_ != nullptr) && (callCostFct_ != nullptr))
                 return 0.5*(  putCostFct_->initialValues()
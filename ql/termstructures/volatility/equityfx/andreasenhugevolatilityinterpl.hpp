@@ -48,6 +48,22 @@ namespace QuantLib {
 
         Andreasen J., Huge B., 2010. Volatility Interpolation
         https://ssrn.com/abstract=1694972
+
+        In CallPut mode the put and the call side of each cost function
+        evaluation are computed concurrently if OpenMP is enabled.
+
+        \warning Experimental: the cost functions also provide a
+                 Jacobian, which is only used by a LevenbergMarquardt
+                 optimizer created with useCostFunctionsJacobian set to
+                 true. The one-step implicit solve is differentiated
+                 analytically, but the derivative of the monotonic
+                 strike interpolation is approximated by a forward
+                 difference. With this Jacobian the optimizer typically
+                 needs an order of magnitude fewer cost function
+                 evaluations, but it is more likely to move along flat
+                 directions of slices that cannot be calibrated exactly.
+                 The default optimizer therefore uses finite
+                 differences of the cost function.
     */
 
     class AndreasenHugeVolatilityInterpl : public LazyObject {
@@ -0,0 +1,255 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <https://www.quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+
+#include <ql/quote.hpp>
+#include <ql/termstructures/volatility/equityfx/interpolatedlocalvolsurface.hpp>
+#include <ql/termstructures/yieldtermstructure.hpp>
+#include <algorithm>
+#include <utility>
+
+namespace QuantLib {
+
+    InterpolatedLocalVolSurface::InterpolatedLocalVolSurface(
+        const Handle<BlackVolTermStructure>& blackTS,
+        const Handle<YieldTermStructure>& riskFreeTS,
+        const Handle<YieldTermStructure>& dividendTS,
+        const Handle<Quote>& underlying,
+        std::vector<Time> times,
+        std::vector<Real> logMoneyness,
+        InterpolationType interpolationType,
+        Real tolerance)
+    : LocalVolSurface(blackTS, riskFreeTS, dividendTS, underlying),
+      times_(std::move(times)), logMoneyness_(std::move(logMoneyness)),
+      interpolationType_(interpolationType), tolerance_(tolerance),
+      maxError_(Null<Real>()), usesGrid_(false) {
+
+        QL_REQUIRE(interpolationType_ == Bilinear
+                   || interpolationType_ == Bicubic,
+                   "unknown interpolation type");
+
+        QL_REQUIRE(times_.size() >= 2, "at least two times required");
+        QL_REQUIRE(logMoneyness_.size() >= 2,
+                   "at least two log-moneyness values required");
+        QL_REQUIRE(times_.front() >= 0.0, "times must not be negative");
+        for (Size i=1; i < times_.size(); ++i)
+            QL_REQUIRE(times_[i] > times_[i-1],
+                       "times must be strictly increasing");
+        for (Size j=1; j < logMoneyness_.size(); ++j)
+            QL_REQUIRE(logMoneyness_[j] > logMoneyness_[j-1],
+                       "log-moneyness values must be strictly increasing");
+    }
+
+    void InterpolatedLocalVolSurface::update() {
+        LocalVolSurface::update();
+        LazyObject::update();
+    }
+
+    const Matrix& InterpolatedLocalVolSurface::localVolMatrix() const {
+        calculate();
+        return localVols_;
+    }
+
+    Real InterpolatedLocalVolSurface::maxError() const {
+        calculate();
+        return maxError_;
+    }
+
+    const std::vector<std::pair<Size, Size> >&
+    InterpolatedLocalVolSurface::failedNodes() const {
+        calculate();
+        return failedNodes_;
+    }
+
+    bool InterpolatedLocalVolSurface::usesGrid() const {
+        calculate();
+        return usesGrid_;
+    }
+
+    Real InterpolatedLocalVolSurface::logForward(Time t) const {
+        return std::log(underlying_->value()*dividendTS_->discount(t, true)
+                        / riskFreeTS_->discount(t, true));
+    }
+
+    Real InterpolatedLocalVolSurface::interpolatedLogForward(Time t) const {
+        if (t <= times_.front() || t >= times_.back())
+            return logForward(t);
+
+        const Size i = std::upper_bound(times_.begin(), times_.end(), t)
+            - times_.begin();
+        const Real w = (t - times_[i-1])/(times_[i] - times_[i-1]);
+        return (1.0-w)*logForwards_[i-1] + w*logForwards_[i];
+    }
+
+    Volatility InterpolatedLocalVolSurface::interpolatedLocalVol(
+        Time t, Real y) const {
+        t = std::min(std::max(t, times_.front()), times_.back());
+        y = std::min(std::max(y, logMoneyness_.front()), logMoneyness_.back());
+
+        const Size i = std::min<Size>(
+            std::upper_bound(times_.begin(), times_.end(), t)
+                - times_.begin(), times_.size()-1) - 1;
+        const Size j = std::min<Size>(
+            std::upper_bound(logMoneyness_.begin(), logMoneyness_.end(), y)
+                - logMoneyness_.begin(), logMoneyness_.size()-1) - 1;
+
+        const Real ht = times_[i+1] - times_[i];
+        const Real hy = logMoneyness_[j+1] - logMoneyness_[j];
+        const Real v = (t - times_[i])/ht;
+        const Real u = (y - logMoneyness_[j])/hy;
+
+        if (interpolationType_ == Bilinear)
+            return (1.0-v)*((1.0-u)*localVols_[i][j] + u*localVols_[i][j+1])
+                + v*((1.0-u)*localVols_[i+1][j] + u*localVols_[i+1][j+1]);
+
+        // cubic Hermite basis functions for values and derivatives
+        const Real u2 = u*u, u3 = u2*u, v2 = v*v, v3 = v2*v;
+        const Real a[2] = { 2*u3 - 3*u2 + 1, 3*u2 - 2*u3 };
+        const Real b[2] = { (u3 - 2*u2 + u)*hy, (u3 - u2)*hy };
+        const Real c[2] = { 2*v3 - 3*v2 + 1, 3*v2 - 2*v3 };
+        const Real d[2] = { (v3 - 2*v2 + v)*ht, (v3 - v2)*ht };
+
+        Real result = 0.0;
+        for (Size k=0; k < 2; ++k)
+            for (Size l=0; l < 2; ++l)
+                result += c[k]*(a[l]*localVols_[i+k][j+l]
+                                + b[l]*dVdY_[i+k][j+l])
+                    + d[k]*(a[l]*dVdT_[i+k][j+l] + b[l]*d2VdTdY_[i+k][j+l]);
+        return result;
+    }
+
+    Matrix InterpolatedLocalVolSurface::derivatives(
+        const Matrix& f, const std::vector<Real>& x) {
+        // derivatives along the rows, three-point formula in the
+        // interior and one-sided differences at the boundaries
+        const Size n = x.size();
+        Matrix result(f.rows(), n);
+        for (Size i=0; i < f.rows(); ++i) {
+            result[i][0] = (f[i][1] - f[i][0])/(x[1] - x[0]);
+            result[i][n-1] = (f[i][n-1] - f[i][n-2])/(x[n-1] - x[n-2]);
+            for (Size j=1; j+1 < n; ++j) {
+                const Real h0 = x[j] - x[j-1], h1 = x[j+1] - x[j];
+                result[i][j] = (h0*h0*(f[i][j+1] - f[i][j])
+                                + h1*h1*(f[i][j] - f[i][j-1]))
+                    / (h0*h1*(h0 + h1));
+            }
+        }
+        return result;
+    }
+
+    void InterpolatedLocalVolSurface::performCalculations() const {
+        const Size nt = times_.size(), ny = logMoneyness_.size();
+
+        logForwards_.resize(nt);
+        localVols_ = Matrix(nt, ny);
+        failedNodes_.clear();
+        std::vector<bool> validRow(nt, false), valid(nt*ny, false);
+        for (Size i=0; i < nt; ++i) {
+            logForwards_[i] = logForward(times_[i]);
+            for (Size j=0; j < ny; ++j) {
+                try {
+                    localVols_[i][j] = LocalVolSurface::localVolImpl(
+                        times_[i],
+                        std::exp(logForwards_[i] + logMoneyness_[j]));
+                    valid[i*ny+j] = true;
+                    validRow[i] = true;
+                } catch (Error&) {
+                    failedNodes_.emplace_back(i, j);
+                }
+            }
+        }
+
+        usesGrid_ = std::find(validRow.begin(), validRow.end(), true)
+            != validRow.end();
+        maxError_ = Null<Real>();
+        if (!usesGrid_)
+            return;
+
+        // fill the failed nodes from their neighbours in the same row
+        for (Size i=0; i < nt && !failedNodes_.empty(); ++i) {
+            if (!validRow[i])
+                continue;
+            Size last = Null<Size>();
+            for (Size j=0; j < ny; ++j) {
+                if (!valid[i*ny+j])
+                    continue;
+                const Size from = (last == Null<Size>()) ? 0 : last+1;
+                for (Size k=from; k < j; ++k)
+                    localVols_[i][k] = (last == Null<Size>())
+                        ? localVols_[i][j]
+                        : localVols_[i][last]
+                            + (localVols_[i][j] - localVols_[i][last])
+                                * (logMoneyness_[k] - logMoneyness_[last])
+                                / (logMoneyness_[j] - logMoneyness_[last]);
+                last = j;
+            }
+            for (Size k=last+1; k < ny; ++k)
+                localVols_[i][k] = localVols_[i][last];
+        }
+        for (Size i=0; i < nt; ++i) {
+            if (validRow[i])
+                continue;
+            Size nearest = Null<Size>();
+            for (Size k=0; k < nt; ++k)
+                if (validRow[k] && (nearest == Null<Size>()
+                    || std::fabs(times_[k] - times_[i])
+                        < std::fabs(times_[nearest] - times_[i])))
+                    nearest = k;
+            std::copy(localVols_.row_begin(nearest),
+                      localVols_.row_end(nearest), localVols_.row_begin(i));
+        }
+
+        if (interpolationType_ == Bicubic) {
+            dVdY_ = derivatives(localVols_, logMoneyness_);
+            dVdT_ = transpose(derivatives(transpose(localVols_), times_));
+            d2VdTdY_ = transpose(derivatives(transpose(dVdY_), times_));
+        }
+
+        maxError_ = 0.0;
+        for (Size i=0; i+1 < nt; ++i) {
+            const Time t = 0.5*(times_[i] + times_[i+1]);
+            const Real f = logForward(t);
+            for (Size j=0; j+1 < ny; ++j) {
+                if (!valid[i*ny+j] || !valid[i*ny+j+1]
+                    || !valid[(i+1)*ny+j] || !valid[(i+1)*ny+j+1])
+                    continue;
+                const Real y = 0.5*(logMoneyness_[j] + logMoneyness_[j+1]);
+                const Real strike = std::exp(f + y);
+                try {
+                    const Real error = std::fabs(
+                        LocalVolSurface::localVolImpl(t, strike)
+                        - interpolatedLocalVol(
+                            t, std::log(strike) - interpolatedLogForward(t)));
+                    maxError_ = std::max(maxError_, error);
+                } catch (Error&) {}
+            }
+        }
+
+        usesGrid_ = (tolerance_ == Null<Real>() || maxError_ <= tolerance_);
+    }
+
+    Volatility InterpolatedLocalVolSurface::localVolImpl(
+        Time t, Real strike) const {
+        calculate();
+        if (!usesGrid_)
+            return LocalVolSurface::localVolImpl(t, strike);
+        return interpolatedLocalVol(
+            t, std::log(strike) - interpolatedLogForward(t));
+    }
+
+}
@@ -0,0 +1,121 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <https://www.quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+
+/*! \file interpolatedlocalvolsurface.hpp
+    \brief Dupire local volatility surface interpolated on a precomputed grid
+*/
+
+#ifndef quantlib_interpolated_local_vol_surface_hpp
+#define quantlib_interpolated_local_vol_surface_hpp
+
+#include <ql/math/matrix.hpp>
+#include <ql/patterns/lazyobject.hpp>
+#include <ql/termstructures/volatility/equityfx/localvolsurface.hpp>
+#include <ql/utilities/null.hpp>
+#include <utility>
+
+namespace QuantLib {
+
+    //! Dupire local volatility surface interpolated on a precomputed grid
+    /*! The local volatility of LocalVolSurface is calculated on a grid
+        of times and log-moneyness values \f$ y = \ln(K/F(t)) \f$ once
+        the market data change. Queries are served by bilinear or
+        bicubic interpolation on the grid, with flat extrapolation
+        outside of it; the forward is interpolated linearly in log space
+        between the grid times. This replaces the six Black variance and
+        the discount factor lookups of each LocalVolSurface query.
+        Bicubic interpolation is done by Hermite polynomials with node
+        derivatives from finite differences, so that each query only
+        involves the four corners of its grid cell.
+
+        Nodes at which the local volatility cannot be calculated, e.g.
+        because of a negative local variance, are listed by
+        failedNodes(). They take the value of the neighbouring nodes in
+        the same row, i.e. linear interpolation between them or flat
+        extrapolation; rows without any valid node take the values of
+        the nearest valid row.
+
+        After the grid is built, the interpolated local volatility is
+        compared with the exact one in the middle of each grid cell
+        whose corners are valid. The largest absolute difference is
+        returned by maxError(). If a tolerance is given and exceeded,
+        or if no node is valid, the grid is not used and queries are
+        forwarded to LocalVolSurface; usesGrid() tells which is the
+        case.
+    */
+    class InterpolatedLocalVolSurface : public LocalVolSurface,
+                                        public LazyObject {
+      public:
+        enum InterpolationType { Bilinear, Bicubic };
+
+        InterpolatedLocalVolSurface(
+            const Handle<BlackVolTermStructure>& blackTS,
+            const Handle<YieldTermStructure>& riskFreeTS,
+            const Handle<YieldTermStructure>& dividendTS,
+            const Handle<Quote>& underlying,
+            std::vector<Time> times,
+            std::vector<Real> logMoneyness,
+            InterpolationType interpolationType = Bicubic,
+            Real tolerance = Null<Real>());
+
+        //! \name Observer interface
+        //@{
+        void update() override;
+        //@}
+        //! \name Inspectors
+        //@{
+        const std::vector<Time>& times() const { return times_; }
+        const std::vector<Real>& logMoneyness() const { return logMoneyness_; }
+        //! local volatilities, rows correspond to times
+        const Matrix& localVolMatrix() const;
+        //! largest interpolation error found in the middle of the grid cells
+        Real maxError() const;
+        //! time and log-moneyness indices of the nodes that failed
+        const std::vector<std::pair<Size, Size> >& failedNodes() const;
+        //! whether queries are interpolated on the grid
+        bool usesGrid() const;
+        //@}
+
+      protected:
+        Volatility localVolImpl(Time t, Real strike) const override;
+
+      private:
+        void performCalculations() const override;
+        Real logForward(Time t) const;
+        Real interpolatedLogForward(Time t) const;
+        Volatility interpolatedLocalVol(Time t, Real y) const;
+        static Matrix derivatives(const Matrix& f,
+                                  const std::vector<Real>& x);
+
+        const std::vector<Time> times_;
+        const std::vector<Real> logMoneyness_;
+        const InterpolationType interpolationType_;
+        const Real tolerance_;
+
+        mutable std::vector<Real> logForwards_;
+        // local vols and their derivatives w.r.t. log-moneyness and time
+        mutable Matrix localVols_, dVdY_, dVdT_, d2VdTdY_;
+        mutable Real maxError_;
+        mutable std::vector<std::pair<Size, Size> > failedNodes_;
+        mutable bool usesGrid_;
+    };
+
+}
+
+#endif
@@ -70,7 +70,6 @@ namespace QuantLib {
       protected:
         Volatility localVolImpl(Time, Real) const override;
 
-      private:
         Handle<BlackVolTermStructure> blackTS_;
         Handle<YieldTermStructure> riskFreeTS_, dividendTS_;
         Handle<Quote> underlying_;
@@ -160,6 +160,147 @@ namespace QuantLib {
                                 << rho << " not allowed");
     }
 
+    namespace {
+
+        // Hagan's formulas as in unsafeSabrLogNormalVolatility and
+        // unsafeSabrNormalVolatility. Both are of the form
+        // scale*multiplier*d, whose logarithmic derivatives with respect
+        // to alpha and beta coincide for the two volatility types.
+        class SabrGridEvaluator {
+          public:
+            SabrGridEvaluator(Rate forward, Time expiryTime,
+                              Real alpha, Real beta, Real nu, Real rho,
+                              VolatilityType volatilityType)
+            : forward_(forward), logForward_(std::log(forward)),
+              expiryTime_(expiryTime), alpha_(alpha), beta_(beta),
+              nu_(nu), rho_(rho), oneMinusBeta_(1.0-beta),
+              betaTerm_(volatilityType == VolatilityType::Normal
+                        ? Real(-beta*(2.0-beta))
+                        : Real(oneMinusBeta_*oneMinusBeta_)),
+              nuTerm_((2.0-3.0*rho*rho)*(nu*nu/24.0)),
+              normal_(volatilityType == VolatilityType::Normal) {}
+
+            // the gradient is only calculated if a pointer is given
+            Real operator()(Rate strike, Real* gradient) const {
+                const Real logFK = logForward_ + std::log(strike);
+                const Real A = std::exp(oneMinusBeta_*logFK);
+                const Real sqrtA = std::sqrt(A);
+                Real logM;
+                if (!close(forward_, strike))
+                    logM = std::log(forward_/strike);
+                else {
+                    const Real epsilon = (forward_-strike)/strike;
+                    logM = epsilon - .5 * epsilon * epsilon ;
+                }
+                const Real z = (nu_/alpha_)*sqrtA*logM;
+                const Real C = oneMinusBeta_*oneMinusBeta_*logM*logM;
+                const Real E = 1.0+C/24.0+C*C/1920.0;
+
+                Real scale;
+                if (normal_) {
+                    const Real D = logM*logM;
+                    scale = alpha_*std::exp(0.5*beta_*logFK)
+                        * (1.0+D/24.0+D*D/1920.0)/E;
+                }
+                else
+                    scale = alpha_/(sqrtA*E);
+
+                const Real d = 1.0 + expiryTime_ *
+                    (betaTerm_*alpha_*alpha_/(24.0*A)
+                     + 0.25*rho_*beta_*nu_*alpha_/sqrtA + nuTerm_);
+
+                Real multiplier, dMultiplierDz, dMultiplierDrho;
+                // computations become precise enough if the square of z worth
+                // slightly more than the precision machine (hence the m)
+                static const Real m = 10;
+                if (std::fabs(z*z)>QL_EPSILON * m) {
+                    const Real sqrtB = std::sqrt(1.0-2.0*rho_*z+z*z);
+                    const Real xx = std::log((sqrtB+z-rho_)/(1.0-rho_));
+                    multiplier = z/xx;
+                    dMultiplierDz = (1.0 - z/(xx*sqrtB))/xx;
+                    dMultiplierDrho = -multiplier/xx
+                        * (1.0/(1.0-rho_) - (z/sqrtB+1.0)/(sqrtB+z-rho_));
+                }
+                else {
+                    multiplier =
+                        1.0 - 0.5*rho_*z - (3.0*rho_*rho_-2.0)*z*z/12.0;
+                    dMultiplierDz = -0.5*rho_ - (3.0*rho_*rho_-2.0)*z/6.0;
+                    dMultiplierDrho = -0.5*z - 0.5*rho_*z*z;
+                }
+
+                const Real vol = scale*multiplier*d;
+
+                if (gradient != nullptr) {
+                    const Real t = expiryTime_;
+                    const Real dEdBeta =
+                        -2.0*oneMinusBeta_*logM*logM*(1.0/24.0 + C/960.0);
+                    const Real dDdAlpha = t*(betaTerm_*alpha_/(12.0*A)
+                                             + 0.25*rho_*beta_*nu_/sqrtA);
+                    const Real dDdBeta =
+                        t*(alpha_*alpha_/24.0
+                           * (betaTerm_*logFK - 2.0*oneMinusBeta_)/A
+                           + 0.25*rho_*nu_*alpha_*(1.0 + 0.5*beta_*logFK)/sqrtA);
+                    const Real dDdNu = t*(0.25*rho_*beta_*alpha_/sqrtA
+                                          + (2.0-3.0*rho_*rho_)*nu_/12.0);
+                    const Real dDdRho = t*(0.25*beta_*nu_*alpha_/sqrtA
+                                           - 0.25*rho_*nu_*nu_);
+
+                    gradient[0] = vol/alpha_ + scale*(
+                        -dMultiplierDz*z/alpha_*d + multiplier*dDdAlpha);
+                    gradient[1] = vol*(0.5*logFK - dEdBeta/E) + scale*(
+                        -0.5*dMultiplierDz*z*logFK*d + multiplier*dDdBeta);
+                    gradient[2] = scale*(dMultiplierDz*sqrtA*logM/alpha_*d
+                                         + multiplier*dDdNu);
+                    gradient[3] = scale*(dMultiplierDrho*d + multiplier*dDdRho);
+                }
+                return vol;
+            }
+
+          private:
+            const Real forward_, logForward_, expiryTime_;
+            const Real alpha_, beta_, nu_, rho_;
+            const Real oneMinusBeta_, betaTerm_, nuTerm_;
+            const bool normal_;
+        };
+
+    }
+
+    std::vector<Real> unsafeShiftedSabrVolatilities(const std::vector<Real>& strikes,
+                                                    Rate forward,
+                                                    Time expiryTime,
+                                                    Real alpha,
+                                                    Real beta,
+                                                    Real nu,
+                                                    Real rho,
+                                                    Real shift,
+                                                    VolatilityType volatilityType) {
+        const SabrGridEvaluator evaluator(forward + shift, expiryTime,
+                                          alpha, beta, nu, rho, volatilityType);
+        std::vector<Real> result(strikes.size());
+        for (Size i=0; i<strikes.size(); ++i)
+            result[i] = evaluator(strikes[i] + shift, nullptr);
+        return result;
+    }
+
+    std::vector<Real> unsafeShiftedSabrVolatilities(const std::vector<Real>& strikes,
+                                                    Rate forward,
+                                                    Time expiryTime,
+                                                    Real alpha,
+                                                    Real beta,
+                                                    Real nu,
+                                                    Real rho,
+                                                    Real shift,
+                                                    VolatilityType volatilityType,
+                                                    Matrix& gradient) {
+        const SabrGridEvaluator evaluator(forward + shift, expiryTime,
+                                          alpha, beta, nu, rho, volatilityType);
+        std::vector<Real> result(strikes.size());
+        gradient = Matrix(strikes.size(), 4);
+        for (Size i=0; i<strikes.size(); ++i)
+            result[i] = evaluator(strikes[i] + shift, gradient.row_begin(i));
+        return result;
+    }
+
     Real sabrVolatility(Rate strike,
                         Rate forward,
                         Time expiryTime,
@@ -29,8 +29,10 @@
 #define quantlib_sabr_hpp
 
 #include <ql/types.hpp>
+#include <ql/math/matrix.hpp>
 #include <ql/termstructures/volatility/volatilitytype.hpp>
 #include <array>
+#include <vector>
 
 namespace QuantLib {
 
@@ -72,6 +74,38 @@ namespace QuantLib {
                               Real rho,
                               VolatilityType volatilityType = VolatilityType::ShiftedLognormal);
 
+    //! shifted SABR volatilities for a grid of strikes
+    /*! Gives the same results as unsafeShiftedSabrVolatility for each
+        of the strikes; the terms not depending on the strike are
+        computed once for the whole grid.
+    */
+    std::vector<Real> unsafeShiftedSabrVolatilities(
+                              const std::vector<Real>& strikes,
+                              Rate forward,
+                              Time expiryTime,
+                              Real alpha,
+                              Real beta,
+                              Real nu,
+                              Real rho,
+                              Real shift,
+                              VolatilityType volatilityType = VolatilityType::ShiftedLognormal);
+
+    //! shifted SABR volatilities and their gradients for a grid of strikes
+    /*! On return, the i-th row of gradient holds the analytic derivatives
+        of the i-th volatility with respect to alpha, beta, nu and rho.
+    */
+    std::vector<Real> unsafeShiftedSabrVolatilities(
+                              const std::vector<Real>& strikes,
+                              Rate forward,
+                              Time expiryTime,
+                              Real alpha,
+                              Real beta,
+                              Real nu,
+                              Real rho,
+                              Real shift,
+                              VolatilityType volatilityType,
+                              Matrix& gradient);
+
     Real sabrVolatility(Rate strike,
                         Rate forward,
                         Time expiryTime,
@@ -38,6 +38,7 @@
 #include <ql/quote.hpp>
 #include <ql/termstructures/volatility/sabrsmilesection.hpp>
 #include <ql/termstructures/volatility/swaption/swaptionvolcube.hpp>
+#include <chrono>
 #include <utility>
 
 
@@ -58,6 +59,20 @@ namespace QuantLib {
     /*! This class implements the XABR Swaption Volatility Cube
         which is a generic for different SABR, ZABR and 
         different smile models that can be used to instantiate concrete cubes.
+
+        The smile sections are calibrated independently of each other;
+        if requested, the calibrations are run in parallel (requires
+        OpenMP). Restarts of each calibration use a fixed low-discrepancy
+        sequence, hence the results do not depend on the number of threads.
+        With warm starts, the free parameters of the previous calibration
+        are the initial guesses of the next one, which speeds up the
+        frequent recalibrations to slightly moved quotes; the parameter
+        guesses are then only used for the first calibration.
+
+        \warning The optimization method, if given, is shared between
+                 the smile sections and is not thread-safe in general.
+                 In this case the calibrations are always run serially;
+                 by default each section uses its own optimizer.
     */
     template<class Model>
     class XabrSwaptionVolatilityCube : public SwaptionVolatilityCube {
@@ -133,7 +148,9 @@ namespace QuantLib {
             bool useMaxError = false,
             Size maxGuesses = 50,
             bool backwardFlat = false,
-            Real cutoffStrike = 0.0001);
+            Real cutoffStrike = 0.0001,
+            bool parallelCalibration = false,
+            bool warmStart = false);
         //! \name LazyObject interface
         //@{
         void performCalculations() const override;
@@ -153,6 +170,19 @@ namespace QuantLib {
         Matrix marketVolCube() const;
         Matrix volCubeAtmCalibrated() const;
         //@}
+        //! \name Calibration statistics
+        /*! Wall-clock time in seconds, number of cost-function
+            evaluations and number of starting points of the last
+            calibration of each smile section, indexed by option and
+            swap tenor.
+        */
+        //@{
+        struct CalibrationStatistics {
+            Matrix times, functionEvaluations, guesses;
+        };
+        const CalibrationStatistics& sparseCalibrationStatistics() const;
+        const CalibrationStatistics& denseCalibrationStatistics() const;
+        //@}
         void sabrCalibrationSection(const Cube& marketVolCube,
                                     Cube& parametersCube,
                                     const Period& swapTenor) const;
@@ -171,7 +201,9 @@ namespace QuantLib {
                                     Time optionTime,
                                     Time swapLength,
                                     const Cube& sabrParametersCube) const;
-        Cube sabrCalibration(const Cube &marketVolCube) const;
+        Cube sabrCalibration(const Cube& marketVolCube,
+                             const Cube& previousParameters,
+                             CalibrationStatistics& statistics) const;
         void fillVolatilityCube() const;
         void createSparseSmiles() const;
         std::vector<Real> spreadVolInterpolation(const Date& atmOptionDate,
@@ -196,7 +228,10 @@ namespace QuantLib {
         const Size maxGuesses_;
         const bool backwardFlat_;
         const Real cutoffStrike_;
+        const bool parallelCalibration_;
+        const bool warmStart_;
         VolatilityType volatilityType_;
+        mutable CalibrationStatistics sparseStatistics_, denseStatistics_;
 
         class PrivateObserver : public Observer {
           public:
@@ -239,7 +274,9 @@ namespace QuantLib {
         const bool useMaxError,
         const Size maxGuesses,
         const bool backwardFlat,
-        const Real cutoffStrike)
+        const Real cutoffStrike,
+        const bool parallelCalibration,
+        const bool warmStart)
     : SwaptionVolatilityCube(atmVolStructure,
                              optionTenors,
                              swapTenors,
@@ -252,7 +289,8 @@ namespace QuantLib {
       isParameterFixed_(std::move(isParameterFixed)), isAtmCalibrated_(isAtmCalibrated),
       endCriteria_(std::move(endCriteria)), optMethod_(std::move(optMethod)),
       useMaxError_(useMaxError), maxGuesses_(maxGuesses), backwardFlat_(backwardFlat),
-      cutoffStrike_(cutoffStrike), volatilityType_(atmVolStructure->volatilityType()) {
+      cutoffStrike_(cutoffStrike), parallelCalibration_(parallelCalibration),
+      warmStart_(warmStart), volatilityType_(atmVolStructure->volatilityType()) {
 
         if (maxErrorTolerance != Null<Rate>()) {
             maxErrorTolerance_ = maxErrorTolerance;
@@ -318,7 +356,8 @@ namespace QuantLib {
         }
         marketVolCube_.updateInterpolators();
 
-        sparseParameters_ = sabrCalibration(marketVolCube_);
+        sparseParameters_ = sabrCalibration(marketVolCube_, sparseParameters_,
+                                            sparseStatistics_);
         //parametersGuess_ = sparseParameters_;
         sparseParameters_.updateInterpolators();
         //parametersGuess_.updateInterpolators();
@@ -326,7 +365,9 @@ namespace QuantLib {
 
         if(isAtmCalibrated_){
             fillVolatilityCube();
-            denseParameters_ = sabrCalibration(volCubeAtmCalibrated_);
+            denseParameters_ = sabrCalibration(volCubeAtmCalibrated_,
+                                               denseParameters_,
+                                               denseStatistics_);
             denseParameters_.updateInterpolators();
         }
     }
@@ -335,7 +376,9 @@ namespace QuantLib {
         volCubeAtmCalibrated_ = marketVolCube_;
         if(isAtmCalibrated_){
             fillVolatilityCube();
-            denseParameters_ = sabrCalibration(volCubeAtmCalibrated_);
+            denseParameters_ = sabrCalibration(volCubeAtmCalibrated_,
+                                               denseParameters_,
+                                               denseStatistics_);
             denseParameters_.updateInterpolators();
         }
         notifyObservers();
@@ -343,7 +386,10 @@ namespace QuantLib {
 
     template <class Model>
     typename XabrSwaptionVolatilityCube<Model>::Cube
-    XabrSwaptionVolatilityCube<Model>::sabrCalibration(const Cube &marketVolCube) const {
+    XabrSwaptionVolatilityCube<Model>::sabrCalibration(
+        const Cube& marketVolCube,
+        const Cube& previousParameters,
+        CalibrationStatistics& statistics) const {
 
         const std::vector<Time>& optionTimes = marketVolCube.optionTimes();
         const std::vector<Time>& swapLengths = marketVolCube.swapLengths();
@@ -358,33 +404,61 @@ namespace QuantLib {
         Matrix maxErrors(alphas);
         Matrix endCriteria(alphas);
 
+        statistics.times = Matrix(alphas.rows(), alphas.columns(), 0.0);
+        statistics.functionEvaluations = statistics.times;
+        statistics.guesses = statistics.times;
+
         const std::vector<Matrix>& tmpMarketVolCube = marketVolCube.points();
+        const bool warmStart =
+            warmStart_ && !previousParameters.optionTimes().empty();
 
-        std::vector<Real> strikes(strikeSpreads_.size());
-        std::vector<Real> volatilities(strikeSpreads_.size());
+        // market data and guesses are collected upfront, as the term
+        // structures involved might trigger lazy calculations
+        const Size nSwapLengths = swapLengths.size();
+        const Size nSections = optionTimes.size()*nSwapLengths;
+        std::vector<std::vector<Real> > strikes(nSections), volatilities(nSections);
+        std::vector<std::vector<Real> > guesses(nSections);
+        std::vector<Real> shifts(nSections);
 
         for (Size j=0; j<optionTimes.size(); j++) {
             for (Size k=0; k<swapLengths.size(); k++) {
+                const Size s = j*nSwapLengths + k;
                 Rate atmForward = atmStrike(optionDates[j], swapTenors[k]);
-                Real shiftTmp = atmVol_->shift(optionTimes[j], swapLengths[k]);
-                strikes.clear();
-                volatilities.clear();
+                shifts[s] = atmVol_->shift(optionTimes[j], swapLengths[k]);
                 for (Size i=0; i<nStrikes_; i++){
                     Real strike = atmForward+strikeSpreads_[i];
-                    if(strike + shiftTmp >=cutoffStrike_) {
-                        strikes.push_back(strike);
-                        volatilities.push_back(tmpMarketVolCube[i][j][k]);
+                    if(strike + shifts[s] >=cutoffStrike_) {
+                        strikes[s].push_back(strike);
+                        volatilities[s].push_back(tmpMarketVolCube[i][j][k]);
                     }
                 }
+                forwards[j][k] = atmForward;
+
+                guesses[s] = parametersGuess_(optionTimes[j], swapLengths[k]);
+                if (warmStart) {
+                    const std::vector<Real> previous =
+                        previousParameters(optionTimes[j], swapLengths[k]);
+                    for (Size i=0; i<4; ++i)
+                        if (!isParameterFixed_[i])
+                            guesses[s][i] = previous[i];
+                }
+            }
+        }
 
-                const std::vector<Real>& guess =
-                    parametersGuess_(optionTimes[j], swapLengths[k]);
+        std::vector<std::string> calibrationErrors(nSections);
+
+        #pragma omp parallel for schedule(dynamic) if(parallelCalibration_ && !optMethod_)
+        for (long l=0; l < (long)nSections; ++l) {
+            const Size j = Size(l) / nSwapLengths, k = Size(l) % nSwapLengths;
+            const std::vector<Real>& guess = guesses[l];
+            try {
+                const auto startTime = std::chrono::steady_clock::now();
 
                 const ext::shared_ptr<typename Model::Interpolation> sabrInterpolation =
                     ext::shared_ptr<typename Model::Interpolation>(new
-                                          (typename Model::Interpolation)(strikes.begin(), strikes.end(),
-                                          volatilities.begin(),
-                                          optionTimes[j], atmForward,
+                                          (typename Model::Interpolation)(strikes[l].begin(), strikes[l].end(),
+                                          volatilities[l].begin(),
+                                          optionTimes[j], forwards[j][k],
                                           guess[0], guess[1],
                                           guess[2], guess[3],
                                           isParameterFixed_[0],
@@ -397,21 +471,39 @@ namespace QuantLib {
                                           errorAccept_,
                                           useMaxError_,
                                           maxGuesses_,
-                                          shiftTmp,
+                                          shifts[l],
                                           volatilityType_));
                 sabrInterpolation->update();
 
-                Real rmsError = sabrInterpolation->rmsError();
-                Real maxError = sabrInterpolation->maxError();
                 alphas     [j][k] = sabrInterpolation->alpha();
                 betas      [j][k] = sabrInterpolation->beta();
                 nus        [j][k] = sabrInterpolation->nu();
                 rhos       [j][k] = sabrInterpolation->rho();
-                forwards   [j][k] = atmForward;
-                errors     [j][k] = rmsError;
-                maxErrors  [j][k] = maxError;
+                errors     [j][k] = sabrInterpolation->rmsError();
+                maxErrors  [j][k] = sabrInterpolation->maxError();
                 endCriteria[j][k] = sabrInterpolation->endCriteria();
 
+                statistics.functionEvaluations[j][k] =
+                    sabrInterpolation->functionEvaluations();
+                statistics.guesses[j][k] = sabrInterpolation->guesses();
+                statistics.times[j][k] = std::chrono::duration<Real>(
+                    std::chrono::steady_clock::now() - startTime).count();
+            } catch (std::exception& e) {
+                calibrationErrors[l] = e.what();
+            }
+        }
+
+        for (Size j=0; j<optionTimes.size(); j++) {
+            for (Size k=0; k<swapLengths.size(); k++) {
+                QL_ENSURE(calibrationErrors[j*nSwapLengths + k].empty(),
+                          "global swaptions calibration failed: " << "\n" <<
+                          "option maturity = " << optionDates[j] << ", \n" <<
+                          "swap tenor = " << swapTenors[k] << ", \n" <<
+                          calibrationErrors[j*nSwapLengths + k]);
+
+                const Real rmsError = errors[j][k];
+                const Real maxError = maxErrors[j][k];
+
                 QL_ENSURE(endCriteria[j][k] != Integer(EndCriteria::MaxIterations),
                           "global swaptions calibration failed: "
                           "MaxIterations reached: " << "\n" <<
@@ -804,6 +896,21 @@ namespace QuantLib {
         return denseParameters_.browse();
     }
 
+    template <class Model>
+    const typename XabrSwaptionVolatilityCube<Model>::CalibrationStatistics&
+    XabrSwaptionVolatilityCube<Model>::sparseCalibrationStatistics() const {
+        calculate();
+        return sparseStatistics_;
+    }
+
+    template <class Model>
+    const typename XabrSwaptionVolatilityCube<Model>::CalibrationStatistics&
+    XabrSwaptionVolatilityCube<Model>::denseCalibrationStatistics() const {
+        QL_REQUIRE(isAtmCalibrated_, "cube is not atm calibrated");
+        calculate();
+        return denseStatistics_;
+    }
+
     template<class Model> Matrix XabrSwaptionVolatilityCube<Model>::marketVolCube() const {
         calculate();
         return marketVolCube_.browse();
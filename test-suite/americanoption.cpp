@@ -39,7 +39,9 @@
 #include <ql/pricingengines/vanilla/qdfpamericanengine.hpp>
 #include <ql/pricingengines/vanilla/qdplusamericanengine.hpp>
 #include <ql/termstructures/volatility/equityfx/blackconstantvol.hpp>
+#include <ql/termstructures/volatility/equityfx/blackvariancesurface.hpp>
 #include <ql/termstructures/yield/flatforward.hpp>
+#include <ql/time/calendars/nullcalendar.hpp>
 #include <ql/time/daycounters/actual360.hpp>
 #include <ql/time/daycounters/thirty360.hpp>
 #include <ql/utilities/dataformatters.hpp>
@@ -803,6 +805,122 @@ BOOST_AUTO_TEST_CASE(testEscrowedVsSpotAmericanOption) {
    }
 }
 
+BOOST_AUTO_TEST_CASE(testFdMultipleStrikesCaching) {
+    BOOST_TEST_MESSAGE("Testing finite-differences American options "
+                       "with multiple strikes caching...");
+
+    const auto dc = Actual365Fixed();
+    const auto today = Date(4, February, 2021);
+    Settings::instance().evaluationDate() = today;
+
+    const auto exercise = ext::make_shared<AmericanExercise>(
+        today, today + Period(1, Years));
+
+    const std::vector<Real> strikes = { 80.0, 90.0, 100.0, 110.0, 120.0 };
+
+    // the two highest strikes share their volatility, hence their operator
+    Matrix smileVols(strikes.size(), 2);
+    const Volatility smile[] = { 0.32, 0.28, 0.25, 0.23, 0.23 };
+    for (Size i=0; i < strikes.size(); ++i)
+        smileVols[i][0] = smileVols[i][1] = smile[i];
+
+    const Handle<BlackVolTermStructure> volTSs[] = {
+        Handle<BlackVolTermStructure>(flatVol(0.25, dc)),
+        Handle<BlackVolTermStructure>(
+            ext::make_shared<BlackVarianceSurface>(
+                today, NullCalendar(),
+                std::vector<Date>{ today + Period(6, Months),
+                                   today + Period(2, Years) },
+                strikes, smileVols, dc))
+    };
+
+    for (const auto& volTS : volTSs) {
+        const auto process = ext::make_shared<BlackScholesMertonProcess>(
+            Handle<Quote>(ext::make_shared<SimpleQuote>(100.0)),
+            Handle<YieldTermStructure>(flatRate(0.03, dc)),
+            Handle<YieldTermStructure>(flatRate(0.06, dc)),
+            volTS);
+
+        const auto multiEngine =
+            ext::make_shared<FdBlackScholesVanillaEngine>(process, 200, 800, 4);
+        multiEngine->enableMultipleStrikesCaching(strikes);
+
+        // the grid of a chain is set by its strike with the largest
+        // volatility, which is added to the single-strike chains
+        // below so that they use the same grid
+        Real widthStrike = strikes.front();
+        for (Real strike : strikes)
+            if (volTS->blackVol(exercise->lastDate(), strike)
+                > volTS->blackVol(exercise->lastDate(), widthStrike))
+                widthStrike = strike;
+
+        for (auto type : { Option::Put, Option::Call }) {
+            for (Real strike : strikes) {
+                VanillaOption option(
+                    ext::make_shared<PlainVanillaPayoff>(type, strike),
+                    exercise);
+
+                option.setPricingEngine(
+                    ext::make_shared<FdBlackScholesVanillaEngine>(
+                        process, 200, 800, 4));
+                const Real singleStrikeNpv = option.NPV();
+
+                const auto singleEngine =
+                    ext::make_shared<FdBlackScholesVanillaEngine>(
+                        process, 200, 800, 4);
+                singleEngine->enableMultipleStrikesCaching(
+                    std::vector<Real>{ strike, widthStrike });
+                option.setPricingEngine(singleEngine);
+                const Real expectedNpv = option.NPV();
+                const Real expectedDelta = option.delta();
+                const Real expectedGamma = option.gamma();
+                const Real expectedTheta = option.theta();
+
+                option.setPricingEngine(multiEngine);
+                const Real npv = option.NPV();
+                const Real delta = option.delta();
+                const Real gamma = option.gamma();
+                const Real theta = option.theta();
+
+                // the columns of a chain are solved independently
+                const Real tol = 1e-12;
+                if (std::fabs(npv - expectedNpv) > tol
+                    || std::fabs(delta - expectedDelta) > tol
+                    || std::fabs(gamma - expectedGamma) > tol
+                    || std::fabs(theta - expectedTheta) > tol) {
+                    BOOST_FAIL("failed to reproduce single option results "
+                               "on the same grid with multiple strikes "
+                               "caching"
+                               << "\n    option type: " << type
+                               << "\n    strike:      " << strike
+                               << "\n    npv:         " << npv
+                               << "\n    expected:    " << expectedNpv
+                               << "\n    delta:       " << delta
+                               << "\n    expected:    " << expectedDelta
+                               << "\n    gamma:       " << gamma
+                               << "\n    expected:    " << expectedGamma
+                               << "\n    theta:       " << theta
+                               << "\n    expected:    " << expectedTheta
+                               << "\n    tolerance:   " << tol);
+                }
+
+                // the grid of the single-strike engine is concentrated
+                // around the strike instead of the spot
+                const Real gridTol = 5e-4;
+                if (std::fabs(npv - singleStrikeNpv) > gridTol) {
+                    BOOST_FAIL("failed to reproduce single option value "
+                               "with multiple strikes caching"
+                               << "\n    option type: " << type
+                               << "\n    strike:      " << strike
+                               << "\n    npv:         " << npv
+                               << "\n    expected:    " << singleStrikeNpv
+                               << "\n    tolerance:   " << gridTol);
+                }
+            }
+        }
+    }
+}
+
 BOOST_AUTO_TEST_CASE(testTodayIsDividendDate) {
     BOOST_TEST_MESSAGE("Testing escrowed vs spot dividend model on dividend dates for American options...");
 
@@ -860,6 +860,7 @@ BOOST_AUTO_TEST_CASE(testDifferentOptimizers) {
 
     const ext::shared_ptr<OptimizationMethod> optimizationMethods[] = {
         ext::make_shared<LevenbergMarquardt>(),
+        ext::make_shared<LevenbergMarquardt>(1e-8, 1e-8, 1e-8, true),
         ext::make_shared<BFGS>(),
         ext::make_shared<Simplex>(0.2)
     };
@@ -880,6 +881,81 @@ BOOST_AUTO_TEST_CASE(testDifferentOptimizers) {
     }
 }
 
+class JacobianCheckingOptimizer : public OptimizationMethod {
+  public:
+    explicit JacobianCheckingOptimizer(Real& maxError)
+    : maxError_(maxError) {}
+
+    EndCriteria::Type minimize(Problem& P,
+                               const EndCriteria& endCriteria) override {
+        checkJacobian(P.costFunction(), P.currentValue());
+        const EndCriteria::Type ecType =
+            LevenbergMarquardt(1e-8, 1e-8, 1e-8, true)
+                .minimize(P, endCriteria);
+        checkJacobian(P.costFunction(), P.currentValue());
+
+        return ecType;
+    }
+
+  private:
+    void checkJacobian(const CostFunction& costFunction, const Array& x) {
+        const Array values = costFunction.values(x);
+
+        Matrix jac(values.size(), x.size());
+        costFunction.jacobian(jac, x);
+
+        const Real h = 1e-6;
+        for (Size j=0; j < x.size(); ++j) {
+            Array xUp(x), xDown(x);
+            xUp[j] += h;
+            xDown[j] -= h;
+            const Array fd = (costFunction.values(xUp)
+                              - costFunction.values(xDown))/(2*h);
+            for (Size i=0; i < fd.size(); ++i)
+                maxError_ = std::max(maxError_, std::fabs(jac[i][j] - fd[i]));
+        }
+    }
+
+    Real& maxError_;
+};
+
+BOOST_AUTO_TEST_CASE(testCostFunctionJacobian) {
+    BOOST_TEST_MESSAGE(
+        "Testing the Jacobian of the Andreasen-Huge "
+        "calibration against finite differences...");
+
+    const CalibrationData data[] = {
+        AndreasenHugeExampleData(), BorovkovaExampleData(), arbitrageData()
+    };
+
+    const AndreasenHugeVolatilityInterpl::CalibrationType calibrationTypes[] = {
+        AndreasenHugeVolatilityInterpl::Put,
+        AndreasenHugeVolatilityInterpl::Call,
+        AndreasenHugeVolatilityInterpl::CallPut
+    };
+
+    for (const auto& d : data) {
+        for (auto calibrationType : calibrationTypes) {
+            Real maxError = 0.0;
+            AndreasenHugeVolatilityInterpl(
+                d.calibrationSet, d.spot, d.rTS, d.qTS,
+                AndreasenHugeVolatilityInterpl::CubicSpline, calibrationType,
+                400, Null<Real>(), Null<Real>(),
+                ext::make_shared<JacobianCheckingOptimizer>(maxError))
+                .calibrationError();
+
+            const Real tol = 1e-7;
+            if (maxError > tol) {
+                BOOST_FAIL("Jacobian of the Andreasen-Huge "
+                           "calibration differs from finite differences"
+                           << "\n    calibration type: " << calibrationType
+                           << "\n    max difference:   " << maxError
+                           << "\n    tolerance:        " << tol);
+            }
+        }
+    }
+}
+
 BOOST_AUTO_TEST_CASE(testMovingReferenceDate) {
     BOOST_TEST_MESSAGE(
         "Testing that reference date of adapter surface moves along with "
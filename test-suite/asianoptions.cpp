@@ -855,6 +855,107 @@ BOOST_AUTO_TEST_CASE(testMCDiscreteArithmeticAveragePrice, *precondition(if_spee
     }
 }
 
+BOOST_AUTO_TEST_CASE(testMCDiscreteArithmeticAveragePriceGreeks) {
+
+    BOOST_TEST_MESSAGE("Testing pathwise greeks of Monte Carlo discrete "
+                       "arithmetic average-price Asians...");
+
+    DayCounter dc = Actual360();
+    Date today = Settings::instance().evaluationDate();
+
+    ext::shared_ptr<SimpleQuote> spot(new SimpleQuote(100.0));
+    ext::shared_ptr<SimpleQuote> qRate(new SimpleQuote(0.03));
+    ext::shared_ptr<YieldTermStructure> qTS = flatRate(today, qRate, dc);
+    ext::shared_ptr<SimpleQuote> rRate(new SimpleQuote(0.06));
+    ext::shared_ptr<YieldTermStructure> rTS = flatRate(today, rRate, dc);
+    ext::shared_ptr<SimpleQuote> vol(new SimpleQuote(0.20));
+    ext::shared_ptr<BlackVolTermStructure> volTS = flatVol(today, vol, dc);
+
+    ext::shared_ptr<BlackScholesMertonProcess> stochProcess(
+        new BlackScholesMertonProcess(Handle<Quote>(spot),
+                                      Handle<YieldTermStructure>(qTS),
+                                      Handle<YieldTermStructure>(rTS),
+                                      Handle<BlackVolTermStructure>(volTS)));
+
+    ext::shared_ptr<Exercise> exercise(new EuropeanExercise(today + 1*Years));
+
+    // the same seed is used for the bumped prices, so that the
+    // finite-difference estimates are affected by the same
+    // simulation error as the pathwise ones.
+    ext::shared_ptr<PricingEngine> engine =
+        MakeMCDiscreteArithmeticAPEngine<PseudoRandom>(stochProcess)
+        .withSamples(20000)
+        .withAntitheticVariate()
+        .withPathwiseGreeks()
+        .withSeed(42);
+
+    Option::Type types[] = { Option::Call, Option::Put };
+    Size pastFixings[] = { 0, 2 };
+
+    for (auto& type : types) {
+        for (Size past : pastFixings) {
+            ext::shared_ptr<StrikedTypePayoff> payoff(
+                                        new PlainVanillaPayoff(type, 100.0));
+            std::vector<Date> fixingDates;
+            for (Integer i=1; i<=12; ++i)
+                fixingDates.push_back(today + i*Months);
+            Real runningSum = past * spot->value() * 0.9;
+
+            DiscreteAveragingAsianOption option(Average::Arithmetic,
+                                                runningSum, past,
+                                                fixingDates, payoff,
+                                                exercise);
+            option.setPricingEngine(engine);
+
+            std::map<std::string,Real> calculated, error, expected;
+            for (const std::string greek : { "delta", "vega", "rho" }) {
+                calculated[greek] = option.result<Real>(greek);
+                error[greek] = option.result<Real>(greek + "Error");
+            }
+
+            Real u = spot->value(), du = u*1.0e-4;
+            spot->setValue(u+du);
+            Real valueP = option.NPV();
+            spot->setValue(u-du);
+            Real valueM = option.NPV();
+            spot->setValue(u);
+            expected["delta"] = (valueP - valueM)/(2*du);
+
+            Volatility v = vol->value(), dv = 1.0e-4;
+            vol->setValue(v+dv);
+            valueP = option.NPV();
+            vol->setValue(v-dv);
+            valueM = option.NPV();
+            vol->setValue(v);
+            expected["vega"] = (valueP - valueM)/(2*dv);
+
+            Rate r = rRate->value(), dr = 1.0e-4;
+            rRate->setValue(r+dr);
+            valueP = option.NPV();
+            rRate->setValue(r-dr);
+            valueM = option.NPV();
+            rRate->setValue(r);
+            expected["rho"] = (valueP - valueM)/(2*dr);
+
+            for (const auto& it : expected) {
+                const std::string& greek = it.first;
+                // the difference is much smaller than the simulation
+                // error since the same paths are used.
+                Real tolerance = 0.1*error[greek];
+                if (std::fabs(calculated[greek] - it.second) > tolerance)
+                    BOOST_ERROR("failed to reproduce " << greek
+                                << " of " << type << " Asian option with "
+                                << past << " past fixings:"
+                                << "\n    finite differences: " << it.second
+                                << "\n    pathwise:           "
+                                << calculated[greek]
+                                << "\n    error estimate:     "
+                                << error[greek]);
+            }
+        }
+    }
+}
+
 BOOST_AUTO_TEST_CASE(testMCDiscreteArithmeticAveragePriceHeston, *precondition(if_speed(Slow))) {
 
     BOOST_TEST_MESSAGE(
@@ -1636,6 +1636,114 @@ BOOST_AUTO_TEST_CASE(testNdimPDEinDifferentDims) {
     }
 }
 
+BOOST_AUTO_TEST_CASE(testSparseGridNdimPDE) {
+    BOOST_TEST_MESSAGE("Testing sparse-grid n-dimensional PDE engine...");
+
+    const DayCounter dc = Actual365Fixed();
+    const Date today = Date(25, February, 2024);
+    const Date maturity = today + Period(6, Months);
+
+    const std::vector<Real> underlyings({100, 50, 75, 120, 80});
+    const std::vector<Real> volatilities({0.3, 0.2, 0.6, 0.4, 0.25});
+
+    const Handle<YieldTermStructure> rTS = Handle<YieldTermStructure>(
+        flatRate(today, 0.05, dc));
+    const ext::shared_ptr<Exercise> exercise
+        = ext::make_shared<EuropeanExercise>(maturity);
+
+    std::vector<ext::shared_ptr<GeneralizedBlackScholesProcess> > processes;
+    Real strike = 5.0;
+    for (Size d=1; d <= underlyings.size(); ++d) {
+        processes.push_back(
+            ext::make_shared<BlackScholesProcess>(
+                Handle<Quote>(ext::make_shared<SimpleQuote>(underlyings[d-1])),
+                rTS,
+                Handle<BlackVolTermStructure>(flatVol(today, volatilities[d-1], dc))
+            )
+        );
+        strike += underlyings[d-1];
+
+        if (d < 3)
+            continue;
+
+        Matrix rho(d, d);
+        for (Size i=0; i < d; ++i)
+            for (Size j=0; j < d; ++j)
+                rho(i, j) = rho(j, i) = std::exp(-0.5*std::abs(Real(i)-Real(j)));
+
+        BasketOption option(
+            ext::make_shared<AverageBasketPayoff>(
+                ext::make_shared<PlainVanillaPayoff>(Option::Call, strike),
+                Array(d, 1.0)
+            ),
+            exercise
+        );
+
+        option.setPricingEngine(
+            ext::make_shared<ChoiBasketEngine>(processes, rho, 8));
+        const Real expected = option.NPV();
+
+        option.setPricingEngine(
+            ext::make_shared<FdndimBlackScholesVanillaEngine>(
+                processes, rho, FdmSparseGridDesc{5}, 10));
+        const Real calculated = option.NPV();
+
+        const Real diff = std::abs(calculated - expected);
+        const Real tol = 0.05;
+
+        if (diff > tol) {
+            BOOST_FAIL("failed to reproduce " << d << "-dim option price "
+                   "with sparse grids"
+                   << std::fixed << std::setprecision(5)
+                   << "\n    calculated: " << calculated
+                   << "\n    expected:   " << expected
+                   << "\n    diff:       " << diff
+                   << "\n    tolerance : " << tol);
+        }
+
+        if (d == 3) {
+            // solving the grids concurrently must not change the price,
+            // also when the operators query the term structures
+            FdmSparseGridDesc parallelDesc{5};
+            parallelDesc.parallel = true;
+
+            for (const auto& ex : std::vector<ext::shared_ptr<Exercise> >{
+                     exercise, ext::make_shared<AmericanExercise>(today, maturity)}) {
+                BasketOption o(
+                    ext::dynamic_pointer_cast<BasketPayoff>(option.payoff()), ex);
+
+                o.setPricingEngine(
+                    ext::make_shared<FdndimBlackScholesVanillaEngine>(
+                        processes, rho, FdmSparseGridDesc{5}, 10));
+                const Real serial = o.NPV();
+
+                o.setPricingEngine(
+                    ext::make_shared<FdndimBlackScholesVanillaEngine>(
+                        processes, rho, parallelDesc, 10));
+                const Real parallel = o.NPV();
+
+                if (std::abs(parallel - serial) > 1e-12) {
+                    BOOST_FAIL("parallel sparse-grid calculation differs "
+                               "from the serial one"
+                               << std::setprecision(16)
+                               << "\n    exercise: "
+                               << (ex == exercise ? "European" : "American")
+                               << "\n    serial:   " << serial
+                               << "\n    parallel: " << parallel);
+                }
+            }
+        }
+
+        if (d == underlyings.size()) {
+            // grids with three points per direction are too coarse
+            option.setPricingEngine(
+                ext::make_shared<FdndimBlackScholesVanillaEngine>(
+                    processes, rho, FdmSparseGridDesc{5, 1}, 10));
+            BOOST_CHECK_THROW(option.NPV(), Error);
+        }
+    }
+}
+
 BOOST_AUTO_TEST_CASE(testDengLiZhouVsPDE) {
     BOOST_TEST_MESSAGE("Testing Deng-Li-Zhou basket engine vs PDE engine...");
 
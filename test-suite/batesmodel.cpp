@@ -30,6 +30,7 @@
 #include <ql/pricingengines/blackformula.hpp>
 #include <ql/math/optimization/levenbergmarquardt.hpp>
 #include <ql/pricingengines/vanilla/batesengine.hpp>
+#include <ql/pricingengines/vanilla/coshestonengine.hpp>
 #include <ql/pricingengines/vanilla/jumpdiffusionengine.hpp>
 #include <ql/pricingengines/vanilla/analyticeuropeanengine.hpp>
 #include <ql/pricingengines/vanilla/mceuropeanhestonengine.hpp>
@@ -359,6 +360,73 @@ BOOST_AUTO_TEST_CASE(testAnalyticVsMCPricing) {
     }
 }
 
+BOOST_AUTO_TEST_CASE(testCosVsAnalyticPricing) {
+    BOOST_TEST_MESSAGE("Testing COS Bates engine against analytic "
+                       "engine...");
+
+    const Date settlementDate(30, March, 2007);
+    Settings::instance().evaluationDate() = settlementDate;
+
+    const DayCounter dayCounter = Actual365Fixed();
+    const Date exerciseDate(30, March, 2009);
+
+    const Handle<YieldTermStructure> riskFreeTS(flatRate(0.05, dayCounter));
+    const Handle<YieldTermStructure> dividendTS(flatRate(0.02, dayCounter));
+    const Handle<Quote> s0(ext::make_shared<SimpleQuote>(100.0));
+
+    const ext::shared_ptr<BatesModel> batesModel =
+        ext::make_shared<BatesModel>(
+            ext::make_shared<BatesProcess>(
+                riskFreeTS, dividendTS, s0,
+                0.04, 1.5, 0.05, 0.4, -0.6, 0.8, -0.15, 0.2));
+
+    const ext::shared_ptr<PricingEngine> analyticEngine =
+        ext::make_shared<BatesEngine>(batesModel, 192);
+    const ext::shared_ptr<COSHestonEngine> cosEngine =
+        ext::make_shared<COSHestonEngine>(batesModel, 16, 400);
+
+    const std::vector<Real> strikes = { 60, 80, 95, 100, 105, 120, 160 };
+
+    const ext::shared_ptr<Exercise> exercise =
+        ext::make_shared<EuropeanExercise>(exerciseDate);
+
+    const Real tol = 1e-6;
+    for (auto type : { Option::Call, Option::Put }) {
+        const Array chain
+            = cosEngine->chainPrices(exerciseDate, strikes, type);
+
+        for (Size i=0; i < strikes.size(); ++i) {
+            VanillaOption option(
+                ext::make_shared<PlainVanillaPayoff>(type, strikes[i]),
+                exercise);
+
+            option.setPricingEngine(analyticEngine);
+            const Real expected = option.NPV();
+
+            option.setPricingEngine(cosEngine);
+            const Real calculated = option.NPV();
+
+            if (std::fabs(calculated - expected) > tol
+                || std::fabs(chain[i] - expected) > tol)
+                BOOST_ERROR("failed to reproduce Bates prices "
+                            "with COS engine"
+                            << "\n    strike:      " << strikes[i]
+                            << "\n    type:        " << type
+                            << "\n    expected:    " << expected
+                            << "\n    calculated:  " << calculated
+                            << "\n    chain price: " << chain[i]
+                            << "\n    tolerance:   " << tol);
+        }
+    }
+
+    BOOST_CHECK_THROW(
+        COSHestonEngine(ext::make_shared<BatesDetJumpModel>(
+            ext::make_shared<BatesProcess>(
+                riskFreeTS, dividendTS, s0,
+                0.04, 1.5, 0.05, 0.4, -0.6, 0.8, -0.15, 0.2))),
+        Error);
+}
+
 BOOST_AUTO_TEST_CASE(testDAXCalibration) {
     /* this example is taken from A. Sepp
        Pricing European-Style Options under Jump Diffusion Processes
@@ -243,6 +243,45 @@ BOOST_AUTO_TEST_CASE(testPathGeneration) {
     }
 }
 
+BOOST_AUTO_TEST_CASE(testBlockTransform) {
+    BOOST_TEST_MESSAGE("Testing Brownian-bridge transform of path blocks...");
+
+    std::vector<Time> times = {0.1, 0.25, 0.3, 0.5, 0.9, 1.0, 2.0, 5.0, 7.5};
+
+    Size N = times.size();
+    Size paths = 37;
+
+    BrownianBridge bridge(times);
+
+    unsigned long seed = 42;
+    SobolRsg sobol(N, seed);
+    InverseCumulativeRsg<SobolRsg,InverseCumulativeNormal> generator(sobol);
+
+    std::vector<Real> input(N*paths), output(N*paths);
+    std::vector<std::vector<Real> > expected(paths, std::vector<Real>(N));
+    for (Size p=0; p<paths; ++p) {
+        const std::vector<Real>& sample = generator.nextSequence().value;
+        for (Size i=0; i<N; ++i)
+            input[i*paths+p] = sample[i];
+        bridge.transform(sample.begin(), sample.end(), expected[p].begin());
+    }
+
+    bridge.transformBlock(input.data(), output.data(), paths);
+
+    Real tolerance = 1.0e-14;
+    for (Size p=0; p<paths; ++p) {
+        for (Size i=0; i<N; ++i) {
+            Real calculated = output[i*paths+p];
+            if (std::fabs(calculated - expected[p][i]) > tolerance)
+                BOOST_ERROR("failed to reproduce single-path transform"
+                            << "\n    path:       " << p
+                            << "\n    step:       " << i
+                            << "\n    calculated: " << calculated
+                            << "\n    expected:   " << expected[p][i]);
+        }
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 BOOST_AUTO_TEST_SUITE_END()
@@ -34,6 +34,7 @@
 #include <ql/experimental/variancegamma/fftvanillaengine.hpp>
 #include <ql/pricingengines/vanilla/mceuropeanengine.hpp>
 #include <ql/pricingengines/vanilla/integralengine.hpp>
+#include <ql/pricingengines/richardsonextrapolationengine.hpp>
 #include <ql/termstructures/yield/flatforward.hpp>
 #include <ql/termstructures/yield/zerocurve.hpp>
 #include <ql/termstructures/yield/forwardcurve.hpp>
@@ -1292,6 +1293,76 @@ BOOST_AUTO_TEST_CASE(testQmcEngines) {
     testEngineConsistency(engine,steps,samples,relativeTol);
 }
 
+BOOST_AUTO_TEST_CASE(testMcPathwiseGreeks) {
+
+    BOOST_TEST_MESSAGE("Testing Monte Carlo European pathwise greeks "
+                       "against analytic results...");
+
+    DayCounter dc = Actual360();
+    Date today = Date::todaysDate();
+    Settings::instance().evaluationDate() = today;
+
+    ext::shared_ptr<SimpleQuote> spot(new SimpleQuote(100.0));
+    Handle<YieldTermStructure> qTS(flatRate(0.03, dc));
+    Handle<YieldTermStructure> rTS(flatRate(0.05, dc));
+    Handle<BlackVolTermStructure> volTS(flatVol(0.25, dc));
+    ext::shared_ptr<BlackScholesMertonProcess> stochProcess(
+        new BlackScholesMertonProcess(Handle<Quote>(spot), qTS, rTS, volTS));
+
+    ext::shared_ptr<Exercise> exercise(
+                            new EuropeanExercise(today + timeToDays(1.5)));
+
+    Option::Type types[] = { Option::Call, Option::Put };
+    Real strikes[] = { 80.0, 100.0, 120.0 };
+
+    for (auto& type : types) {
+        for (Real strike : strikes) {
+            for (Size kk = 0; kk < 2; kk++) {
+                ext::shared_ptr<StrikedTypePayoff> payoff;
+                if (kk == 0)
+                    payoff = ext::make_shared<PlainVanillaPayoff>(type, strike);
+                else
+                    payoff = ext::make_shared<CashOrNothingPayoff>(type, strike,
+                                                                   10.0);
+
+                EuropeanOption option(payoff, exercise);
+                option.setPricingEngine(
+                    ext::make_shared<AnalyticEuropeanEngine>(stochProcess));
+                std::map<std::string,Real> expected;
+                expected["delta"] = option.delta();
+                expected["vega"] = option.vega();
+                expected["rho"] = option.rho();
+
+                option.setPricingEngine(
+                    MakeMCEuropeanEngine<PseudoRandom>(stochProcess)
+                    .withSteps(1)
+                    .withSamples(50000)
+                    .withAntitheticVariate()
+                    .withPathwiseGreeks()
+                    .withSeed(42));
+
+                for (const auto& it : expected) {
+                    const std::string& greek = it.first;
+                    Real calculated =
+                        option.result<Real>(greek);
+                    Real error = option.result<Real>(greek + "Error");
+                    // four standard deviations
+                    Real tolerance = 4.0*error + 1.0e-8;
+                    if (std::fabs(calculated - it.second) > tolerance)
+                        BOOST_ERROR("failed to reproduce " << greek
+                                    << " of " << type << " option with "
+                                    << payoffTypeToString(payoff)
+                                    << " payoff:"
+                                    << "\n    strike:     " << strike
+                                    << "\n    expected:   " << it.second
+                                    << "\n    calculated: " << calculated
+                                    << "\n    error:      " << error);
+                }
+            }
+        }
+    }
+}
+
 BOOST_AUTO_TEST_CASE(testLocalVolatility) {
     BOOST_TEST_MESSAGE("Testing finite-differences with local volatility...");
 
@@ -1696,6 +1767,77 @@ BOOST_AUTO_TEST_CASE(testDouglasVsCrankNicolson) {
     }
 }
 
+BOOST_AUTO_TEST_CASE(testRichardsonExtrapolatedFdEngine) {
+    BOOST_TEST_MESSAGE("Testing Richardson extrapolation "
+                       "of finite-difference European engines...");
+
+    DayCounter dc = Actual360();
+    Date today = Settings::instance().evaluationDate();
+
+    ext::shared_ptr<SimpleQuote> spot(new SimpleQuote(100.0));
+    ext::shared_ptr<YieldTermStructure> qTS = flatRate(today, 0.02, dc);
+    ext::shared_ptr<YieldTermStructure> rTS = flatRate(today, 0.05, dc);
+    ext::shared_ptr<BlackVolTermStructure> volTS = flatVol(today, 0.25, dc);
+
+    ext::shared_ptr<BlackScholesMertonProcess> process =
+        ext::make_shared<BlackScholesMertonProcess>(
+            Handle<Quote>(spot), Handle<YieldTermStructure>(qTS),
+            Handle<YieldTermStructure>(rTS),
+            Handle<BlackVolTermStructure>(volTS));
+
+    ext::shared_ptr<Exercise> exercise =
+        ext::make_shared<EuropeanExercise>(today + 360);
+    ext::shared_ptr<StrikedTypePayoff> payoff =
+        ext::make_shared<PlainVanillaPayoff>(Option::Put, 105.0);
+
+    EuropeanOption option(payoff, exercise);
+    option.setPricingEngine(ext::make_shared<AnalyticEuropeanEngine>(process));
+    const Real expectedNPV = option.NPV();
+    const Real expectedDelta = option.delta();
+    const Real expectedGamma = option.gamma();
+
+    const auto fdEngine = [&](Real r) {
+        return ext::make_shared<FdBlackScholesVanillaEngine>(
+            process, Size(25*r), Size(50*r), 0, FdmSchemeDesc::CrankNicolson());
+    };
+
+    option.setPricingEngine(fdEngine(2.0));
+    const Real fineError = std::fabs(option.NPV() - expectedNPV);
+
+    typedef RichardsonExtrapolationEngine<VanillaOption::arguments,
+                                          VanillaOption::results>
+        ExtrapolatedEngine;
+
+    for (bool parallel : {false, true}) {
+        option.setPricingEngine(
+            ext::make_shared<ExtrapolatedEngine>(fdEngine, 2.0, 2.0, parallel));
+
+        const Real npvError = std::fabs(option.NPV() - expectedNPV);
+        if (npvError > 0.2*fineError || npvError > 2e-3) {
+            BOOST_ERROR("Richardson extrapolation does not improve the NPV"
+                        << "\n    expected:               " << expectedNPV
+                        << "\n    calculated:             " << option.NPV()
+                        << "\n    error on the fine grid: " << fineError);
+        }
+        if (option.errorEstimate() < npvError
+            || option.errorEstimate() > 2.0*fineError) {
+            BOOST_ERROR("inconsistent error estimate"
+                        << "\n    error estimate:         "
+                        << option.errorEstimate()
+                        << "\n    error:                  " << npvError
+                        << "\n    error on the fine grid: " << fineError);
+        }
+        if (std::fabs(option.delta() - expectedDelta) > 1e-4
+            || std::fabs(option.gamma() - expectedGamma) > 1e-4) {
+            BOOST_ERROR("failed to extrapolate Greeks"
+                        << "\n    expected delta:   " << expectedDelta
+                        << "\n    calculated delta: " << option.delta()
+                        << "\n    expected gamma:   " << expectedGamma
+                        << "\n    calculated gamma: " << option.gamma());
+        }
+    }
+}
+
 BOOST_AUTO_TEST_CASE(testFFTEngines) {
 
     BOOST_TEST_MESSAGE("Testing FFT European engines "
@@ -37,6 +37,7 @@
 #include <ql/methods/finitedifferences/meshers/fdmmeshercomposite.hpp>
 #include <ql/methods/finitedifferences/meshers/uniform1dmesher.hpp>
 #include <ql/methods/finitedifferences/meshers/uniformgridmesher.hpp>
+#include <ql/methods/finitedifferences/operators/fdmbatesop.hpp>
 #include <ql/methods/finitedifferences/operators/fdmblackscholesop.hpp>
 #include <ql/methods/finitedifferences/operators/fdmhestonhullwhiteop.hpp>
 #include <ql/methods/finitedifferences/operators/fdmhestonop.hpp>
@@ -44,25 +45,32 @@
 #include <ql/methods/finitedifferences/operators/fdmlinearopcomposite.hpp>
 #include <ql/methods/finitedifferences/operators/fdmlinearoplayout.hpp>
 #include <ql/methods/finitedifferences/operators/firstderivativeop.hpp>
+#include <ql/methods/finitedifferences/operators/modtriplebandlinearop.hpp>
 #include <ql/methods/finitedifferences/operators/numericaldifferentiation.hpp>
 #include <ql/methods/finitedifferences/operators/secondderivativeop.hpp>
 #include <ql/methods/finitedifferences/operators/secondordermixedderivativeop.hpp>
 #include <ql/methods/finitedifferences/schemes/craigsneydscheme.hpp>
 #include <ql/methods/finitedifferences/schemes/douglasscheme.hpp>
 #include <ql/methods/finitedifferences/schemes/hundsdorferscheme.hpp>
+#include <ql/methods/finitedifferences/schemes/impliciteulerscheme.hpp>
+#include <ql/methods/finitedifferences/solvers/fdm1dimsolver.hpp>
 #include <ql/methods/finitedifferences/solvers/fdm3dimsolver.hpp>
 #include <ql/methods/finitedifferences/solvers/fdmbackwardsolver.hpp>
 #include <ql/methods/finitedifferences/solvers/fdmhestonsolver.hpp>
 #include <ql/methods/finitedifferences/solvers/fdmndimsolver.hpp>
 #include <ql/methods/finitedifferences/stepconditions/fdmamericanstepcondition.hpp>
+#include <ql/methods/finitedifferences/stepconditions/fdmsnapshotcondition.hpp>
 #include <ql/methods/finitedifferences/stepconditions/fdmstepconditioncomposite.hpp>
 #include <ql/methods/finitedifferences/utilities/fdmdividendhandler.hpp>
+#include <ql/methods/finitedifferences/utilities/fdmilupreconditioner.hpp>
 #include <ql/methods/finitedifferences/utilities/fdminnervaluecalculator.hpp>
 #include <ql/methods/finitedifferences/utilities/fdmmesherintegral.hpp>
+#include <ql/methods/finitedifferences/utilities/fdmmultigridpreconditioner.hpp>
 #include <ql/models/equity/hestonmodel.hpp>
 #include <ql/pricingengines/vanilla/analyticeuropeanengine.hpp>
 #include <ql/pricingengines/vanilla/mchestonhullwhiteengine.hpp>
 #include <ql/processes/blackscholesprocess.hpp>
+#include <ql/processes/batesprocess.hpp>
 #include <ql/processes/hestonprocess.hpp>
 #include <ql/processes/hullwhiteprocess.hpp>
 #include <ql/processes/hybridhestonhullwhiteprocess.hpp>
@@ -74,6 +82,7 @@
 #include <boost/numeric/ublas/vector.hpp>
 #include <functional>
 #include <numeric>
+#include <thread>
 #include <utility>
 
 using namespace QuantLib;
@@ -330,6 +339,51 @@ BOOST_AUTO_TEST_CASE(testFdmLinearOpLayout) {
             }
         }
     }
+
+    for (Size d=0; d < dim.size(); ++d) {
+        const ext::shared_ptr<const FdmLinearOpLayout::Neighbours>&
+            neighbours = layout.neighbours(d);
+        if (neighbours != layout.neighbours(d)
+            || neighbours != FdmLinearOpLayout(layout).neighbours(d))
+            BOOST_FAIL("neighbour tables are not shared");
+
+        for (const auto& iter : layout) {
+            const Size i = iter.index();
+            if (neighbours->lower[i] != layout.neighbourhood(iter, d, -1)
+                || neighbours->upper[i] != layout.neighbourhood(iter, d, 1))
+                BOOST_FAIL("wrong neighbour table entry at index " << i
+                           << " in direction " << d);
+        }
+
+        // the reverse index walks along direction d first
+        const std::vector<Size>& reverseIndex = neighbours->reverseIndex;
+        std::vector<bool> visited(layout.size(), false);
+        for (Size j=0; j < reverseIndex.size(); ++j) {
+            if (visited[reverseIndex[j]])
+                BOOST_FAIL("reverse index is not a permutation");
+            visited[reverseIndex[j]] = true;
+
+            if ((j+1) % dim[d] != 0
+                && reverseIndex[j+1] != neighbours->upper[reverseIndex[j]])
+                BOOST_FAIL("wrong reverse index entry at position " << j+1
+                           << " in direction " << d);
+        }
+    }
+
+    // concurrent first use must yield a single table
+    const FdmLinearOpLayout freshLayout(dim);
+    std::vector<const FdmLinearOpLayout::Neighbours*> tables(4);
+    std::vector<std::thread> threads;
+    for (Size i=0; i < tables.size(); ++i)
+        threads.emplace_back([&, i]() {
+            tables[i] = freshLayout.neighbours(1).get();
+        });
+    for (auto& t : threads)
+        t.join();
+
+    for (Size i=1; i < tables.size(); ++i)
+        if (tables[i] != tables[0])
+            BOOST_FAIL("neighbour tables calculated more than once");
 }
 
 BOOST_AUTO_TEST_CASE(testUniformGridMesher) {
@@ -1196,6 +1250,276 @@ BOOST_AUTO_TEST_CASE(testFdmHestonHullWhiteOp, *precondition(if_speed(Fast))) {
     }
 }
 
+BOOST_AUTO_TEST_CASE(testAllocationFreeInterface) {
+    BOOST_TEST_MESSAGE(
+        "Testing allocation-free interface of FDM operators...");
+
+    const Date today = Date(28, March, 2004);
+    Settings::instance().evaluationDate() = today;
+
+    const std::vector<Size> dim = {21, 11, 11};
+    ext::shared_ptr<HybridHestonHullWhiteProcess> jointProcess
+                                            = createHestonHullWhite(1.0);
+    FdmSolverDesc desc = createSolverDesc(dim, jointProcess);
+    ext::shared_ptr<FdmMesher> mesher = desc.mesher;
+
+    ext::shared_ptr<HullWhiteForwardProcess> hwFwdProcess
+                                            = jointProcess->hullWhiteProcess();
+    ext::shared_ptr<HullWhiteProcess> hwProcess(
+        new HullWhiteProcess(jointProcess->hestonProcess()->riskFreeRate(),
+                             hwFwdProcess->a(), hwFwdProcess->sigma()));
+
+    std::vector<ext::shared_ptr<FdmLinearOpComposite> > ops = {
+        ext::make_shared<FdmHestonHullWhiteOp>(
+            mesher, jointProcess->hestonProcess(),
+            hwProcess, jointProcess->eta()),
+        ext::make_shared<FdmHestonOp>(
+            mesher, jointProcess->hestonProcess()),
+        ext::make_shared<FdmBlackScholesOp>(
+            mesher, ext::make_shared<GeneralizedBlackScholesProcess>(
+                jointProcess->hestonProcess()->s0(),
+                jointProcess->hestonProcess()->dividendYield(),
+                jointProcess->hestonProcess()->riskFreeRate(),
+                Handle<BlackVolTermStructure>(
+                    flatVol(0.2, Actual365Fixed()))), 100.0)
+    };
+
+    // the Bates operator is restricted to two dimensions
+    const ext::shared_ptr<HestonProcess> hestonProcess
+        = jointProcess->hestonProcess();
+    const ext::shared_ptr<FdmMesher> batesMesher(new UniformGridMesher(
+        ext::make_shared<FdmLinearOpLayout>(std::vector<Size>({21, 11})),
+        {{std::log(50.0), std::log(200.0)}, {0.001, 1.0}}));
+    ops.push_back(ext::make_shared<FdmBatesOp>(
+        batesMesher,
+        ext::make_shared<BatesProcess>(
+            hestonProcess->riskFreeRate(), hestonProcess->dividendYield(),
+            hestonProcess->s0(), hestonProcess->v0(), hestonProcess->kappa(),
+            hestonProcess->theta(), hestonProcess->sigma(),
+            hestonProcess->rho(), 0.3, -0.1, 0.2),
+        FdmBoundaryConditionSet(), 16));
+
+    const Real dt = 0.01;
+    for (const auto& op : ops) {
+        const Size n = (op == ops.back())
+            ? batesMesher->layout()->size() : mesher->layout()->size();
+
+        Array r(n);
+        for (Size i=0; i < n; ++i)
+            r[i] = std::sin(0.1*i) + 1.0;
+
+        // results must not alias the input, see FdmLinearOpComposite
+        Array result(n);
+        const auto check = [&](const Array& expected, const std::string& what) {
+            for (Size i=0; i < n; ++i) {
+                if (expected[i] != result[i])
+                    BOOST_FAIL("allocation-free " << what << " differs from "
+                               "the allocating one at index " << i
+                               << "\n    expected:   " << expected[i]
+                               << "\n    calculated: " << result[i]);
+            }
+        };
+
+        op->setTime(0.25, 0.25+dt);
+
+        op->apply_into(r, result);
+        check(op->apply(r), "apply");
+        op->apply_mixed_into(r, result);
+        check(op->apply_mixed(r), "apply_mixed");
+        op->preconditioner_into(r, dt, result);
+        check(op->preconditioner(r, dt), "preconditioner");
+
+        for (Size d=0; d < op->size(); ++d) {
+            op->apply_direction_into(d, r, result);
+            check(op->apply_direction(d, r), "apply_direction");
+            op->solve_splitting_into(d, r, -dt, result);
+            check(op->solve_splitting(d, r, -dt), "solve_splitting");
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testTripleBandFactorizationCache) {
+    BOOST_TEST_MESSAGE(
+        "Testing cached factorization of triple-band operators...");
+
+    const std::vector<Size> dim = {30, 20};
+    ext::shared_ptr<FdmLinearOpLayout> layout(new FdmLinearOpLayout(dim));
+    ext::shared_ptr<FdmMesher> mesher(new UniformGridMesher(
+        layout, {{0.0, 1.0}, {0.0, 2.0}}));
+
+    const Size n = layout->size();
+    Array u(n), a(n);
+    for (Size i=0; i < n; ++i) {
+        u[i] = std::sin(0.1*i) + std::cos(0.35*i);
+        a[i] = 0.5 + 0.1*std::cos(0.2*i);
+    }
+
+    const SecondDerivativeOp dxx(0, mesher);
+    const FirstDerivativeOp dx(0, mesher);
+
+    // solve_splitting uses a fresh factorization, hence its
+    // solutions are used as reference.
+    TripleBandLinearOp::SplittingFactorization factorization;
+    const auto check = [&](const TripleBandLinearOp& op, Real dt,
+                           const std::string& what) {
+        const Array expected = op.solve_splitting(u, dt);
+        Array calculated(n);
+        op.solve_splitting_into(u, calculated, factorization, dt);
+        for (Size i=0; i < n; ++i) {
+            if (expected[i] != calculated[i])
+                BOOST_FAIL("cached factorization gives a different "
+                           "solution (" << what << ") at index " << i
+                           << "\n    expected:   " << expected[i]
+                           << "\n    calculated: " << calculated[i]);
+        }
+    };
+
+    TripleBandLinearOp op(0, mesher);
+    op.axpyb(a, dxx, dx, Array(1, -0.05));
+    check(op, -0.01, "first solve");
+    check(op, -0.01, "same coefficients");
+    check(op, -0.02, "different time step");
+
+    // a second factorization of the same operator is independent
+    TripleBandLinearOp::SplittingFactorization other;
+    Array tmp(n);
+    op.solve_splitting_into(u, tmp, other, -0.03);
+    check(op, -0.02, "second factorization in use");
+
+    op.axpyb(a, dxx, dx, Array(1, -0.05));
+    check(op, -0.02, "operator rebuilt with same coefficients");
+
+    op.axpyb(1.1*a, dxx, dx, Array(1, -0.05));
+    check(op, -0.02, "operator rebuilt with new coefficients");
+
+    ModTripleBandLinearOp modOp(op);
+    check(modOp, -0.02, "copied operator");
+    modOp.diag(n/2) += 1.0;
+    check(modOp, -0.02, "modified operator");
+    modOp.setUpper(n/2, modOp.upper(n/2) - 0.5);
+    check(modOp, -0.02, "operator modified by setter");
+    modOp.lower(n/2) = modOp.upper(n/2+1);
+    check(modOp, -0.02, "operator modified by assignment");
+}
+
+BOOST_AUTO_TEST_CASE(testAlgebraicPreconditioners) {
+    BOOST_TEST_MESSAGE(
+        "Testing ILU and multigrid preconditioners of implicit schemes...");
+
+    const Date today = Date(28, March, 2004);
+    Settings::instance().evaluationDate() = today;
+
+    const std::vector<Size> dim = {41, 21, 21};
+    ext::shared_ptr<HybridHestonHullWhiteProcess> jointProcess
+                                            = createHestonHullWhite(1.0);
+    FdmSolverDesc desc = createSolverDesc(dim, jointProcess);
+    ext::shared_ptr<FdmMesher> mesher = desc.mesher;
+
+    ext::shared_ptr<HullWhiteForwardProcess> hwFwdProcess
+                                            = jointProcess->hullWhiteProcess();
+    ext::shared_ptr<HullWhiteProcess> hwProcess(
+        new HullWhiteProcess(jointProcess->hestonProcess()->riskFreeRate(),
+                             hwFwdProcess->a(), hwFwdProcess->sigma()));
+
+    const ext::shared_ptr<FdmLinearOpComposite> op =
+        ext::make_shared<FdmHestonHullWhiteOp>(
+            mesher, jointProcess->hestonProcess(),
+            hwProcess, jointProcess->eta());
+
+    Array initial(mesher->layout()->size());
+    for (const auto& iter : *mesher->layout())
+        initial[iter.index()] = std::max(
+            0.0, std::exp(mesher->location(iter, 0)) - 100.0);
+
+    const auto solve = [&](
+        const ext::shared_ptr<FdmLinearOpPreconditioner>& preconditioner,
+        Size& iterations) {
+        ImplicitEulerScheme scheme(op, FdmBoundaryConditionSet(), 1e-10,
+                                   ImplicitEulerScheme::BiCGstab,
+                                   preconditioner);
+        scheme.setStep(0.1);
+        Array a = initial;
+        for (Time t=1.0; t > 0.75; t-=0.1)
+            scheme.step(a, t);
+        iterations = scheme.numberOfIterations();
+        return a;
+    };
+
+    Size splittingIterations, iluIterations, multigridIterations;
+    const Array expected = solve({}, splittingIterations);
+    const Array ilu = solve(
+        ext::make_shared<FdmILUPreconditioner>(), iluIterations);
+    const Array multigrid = solve(
+        ext::make_shared<FdmMultigridPreconditioner>(mesher),
+        multigridIterations);
+
+    const Real tol = 1e-6;
+    for (Size i=0; i < expected.size(); ++i) {
+        const Real scale = std::max(1.0, std::fabs(expected[i]));
+        if (std::fabs(ilu[i] - expected[i]) > tol*scale
+            || std::fabs(multigrid[i] - expected[i]) > tol*scale) {
+            BOOST_FAIL("preconditioned solutions differ at index " << i
+                       << "\n    directional splitting: " << expected[i]
+                       << "\n    ILU(0):                " << ilu[i]
+                       << "\n    multigrid:             " << multigrid[i]);
+        }
+    }
+
+    if (iluIterations >= splittingIterations
+        || multigridIterations >= splittingIterations) {
+        BOOST_FAIL("algebraic preconditioners do not reduce the number "
+                   "of iterations"
+                   << "\n    directional splitting: " << splittingIterations
+                   << "\n    ILU(0):                " << iluIterations
+                   << "\n    multigrid:             " << multigridIterations);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testCompressedMatrixRepresentation) {
+    BOOST_TEST_MESSAGE(
+        "Testing compressed sparse matrix representation of operators...");
+
+    const Date today = Date(28, March, 2004);
+    Settings::instance().evaluationDate() = today;
+
+    const std::vector<Size> dim = {21, 11, 11};
+    ext::shared_ptr<HybridHestonHullWhiteProcess> jointProcess
+                                            = createHestonHullWhite(1.0);
+    FdmSolverDesc desc = createSolverDesc(dim, jointProcess);
+    ext::shared_ptr<FdmMesher> mesher = desc.mesher;
+
+    ext::shared_ptr<HullWhiteForwardProcess> hwFwdProcess
+                                            = jointProcess->hullWhiteProcess();
+    ext::shared_ptr<HullWhiteProcess> hwProcess(
+        new HullWhiteProcess(jointProcess->hestonProcess()->riskFreeRate(),
+                             hwFwdProcess->a(), hwFwdProcess->sigma()));
+
+    FdmHestonHullWhiteOp op(mesher, jointProcess->hestonProcess(),
+                            hwProcess, jointProcess->eta());
+    op.setTime(0.5, 0.6);
+
+    Array u(mesher->layout()->size());
+    for (Size i=0; i < u.size(); ++i)
+        u[i] = std::sin(0.1*i) + std::cos(0.37*i);
+
+    const Array expected = op.apply(u);
+    const Array calculated = prod(op.toCompressedMatrix(), u);
+    const Array ublas = prod(op.toMatrix(), u);
+
+    const Real tol = 1e-10;
+    for (Size i=0; i < u.size(); ++i) {
+        const Real scale = std::max(1.0, std::fabs(expected[i]));
+        if (std::fabs(calculated[i] - expected[i]) > tol*scale
+            || std::fabs(ublas[i] - expected[i]) > tol*scale) {
+            BOOST_FAIL("matrix representation differs from operator"
+                       << "\n    index:      " << i
+                       << "\n    operator:   " << expected[i]
+                       << "\n    compressed: " << calculated[i]
+                       << "\n    ublas:      " << ublas[i]);
+        }
+    }
+}
+
 BOOST_AUTO_TEST_CASE(testBiCGstab) {
     BOOST_TEST_MESSAGE(
         "Testing bi-conjugated gradient stabilized algorithm...");
@@ -1377,6 +1701,146 @@ BOOST_AUTO_TEST_CASE(testCrankNicolsonWithDamping) {
     }
 }
 
+BOOST_AUTO_TEST_CASE(testAdaptiveTimeStepping) {
+
+    BOOST_TEST_MESSAGE("Testing adaptive time stepping of the backward solver...");
+
+    DayCounter dc = Actual360();
+    Date today = Date::todaysDate();
+
+    ext::shared_ptr<SimpleQuote> spot(new SimpleQuote(100.0));
+    ext::shared_ptr<YieldTermStructure> qTS = flatRate(today, 0.02, dc);
+    ext::shared_ptr<YieldTermStructure> rTS = flatRate(today, 0.05, dc);
+    ext::shared_ptr<BlackVolTermStructure> volTS = flatVol(today, 0.25, dc);
+
+    ext::shared_ptr<StrikedTypePayoff> payoff(
+                                    new PlainVanillaPayoff(Option::Put, 105));
+
+    Time maturity = 1.0;
+    Date exDate = today + timeToDays(maturity);
+    ext::shared_ptr<Exercise> exercise(new EuropeanExercise(exDate));
+
+    ext::shared_ptr<BlackScholesMertonProcess> process(new
+        BlackScholesMertonProcess(Handle<Quote>(spot),
+                                  Handle<YieldTermStructure>(qTS),
+                                  Handle<YieldTermStructure>(rTS),
+                                  Handle<BlackVolTermStructure>(volTS)));
+
+    VanillaOption opt(payoff, exercise);
+    opt.setPricingEngine(ext::make_shared<AnalyticEuropeanEngine>(process));
+    const Real expectedPV = opt.NPV();
+
+    const std::vector<Size> dim(1, 400);
+    ext::shared_ptr<FdmLinearOpLayout> layout(new FdmLinearOpLayout(dim));
+    const ext::shared_ptr<FdmMesher> mesher(new FdmMesherComposite(
+        ext::make_shared<FdmBlackScholesMesher>(
+            dim[0], process, maturity, payoff->strike(),
+            Null<Real>(), Null<Real>(), 0.0001, 1.5,
+            std::pair<Real, Real>(payoff->strike(), 0.1))));
+
+    ext::shared_ptr<FdmInnerValueCalculator> calculator(
+                                  new FdmLogInnerValue(payoff, mesher, 0));
+
+    Array x(layout->size());
+    for (const auto& iter : *layout)
+        x[iter.index()] = mesher->location(iter, 0);
+
+    const ext::shared_ptr<FdmBlackScholesOp> op(
+        new FdmBlackScholesOp(mesher, process, payoff->strike()));
+
+    // the snapshot is only taken if its time is hit exactly
+    const Time snapshotTime = 0.3;
+
+    Size steps = 0;
+    for (Real tolerance : {1e-3, 1e-5}) {
+        const ext::shared_ptr<FdmSnapshotCondition> snapshot(
+            new FdmSnapshotCondition(snapshotTime));
+        const ext::shared_ptr<FdmStepConditionComposite> conditions(
+            new FdmStepConditionComposite(
+                std::list<std::vector<Time> >(1, {snapshotTime}),
+                FdmStepConditionComposite::Conditions(1, snapshot)));
+
+        Array rhs(layout->size());
+        for (const auto& iter : *layout)
+            rhs[iter.index()] = calculator->avgInnerValue(iter, maturity);
+
+        FdmBackwardSolver solver(
+            op, FdmBoundaryConditionSet(), conditions,
+            FdmSchemeDesc::Douglas());
+        solver.rollback(rhs, maturity, 0.0,
+                        FdmAdaptiveStepping(tolerance), 2);
+
+        const Real calculatedPV = MonotonicCubicNaturalSpline(
+            x.begin(), x.end(), rhs.begin())(std::log(spot->value()));
+
+        const FdmRollbackDiagnostics& diagnostics = solver.diagnostics();
+        const Real tol = 5e-3;
+        if (std::fabs(calculatedPV - expectedPV) > tol) {
+            BOOST_FAIL("Error calculating the PV with adaptive time steps"
+                       "\n tolerance:  " << tolerance <<
+                       "\n expected:   " << expectedPV <<
+                       "\n calculated: " << calculatedPV <<
+                       "\n steps:      " << diagnostics.steps);
+        }
+        if (snapshot->getValues().empty())
+            BOOST_FAIL("stopping time missed by the adaptive time stepping");
+        if (diagnostics.steps <= steps)
+            BOOST_FAIL("tighter tolerance does not lead to more steps"
+                       "\n steps: " << diagnostics.steps <<
+                       "\n steps with looser tolerance: " << steps);
+        if (diagnostics.estimatedError == Null<Real>()
+            || diagnostics.estimatedError
+                   > diagnostics.steps*tolerance*payoff->strike())
+            BOOST_FAIL("inconsistent error estimate of the adaptive "
+                       "time stepping: " << diagnostics.estimatedError);
+        if (diagnostics.forcedSteps != 0)
+            BOOST_FAIL("unexpected steps of minimum size: "
+                       << diagnostics.forcedSteps);
+        steps = diagnostics.steps;
+
+        // the same rollback driven by a solver description, a single
+        // fixed time step would be far off
+        const FdmSolverDesc solverDesc = {
+            mesher, FdmBoundaryConditionSet(),
+            ext::make_shared<FdmStepConditionComposite>(
+                std::list<std::vector<Time> >(),
+                FdmStepConditionComposite::Conditions()),
+            calculator, maturity, 1, 2,
+            ext::make_shared<FdmAdaptiveStepping>(tolerance) };
+        const Real descPV = Fdm1DimSolver(
+            solverDesc, FdmSchemeDesc::Douglas(), op)
+                .interpolateAt(std::log(spot->value()));
+
+        if (std::fabs(descPV - calculatedPV) > 1e-2) {
+            BOOST_FAIL("solver description does not use its adaptive "
+                       "time stepping"
+                       "\n tolerance:    " << tolerance <<
+                       "\n rollback PV:  " << calculatedPV <<
+                       "\n solver PV:    " << descPV);
+        }
+    }
+
+    // steps of minimum size are accepted to guarantee termination
+    Array rhs(layout->size());
+    for (const auto& iter : *layout)
+        rhs[iter.index()] = calculator->avgInnerValue(iter, maturity);
+
+    FdmBackwardSolver solver(op, FdmBoundaryConditionSet(),
+                             ext::shared_ptr<FdmStepConditionComposite>(),
+                             FdmSchemeDesc::Douglas());
+    solver.rollback(rhs, maturity, 0.0,
+                    FdmAdaptiveStepping(1e-12, 0.1, 0.1, 0.1), 2);
+
+    const FdmRollbackDiagnostics& diagnostics = solver.diagnostics();
+    if (diagnostics.forcedSteps == 0
+        || diagnostics.forcedSteps > diagnostics.steps
+        || diagnostics.rejectedSteps != 0)
+        BOOST_FAIL("steps of minimum size are not accepted"
+                   "\n steps:          " << diagnostics.steps <<
+                   "\n forced steps:   " << diagnostics.forcedSteps <<
+                   "\n rejected steps: " << diagnostics.rejectedSteps);
+}
+
 BOOST_AUTO_TEST_CASE(testSpareMatrixReference) {
     BOOST_TEST_MESSAGE("Testing SparseMatrixReference type...");
 
@@ -39,6 +39,7 @@
 #include <ql/pricingengines/blackformula.hpp>
 #include <ql/pricingengines/vanilla/analyticdividendeuropeanengine.hpp>
 #include <ql/pricingengines/vanilla/analytichestonengine.hpp>
+#include <ql/pricingengines/vanilla/analytichestonsliceengine.hpp>
 #include <ql/pricingengines/vanilla/analyticpdfhestonengine.hpp>
 #include <ql/pricingengines/vanilla/analyticptdhestonengine.hpp>
 #include <ql/pricingengines/vanilla/coshestonengine.hpp>
@@ -370,6 +371,291 @@ BOOST_AUTO_TEST_CASE(testDAXCalibration) {
     }
 }
 
+BOOST_AUTO_TEST_CASE(testSliceCalibration) {
+
+    BOOST_TEST_MESSAGE(
+             "Testing Heston model calibration on maturity slices...");
+
+    Date settlementDate(5, July, 2002);
+    Settings::instance().evaluationDate() = settlementDate;
+
+    CalibrationMarketData marketData = getDAXCalibrationMarketData();
+    const std::vector<ext::shared_ptr<CalibrationHelper> >& options = marketData.options;
+
+    std::vector<ext::shared_ptr<HestonModelHelper> > helpers;
+    for (const auto& option : options)
+        helpers.push_back(
+            ext::dynamic_pointer_cast<HestonModelHelper>(option));
+
+    const ext::shared_ptr<HestonModel> model(
+        ext::make_shared<HestonModel>(
+            ext::make_shared<HestonProcess>(
+                marketData.riskFreeTS, marketData.dividendYield,
+                marketData.s0, 0.1, 1.0, 0.1, 0.5, -0.5)));
+
+    const ext::shared_ptr<PricingEngine> referenceEngine =
+        ext::make_shared<AnalyticHestonEngine>(model, 1e-12, 100000);
+    const ext::shared_ptr<AnalyticHestonSliceEngine> engine =
+        ext::make_shared<AnalyticHestonSliceEngine>(model);
+
+    std::vector<Real> expected(helpers.size());
+    for (Size i=0; i < helpers.size(); ++i) {
+        helpers[i]->setPricingEngine(referenceEngine);
+        expected[i] = helpers[i]->modelValue();
+        helpers[i]->setPricingEngine(engine);
+    }
+
+    for (Size i=0; i < helpers.size(); ++i) {
+        const Real calculated = helpers[i]->modelValue();
+        if (std::fabs(calculated - expected[i])
+                > 1e-8*helpers[i]->marketValue())
+            BOOST_ERROR("failed to reproduce Heston price"
+                        << "\n    strike:     " << helpers[i]->strike()
+                        << "\n    maturity:   " << helpers[i]->maturity()
+                        << std::setprecision(12)
+                        << "\n    calculated: " << calculated
+                        << "\n    expected:   " << expected[i]);
+    }
+
+    if (engine->numberOfSlices() != 8)
+        BOOST_ERROR("unexpected number of maturity slices"
+                    << "\n    calculated: " << engine->numberOfSlices()
+                    << "\n    expected:   " << 8);
+
+    const Array params = model->params();
+    std::vector<Array> gradients(helpers.size());
+    for (Size i=0; i < helpers.size(); ++i)
+        helpers[i]->calibrationErrorAndGradient(gradients[i]);
+
+    const Real h = 1e-6;
+    for (Size p=0; p < params.size(); ++p) {
+        Array up(params), down(params);
+        up[p] += h;
+        down[p] -= h;
+        for (Size i=0; i < helpers.size(); ++i) {
+            model->setParams(up);
+            const Real errorUp = helpers[i]->calibrationError();
+            model->setParams(down);
+            const Real errorDown = helpers[i]->calibrationError();
+            const Real fd = (errorUp - errorDown)/(2*h);
+
+            if (gradients[i].size() != params.size()
+                || std::fabs(fd - gradients[i][p]) > 1e-5)
+                BOOST_ERROR("failed to reproduce calibration error derivative"
+                            << "\n    parameter:  " << p
+                            << "\n    strike:     " << helpers[i]->strike()
+                            << "\n    maturity:   " << helpers[i]->maturity()
+                            << std::setprecision(12)
+                            << "\n    calculated: " << gradients[i]
+                            << "\n    expected:   " << fd);
+        }
+    }
+    model->setParams(params);
+
+    LevenbergMarquardt om(1e-8, 1e-8, 1e-8, true);
+    model->calibrate(options, om,
+                     EndCriteria(400, 40, 1.0e-8, 1.0e-8, 1.0e-8));
+
+    Real sse = 0;
+    for (const auto& helper : helpers) {
+        const Real diff = helper->calibrationError()*100.0;
+        sse += diff*diff;
+    }
+    Real expectedSse = 177.2; //see article by A. Sepp.
+    if (std::fabs(sse - expectedSse) > 1.0) {
+        BOOST_FAIL("Failed to reproduce calibration error"
+                   << "\n    calculated: " << sse
+                   << "\n    expected:   " << expectedSse);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testCalibrationWithAnalyticGradient) {
+
+    BOOST_TEST_MESSAGE(
+             "Testing Heston model calibration with analytic gradients...");
+
+    Date settlementDate(5, July, 2002);
+    Settings::instance().evaluationDate() = settlementDate;
+
+    CalibrationMarketData marketData = getDAXCalibrationMarketData();
+    const std::vector<ext::shared_ptr<CalibrationHelper> >& options = marketData.options;
+
+    const ext::shared_ptr<HestonModel> model(
+        ext::make_shared<HestonModel>(
+            ext::make_shared<HestonProcess>(
+                marketData.riskFreeTS, marketData.dividendYield,
+                marketData.s0, 0.1, 1.0, 0.1, 0.5, -0.5)));
+
+    const ext::shared_ptr<PricingEngine> engine =
+        ext::make_shared<AnalyticHestonEngine>(model, 64);
+    for (const auto& option : options)
+        ext::dynamic_pointer_cast<BlackCalibrationHelper>(option)->setPricingEngine(engine);
+
+    const Array params = model->params();
+    const Real h = 1e-6;
+    for (Size i=0; i < options.size(); i+=7) {
+        model->setParams(params);
+        Array gradient;
+        options[i]->calibrationErrorAndGradient(gradient);
+        if (gradient.size() != params.size())
+            BOOST_FAIL("analytic gradient not provided");
+
+        for (Size j=0; j < params.size(); ++j) {
+            Array bumped(params);
+            bumped[j] += h;
+            model->setParams(bumped);
+            const Real up = options[i]->calibrationError();
+            bumped[j] -= 2*h;
+            model->setParams(bumped);
+            const Real down = options[i]->calibrationError();
+            const Real expected = (up - down)/(2*h);
+
+            if (std::fabs(gradient[j] - expected) > 1e-4)
+                BOOST_ERROR("failed to reproduce calibration error derivative"
+                            << "\n    option:     " << i
+                            << "\n    parameter:  " << j
+                            << std::setprecision(10)
+                            << "\n    calculated: " << gradient[j]
+                            << "\n    expected:   " << expected);
+        }
+    }
+
+    model->setParams(params);
+    LevenbergMarquardt om(1e-8, 1e-8, 1e-8, true);
+    model->calibrate(options, om,
+                     EndCriteria(400, 40, 1.0e-8, 1.0e-8, 1.0e-8));
+
+    Real sse = 0;
+    for (const auto& option : options) {
+        const Real diff = option->calibrationError()*100.0;
+        sse += diff*diff;
+    }
+    Real expected = 177.2; //see article by A. Sepp.
+    if (std::fabs(sse - expected) > 1.0) {
+        BOOST_FAIL("Failed to reproduce calibration error"
+                   << "\n    calculated: " << sse
+                   << "\n    expected:   " << expected);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testAnalyticEngineModelGradient) {
+
+    BOOST_TEST_MESSAGE(
+             "Testing model-parameter gradients of the analytic Heston engine...");
+
+    const Date settlementDate(5, July, 2002);
+    Settings::instance().evaluationDate() = settlementDate;
+
+    const DayCounter dayCounter = Actual365Fixed();
+    const Handle<YieldTermStructure> riskFreeTS(
+        flatRate(settlementDate, 0.05, dayCounter));
+    const Handle<YieldTermStructure> dividendTS(
+        flatRate(settlementDate, 0.02, dayCounter));
+    const Handle<Quote> s0(ext::make_shared<SimpleQuote>(100.0));
+
+    typedef AnalyticHestonEngine::Integration Integration;
+    typedef AnalyticHestonEngine::ComplexLogFormula ComplexLogFormula;
+
+    const struct {
+        ComplexLogFormula cpxLog;
+        Integration integration;
+        Real tolerance;
+    } engines[] = {
+        { AnalyticHestonEngine::OptimalCV,
+          Integration::gaussLaguerre(144), 1e-7 },
+        { AnalyticHestonEngine::AndersenPiterbarg,
+          Integration::gaussLaguerre(144), 1e-7 },
+        { AnalyticHestonEngine::AndersenPiterbargOptCV,
+          Integration::gaussLaguerre(144), 1e-7 },
+        { AnalyticHestonEngine::AngledContour,
+          Integration::gaussLaguerre(144), 1e-7 },
+        { AnalyticHestonEngine::AngledContourNoCV,
+          Integration::gaussLaguerre(144), 1e-7 },
+        { AnalyticHestonEngine::AsymptoticChF,
+          Integration::gaussLaguerre(144), 1e-7 },
+        // adaptive integrations are accurate up to their tolerance
+        { AnalyticHestonEngine::AndersenPiterbarg,
+          Integration::gaussLobatto(1e-10, Null<Real>(), 100000), 1e-5 }
+    };
+
+    // the second parameter set selects the asymptotic control variate
+    const Real parameters[][5] = {
+        // v0,   kappa, theta, sigma, rho
+        { 0.04,  1.5,   0.05,  0.6,  -0.6 },
+        { 0.02,  0.5,   0.03,  2.0,  -0.3 }
+    };
+
+    const Date maturityDate = settlementDate + Period(2, Years);
+    const ext::shared_ptr<Exercise> exercise =
+        ext::make_shared<EuropeanExercise>(maturityDate);
+
+    for (const auto& p : parameters) {
+        const ext::shared_ptr<HestonModel> model =
+            ext::make_shared<HestonModel>(
+                ext::make_shared<HestonProcess>(
+                    riskFreeTS, dividendTS, s0, p[0], p[1], p[2], p[3], p[4]));
+        const Array params = model->params();
+
+        for (const auto& e : engines) {
+            const ext::shared_ptr<AnalyticHestonEngine> engine =
+                ext::make_shared<AnalyticHestonEngine>(
+                    model, e.cpxLog, e.integration, 1e-25);
+            engine->enableModelGradient();
+
+            for (Real strike : {70.0, 100.0, 140.0}) {
+                for (Option::Type type : {Option::Call, Option::Put}) {
+                    VanillaOption option(
+                        ext::make_shared<PlainVanillaPayoff>(type, strike),
+                        exercise);
+                    option.setPricingEngine(engine);
+
+                    model->setParams(params);
+                    const Array gradient =
+                        option.result<Array>("modelParameterGradient");
+
+                    const Real h = 1e-5;
+                    for (Size j=0; j < params.size(); ++j) {
+                        Array bumped(params);
+                        bumped[j] += h;
+                        model->setParams(bumped);
+                        const Real up = option.NPV();
+                        bumped[j] -= 2*h;
+                        model->setParams(bumped);
+                        const Real down = option.NPV();
+                        const Real expected = (up - down)/(2*h);
+
+                        if (std::fabs(gradient[j] - expected)
+                                > e.tolerance*std::max(1.0, std::fabs(expected)))
+                            BOOST_ERROR("failed to reproduce the derivative "
+                                        "of the engine's price"
+                                        << "\n    formula:    " << e.cpxLog
+                                        << "\n    strike:     " << strike
+                                        << "\n    type:       " << type
+                                        << "\n    parameter:  " << j
+                                        << std::setprecision(12)
+                                        << "\n    calculated: " << gradient[j]
+                                        << "\n    expected:   " << expected);
+                    }
+                }
+            }
+        }
+
+        // not available for the Gatheral formula
+        const ext::shared_ptr<AnalyticHestonEngine> gatheral =
+            ext::make_shared<AnalyticHestonEngine>(
+                model, AnalyticHestonEngine::Gatheral,
+                Integration::gaussLaguerre(144));
+        gatheral->enableModelGradient();
+        model->setParams(params);
+        VanillaOption option(
+            ext::make_shared<PlainVanillaPayoff>(Option::Call, 100.0),
+            exercise);
+        option.setPricingEngine(gatheral);
+        if (option.additionalResults().count("modelParameterGradient") != 0)
+            BOOST_ERROR("unexpected gradient for the Gatheral formula");
+    }
+}
+
 BOOST_AUTO_TEST_CASE(testAnalyticVsBlack) {
     BOOST_TEST_MESSAGE("Testing analytic Heston engine against Black formula...");
 
@@ -1940,6 +2226,97 @@ BOOST_AUTO_TEST_CASE(testCosHestonEngine) {
     }
 }
 
+BOOST_AUTO_TEST_CASE(testCosHestonChainPrices) {
+    BOOST_TEST_MESSAGE("Testing COS pricing of option chains...");
+
+    const Date settlementDate(5, July, 2017);
+    Settings::instance().evaluationDate() = settlementDate;
+
+    const DayCounter dc = Actual365Fixed();
+    const Date maturityDate(5, July, 2018);
+
+    const Handle<YieldTermStructure> rTS(flatRate(0.05, dc));
+    const Handle<YieldTermStructure> qTS(flatRate(0.08, dc));
+    const Handle<Quote> s0(ext::make_shared<SimpleQuote>(100.0));
+
+    const ext::shared_ptr<HestonModel> model =
+        ext::make_shared<HestonModel>(
+            ext::make_shared<HestonProcess>(
+                rTS, qTS, s0, 0.1, 1.0, 0.1, 0.75, -0.75));
+
+    const ext::shared_ptr<COSHestonEngine> cosEngine =
+        ext::make_shared<COSHestonEngine>(model, 25, 600);
+    const ext::shared_ptr<PricingEngine> analyticEngine =
+        ext::make_shared<AnalyticHestonEngine>(model, 1e-12, 100000);
+
+    const std::vector<Real> strikes = { 25, 70, 90, 100, 110, 130, 400 };
+
+    const ext::shared_ptr<Exercise> exercise =
+        ext::make_shared<EuropeanExercise>(maturityDate);
+
+    for (auto type : { Option::Call, Option::Put }) {
+        const Array chain
+            = cosEngine->chainPrices(maturityDate, strikes, type);
+
+        for (Size i=0; i < strikes.size(); ++i) {
+            VanillaOption option(
+                ext::make_shared<PlainVanillaPayoff>(type, strikes[i]),
+                exercise);
+            option.setPricingEngine(analyticEngine);
+            const Real expected = option.NPV();
+
+            const Real tol = 1e-9;
+            if (std::fabs(chain[i] - expected) > tol)
+                BOOST_ERROR("failed to reproduce analytic Heston price "
+                            "with COS chain prices"
+                            << "\n    strike:     " << strikes[i]
+                            << "\n    expected:   " << expected
+                            << "\n    calculated: " << chain[i]);
+        }
+    }
+
+    // piecewise time dependent model
+    std::vector<Time> modelTimes = {0.25, 0.75, 10.0};
+    const TimeGrid modelGrid(modelTimes.begin(), modelTimes.end());
+
+    ConstantParameter theta( 0.1, PositiveConstraint());
+    ConstantParameter kappa( 1.0, PositiveConstraint());
+    ConstantParameter rho( -0.75, BoundaryConstraint(-1.0, 1.0));
+
+    PiecewiseConstantParameter sigma({0.25, 0.75}, PositiveConstraint());
+    sigma.setParam(0, 0.30);
+    sigma.setParam(1, 0.15);
+    sigma.setParam(2, 1.25);
+
+    const ext::shared_ptr<PiecewiseTimeDependentHestonModel> ptdModel(
+        ext::make_shared<PiecewiseTimeDependentHestonModel>(
+            rTS, qTS, s0, 0.1, theta, kappa, sigma, rho, modelGrid));
+
+    const ext::shared_ptr<AnalyticPTDHestonEngine> ptdEngine(
+        ext::make_shared<AnalyticPTDHestonEngine>(ptdModel));
+
+    for (auto type : { Option::Call, Option::Put }) {
+        const Array chain
+            = ptdEngine->cosChainPrices(maturityDate, strikes, type);
+
+        for (Size i=0; i < strikes.size(); ++i) {
+            VanillaOption option(
+                ext::make_shared<PlainVanillaPayoff>(type, strikes[i]),
+                exercise);
+            option.setPricingEngine(ptdEngine);
+            const Real expected = option.NPV();
+
+            const Real tol = 1e-6;
+            if (std::fabs(chain[i] - expected) > tol)
+                BOOST_ERROR("failed to reproduce time dependent Heston "
+                            "price with COS chain prices"
+                            << "\n    strike:     " << strikes[i]
+                            << "\n    expected:   " << expected
+                            << "\n    calculated: " << chain[i]);
+        }
+    }
+}
+
 BOOST_AUTO_TEST_CASE(testCosHestonEngineTruncation) {
     BOOST_TEST_MESSAGE("Testing Heston pricing via COS method outside truncation bounds...");
     
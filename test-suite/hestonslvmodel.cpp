@@ -80,10 +80,12 @@
 #include <ql/termstructures/volatility/equityfx/fixedlocalvolsurface.hpp>
 #include <ql/termstructures/volatility/equityfx/gridmodellocalvolsurface.hpp>
 #include <ql/termstructures/volatility/equityfx/hestonblackvolsurface.hpp>
+#include <ql/termstructures/volatility/equityfx/interpolatedlocalvolsurface.hpp>
 #include <ql/termstructures/volatility/equityfx/localconstantvol.hpp>
 #include <ql/termstructures/volatility/equityfx/localvolsurface.hpp>
 #include <ql/termstructures/volatility/equityfx/noexceptlocalvolsurface.hpp>
 #include <ql/termstructures/yield/zerocurve.hpp>
+#include <ql/time/calendars/nullcalendar.hpp>
 #include <ql/time/calendars/target.hpp>
 #include <ql/time/daycounters/actualactual.hpp>
 #include <boost/math/special_functions/gamma.hpp>
@@ -1539,6 +1541,143 @@ BOOST_AUTO_TEST_CASE(testBlackScholesFokkerPlanckFwdEquationLocalVol, *precondit
 //
 //}
 
+// smooth quadratic smile in log-moneyness, quotes beyond
+// maxLogMoneyness are missing
+class QuadraticSmileVolSurface : public BlackVolatilityTermStructure {
+  public:
+    QuadraticSmileVolSurface(Handle<Quote> spot,
+                             Handle<YieldTermStructure> rTS,
+                             Handle<YieldTermStructure> qTS,
+                             Real maxLogMoneyness = QL_MAX_REAL)
+    : BlackVolatilityTermStructure(0, NullCalendar(), Following,
+                                   rTS->dayCounter()),
+      spot_(std::move(spot)), rTS_(std::move(rTS)), qTS_(std::move(qTS)),
+      maxLogMoneyness_(maxLogMoneyness) {
+        registerWith(spot_);
+    }
+
+    Date maxDate() const override { return Date::maxDate(); }
+    Rate minStrike() const override { return 0.0; }
+    Rate maxStrike() const override { return QL_MAX_REAL; }
+
+  protected:
+    Volatility blackVolImpl(Time t, Real strike) const override {
+        const Real fwd = spot_->value()*qTS_->discount(t)/rTS_->discount(t);
+        const Real y = std::log(strike/fwd);
+        QL_REQUIRE(y <= maxLogMoneyness_, "no quote for strike " << strike);
+
+        return 0.25 - 0.1*y + 0.15*y*y + 0.02*t;
+    }
+
+  private:
+    const Handle<Quote> spot_;
+    const Handle<YieldTermStructure> rTS_, qTS_;
+    const Real maxLogMoneyness_;
+};
+
+BOOST_AUTO_TEST_CASE(testInterpolatedLocalVolSurface) {
+    BOOST_TEST_MESSAGE("Testing interpolated Dupire local volatility surface...");
+
+    const Date todaysDate(5, July, 2014);
+    Settings::instance().evaluationDate() = todaysDate;
+
+    const DayCounter dayCounter = Actual365Fixed();
+
+    const Handle<YieldTermStructure> rTS(flatRate(todaysDate, 0.035, dayCounter));
+    const Handle<YieldTermStructure> qTS(flatRate(todaysDate, 0.01, dayCounter));
+    const ext::shared_ptr<SimpleQuote> spotQuote(ext::make_shared<SimpleQuote>(100.0));
+    const Handle<Quote> spot(spotQuote);
+
+    const Handle<BlackVolTermStructure> vTS(
+        ext::make_shared<QuadraticSmileVolSurface>(spot, rTS, qTS));
+
+    std::vector<Time> times(37);
+    for (Size i=0; i < times.size(); ++i)
+        times[i] = 0.1 + 0.05*i;
+    std::vector<Real> logMoneyness(41);
+    for (Size j=0; j < logMoneyness.size(); ++j)
+        logMoneyness[j] = -0.4 + 0.02*j;
+
+    const ext::shared_ptr<LocalVolSurface> exact(
+        ext::make_shared<LocalVolSurface>(vTS, rTS, qTS, spot));
+
+    const auto check = [&](const InterpolatedLocalVolSurface& interpolated,
+                           Real tol) {
+        for (Real s0 : {100.0, 110.0}) {
+            spotQuote->setValue(s0);
+            for (Time t=0.12; t < 1.9; t+=0.09) {
+                const Real fwd = s0*qTS->discount(t)/rTS->discount(t);
+                for (Real y=-0.35; y < 0.35; y+=0.033) {
+                    const Real strike = fwd*std::exp(y);
+                    const Volatility expected = exact->localVol(t, strike, true);
+                    const Volatility calculated = interpolated.localVol(t, strike, true);
+                    if (std::fabs(expected - calculated) > tol)
+                        BOOST_ERROR("failed to reproduce local volatility"
+                                    << "\n   spot:       " << s0
+                                    << "\n   time:       " << t
+                                    << "\n   strike:     " << strike
+                                    << "\n   expected:   " << expected
+                                    << "\n   calculated: " << calculated);
+                }
+            }
+            if (!interpolated.usesGrid() || interpolated.maxError() > tol
+                || !interpolated.failedNodes().empty())
+                BOOST_ERROR("max interpolation error " << interpolated.maxError()
+                            << " exceeds tolerance " << tol);
+        }
+    };
+
+    check(InterpolatedLocalVolSurface(
+              vTS, rTS, qTS, spot, times, logMoneyness,
+              InterpolatedLocalVolSurface::Bicubic, 1e-4), 1e-4);
+    check(InterpolatedLocalVolSurface(
+              vTS, rTS, qTS, spot, times, logMoneyness,
+              InterpolatedLocalVolSurface::Bilinear, 5e-4), 5e-4);
+
+    // a coarse grid exceeds the tolerance, the exact values are used
+    spotQuote->setValue(100.0);
+    const InterpolatedLocalVolSurface coarse(
+        vTS, rTS, qTS, spot, {0.1, 1.9}, {-0.4, 0.4},
+        InterpolatedLocalVolSurface::Bilinear, 1e-4);
+    if (coarse.usesGrid() || coarse.maxError() <= 1e-4)
+        BOOST_ERROR("coarse grid not rejected, max interpolation error "
+                    << coarse.maxError());
+    if (coarse.localVol(1.0, 90.0, true) != exact->localVol(1.0, 90.0, true))
+        BOOST_ERROR("exact local volatility not used for rejected grid");
+
+    // nodes without quotes are extrapolated flat from their neighbours
+    const Real maxLogMoneyness = 0.25;
+    const Handle<BlackVolTermStructure> partialTS(
+        ext::make_shared<QuadraticSmileVolSurface>(
+            spot, rTS, qTS, maxLogMoneyness));
+    const InterpolatedLocalVolSurface partial(
+        partialTS, rTS, qTS, spot, times, logMoneyness,
+        InterpolatedLocalVolSurface::Bicubic, 1e-4);
+
+    if (!partial.usesGrid() || partial.failedNodes().empty())
+        BOOST_ERROR("missing quotes not detected");
+    for (const auto& node : partial.failedNodes()) {
+        if (logMoneyness[node.second] < maxLogMoneyness - 0.05)
+            BOOST_ERROR("node (" << times[node.first] << ", "
+                        << logMoneyness[node.second] << ") should not fail");
+        const Matrix& vols = partial.localVolMatrix();
+        if (vols[node.first][node.second]
+                != vols[node.first][logMoneyness.size()-1])
+            BOOST_ERROR("failed node (" << times[node.first] << ", "
+                        << logMoneyness[node.second]
+                        << ") not extrapolated flat");
+    }
+
+    const Real fwd = 100.0*qTS->discount(1.0)/rTS->discount(1.0);
+    const Volatility expected = exact->localVol(1.0, fwd*std::exp(0.1), true);
+    const Volatility calculated = partial.localVol(1.0, fwd*std::exp(0.1), true);
+    if (std::fabs(expected - calculated) > 1e-4)
+        BOOST_ERROR("failed to reproduce local volatility next to missing quotes"
+                    << "\n   expected:   " << expected
+                    << "\n   calculated: " << calculated);
+    BOOST_CHECK_NO_THROW(partial.localVol(1.0, fwd*std::exp(0.35), true));
+}
+
 BOOST_AUTO_TEST_CASE(testLocalVolsvSLVPropDensity) {
     BOOST_TEST_MESSAGE("Testing local volatility vs SLV model...");
 
@@ -2044,6 +2044,103 @@ BOOST_AUTO_TEST_CASE(testSabrSingleCases) {
 
 }
 
+BOOST_AUTO_TEST_CASE(testSabrVolatilityGradient) {
+
+    BOOST_TEST_MESSAGE("Testing Sabr volatilities and gradients on strike grids...");
+
+    const std::vector<Real> strikes = {
+        0.005, 0.01, 0.02, 0.029999, 0.03, 0.030001, 0.04, 0.06, 0.1 };
+    const Real forward = 0.03, shift = 0.01, tte = 2.5;
+
+    const std::vector<std::array<Real, 4> > parameterSets = {
+        {0.04, 0.5, 0.4, -0.3}, {0.01, 0.2, 0.8, 0.5},
+        {0.2, 0.9, 0.05, 0.0}, {0.005, 0.0, 0.3, -0.7} };
+
+    // the expansion of z/x(z) close to the money makes the numerical
+    // differentiation noisy for small bumps
+    const Real h = 1e-5;
+    const Real gradientTolerance = 1e-5;
+
+    for (auto volatilityType : {VolatilityType::ShiftedLognormal,
+                                VolatilityType::Normal}) {
+        for (const auto& p : parameterSets) {
+            Matrix gradient;
+            const std::vector<Real> vols = unsafeShiftedSabrVolatilities(
+                strikes, forward, tte, p[0], p[1], p[2], p[3], shift,
+                volatilityType, gradient);
+
+            for (Size i=0; i<strikes.size(); ++i) {
+                const Real expected = unsafeShiftedSabrVolatility(
+                    strikes[i], forward, tte, p[0], p[1], p[2], p[3], shift,
+                    volatilityType);
+                if (std::fabs(vols[i] - expected) > 1e-14)
+                    BOOST_ERROR("failed to reproduce Sabr volatility on a grid:"
+                                << "\n    strike:     " << strikes[i]
+                                << "\n    calculated: " << vols[i]
+                                << "\n    expected:   " << expected);
+
+                for (Size j=0; j<4; ++j) {
+                    std::array<Real, 4> up(p), down(p);
+                    up[j] += h;
+                    down[j] -= h;
+                    const Real fd = (unsafeShiftedSabrVolatility(
+                                         strikes[i], forward, tte, up[0], up[1],
+                                         up[2], up[3], shift, volatilityType)
+                                     - unsafeShiftedSabrVolatility(
+                                         strikes[i], forward, tte, down[0], down[1],
+                                         down[2], down[3], shift, volatilityType))
+                        / (2*h);
+                    if (std::fabs(gradient[i][j] - fd)
+                        > gradientTolerance*std::max(1.0, std::fabs(fd)))
+                        BOOST_ERROR("failed to reproduce Sabr volatility gradient:"
+                                    << "\n    strike:     " << strikes[i]
+                                    << "\n    parameter:  " << j
+                                    << "\n    analytic:   " << gradient[i][j]
+                                    << "\n    numerical:  " << fd);
+                }
+            }
+        }
+    }
+
+    // calibration with the analytic and with a numerical jacobian
+    const std::vector<Real> marketStrikes = { 0.01, 0.02, 0.03, 0.04, 0.05, 0.06 };
+    const std::vector<Real> marketVols = unsafeShiftedSabrVolatilities(
+        marketStrikes, forward, tte, 0.035, 0.6, 0.5, -0.25, shift);
+
+    SABRInterpolation analytic(
+        marketStrikes.begin(), marketStrikes.end(), marketVols.begin(),
+        tte, forward, 0.02, 0.6, 0.3, 0.0, false, true, false, false, false,
+        ext::shared_ptr<EndCriteria>(),
+        ext::make_shared<LevenbergMarquardt>(1e-8, 1e-8, 1e-8, true),
+        1e-8, false, 1, shift);
+    SABRInterpolation numerical(
+        marketStrikes.begin(), marketStrikes.end(), marketVols.begin(),
+        tte, forward, 0.02, 0.6, 0.3, 0.0, false, true, false, false, false,
+        ext::shared_ptr<EndCriteria>(), ext::shared_ptr<OptimizationMethod>(),
+        1e-8, false, 1, shift);
+    analytic.update();
+    numerical.update();
+
+    // the numerical jacobian is made of function evaluations; each
+    // evaluation of the analytic one is counted as a single extra
+    // function evaluation
+    const Size analyticCost =
+        analytic.functionEvaluations() + analytic.jacobianEvaluations();
+    if (analytic.rmsError() > 1e-8
+        || analytic.jacobianEvaluations() == 0
+        || numerical.jacobianEvaluations() != 0
+        || analyticCost >= numerical.functionEvaluations())
+        BOOST_ERROR("failed to calibrate Sabr with the analytic jacobian:"
+                    << "\n    rms error:                       "
+                    << analytic.rmsError()
+                    << "\n    evaluations, analytic jacobian:  "
+                    << analytic.functionEvaluations() << " functions, "
+                    << analytic.jacobianEvaluations() << " jacobians"
+                    << "\n    evaluations, numerical jacobian: "
+                    << numerical.functionEvaluations() << " functions, "
+                    << numerical.jacobianEvaluations() << " jacobians");
+}
+
 BOOST_AUTO_TEST_CASE(testTransformations) {
 
     BOOST_TEST_MESSAGE("Testing Sabr and no-arbitrage Sabr transformation functions...");
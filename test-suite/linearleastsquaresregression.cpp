@@ -165,6 +165,24 @@ BOOST_AUTO_TEST_CASE(testMultiDimRegression) {
         }
     }
 
+    // same regression on a precomputed design matrix
+    Matrix A(nr, v.size());
+    for (Size i=0; i < nr; ++i)
+        for (Size j=0; j < v.size(); ++j)
+            A[i][j] = v[j](x[i]);
+    GeneralLinearLeastSquares m2(A, y);
+
+    for (Size i=0; i < v.size(); ++i) {
+        if (m2.coefficients()[i] != m.coefficients()[i]
+            || m2.standardErrors()[i] != m.standardErrors()[i]) {
+            BOOST_ERROR("Failed to reproduce regression on design matrix"
+                << "\n    calculated: " << m2.coefficients()[i]
+                << " +/- " << m2.standardErrors()[i]
+                << "\n    expected:   " << m.coefficients()[i]
+                << " +/- " << m.standardErrors()[i]);
+        }
+    }
+
     // much simpler
     LinearRegression m1(x, y, Real(1.0));
 
@@ -27,6 +27,7 @@
 #include <ql/math/matrixutilities/basisincompleteordered.hpp>
 #include <ql/math/matrixutilities/bicgstab.hpp>
 #include <ql/math/matrixutilities/choleskydecomposition.hpp>
+#include <ql/math/matrixutilities/compressedsparsematrix.hpp>
 #include <ql/math/matrixutilities/gmres.hpp>
 #include <ql/math/matrixutilities/householder.hpp>
 #include <ql/math/matrixutilities/pseudosqrt.hpp>
@@ -776,6 +777,93 @@ BOOST_AUTO_TEST_CASE(testSparseMatrixMemory) {
 
 }
 
+BOOST_AUTO_TEST_CASE(testCompressedSparseMatrix) {
+
+    BOOST_TEST_MESSAGE("Testing compressed sparse matrices...");
+
+    // duplicates are summed up, cancelling elements are dropped
+    const CompressedSparseMatrix m(4, 3, {
+        {3, 2, 43.0}, {1, 2, 6.0}, {3, 1, 40.0},
+        {0, 0, 1.0}, {3, 1, 2.0}, {2, 1, 5.0}, {2, 1, -5.0}
+    });
+
+    BOOST_CHECK_EQUAL(m.rows(), 4);
+    BOOST_CHECK_EQUAL(m.columns(), 3);
+    BOOST_CHECK_EQUAL(m.nonZeros(), 4);
+    const std::vector<Size> rowStart = {0, 1, 2, 2, 4};
+    const std::vector<Size> columnIndices = {0, 2, 1, 2};
+    const std::vector<Real> values = {1.0, 6.0, 42.0, 43.0};
+    BOOST_CHECK_EQUAL_COLLECTIONS(m.rowStart().begin(), m.rowStart().end(),
+                                  rowStart.begin(), rowStart.end());
+    BOOST_CHECK_EQUAL_COLLECTIONS(
+        m.columnIndices().begin(), m.columnIndices().end(),
+        columnIndices.begin(), columnIndices.end());
+    BOOST_CHECK_EQUAL_COLLECTIONS(m.values().begin(), m.values().end(),
+                                  values.begin(), values.end());
+    BOOST_CHECK_EQUAL(m(3, 1), 42.0);
+    BOOST_CHECK_EQUAL(m(2, 1), 0.0);
+
+    const Matrix dense = {
+        {1.0, 0.0,  0.0},
+        {0.0, 0.0,  6.0},
+        {0.0, 0.0,  0.0},
+        {0.0, 42.0, 43.0}
+    };
+
+    const Array x = {1.0, 2.0, 3.0};
+    BOOST_CHECK_EQUAL(prod(m, x), dense*x);
+
+    const SparseMatrix ublas = m.toSparseMatrix();
+    const CompressedSparseMatrix fromUblas(ublas);
+    BOOST_CHECK_EQUAL_COLLECTIONS(
+        fromUblas.rowStart().begin(), fromUblas.rowStart().end(),
+        rowStart.begin(), rowStart.end());
+    BOOST_CHECK_EQUAL_COLLECTIONS(
+        fromUblas.columnIndices().begin(), fromUblas.columnIndices().end(),
+        columnIndices.begin(), columnIndices.end());
+    BOOST_CHECK_EQUAL_COLLECTIONS(
+        fromUblas.values().begin(), fromUblas.values().end(),
+        values.begin(), values.end());
+
+    const CompressedSparseMatrix mt = transpose(m);
+    const CompressedSparseMatrix mtm = prod(mt, m);
+    const CompressedSparseMatrix sum = 2.0*m + m;
+    const Matrix expectedMtm = transpose(dense)*dense;
+    for (Size i=0; i < dense.rows(); ++i) {
+        for (Size j=0; j < dense.columns(); ++j) {
+            BOOST_CHECK_EQUAL(ublas(i, j), dense[i][j]);
+            BOOST_CHECK_EQUAL(mt(j, i), dense[i][j]);
+            BOOST_CHECK_EQUAL(sum(i, j), 3.0*dense[i][j]);
+        }
+    }
+    for (Size i=0; i < expectedMtm.rows(); ++i)
+        for (Size j=0; j < expectedMtm.columns(); ++j)
+            BOOST_CHECK_EQUAL(mtm(i, j), expectedMtm[i][j]);
+
+    // the matrix-vector product plugs into the iterative solvers
+    const Size n = 50;
+    std::vector<CompressedSparseMatrix::Triplet> triplets;
+    for (Size i=0; i < n; ++i) {
+        triplets.push_back({i, i, 4.0});
+        triplets.push_back({i, (i+1) % n, -1.0});
+        triplets.push_back({i, (i+7) % n, -1.5});
+    }
+    const CompressedSparseMatrix a(n, n, triplets);
+    const auto multiply = [&a](const Array& v) { return prod(a, v); };
+
+    Array b(n);
+    for (Size i=0; i < n; ++i)
+        b[i] = std::sin(Real(i));
+
+    constexpr double relTol = 1e4 * QL_EPSILON;
+    const Array y = BiCGstab(multiply, n, relTol).solve(b).x;
+    if (norm2(prod(a, y) - b)/norm2(b) > relTol) {
+        BOOST_FAIL("Failed to solve sparse system using BiCGstab"
+                << "\n  rel error     : " << norm2(prod(a, y) - b)/norm2(b)
+                << "\n  rel tolerance : " << relTol);
+    }
+}
+
 #define QL_CHECK_CLOSE_MATRIX_TOL(actual, expected, tol)                    \
     BOOST_REQUIRE(actual.rows() == expected.rows() &&                       \
                   actual.columns() == expected.columns());                  \
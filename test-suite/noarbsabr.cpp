@@ -21,6 +21,8 @@
 #include "utilities.hpp"
 #include <ql/termstructures/volatility/sabrsmilesection.hpp>
 #include <ql/experimental/volatility/noarbsabrsmilesection.hpp>
+#include <filesystem>
+#include <random>
 
 using namespace QuantLib;
 using namespace boost::unit_test_framework;
@@ -120,6 +122,111 @@ BOOST_AUTO_TEST_CASE(testConsistencyWithHagan) {
 
 }
 
+// a file in the temporary directory, removed on destruction
+class TemporaryFile {  // NOLINT(cppcoreguidelines-special-member-functions)
+  public:
+    explicit TemporaryFile(const std::string& prefix) {
+        std::random_device seed;
+        name_ = (std::filesystem::temp_directory_path() /
+                 (prefix + std::to_string(seed()) + ".bin")).string();
+    }
+    ~TemporaryFile() {
+        std::error_code ignored;
+        std::filesystem::remove(name_, ignored);
+    }
+    const std::string& name() const { return name_; }
+  private:
+    std::string name_;
+};
+
+// restores the compiled-in absorption table on destruction
+class CompiledInAbsorptionTable {  // NOLINT(cppcoreguidelines-special-member-functions)
+  public:
+    ~CompiledInAbsorptionTable() {
+        NoArbSabrAbsorptionTable::instance().reset();
+    }
+};
+
+BOOST_AUTO_TEST_CASE(testPrecomputedPrices) {
+
+    BOOST_TEST_MESSAGE("Testing precomputed noarb-sabr prices...");
+
+    Real tau = 1.0, f = 0.0488;
+    Real alpha = 0.026, beta = 0.5, nu = 0.4, rho = -0.1;
+
+    NoArbSabrModel model(tau, f, alpha, beta, nu, rho);
+
+    // batch evaluation, strikes deliberately unsorted; the integrals
+    // are split differently, so the prices agree up to the accuracy
+    // of the numerical integration
+    std::vector<Real> strikes = {0.05, 0.0001, 0.12, 0.03, 0.0488, 0.2, 0.01};
+    std::vector<Real> prices = model.optionPrices(strikes);
+    for (Size i = 0; i < strikes.size(); ++i) {
+        Real expected = model.optionPrice(strikes[i]);
+        if (std::fabs(prices[i] - expected) > 1e-7)
+            BOOST_ERROR("batch price (" << prices[i]
+                        << ") inconsistent with single price (" << expected
+                        << ") at strike " << strikes[i]);
+    }
+
+    // cached price grids
+    NoArbSabrPriceGridCache& cache = NoArbSabrPriceGridCache::instance();
+    cache.setCapacity(2);
+    cache.setStrikeGrid(201, 6.0);
+
+    NoArbSabrSmileSection s1(tau, f, {alpha, beta, nu, rho});
+    NoArbSabrSmileSection s2(tau, f, {alpha, beta, nu, rho});
+    if (cache.size() != 1 || s1.model() != s2.model())
+        BOOST_ERROR("price grid not reused, cache size is " << cache.size());
+
+    for (Real strike = 0.005; strike < 0.15; strike += 0.0025) {
+        Real cached = s1.optionPrice(strike);
+        Real expected = model.optionPrice(strike);
+        if (std::fabs(cached - expected) > 1e-6)
+            BOOST_ERROR("price from grid (" << cached
+                        << ") inconsistent with model price (" << expected
+                        << ") at strike " << strike);
+    }
+
+    NoArbSabrSmileSection s3(tau, f, {alpha, beta, 0.5, rho});
+    NoArbSabrSmileSection s4(tau, f, {alpha, beta, 0.6, rho});
+    if (cache.size() != 2)
+        BOOST_ERROR("cache size (" << cache.size()
+                    << ") should be limited by its capacity (2)");
+    NoArbSabrSmileSection s5(tau, f, {alpha, beta, nu, rho});
+    if (s5.model() == s1.model())
+        BOOST_ERROR("least recently used price grid not evicted");
+
+    cache.setCapacity(0);
+    cache.setStrikeGrid(0);
+
+    // absorption table mapped from a file
+    NoArbSabrAbsorptionTable& table = NoArbSabrAbsorptionTable::instance();
+    TemporaryFile file("noarbsabr_absorption_");
+    CompiledInAbsorptionTable restore;
+    table.save(file.name());
+
+    QuantLib::detail::D0Interpolator d0(0.03, 10.0, 0.8 / std::pow(0.03, -0.99),
+                                        0.01, 0.1, 0.75);
+    Real builtIn = d0();
+    table.load(file.name());
+    Real mapped = d0();
+    if (!table.mapped() || mapped != builtIn)
+        BOOST_ERROR("absorption probability from mapped table ("
+                    << mapped << ") differs from built-in one (" << builtIn
+                    << ")");
+
+    // an empty file name selects the compiled-in table again
+    table.load("");
+    if (table.mapped())
+        BOOST_ERROR("compiled-in absorption table not restored");
+
+    BOOST_CHECK_EXCEPTION(table.load(file.name() + ".missing"), Error,
+                          ExpectedErrorMessage("could not map"));
+    if (table.mapped() || d0() != builtIn)
+        BOOST_ERROR("failed load changed the absorption table in use");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 BOOST_AUTO_TEST_SUITE_END()
@@ -24,6 +24,8 @@
 #include "preconditions.hpp"
 #include "toplevelfixture.hpp"
 #include "utilities.hpp"
+#include <ql/experimental/math/fireflyalgorithm.hpp>
+#include <ql/experimental/math/particleswarmoptimization.hpp>
 #include <ql/math/optimization/bfgs.hpp>
 #include <ql/math/optimization/conjugategradient.hpp>
 #include <ql/math/optimization/constraint.hpp>
@@ -33,7 +35,12 @@
 #include <ql/math/optimization/levenbergmarquardt.hpp>
 #include <ql/math/optimization/simplex.hpp>
 #include <ql/math/optimization/steepestdescent.hpp>
+#include <ql/math/optimization/trustregionlevenbergmarquardt.hpp>
 #include <ql/math/randomnumbers/mt19937uniformrng.hpp>
+#include <atomic>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 using namespace QuantLib;
 using namespace boost::unit_test_framework;
@@ -113,6 +120,7 @@ class OptimizationBasedCostFunction : public CostFunction {
 enum OptimizationMethodType {simplex,
                              levenbergMarquardt,
                              levenbergMarquardt2,
+                             trustRegionLevenbergMarquardt,
                              conjugateGradient,
                              conjugateGradient_goldstein,
                              steepestDescent,
@@ -128,6 +136,8 @@ std::string optimizationMethodTypeToString(OptimizationMethodType type) {
         return "Levenberg Marquardt";
       case levenbergMarquardt2:
         return "Levenberg Marquardt (cost function's jacbobian)";
+      case trustRegionLevenbergMarquardt:
+        return "Trust-region Levenberg Marquardt";
       case conjugateGradient:
         return "Conjugate Gradient";
       case steepestDescent:
@@ -167,6 +177,10 @@ ext::shared_ptr<OptimizationMethod> makeOptimizationMethod(
                                        levenbergMarquardtXtol,
                                        levenbergMarquardtGtol,
                                        true));
+      case trustRegionLevenbergMarquardt:
+        return ext::shared_ptr<OptimizationMethod>(
+                new TrustRegionLevenbergMarquardt(levenbergMarquardtXtol,
+                                                  levenbergMarquardtGtol));
       case conjugateGradient:
         return ext::shared_ptr<OptimizationMethod>(new ConjugateGradient);
       case steepestDescent:
@@ -243,7 +257,8 @@ void setup() {
                             gradientNormEpsilons_.back()));
     // Set optimization methods for optimizer
     std::vector<OptimizationMethodType> optimizationMethodTypes = {
-        simplex, levenbergMarquardt, levenbergMarquardt2, conjugateGradient,
+        simplex, levenbergMarquardt, levenbergMarquardt2,
+        trustRegionLevenbergMarquardt, conjugateGradient,
         bfgs //, steepestDescent
     };
     Real simplexLambda = 0.1;                   // characteristic search length for simplex
@@ -361,6 +376,92 @@ BOOST_AUTO_TEST_CASE(nestedOptimizationTest) {
 }
 
 
+// residuals of the Rosenbrock function with analytic jacobian
+class RosenbrockResiduals : public CostFunction {
+  public:
+    Array values(const Array& x) const override {
+        Array r(2);
+        r[0] = 10.0*(x[1]-x[0]*x[0]);
+        r[1] = 1.0-x[0];
+        return r;
+    }
+    void jacobian(Matrix& jac, const Array& x) const override {
+        jac[0][0] = -20.0*x[0];
+        jac[0][1] = 10.0;
+        jac[1][0] = -1.0;
+        jac[1][1] = 0.0;
+    }
+};
+
+BOOST_AUTO_TEST_CASE(testTrustRegionLevenbergMarquardt) {
+    BOOST_TEST_MESSAGE(
+        "Testing Levenberg-Marquardt with the cost function's jacobian...");
+
+    RosenbrockResiduals costFunction;
+    NoConstraint noConstraint;
+    const Array initialValue = {-1.2, 1.0};
+    const EndCriteria endCriteria(1000, 100, 1e-12, 1e-12, 1e-12);
+    const Real tolerance = 1e-6;
+
+    Problem reference(costFunction, noConstraint, initialValue);
+    LevenbergMarquardt(1e-8, 1e-12, 1e-12).minimize(reference, endCriteria);
+
+    for (bool geodesicAcceleration : {false, true}) {
+        TrustRegionLevenbergMarquardt optimizer(
+            1e-12, 1e-12, geodesicAcceleration);
+        Problem problem(costFunction, noConstraint, initialValue);
+        const EndCriteria::Type ecType =
+            optimizer.minimize(problem, endCriteria);
+
+        const Array& x = problem.currentValue();
+        if (!EndCriteria::succeeded(ecType)
+            || std::fabs(x[0]-1.0) > tolerance
+            || std::fabs(x[1]-1.0) > tolerance)
+            BOOST_ERROR("failed to find the minimum of the "
+                        "Rosenbrock function"
+                        << "\n    geodesic acceleration: "
+                        << std::boolalpha << geodesicAcceleration
+                        << "\n    end criteria:          " << ecType
+                        << "\n    minimum:               " << x);
+
+        // no finite differences are needed for the jacobian; the
+        // acceleration costs one more evaluation per trial step
+        if (!geodesicAcceleration
+            && problem.functionEvaluation() >= reference.functionEvaluation())
+            BOOST_ERROR("more function evaluations than MINPACK"
+                        << "\n    evaluations:           "
+                        << problem.functionEvaluation()
+                        << "\n    MINPACK evaluations:   "
+                        << reference.functionEvaluation());
+
+        if (optimizer.iterations().empty()
+            || !optimizer.iterations().back().accepted)
+            BOOST_ERROR("last trial step expected to be accepted");
+    }
+
+    // the bound is active at the minimum; the solution lies on the
+    // parabola x1 = x0^2 of zero first residual
+    NonhomogeneousBoundaryConstraint bounds({-2.0, -2.0}, {0.5, 2.0});
+    TrustRegionLevenbergMarquardt optimizer(1e-12, 1e-12);
+    Problem problem(costFunction, bounds, initialValue);
+    optimizer.minimize(problem, endCriteria);
+
+    const Array& x = problem.currentValue();
+    if (std::fabs(x[0]-0.5) > tolerance || std::fabs(x[1]-0.25) > tolerance)
+        BOOST_ERROR("failed to find the bounded minimum of the "
+                    "Rosenbrock function"
+                    << "\n    calculated: " << x
+                    << "\n    expected:   [ 0.5; 0.25 ]");
+
+    Real functionValue = QL_MAX_REAL;
+    for (const auto& iteration : optimizer.iterations()) {
+        if (iteration.functionValue > functionValue)
+            BOOST_ERROR("sum of squares increased in trial step "
+                        << iteration.iteration);
+        functionValue = iteration.functionValue;
+    }
+}
+
 class FirstDeJong : public CostFunction {
   public:
     Array values(const Array& x) const override {
@@ -540,6 +641,283 @@ BOOST_AUTO_TEST_CASE(testDifferentialEvolution) {
     }
 }
 
+// counts the calls and records which threads made them
+class CountingCostFunction : public CostFunction {
+  public:
+    explicit CountingCostFunction(const CostFunction& f) : f_(f) {}
+    Array values(const Array& x) const override {
+        return Array(x.size(), value(x));
+    }
+    Real value(const Array& x) const override {
+        ++calls_;
+        #ifdef _OPENMP
+        threads_ |= 1UL << std::min(omp_get_thread_num(), 63);
+        #endif
+        return f_.value(x);
+    }
+    Integer calls() const { return calls_; }
+    Size threads() const {
+        Size n = 0;
+        for (unsigned long t = threads_; t != 0; t &= t - 1)
+            ++n;
+        return n;
+    }
+  private:
+    const CostFunction& f_;
+    mutable std::atomic<Integer> calls_{0};
+    mutable std::atomic<unsigned long> threads_{0};
+};
+
+// fails on the points with a negative first coordinate, except
+// for the first few calls
+class FailingCostFunction : public CostFunction {
+  public:
+    explicit FailingCostFunction(Size safeCalls) : safeCalls_(safeCalls) {}
+    Array values(const Array& x) const override {
+        return Array(x.size(), value(x));
+    }
+    Real value(const Array& x) const override {
+        QL_REQUIRE(calls_++ < safeCalls_ || x[0] >= 0.0,
+                   "negative first coordinate");
+        return SecondDeJong().value(x);
+    }
+  private:
+    Size safeCalls_;
+    mutable std::atomic<Size> calls_{0};
+};
+
+BOOST_AUTO_TEST_CASE(testDifferentialEvolutionParallelEvaluation) {
+    BOOST_TEST_MESSAGE(
+        "Testing concurrent evaluation in differential evolution...");
+
+    const DifferentialEvolution::Configuration conf =
+        DifferentialEvolution::Configuration()
+        .withStepsizeWeight(0.4)
+        .withBounds()
+        .withCrossoverProbability(0.35)
+        .withPopulationMembers(200)
+        .withStrategy(DifferentialEvolution::BestMemberWithJitter)
+        .withCrossoverType(DifferentialEvolution::Normal)
+        .withAdaptiveCrossover()
+        .withSeed(3242);
+
+    SecondDeJong secondDeJong;
+    BoundaryConstraint constraint(-10.0, 10.0);
+    const EndCriteria endCriteria(50, 10, 1e-10, 1e-8, Null<Real>());
+
+    CountingCostFunction serialCost(secondDeJong);
+    Problem serialProblem(serialCost, constraint, Array(2, 5.0));
+    DifferentialEvolution(conf).minimize(serialProblem, endCriteria);
+
+    CountingCostFunction parallelCost(secondDeJong);
+    Problem parallelProblem(parallelCost, constraint, Array(2, 5.0));
+    DifferentialEvolution(DifferentialEvolution::Configuration(conf)
+                          .withParallelEvaluation())
+        .minimize(parallelProblem, endCriteria);
+
+    // random numbers are drawn independently of the evaluation
+    if (parallelProblem.functionValue() != serialProblem.functionValue()
+        || maxDifference(parallelProblem.currentValue(),
+                         serialProblem.currentValue()) != 0.0
+        || parallelProblem.functionEvaluation()
+               != serialProblem.functionEvaluation())
+        BOOST_ERROR("concurrent evaluation changes the result"
+                    << std::setprecision(16)
+                    << "\n    serial:      " << serialProblem.currentValue()
+                    << ", f = " << serialProblem.functionValue()
+                    << ", evaluations: " << serialProblem.functionEvaluation()
+                    << "\n    concurrent:  " << parallelProblem.currentValue()
+                    << ", f = " << parallelProblem.functionValue()
+                    << ", evaluations: "
+                    << parallelProblem.functionEvaluation());
+
+    // every call of the cost function is counted, including the
+    // ones made concurrently
+    if (serialProblem.functionEvaluation() != serialCost.calls()
+        || parallelProblem.functionEvaluation() != parallelCost.calls())
+        BOOST_ERROR("wrong number of function evaluations"
+                    << "\n    serial:      "
+                    << serialProblem.functionEvaluation()
+                    << " counted, " << serialCost.calls() << " made"
+                    << "\n    concurrent:  "
+                    << parallelProblem.functionEvaluation()
+                    << " counted, " << parallelCost.calls() << " made");
+
+    #ifdef _OPENMP
+    if (omp_get_max_threads() > 1) {
+        if (parallelCost.threads() < 2)
+            BOOST_ERROR("cost function evaluated by "
+                        << parallelCost.threads() << " thread(s) only");
+        if (serialCost.threads() != 1)
+            BOOST_ERROR("serial cost function evaluated by "
+                        << serialCost.threads() << " threads");
+    }
+    #endif
+
+    for (bool parallel : {false, true}) {
+        DifferentialEvolution optimizer(
+            DifferentialEvolution::Configuration(conf)
+            .withParallelEvaluation(parallel));
+
+        // errors of the cost function are penalized during the evolution...
+        FailingCostFunction failingCost(200);
+        Problem problem(failingCost, constraint, Array(2, 5.0));
+        BOOST_CHECK_NO_THROW(optimizer.minimize(problem, endCriteria));
+        if (problem.currentValue()[0] < 0.0)
+            BOOST_ERROR("failing point returned as minimum: "
+                        << problem.currentValue());
+
+        // ...but the ones of the initial population are propagated
+        FailingCostFunction initialFailingCost(0);
+        Problem failingProblem(initialFailingCost, constraint, Array(2, -5.0));
+        BOOST_CHECK_THROW(optimizer.minimize(failingProblem, endCriteria),
+                          Error);
+    }
+}
+
+// exposes the population of the firefly algorithm
+class InspectableFireflyAlgorithm : public FireflyAlgorithm {
+  public:
+    using FireflyAlgorithm::FireflyAlgorithm;
+    // largest difference between the stored and the actual values
+    Real valueError(const CostFunction& f) const {
+        Real error = 0.0;
+        for (const auto& v : values_)
+            error = std::max(error, std::fabs(v.first - f.value(x_[v.second])));
+        return error;
+    }
+    Real bestValue() const {
+        return std::min_element(values_.begin(), values_.end())->first;
+    }
+};
+
+BOOST_AUTO_TEST_CASE(testFireflyAlgorithmPopulation) {
+    BOOST_TEST_MESSAGE("Testing the population of the firefly algorithm...");
+
+    SecondDeJong costFunction;
+    BoundaryConstraint constraint(-10.0, 10.0);
+    const EndCriteria endCriteria(30, 20, 1e-10, 1e-8, Null<Real>());
+    const Size M = 40;
+
+    // pure differential evolution, mixed, pure firefly algorithm
+    for (Size Mde : {M, M/2, Size(0)}) {
+        InspectableFireflyAlgorithm optimizer(
+            M, ext::make_shared<ExponentialIntensity>(1.0, 0.1, 0.1),
+            ext::make_shared<GaussianWalk>(0.1, 0.9, 42), Mde, 0.5, 0.9, 42);
+
+        Problem problem(costFunction, constraint, Array(2, 5.0));
+        optimizer.minimize(problem, endCriteria);
+
+        // accepted points are stored along with their own value
+        const Real error = optimizer.valueError(costFunction);
+        if (error != 0.0)
+            BOOST_ERROR("stored values differ from the cost function"
+                        << "\n    DE members: " << Mde
+                        << "\n    error:      " << error);
+
+        // differential evolution only accepts improvements, hence
+        // the best point found is still in the population
+        if (Mde == M && optimizer.bestValue() != problem.functionValue())
+            BOOST_ERROR("best member lost by differential evolution"
+                        << std::setprecision(16)
+                        << "\n    best in population: "
+                        << optimizer.bestValue()
+                        << "\n    minimum found:      "
+                        << problem.functionValue());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testFireflyAlgorithmParallelEvaluation) {
+    BOOST_TEST_MESSAGE("Testing concurrent evaluation in the firefly algorithm...");
+
+    SecondDeJong secondDeJong;
+    BoundaryConstraint constraint(-10.0, 10.0);
+    const EndCriteria endCriteria(30, 20, 1e-10, 1e-8, Null<Real>());
+
+    std::vector<Array> x;
+    std::vector<Real> f;
+    std::vector<Size> evaluations;
+    for (bool parallel : {false, false, true}) {
+        FireflyAlgorithm optimizer(
+            40, ext::make_shared<ExponentialIntensity>(1.0, 0.1, 0.1),
+            ext::make_shared<GaussianWalk>(0.1, 0.9, 42), 20, 0.5, 0.9, 42,
+            parallel);
+
+        CountingCostFunction costFunction(secondDeJong);
+        Problem problem(costFunction, constraint, Array(2, 5.0));
+        optimizer.minimize(problem, endCriteria);
+
+        if (problem.functionEvaluation() != costFunction.calls())
+            BOOST_ERROR("wrong number of function evaluations: "
+                        << problem.functionEvaluation() << " counted, "
+                        << costFunction.calls() << " made");
+
+        x.push_back(problem.currentValue());
+        f.push_back(problem.functionValue());
+        evaluations.push_back(problem.functionEvaluation());
+    }
+
+    // the same seed gives the same result, whether the points
+    // are evaluated concurrently or not
+    for (Size i = 1; i < x.size(); ++i) {
+        if (f[i] != f[0] || maxDifference(x[i], x[0]) != 0.0
+            || evaluations[i] != evaluations[0])
+            BOOST_ERROR("run #" << i << " differs from the first one"
+                        << std::setprecision(16)
+                        << "\n    first:  " << x[0] << ", f = " << f[0]
+                        << ", evaluations: " << evaluations[0]
+                        << "\n    run #" << i << ": " << x[i]
+                        << ", f = " << f[i]
+                        << ", evaluations: " << evaluations[i]);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testParticleSwarmOptimizationParallelEvaluation) {
+    BOOST_TEST_MESSAGE(
+        "Testing concurrent evaluation in particle swarm optimization...");
+
+    SecondDeJong secondDeJong;
+    BoundaryConstraint constraint(-10.0, 10.0);
+    const EndCriteria endCriteria(50, 40, 1e-10, 1e-8, Null<Real>());
+
+    std::vector<Array> x;
+    std::vector<Real> f;
+    std::vector<Size> evaluations;
+    for (bool parallel : {false, false, true}) {
+        ParticleSwarmOptimization optimizer(
+            40, ext::make_shared<KNeighbors>(3),
+            ext::make_shared<SimpleRandomInertia>(0.5, 42), 2.05, 2.05, 42,
+            parallel);
+
+        CountingCostFunction costFunction(secondDeJong);
+        Problem problem(costFunction, constraint, Array(2, 5.0));
+        optimizer.minimize(problem, endCriteria);
+
+        if (problem.functionEvaluation() != costFunction.calls())
+            BOOST_ERROR("wrong number of function evaluations: "
+                        << problem.functionEvaluation() << " counted, "
+                        << costFunction.calls() << " made");
+
+        x.push_back(problem.currentValue());
+        f.push_back(problem.functionValue());
+        evaluations.push_back(problem.functionEvaluation());
+    }
+
+    // the same seed gives the same result, whether the particles
+    // are evaluated concurrently or not
+    for (Size i = 1; i < x.size(); ++i) {
+        if (f[i] != f[0] || maxDifference(x[i], x[0]) != 0.0
+            || evaluations[i] != evaluations[0])
+            BOOST_ERROR("run #" << i << " differs from the first one"
+                        << std::setprecision(16)
+                        << "\n    first:  " << x[0] << ", f = " << f[0]
+                        << ", evaluations: " << evaluations[0]
+                        << "\n    run #" << i << ": " << x[i]
+                        << ", f = " << f[i]
+                        << ", evaluations: " << evaluations[i]);
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 BOOST_AUTO_TEST_SUITE_END()
@@ -34,6 +34,10 @@
  Benchmark with one worker process per hardware thread and the default size:
  ./quantlib-benchmark
 
+ Thread scaling of the OpenMP parallel finite-difference operators, if the
+ library is built with QL_ENABLE_OPENMP:
+ ./quantlib-benchmark --nProc=1 --filter=FdmLinearOpTests --threads=1,2,4,8,16,32
+
  This benchmark is derived from quantlibtestsuite.cpp. Please see the
  copyrights therein.
 */
@@ -62,6 +66,7 @@ namespace bp = boost::process;
 #include <boost/test/unit_test_suite.hpp>
 #include <boost/test/framework.hpp>
 
+#include <algorithm>
 #include <iomanip>
 #include <iostream>
 #include <utility>
@@ -70,6 +75,10 @@ namespace bp = boost::process;
 #include <chrono>
 #include <thread>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 
 
 /* Use BOOST_MSVC instead of _MSC_VER since some other vendors (Metrowerks,
@@ -412,6 +421,37 @@ namespace {
         }
 
 
+        // Print the runtime of each test for each number of OpenMP threads
+        static void printScaling(
+                const std::vector<unsigned>& threads,
+                const std::vector<std::vector<double> >& runtimes   // [thread count][benchmark]
+                )
+        {
+            size_t len = 0;
+            for (const auto & b : bm) { len = std::max(len, b.getName().length() ); }
+
+            std::cout << "\033[0m\n";
+            std::cout << "                       Runtime and speed-up per number of threads" << std::endl;
+            std::cout << std::string(84,'-') << std::endl;
+            std::cout << std::string(len+2, ' ');
+            for (unsigned n : threads)
+                std::cout << std::setw(18) << n;
+            std::cout << std::endl;
+
+            for (size_t j=0; j < bm.size(); ++j) {
+                std::cout << bm[j].getName()
+                    << std::string(len+2 - bm[j].getName().length(),' ');
+                for (size_t i=0; i < threads.size(); ++i)
+                    std::cout << std::setw(9) << std::fixed << std::setprecision(3)
+                              << runtimes[i][j] << "s"
+                              << std::setw(7) << std::setprecision(2)
+                              << runtimes[0][j]/runtimes[i][j] << "x";
+                std::cout << std::endl;
+            }
+            std::cout << std::string(84,'-') << std::endl << std::endl;
+        }
+
+
 #ifdef QL_ENABLE_PARALLEL_UNIT_TEST_RUNNER
         // The entry point for the std::thread's that will be the workers
         static int worker(const char * exe, const std::vector<std::string>& args) {
@@ -500,6 +540,8 @@ QL_BENCHMARK_DECLARE(HestonModelTests, testLocalVolFromHestonModel, 10, 1.0);
 QL_BENCHMARK_DECLARE(FdHestonTests, testFdmHestonAmerican, 10, 1.0);
 QL_BENCHMARK_DECLARE(FdHestonTests, testAmericanCallPutParity, 15, 1.5);
 QL_BENCHMARK_DECLARE(FdHestonTests, testFdmHestonBarrierVsBlackScholes, 1, 2.0);
+QL_BENCHMARK_DECLARE(FdmLinearOpTests, testFdmHestonBarrier, 5, 1.0);
+QL_BENCHMARK_DECLARE(FdmLinearOpTests, testFdmHestonHullWhiteOp, 1, 2.0);
 QL_BENCHMARK_DECLARE(HestonSLVModelTests, testMonteCarloCalibration, 1, 3.0);
 QL_BENCHMARK_DECLARE(HestonSLVModelTests, testHestonFokkerPlanckFwdEquation, 1, 5.0);
 QL_BENCHMARK_DECLARE(HestonSLVModelTests, testBarrierPricingViaHestonLocalVol, 1, 1.0);
@@ -564,6 +606,7 @@ QL_BENCHMARK_DECLARE(RiskStatisticsTests, testResults, 4, 0.5);
 QL_BENCHMARK_DECLARE(LowDiscrepancyTests, testMersenneTwisterDiscrepancy, 2, 0.5);
 QL_BENCHMARK_DECLARE(LinearLeastSquaresRegressionTests, testMultiDimRegression, 20, 2.0);
 QL_BENCHMARK_DECLARE(StatisticsTests, testIncrementalStatistics, 20, 0.5);
+QL_BENCHMARK_DECLARE(StatisticsTests, testStreamingStatistics, 2, 1.0);
 QL_BENCHMARK_DECLARE(FunctionsTests, testFactorial, 1000, 0.1);
 QL_BENCHMARK_DECLARE(FunctionsTests, testGammaFunction, 1000, 0.5);
 QL_BENCHMARK_DECLARE(FunctionsTests, testGammaValues, 100000, 0.5);
@@ -601,6 +644,11 @@ int main(int argc, char* argv[] )  // NOLINT(bugprone-exception-escape)
     // A threadId is useful for debugging, but has no other purpose
     unsigned threadId = 0;
 
+    // Numbers of OpenMP threads for a scaling measurement, and the
+    // benchmarks it is restricted to
+    std::vector<unsigned> threads;
+    std::string filter;
+
 
 
 
@@ -646,6 +694,32 @@ int main(int argc, char* argv[] )  // NOLINT(bugprone-exception-escape)
                     "benchmark size is not given");
             size = tok[1];
         }
+        else if (tok[0] == "--threads") {
+#ifndef _OPENMP
+            std::cerr << "Option 'threads' requires a build with OpenMP" << std::endl;
+            exit(1);
+#endif
+            QL_REQUIRE(tok.size() == 2, "Must provide the numbers of threads");
+            std::vector<std::string> counts;
+            boost::split(counts, tok[1], boost::is_any_of(","));
+            try {
+                for (const auto& c : counts) {
+                    QL_REQUIRE(c.find_first_not_of("0123456789") == std::string::npos,
+                               "'" << c << "' is not a number");
+                    const int n = boost::numeric_cast<int>(std::stoul(c));
+                    QL_REQUIRE(n > 0, "zero threads given");
+                    threads.push_back(unsigned(n));
+                }
+            } catch(const std::exception &e) {
+                std::cerr << "Invalid argument to 'threads', not a list of positive integers" << std::endl;
+                std::cerr << "Exception generated: " << e.what() << "\n";
+                exit(1);
+            }
+        }
+        else if (tok[0] == "--filter") {
+            QL_REQUIRE(tok.size() == 2, "Must provide a filter");
+            filter = tok[1];
+        }
         else if (arg == "-h" || arg == "--help" || arg == "-?") {
             std::cout
                 << "\n'quantlib-benchmark' is QuantLib " QL_VERSION " CPU performance benchmark\n"
@@ -678,6 +752,13 @@ int main(int argc, char* argv[] )  // NOLINT(bugprone-exception-escape)
                 << "\n"
                 << "--verbose=<0|1|2|3>\t controls verbosity of output, default value is verbose=" << BenchmarkSupport::verbose << "\n"
                 << "\n"
+                << "--filter=<name>    \t only run the benchmarks whose name contains 'name'\n"
+                << "\n"
+#ifdef _OPENMP
+                << "--threads=<N1,N2,..>\t run the benchmarks once for each number of OpenMP\n"
+                << "                   \t threads and report the runtimes, requires nProc=1\n"
+                << "\n"
+#endif
                 << "-?, --help         \t display this help and exit"
                 << std::endl;
             return 0;
@@ -697,6 +778,20 @@ int main(int argc, char* argv[] )  // NOLINT(bugprone-exception-escape)
     const unsigned int nSize = BenchmarkSupport::parseBmSize(size);
     std::vector<double> workerLifetimes;
 
+    if (!threads.empty() && nProc != 1) {
+        std::cerr << "Option 'threads' requires nProc=1" << std::endl;
+        exit(1);
+    }
+
+    if (!filter.empty()) {
+        bm.erase(std::remove_if(bm.begin(), bm.end(),
+                                [&](const Benchmark& b) {
+                                    return b.getName().find(filter) == std::string::npos;
+                                }),
+                 bm.end());
+        QL_REQUIRE(!bm.empty(), "no benchmark matches filter '" << filter << "'");
+    }
+
     ////////  Finished argument processing, start benchmark code   //////////////////////////////////////////////
 
     try {
@@ -729,6 +824,25 @@ int main(int argc, char* argv[] )  // NOLINT(bugprone-exception-escape)
                 }
              }
 
+#ifdef _OPENMP
+            // Thread scaling, each test is timed for each number of threads
+            if (!threads.empty()) {
+                std::vector<std::vector<double> > runtimes;
+                for (unsigned n : threads) {
+                    omp_set_num_threads(int(n));
+                    std::vector<double> runtime(bm.size(), 0.0);
+                    for (unsigned i=0; i < nSize; ++i) {
+                        for(unsigned int j=0; j<bm.size(); j++) {
+                            runtime[j] += bm[j].runBenchmark();
+                        }
+                    }
+                    runtimes.push_back(runtime);
+                }
+                BenchmarkSupport::printScaling(threads, runtimes);
+                return 0;
+            }
+#endif
+
             // Now run the benchmark proper
             auto startTime = std::chrono::steady_clock::now();
             for (unsigned i=0; i < nSize; ++i) {
@@ -26,7 +26,9 @@
 #include <ql/cashflows/iborcoupon.hpp>
 #include <ql/models/shortrate/onefactormodels/hullwhite.hpp>
 #include <ql/models/shortrate/onefactormodels/extendedcoxingersollross.hpp>
+#include <ql/models/shortrate/calibrationhelpers/caphelper.hpp>
 #include <ql/models/shortrate/calibrationhelpers/swaptionhelper.hpp>
+#include <ql/pricingengines/capfloor/analyticcapfloorengine.hpp>
 #include <ql/pricingengines/swaption/jamshidianswaptionengine.hpp>
 #include <ql/pricingengines/swap/treeswapengine.hpp>
 #include <ql/pricingengines/swap/discountingswapengine.hpp>
@@ -34,6 +36,7 @@
 #include <ql/indexes/indexmanager.hpp>
 #include <ql/math/optimization/simplex.hpp>
 #include <ql/math/optimization/levenbergmarquardt.hpp>
+#include <ql/math/optimization/trustregionlevenbergmarquardt.hpp>
 #include <ql/termstructures/yield/discountcurve.hpp>
 #include <ql/time/calendars/target.hpp>
 #include <ql/time/daycounters/thirty360.hpp>
@@ -280,6 +283,119 @@ BOOST_AUTO_TEST_CASE(testCachedHullWhite2) {
     }
 }
 
+BOOST_AUTO_TEST_CASE(testHullWhiteAnalyticGradient) {
+    BOOST_TEST_MESSAGE("Testing Hull-White calibration with analytic gradients...");
+
+    Date today(15, February, 2002);
+    Date settlement(19, February, 2002);
+    Settings::instance().evaluationDate() = today;
+    Handle<YieldTermStructure> termStructure(flatRate(settlement,0.04875825,
+                                                      Actual365Fixed()));
+    ext::shared_ptr<HullWhite> model(new HullWhite(termStructure));
+    CalibrationData data[] = {{ 1, 5, 0.1148 },
+                              { 2, 4, 0.1108 },
+                              { 3, 3, 0.1070 },
+                              { 4, 2, 0.1021 },
+                              { 5, 1, 0.1000 }};
+    ext::shared_ptr<IborIndex> index(new Euribor6M(termStructure));
+
+    ext::shared_ptr<PricingEngine> swaptionEngine(
+                                         new JamshidianSwaptionEngine(model));
+    ext::shared_ptr<PricingEngine> capEngine(
+                                         new AnalyticCapFloorEngine(model));
+
+    std::vector<ext::shared_ptr<CalibrationHelper> > helpers;
+    for (auto& i : data) {
+        ext::shared_ptr<Quote> vol(new SimpleQuote(i.volatility));
+        ext::shared_ptr<BlackCalibrationHelper> helper(
+            new SwaptionHelper(Period(i.start, Years), Period(i.length, Years), Handle<Quote>(vol),
+                               index, Period(1, Years), Thirty360(Thirty360::BondBasis), Actual360(), termStructure,
+                               BlackCalibrationHelper::ImpliedVolError));
+        helper->setPricingEngine(swaptionEngine);
+        helpers.push_back(helper);
+    }
+    for (Integer length=2; length <= 10; length+=4) {
+        ext::shared_ptr<Quote> vol(new SimpleQuote(0.11));
+        ext::shared_ptr<BlackCalibrationHelper> helper(
+            new CapHelper(Period(length, Years), Handle<Quote>(vol), index,
+                          Annual, Thirty360(Thirty360::BondBasis), false,
+                          termStructure));
+        helper->setPricingEngine(capEngine);
+        helpers.push_back(helper);
+    }
+
+    const Array params = model->params();
+    const Real h = 1e-7;
+    for (const auto& helper : helpers) {
+        model->setParams(params);
+        Array gradient;
+        const Real error = helper->calibrationErrorAndGradient(gradient);
+
+        if (gradient.size() != params.size())
+            BOOST_FAIL("analytic gradient not provided");
+        if (std::fabs(error - helper->calibrationError()) > 1e-14)
+            BOOST_ERROR("inconsistent calibration errors"
+                        << "\n    with gradient:    " << error
+                        << "\n    without gradient: "
+                        << helper->calibrationError());
+
+        for (Size j=0; j < params.size(); ++j) {
+            Array bumped(params);
+            bumped[j] += h;
+            model->setParams(bumped);
+            const Real up = helper->calibrationError();
+            bumped[j] -= 2*h;
+            model->setParams(bumped);
+            const Real down = helper->calibrationError();
+            const Real expected = (up - down)/(2*h);
+
+            if (std::fabs(gradient[j] - expected) > 1e-5*std::fabs(expected) + 1e-8)
+                BOOST_ERROR("failed to reproduce calibration error derivative"
+                            << "\n    parameter:  " << j
+                            << std::setprecision(10)
+                            << "\n    calculated: " << gradient[j]
+                            << "\n    expected:   " << expected);
+        }
+    }
+
+    model->setParams(params);
+    LevenbergMarquardt numericalJacobian(1.0e-8,1.0e-8,1.0e-8);
+    EndCriteria endCriteria(10000, 100, 1e-6, 1e-8, 1e-8);
+    model->calibrate(helpers, numericalJacobian, endCriteria);
+    const Array expected = model->params();
+
+    model->setParams(params);
+    LevenbergMarquardt analyticJacobian(1.0e-8,1.0e-8,1.0e-8,true);
+    model->calibrate(helpers, analyticJacobian, endCriteria);
+    const Array calculated = model->params();
+
+    // the mean reversion is poorly determined by the data, hence the
+    // minima are compared instead of the parameters
+    const Real calculatedValue = model->value(calculated, helpers);
+    const Real expectedValue = model->value(expected, helpers);
+    if (calculatedValue > expectedValue*(1.0 + 1e-6)
+        || std::fabs(calculated[1] - expected[1]) > 1e-6)
+        BOOST_ERROR("failed to reproduce calibration"
+                    << std::setprecision(10)
+                    << "\n    calculated: " << calculated
+                    << ", f = " << calculatedValue
+                    << "\n    expected:   " << expected
+                    << ", f = " << expectedValue);
+
+    model->setParams(params);
+    TrustRegionLevenbergMarquardt trustRegion(1.0e-8,1.0e-8);
+    model->calibrate(helpers, trustRegion, endCriteria);
+    const Real trustRegionValue = model->value(model->params(), helpers);
+    if (trustRegionValue > expectedValue*(1.0 + 1e-6)
+        || std::fabs(model->params()[1] - expected[1]) > 1e-6)
+        BOOST_ERROR("failed to reproduce calibration with trust region"
+                    << std::setprecision(10)
+                    << "\n    calculated: " << model->params()
+                    << ", f = " << trustRegionValue
+                    << "\n    expected:   " << expected
+                    << ", f = " << expectedValue);
+}
+
 BOOST_AUTO_TEST_CASE(testSwaps) {
     BOOST_TEST_MESSAGE("Testing Hull-White swap pricing against known values...");
 
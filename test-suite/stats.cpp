@@ -27,11 +27,13 @@
 #include <ql/math/statistics/gaussianstatistics.hpp>
 #include <ql/math/statistics/sequencestatistics.hpp>
 #include <ql/math/statistics/convergencestatistics.hpp>
+#include <ql/math/statistics/streamingstatistics.hpp>
 #include <ql/math/randomnumbers/mt19937uniformrng.hpp>
 #include <ql/math/randomnumbers/inversecumulativerng.hpp>
 #include <ql/math/distributions/normaldistribution.hpp>
 #include <ql/math/comparison.hpp>
 #include <ql/utilities/dataformatters.hpp>
+#include <sstream>
 
 using namespace QuantLib;
 using namespace boost::unit_test_framework;
@@ -294,6 +296,7 @@ BOOST_AUTO_TEST_CASE(testStatistics) {
     check<IncrementalStatistics>(
         std::string("IncrementalStatistics"));
     check<Statistics>(std::string("Statistics"));
+    check<StreamingStatistics>(std::string("StreamingStatistics"));
 }
 
 BOOST_AUTO_TEST_CASE(testSequenceStatistics) {
@@ -329,6 +332,8 @@ BOOST_AUTO_TEST_CASE(testIncrementalStatistics) {
     // a wrapper to the boost accumulator library. This is
     // a test of the new implementation against results from
     // the old one.
+    // Skewness and kurtosis are now computed from central moments,
+    // which changed the last digits of the cached results.
 
     MersenneTwisterUniformRng mt(42);
 
@@ -349,8 +354,8 @@ BOOST_AUTO_TEST_CASE(testIncrementalStatistics) {
     TEST_INC_STAT(stat.variance(),  5.0706503959683329e+05);
     TEST_INC_STAT(stat.standardDeviation(),  7.1208499464378076e+02);
     TEST_INC_STAT(stat.errorEstimate(), 1.0070402569876076e+00);
-    TEST_INC_STAT(stat.skewness(), -1.7360169326720038e-03);
-    TEST_INC_STAT(stat.kurtosis(), -1.1990742562085395e+00);
+    TEST_INC_STAT(stat.skewness(), -1.7360169326719533e-03);
+    TEST_INC_STAT(stat.kurtosis(), -1.1990742562085244e+00);
     TEST_INC_STAT(stat.min(), -1.2339945045639761e+03);
     TEST_INC_STAT(stat.max(),  1.2339958308008499e+03);
     TEST_INC_STAT(stat.downsideVariance(), 5.0786776146975247e+05);
@@ -377,6 +382,294 @@ BOOST_AUTO_TEST_CASE(testIncrementalStatistics) {
                                  << tol);
 }
 
+template <class S>
+void checkMerge(const std::string& name) {
+
+    MersenneTwisterUniformRng mt(42);
+
+    const Size dimension = 3, nPartial = 4;
+    GenericSequenceStatistics<S> whole(dimension);
+    std::vector<GenericSequenceStatistics<S> > partial(
+        nPartial, GenericSequenceStatistics<S>(dimension));
+
+    for (Size i = 0; i < 10000; ++i) {
+        Real x = mt.nextReal() - 0.5;
+        Real y = 0.3*x + mt.nextReal();
+        std::vector<Real> sample = { -1.0e4 + x, y, x*y };
+        Real w = mt.nextReal();
+        whole.add(sample, w);
+        partial[i % nPartial].add(sample, w);
+    }
+
+    // the last partial accumulator goes through serialization
+    std::stringstream buffer;
+    partial.back().save(buffer);
+    GenericSequenceStatistics<S> restored;
+    restored.load(buffer);
+    partial.back() = restored;
+
+    GenericSequenceStatistics<S> merged;
+    for (const auto& p : partial)
+        merged.merge(p);
+
+    const Real tolerance = 1.0e-8;
+
+    if (merged.samples() != whole.samples())
+        BOOST_FAIL("SequenceStatistics<" << name << ">: "
+                   << "wrong number of merged samples\n"
+                   << "    calculated: " << merged.samples() << "\n"
+                   << "    expected:   " << whole.samples());
+
+    if (std::fabs(merged.weightSum() - whole.weightSum()) > tolerance)
+        BOOST_FAIL("SequenceStatistics<" << name << ">: "
+                   << "wrong merged sum of weights\n"
+                   << "    calculated: " << merged.weightSum() << "\n"
+                   << "    expected:   " << whole.weightSum());
+
+    #define CHECK_MERGED(METHOD)                                          \
+    {                                                                     \
+        std::vector<Real> calculated = merged.METHOD();                   \
+        std::vector<Real> expected = whole.METHOD();                      \
+        for (Size i=0; i<dimension; ++i) {                                \
+            if (std::fabs(calculated[i]-expected[i])                      \
+                > tolerance*std::max<Real>(1.0, std::fabs(expected[i])))  \
+                BOOST_FAIL("SequenceStatistics<" << name << ">: "         \
+                           << io::ordinal(i+1) << " dimension: "          \
+                           << "wrong merged " #METHOD "\n"                \
+                           << "    calculated: " << calculated[i] << "\n" \
+                           << "    expected:   " << expected[i]);         \
+        }                                                                 \
+    }
+
+    CHECK_MERGED(mean)
+    CHECK_MERGED(variance)
+    CHECK_MERGED(skewness)
+    CHECK_MERGED(kurtosis)
+    CHECK_MERGED(min)
+    CHECK_MERGED(max)
+    CHECK_MERGED(downsideVariance)
+
+    #undef CHECK_MERGED
+
+    Matrix calculated = merged.covariance();
+    Matrix expected = whole.covariance();
+    for (Size i=0; i<dimension; ++i) {
+        for (Size j=0; j<dimension; ++j) {
+            if (std::fabs(calculated[i][j] - expected[i][j]) > tolerance)
+                BOOST_FAIL("SequenceStatistics<" << name << ">: "
+                           << "wrong merged covariance ("
+                           << i << ", " << j << ")\n"
+                           << "    calculated: " << calculated[i][j] << "\n"
+                           << "    expected:   " << expected[i][j]);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testMergedStatistics) {
+
+    BOOST_TEST_MESSAGE("Testing merged statistics...");
+
+    checkMerge<IncrementalStatistics>(std::string("IncrementalStatistics"));
+    checkMerge<Statistics>(std::string("Statistics"));
+}
+
+BOOST_AUTO_TEST_CASE(testMergedStatisticsWithLargeOffset) {
+
+    BOOST_TEST_MESSAGE("Testing merged statistics of data "
+                       "with a large common offset...");
+
+    MersenneTwisterUniformRng mt(42);
+
+    // the central moments do not depend on the offset; combining
+    // raw power sums would lose all significant digits here.
+    const Real offset = 1.0e8;
+    const Size nPartial = 5;
+
+    IncrementalStatistics reference, whole;
+    std::vector<IncrementalStatistics> partial(nPartial);
+
+    for (Size i = 0; i < 50000; ++i) {
+        Real u = mt.nextReal();
+        Real x = u*u*u;
+        Real w = 0.5 + mt.nextReal();
+        reference.add(x, w);
+        whole.add(offset + x, w);
+        partial[i % nPartial].add(offset + x, w);
+    }
+
+    IncrementalStatistics merged;
+    for (const auto& p : partial)
+        merged.merge(p);
+
+    const Real tolerance = 1.0e-6;
+    for (const auto& stat : { whole, merged }) {
+        if (std::fabs(stat.variance() - reference.variance())
+            > tolerance*reference.variance())
+            BOOST_ERROR("wrong variance with large offset\n"
+                        << std::setprecision(12)
+                        << "    calculated: " << stat.variance() << "\n"
+                        << "    expected:   " << reference.variance());
+        if (std::fabs(stat.skewness() - reference.skewness()) > tolerance)
+            BOOST_ERROR("wrong skewness with large offset\n"
+                        << std::setprecision(12)
+                        << "    calculated: " << stat.skewness() << "\n"
+                        << "    expected:   " << reference.skewness());
+        if (std::fabs(stat.kurtosis() - reference.kurtosis()) > tolerance)
+            BOOST_ERROR("wrong kurtosis with large offset\n"
+                        << std::setprecision(12)
+                        << "    calculated: " << stat.kurtosis() << "\n"
+                        << "    expected:   " << reference.kurtosis());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testStatisticsState) {
+
+    BOOST_TEST_MESSAGE("Testing saving and loading statistics state...");
+
+    MersenneTwisterUniformRng mt(42);
+
+    GeneralStatistics general;
+    IncrementalStatistics incremental;
+    StreamingStatistics streaming;
+    for (Size i = 0; i < 1000; ++i) {
+        Real x = mt.nextReal();
+        general.add(x);
+        incremental.add(x);
+        streaming.add(x);
+    }
+
+    std::stringstream generalState, incrementalState, streamingState;
+    general.save(generalState);
+    incremental.save(incrementalState);
+    streaming.save(streamingState);
+
+    StreamingStatistics restored;
+    restored.load(streamingState);
+    if (restored.samples() != streaming.samples()
+        || restored.mean() != streaming.mean()
+        || restored.percentile(0.9) != streaming.percentile(0.9))
+        BOOST_ERROR("failed to restore streaming statistics"
+                    << "\n    samples:    " << restored.samples()
+                    << "\n    mean:       " << restored.mean()
+                    << "\n    percentile: " << restored.percentile(0.9)
+                    << "\n    expected:   " << streaming.samples()
+                    << ", " << streaming.mean()
+                    << ", " << streaming.percentile(0.9));
+
+    // the state of another accumulator is rejected
+    IncrementalStatistics target;
+    target.add(1.0);
+    BOOST_CHECK_THROW(target.load(generalState), Error);
+
+    // so are truncated states and unknown versions, leaving the
+    // accumulator unchanged
+    const std::string state = incrementalState.str();
+    std::stringstream truncated(state.substr(0, state.size()-1));
+    BOOST_CHECK_THROW(target.load(truncated), Error);
+
+    std::string newerState = state;
+    newerState[4] += 1;
+    std::stringstream newer(newerState);
+    BOOST_CHECK_THROW(target.load(newer), Error);
+
+    if (target.samples() != 1 || target.mean() != 1.0)
+        BOOST_ERROR("accumulator modified by failed load");
+
+    std::stringstream complete(state);
+    target.load(complete);
+    if (target.samples() != incremental.samples()
+        || target.mean() != incremental.mean())
+        BOOST_ERROR("failed to restore incremental statistics");
+}
+
+BOOST_AUTO_TEST_CASE(testStreamingStatistics) {
+
+    BOOST_TEST_MESSAGE("Testing streaming statistics against exact ones...");
+
+    MersenneTwisterUniformRng mt(42);
+    InverseCumulativeRng<MersenneTwisterUniformRng,InverseCumulativeNormal>
+        normal_gen(mt);
+
+    const Size n = 1000000;
+    Statistics exact;
+    StreamingRiskStatistics streaming;
+    std::vector<StreamingRiskStatistics> partial(4);
+    exact.reserve(n);
+
+    for (Size i = 0; i < n; ++i) {
+        Real x = normal_gen.next().value;
+        exact.add(x);
+        streaming.add(x);
+        partial[i % partial.size()].add(x);
+    }
+
+    StreamingRiskStatistics merged;
+    for (const auto& p : partial)
+        merged.merge(p);
+
+    // the digest must not grow with the number of samples
+    if (streaming.centroids() > Size(streaming.compression()))
+        BOOST_ERROR("too many centroids: " << streaming.centroids()
+                    << " for compression " << streaming.compression());
+
+    // error bounds as documented in the class, in units of
+    // the standard deviation of the samples
+    const Real momentTolerance = 1.0e-10;
+    const Real percentileTolerance = 5.0e-3;
+    const Real tailPercentileTolerance = 1.5e-2;
+    const Real varTolerance = 1.0e-3;
+    const Real esTolerance = 1.5e-2;
+
+    for (const auto& s : { streaming, merged }) {
+        if (s.samples() != n)
+            BOOST_ERROR("wrong number of samples: " << s.samples());
+        if (std::fabs(s.mean() - exact.mean()) > momentTolerance)
+            BOOST_ERROR("wrong mean: " << s.mean()
+                        << " instead of " << exact.mean());
+        if (std::fabs(s.variance() - exact.variance()) > momentTolerance)
+            BOOST_ERROR("wrong variance: " << s.variance()
+                        << " instead of " << exact.variance());
+        if (std::fabs(s.skewness() - exact.skewness()) > momentTolerance)
+            BOOST_ERROR("wrong skewness: " << s.skewness()
+                        << " instead of " << exact.skewness());
+        if (std::fabs(s.kurtosis() - exact.kurtosis()) > momentTolerance)
+            BOOST_ERROR("wrong kurtosis: " << s.kurtosis()
+                        << " instead of " << exact.kurtosis());
+        if (s.min() != exact.min() || s.max() != exact.max())
+            BOOST_ERROR("wrong extrema: [" << s.min() << ", " << s.max()
+                        << "] instead of [" << exact.min() << ", "
+                        << exact.max() << "]");
+
+        for (Real q : { 0.001, 0.01, 0.05, 0.25, 0.5, 0.75, 0.95, 0.99, 0.999 }) {
+            Real calculated = s.percentile(q);
+            Real expected = exact.percentile(q);
+            Real tolerance = (q < 0.01 || q > 0.99)
+                ? tailPercentileTolerance : percentileTolerance;
+            if (std::fabs(calculated - expected) > tolerance)
+                BOOST_ERROR("wrong " << io::percent(q) << " percentile"
+                            << "\n    calculated: " << calculated
+                            << "\n    expected:   " << expected);
+        }
+
+        for (Real p : { 0.95, 0.975, 0.99 }) {
+            Real calculated = s.valueAtRisk(p);
+            Real expected = exact.valueAtRisk(p);
+            if (std::fabs(calculated - expected) > varTolerance)
+                BOOST_ERROR("wrong " << io::percent(p) << " value-at-risk"
+                            << "\n    calculated: " << calculated
+                            << "\n    expected:   " << expected);
+
+            calculated = s.expectedShortfall(p);
+            expected = exact.expectedShortfall(p);
+            if (std::fabs(calculated - expected) > esTolerance)
+                BOOST_ERROR("wrong " << io::percent(p)
+                            << " expected shortfall"
+                            << "\n    calculated: " << calculated
+                            << "\n    expected:   " << expected);
+        }
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 BOOST_AUTO_TEST_SUITE_END()
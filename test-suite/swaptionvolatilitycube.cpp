@@ -572,6 +572,89 @@ BOOST_AUTO_TEST_CASE(testSabrParameters) {
 
 }
 
+BOOST_AUTO_TEST_CASE(testParallelSabrCalibration) {
+    BOOST_TEST_MESSAGE("Testing parallel and warm-started SABR cube calibration...");
+
+    CommonVars vars;
+
+    const Size nSections =
+        vars.cube.tenors.options.size()*vars.cube.tenors.swaps.size();
+    std::vector<std::vector<Handle<Quote> > > parametersGuess(nSections);
+    std::vector<std::vector<Handle<Quote> > > volSpreads(nSections);
+    std::vector<ext::shared_ptr<SimpleQuote> > volSpreadQuotes;
+    for (Size i=0; i<nSections; i++) {
+        parametersGuess[i] = {
+            Handle<Quote>(ext::make_shared<SimpleQuote>(0.2)),
+            Handle<Quote>(ext::make_shared<SimpleQuote>(0.5)),
+            Handle<Quote>(ext::make_shared<SimpleQuote>(0.4)),
+            Handle<Quote>(ext::make_shared<SimpleQuote>(0.0))
+        };
+        for (const auto& q : vars.cube.volSpreadsHandle[i]) {
+            volSpreadQuotes.push_back(ext::make_shared<SimpleQuote>(q->value()));
+            volSpreads[i].emplace_back(volSpreadQuotes.back());
+        }
+    }
+    std::vector<bool> isParameterFixed(4, false);
+
+    std::vector<ext::shared_ptr<SabrSwaptionVolatilityCube> > volCubes;
+    for (bool parallel : {false, true})
+        volCubes.push_back(ext::make_shared<SabrSwaptionVolatilityCube>(
+            vars.atmVolMatrix, vars.cube.tenors.options, vars.cube.tenors.swaps,
+            vars.cube.strikeSpreads, volSpreads, vars.swapIndexBase,
+            vars.shortSwapIndexBase, vars.vegaWeighedSmileFit, parametersGuess,
+            isParameterFixed, true, ext::shared_ptr<EndCriteria>(), Null<Real>(),
+            ext::shared_ptr<OptimizationMethod>(), Null<Real>(), false, 50, false,
+            0.0001, parallel, parallel));
+
+    const Matrix serial = volCubes[0]->denseSabrParameters();
+    const Matrix parallel = volCubes[1]->denseSabrParameters();
+    for (Size i=0; i<serial.rows(); ++i)
+        for (Size j=0; j<serial.columns(); ++j)
+            if (std::fabs(serial[i][j] - parallel[i][j]) > 1e-12)
+                BOOST_ERROR("parallel calibration differs from serial one:"
+                            << "\n    row:      " << i
+                            << "\n    column:   " << j
+                            << "\n    serial:   " << serial[i][j]
+                            << "\n    parallel: " << parallel[i][j]);
+
+    // intraday move of the smiles
+    for (const auto& q : volSpreadQuotes)
+        q->setValue(q->value() + 0.0005);
+
+    Real coldEvaluations = 0.0, warmEvaluations = 0.0;
+    const Matrix& cold =
+        volCubes[0]->sparseCalibrationStatistics().functionEvaluations;
+    const Matrix& warm =
+        volCubes[1]->sparseCalibrationStatistics().functionEvaluations;
+    for (Size i=0; i<cold.rows(); ++i)
+        for (Size j=0; j<cold.columns(); ++j) {
+            coldEvaluations += cold[i][j];
+            warmEvaluations += warm[i][j];
+        }
+
+    if (warmEvaluations >= coldEvaluations)
+        BOOST_ERROR("warm start does not reduce the calibration effort:"
+                    << "\n    cold start evaluations: " << coldEvaluations
+                    << "\n    warm start evaluations: " << warmEvaluations);
+
+    const Real tolerance = 1.0e-5;
+    for (const auto& optionTenor : vars.cube.tenors.options)
+        for (const auto& swapTenor : vars.cube.tenors.swaps)
+            for (Real strike : {0.02, 0.04, 0.06}) {
+                const Real coldVol =
+                    volCubes[0]->volatility(optionTenor, swapTenor, strike);
+                const Real warmVol =
+                    volCubes[1]->volatility(optionTenor, swapTenor, strike);
+                if (std::fabs(coldVol - warmVol) > tolerance)
+                    BOOST_ERROR("warm-started calibration differs:"
+                                << "\n    option tenor: " << optionTenor
+                                << "\n    swap tenor:   " << swapTenor
+                                << "\n    strike:       " << strike
+                                << "\n    cold start:   " << coldVol
+                                << "\n    warm start:   " << warmVol);
+            }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 BOOST_AUTO_TEST_SUITE_END()